@@ -0,0 +1,44 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+struct PerObject {
+    mat4 WVP, World;
+    // Index into the bindless material table, unused when materials are bound per draw
+    uint MaterialIndex;
+};
+
+// Every drawn object's matrices, indexed by the instance index. Each indirect draw's first instance points at its first object.
+layout (std430, set = 1, binding = 2) readonly buffer PerObjects {
+    PerObject Objects[];
+} g_PerObjects;
+
+layout (location = 0) in vec3 in_Position;
+// Octahedral encoding, expanded from snorm16 by the input assembler
+layout (location = 1) in vec2 in_Normal;
+layout (location = 2) in vec2 in_TXCoords;
+
+layout (location = 0) out vec3 out_Normal;
+layout (location = 1) out vec3 out_WorldPos;
+layout (location = 2) out vec2 out_TXCoords;
+layout (location = 3) flat out uint out_MaterialIndex;
+
+vec3 decodeOctahedral(vec2 encoded)
+{
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-normal.z, 0.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+    return normalize(normal);
+}
+
+void main()
+{
+    PerObject perObject = g_PerObjects.Objects[gl_InstanceIndex];
+    vec4 inPos     = vec4(in_Position, 1.0);
+
+    out_WorldPos    = (inPos * perObject.World).xyz;
+    gl_Position     = inPos * perObject.WVP;
+    out_Normal      = (vec4(decodeOctahedral(in_Normal), 0.0) * perObject.World).xyz;
+    out_TXCoords    = in_TXCoords;
+    out_MaterialIndex = perObject.MaterialIndex;
+}
@@ -0,0 +1,39 @@
+cbuffer perObject : register(b2) {
+    float4x4 wvp;
+    float4x4 world;
+};
+
+struct VS_IN {
+    float3 pos : POSITION;
+    // Octahedral encoding, expanded from snorm16 by the input assembler
+    float2 normal : NORMAL;
+    float2 txCoords : TEXCOORD0;
+};
+
+struct VS_OUT {
+    float4 pos : SV_POSITION;
+    float3 normal : NORMAL;
+    float3 worldPos : WORLD_POSITION;
+    float2 txCoords : TEXCOORD0;
+};
+
+float3 decodeOctahedral(float2 encoded) {
+    float3 normal = float3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-normal.z, 0.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+    return normalize(normal);
+}
+
+VS_OUT main(VS_IN v_in) {
+    VS_OUT v_out = (VS_OUT) 0;
+
+    v_out.pos = float4(v_in.pos, 1.0);
+
+    v_out.worldPos = mul(v_out.pos, world).xyz;
+    v_out.pos = mul(v_out.pos, wvp);
+    v_out.normal = mul(float4(decodeOctahedral(v_in.normal), 0.0), world).xyz;
+    v_out.txCoords = v_in.txCoords;
+
+    return v_out;
+}
@@ -3,18 +3,18 @@
 
 layout(binding = 4) uniform sampler2D u_UITexture;
 
-layout (binding = 2) uniform PerObject {
-    vec2 Position, Size;
-    vec4 Highlight;
-    float HighlightFactor;
-} g_PerObject;
-
 layout (location = 0) in vec2 in_TXCoords;
+layout (location = 1) in vec4 in_Color;
+// 1 when the texture is single channel, e.g. text, its red channel is then used for all channels
+layout (location = 2) in float in_SingleChannel;
 
 layout (location = 0) out vec4 out_Color;
 
 void main()
 {
     vec4 txColor    = texture(u_UITexture, in_TXCoords);
-    out_Color       = clamp(txColor + g_PerObject.HighlightFactor * txColor * g_PerObject.Highlight, 0.0, 1.0);
+    txColor         = mix(txColor, txColor.rrrr, in_SingleChannel);
+
+    // The texture's color is premultiplied, the vertex color is either a panel's highlight or a text's premultiplied color
+    out_Color       = clamp(txColor * in_Color, 0.0, 1.0);
 }
@@ -1,19 +1,18 @@
 Texture2D uiTexture : register(t4);
 SamplerState sampAni : register(s4);
 
-cbuffer perObject : register(b2)
-{
-    float2 position, size;
-    float4 highlight;
-    float highlightFactor;
-};
-
 struct VS_OUT {
     float4 pos : SV_POSITION;
     float2 txCoords : TEXCOORD0;
+    float4 color : COLOR0;
+    // 1 when the texture is single channel, e.g. text, its red channel is then used for all channels
+    float singleChannel : SINGLECHANNEL;
 };
 
 float4 main(VS_OUT ps_in) : SV_TARGET {
     float4 txColor = uiTexture.Sample(sampAni, ps_in.txCoords);
-    return saturate(txColor + highlightFactor * txColor * highlight);
+    txColor = lerp(txColor, txColor.rrrr, ps_in.singleChannel);
+
+    // The texture's color is premultiplied, the vertex color is either a panel's highlight or a text's premultiplied color
+    return saturate(txColor * ps_in.color);
 }
@@ -100,6 +100,8 @@ workspace "GameProject"
 	filter "system:windows"
 		defines {
 			"PLATFORM_WINDOWS",
+			-- FMOD is only configured for Windows, other platforms use the software audio backend
+			"AUDIO_FMOD",
 		}
 	filter {}
 
@@ -149,7 +151,6 @@ workspace "GameProject"
 
         links {
             "vulkan-1",
-            "fmodL_vc.lib",
         }
 
         libdirs {
@@ -170,6 +171,7 @@ workspace "GameProject"
 
         filter { "system:windows" }
             links {
+				"fmodL_vc.lib",
 				"d3d11.lib",
 				"runtimeobject.lib",
                 "D3DCompiler.lib"
@@ -214,3 +216,65 @@ workspace "GameProject"
 				("{COPY} vendor/GLFW/bin \"build/bin/" .. outputdir .. "/GameProject/\"")
 			}
         filter {}
+
+	-- Converts models and textures into the engine's cooked format ahead of time, e.g. AssetCooker ./assets/Models/Cube.dae
+	project "AssetCooker"
+		kind "ConsoleApp"
+		language "C++"
+		cppdialect "C++latest"
+		systemversion "latest"
+
+		targetdir ("build/bin/" .. outputdir .. "/AssetCooker")
+		objdir ("build/obj/" .. outputdir .. "/AssetCooker")
+
+		includedirs {
+			"src",
+			"vendor",
+			""
+		}
+
+		files {
+			"tools/AssetCooker/**.cpp",
+			"src/Engine/Rendering/APIAbstractions/GeneralResources.hpp",
+			"src/Engine/Rendering/APIAbstractions/GeneralResources.cpp",
+			"src/Engine/Rendering/AssetLoaders/BlockCompressor.hpp",
+			"src/Engine/Rendering/AssetLoaders/BlockCompressor.cpp",
+			"src/Engine/Rendering/AssetLoaders/MeshOptimizer.hpp",
+			"src/Engine/Rendering/AssetLoaders/MeshOptimizer.cpp",
+			"src/Engine/Rendering/AssetLoaders/MeshSimplifier.hpp",
+			"src/Engine/Rendering/AssetLoaders/MeshSimplifier.cpp",
+			"src/Engine/Rendering/AssetLoaders/ModelCooker.hpp",
+			"src/Engine/Rendering/AssetLoaders/ModelCooker.cpp",
+			"src/Engine/Rendering/AssetLoaders/TextureCooker.hpp",
+			"src/Engine/Rendering/AssetLoaders/TextureCooker.cpp",
+			"src/Engine/Utils/Logger.hpp",
+			"src/Engine/Utils/Logger.cpp",
+			"src/Engine/Utils/MappedFile.hpp",
+			"src/Engine/Utils/MappedFile.cpp",
+			"src/Engine/Utils/ThreadPool.hpp",
+			"src/Engine/Utils/ThreadPool.cpp"
+		}
+
+		libdirs {
+			"vendor/assimp/libs"
+		}
+
+		filter { "configurations:Debug" }
+			links {
+				"/debug/assimp-vc142-mtd.lib",
+				"/debug/IrrXMLd.lib",
+				"/debug/zlibstaticd.lib"
+			}
+			postbuildcommands {
+				("{COPY} vendor/assimp/bin/debug \"build/bin/" .. outputdir .. "/AssetCooker/\"")
+			}
+		filter { "configurations:Release or Production" }
+			links {
+				"/release/assimp-vc142-mt.lib",
+				"/release/IrrXML.lib",
+				"/release/zlibstatic.lib"
+			}
+			postbuildcommands {
+				("{COPY} vendor/assimp/bin/release \"build/bin/" .. outputdir .. "/AssetCooker/\"")
+			}
+		filter {}
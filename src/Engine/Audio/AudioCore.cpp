@@ -1,8 +1,13 @@
 #include "AudioCore.hpp"
 
-bool AudioCore::Init()
+bool AudioCore::Init(const EngineConfig& engineConfig)
 {
-    return m_SoundPlayer.Init();
+    const AudioBackendInfo backendInfo = {
+        .Backend    = engineConfig.AudioBackend,
+        .OutputPath = engineConfig.AudioOutputPath
+    };
+
+    return m_SoundPlayer.Init(backendInfo);
 }
 
 void AudioCore::PlayLoopingSound(Entity entity, const std::string& soundPath, float volume)
@@ -10,11 +15,11 @@ void AudioCore::PlayLoopingSound(Entity entity, const std::string& soundPath, fl
     ECSCore* pECS = ECSCore::GetInstance();
 
     SoundComponent soundComponent = m_SoundPlayer.CreateSound(soundPath);
-    if (soundComponent.pSound) {
-        pECS->AddComponent(entity, soundComponent);
-        pECS->AddComponent(entity, m_SoundPlayer.CreateSoundLooper(soundComponent));
-
-        m_SoundPlayer.PlaySound(soundComponent);
+    if (soundComponent.Sound != INVALID_AUDIO_HANDLE) {
+        // Start playing before adding the component, which stores a copy of the playing voice's handle
+        m_SoundPlayer.PlaySound(soundComponent, true);
         m_SoundPlayer.SetVolume(soundComponent, volume);
+
+        pECS->AddComponent(entity, soundComponent);
     }
 }
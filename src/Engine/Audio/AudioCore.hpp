@@ -2,14 +2,17 @@
 
 #include <Engine/Audio/SoundPlayer.hpp>
 
+struct EngineConfig;
+
 class AudioCore
 {
 public:
     AudioCore() = default;
     ~AudioCore() = default;
 
-    bool Init();
+    bool Init(const EngineConfig& engineConfig);
 
+    // The sound loops until the entity's sound component is removed
     void PlayLoopingSound(Entity entity, const std::string& soundPath, float volume);
 
     SoundPlayer* GetSoundPlayer() { return &m_SoundPlayer; }
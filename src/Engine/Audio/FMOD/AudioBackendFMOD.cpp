@@ -0,0 +1,363 @@
+#include "AudioBackendFMOD.hpp"
+
+#ifdef AUDIO_FMOD
+
+#include <Engine/Audio/VoiceManager.hpp>
+
+#include <fmod_errors.h>
+
+#include <filesystem>
+#include <thread>
+
+AudioBackendFMOD::AudioBackendFMOD()
+    :m_pSystem(nullptr),
+    m_pMasterGroup(nullptr),
+    m_SampleRate(0u)
+{}
+
+AudioBackendFMOD::~AudioBackendFMOD()
+{
+    if (m_pSystem) {
+        m_pSystem->release();
+    }
+}
+
+bool AudioBackendFMOD::Init()
+{
+    FMOD_RESULT result = FMOD::System_Create(&m_pSystem);
+    if (result != FMOD_OK) {
+        LOG_ERRORF("Failed to create FMOD system: %s", FMOD_ErrorString(result));
+        return false;
+    }
+
+    // Mix as many voices as the voice manager keeps real. Silent channels become virtual in FMOD as well, they keep
+    // their playback position without being mixed. FMOD supports at most 4095 channels.
+    result = m_pSystem->setSoftwareChannels((int)MAX_REAL_VOICES);
+    if (result != FMOD_OK) {
+        LOG_ERRORF("Failed to set FMOD's software channel count: %s", FMOD_ErrorString(result));
+        return false;
+    }
+
+    const int maxChannels = 4095;
+
+    result = m_pSystem->init(maxChannels, FMOD_INIT_NORMAL | FMOD_INIT_VOL0_BECOMES_VIRTUAL, nullptr);
+    if (result != FMOD_OK) {
+        LOG_ERRORF("Failed to initialize FMOD system: %s", FMOD_ErrorString(result));
+        return false;
+    }
+
+    // Lets the channel callback find the backend
+    m_pSystem->setUserData(this);
+
+    // Scheduled voices are delayed relative to the master channel group's clock, which counts frames at the output's rate
+    int sampleRate = 0;
+    result = m_pSystem->getSoftwareFormat(&sampleRate, nullptr, nullptr);
+    if (result == FMOD_OK) {
+        result = m_pSystem->getMasterChannelGroup(&m_pMasterGroup);
+    }
+
+    if (result != FMOD_OK) {
+        LOG_ERRORF("Failed to get FMOD's output format: %s", FMOD_ErrorString(result));
+        return false;
+    }
+
+    m_SampleRate = (uint32_t)sampleRate;
+    return true;
+}
+
+void AudioBackendFMOD::Update(float dt)
+{
+    UNREFERENCED_VARIABLE(dt);
+
+    // Start the voices whose sounds have loaded since the previous update
+    std::erase_if(m_PendingVoices, [this](uint32_t voiceIdx) { return TryStartVoice(voiceIdx); });
+
+    m_pSystem->update();
+
+    for (FMOD::Sound* pStream : m_FinishedStreams) {
+        pStream->release();
+    }
+
+    m_FinishedStreams.clear();
+}
+
+SoundHandle AudioBackendFMOD::CreateSound(const std::string& filePath)
+{
+    std::error_code errorCode;
+    const uintmax_t fileSize = std::filesystem::file_size(filePath, errorCode);
+    if (errorCode) {
+        LOG_WARNINGF("Failed to create sound from file [%s]: %s", filePath.c_str(), errorCode.message().c_str());
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    SoundEntry soundEntry = {};
+    soundEntry.FilePath     = filePath;
+    soundEntry.IsStreamed   = fileSize > SOUND_STREAM_THRESHOLD;
+
+    const FMOD_MODE mode = soundEntry.IsStreamed ? FMOD_CREATESTREAM | FMOD_OPENONLY | FMOD_NONBLOCKING : FMOD_DEFAULT | FMOD_NONBLOCKING;
+    const FMOD_RESULT result = m_pSystem->createSound(filePath.c_str(), mode, nullptr, &soundEntry.pSound);
+    if (result != FMOD_OK) {
+        LOG_WARNINGF("Failed to create sound from file [%s]: %s", filePath.c_str(), FMOD_ErrorString(result));
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    m_Sounds.push_back(soundEntry);
+    return (SoundHandle)m_Sounds.size() - 1u;
+}
+
+bool AudioBackendFMOD::IsSoundLoaded(SoundHandle sound) const
+{
+    FMOD_OPENSTATE openState = FMOD_OPENSTATE_LOADING;
+    return sound < m_Sounds.size() && m_Sounds[sound].pSound->getOpenState(&openState, nullptr, nullptr, nullptr) == FMOD_OK && openState == FMOD_OPENSTATE_READY;
+}
+
+float AudioBackendFMOD::GetSoundDuration(SoundHandle sound) const
+{
+    FMOD::Sound* pSound = m_Sounds[sound].pSound;
+
+    FMOD_OPENSTATE openState = FMOD_OPENSTATE_LOADING;
+    while (pSound->getOpenState(&openState, nullptr, nullptr, nullptr) == FMOD_OK && openState != FMOD_OPENSTATE_READY && openState != FMOD_OPENSTATE_ERROR) {
+        std::this_thread::yield();
+    }
+
+    unsigned int soundDurationMS = 0;
+    const FMOD_RESULT result = pSound->getLength(&soundDurationMS, FMOD_TIMEUNIT_MS);
+    if (result != FMOD_OK) {
+        LOG_WARNINGF("Failed to get sound duration: %s", FMOD_ErrorString(result));
+        return 0.0f;
+    }
+
+    return float(soundDurationMS) * 0.001f;
+}
+
+size_t AudioBackendFMOD::GetSoundMemory() const
+{
+    int currentAllocated = 0;
+    int maxAllocated = 0;
+    FMOD::Memory_GetStats(&currentAllocated, &maxAllocated, false);
+    return (size_t)currentAllocated;
+}
+
+VoiceHandle AudioBackendFMOD::PlaySound(SoundHandle sound, bool loop)
+{
+    return ScheduleSound(sound, loop, 0u);
+}
+
+VoiceHandle AudioBackendFMOD::ScheduleSound(SoundHandle sound, bool loop, uint64_t startClock)
+{
+    if (sound >= m_Sounds.size()) {
+        LOG_WARNINGF("Failed to play sound, invalid sound handle: %d", sound);
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    // Streams are looped by the stream itself, which reads the start of the file before reaching the end
+    const SoundEntry& soundEntry = m_Sounds[sound];
+    FMOD::Sound* pStream = nullptr;
+    if (soundEntry.IsStreamed) {
+        const FMOD_MODE mode = FMOD_CREATESTREAM | FMOD_NONBLOCKING | (loop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF);
+        const FMOD_RESULT result = m_pSystem->createSound(soundEntry.FilePath.c_str(), mode, nullptr, &pStream);
+        if (result != FMOD_OK) {
+            LOG_WARNINGF("Failed to open stream [%s]: %s", soundEntry.FilePath.c_str(), FMOD_ErrorString(result));
+            return INVALID_AUDIO_HANDLE;
+        }
+    }
+
+    uint32_t voiceIdx = 0u;
+    if (m_FreeVoices.empty()) {
+        voiceIdx = (uint32_t)m_Voices.size();
+        m_Voices.push_back({ .Generation = 0u });
+    } else {
+        voiceIdx = m_FreeVoices.back();
+        m_FreeVoices.pop_back();
+    }
+
+    VoiceSlot& voiceSlot = m_Voices[voiceIdx];
+    voiceSlot.pChannel      = nullptr;
+    voiceSlot.pStream       = pStream;
+    voiceSlot.VoiceSound    = sound;
+    voiceSlot.BaseFrequency = 0.0f;
+    voiceSlot.Volume        = 1.0f;
+    voiceSlot.PanLeft       = 1.0f;
+    voiceSlot.PanRight      = 1.0f;
+    voiceSlot.HasPan        = false;
+    voiceSlot.Pitch         = 1.0f;
+    voiceSlot.Loop          = loop;
+    voiceSlot.StartClock    = startClock;
+
+    // The handle is created before trying to start the voice, as the voice is released if its sound failed to load
+    const VoiceHandle voiceHandle = CreateVoiceHandle(voiceIdx, voiceSlot.Generation);
+    if (!TryStartVoice(voiceIdx)) {
+        m_PendingVoices.push_back(voiceIdx);
+    }
+
+    return voiceHandle;
+}
+
+void AudioBackendFMOD::StopVoice(VoiceHandle voice)
+{
+    VoiceSlot* pVoiceSlot = GetVoiceSlot(voice);
+    if (!pVoiceSlot) {
+        return;
+    }
+
+    // The voice is released here rather than by the channel's end callback
+    const uint32_t voiceIdx = GetVoiceIndex(voice);
+    if (pVoiceSlot->pChannel) {
+        pVoiceSlot->pChannel->setCallback(nullptr);
+        pVoiceSlot->pChannel->stop();
+    } else {
+        std::erase(m_PendingVoices, voiceIdx);
+    }
+
+    ReleaseVoice(voiceIdx);
+}
+
+void AudioBackendFMOD::SetVoiceVolume(VoiceHandle voice, float volume)
+{
+    VoiceSlot* pVoiceSlot = GetVoiceSlot(voice);
+    if (pVoiceSlot) {
+        pVoiceSlot->Volume = volume;
+        if (pVoiceSlot->pChannel) {
+            pVoiceSlot->pChannel->setVolume(volume);
+        }
+    }
+}
+
+void AudioBackendFMOD::SetVoicePan(VoiceHandle voice, float left, float right)
+{
+    VoiceSlot* pVoiceSlot = GetVoiceSlot(voice);
+    if (pVoiceSlot) {
+        pVoiceSlot->PanLeft = left;
+        pVoiceSlot->PanRight = right;
+        pVoiceSlot->HasPan = true;
+        if (pVoiceSlot->pChannel) {
+            pVoiceSlot->pChannel->setMixLevelsOutput(left, right, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+    }
+}
+
+void AudioBackendFMOD::SetVoicePitch(VoiceHandle voice, float pitch)
+{
+    VoiceSlot* pVoiceSlot = GetVoiceSlot(voice);
+    if (pVoiceSlot) {
+        pVoiceSlot->Pitch = pitch;
+        if (pVoiceSlot->pChannel) {
+            pVoiceSlot->pChannel->setFrequency(pVoiceSlot->BaseFrequency * pitch);
+        }
+    }
+}
+
+FMOD_RESULT F_CALLBACK AudioBackendFMOD::OnChannelEvent(FMOD_CHANNELCONTROL* pChannelControl, FMOD_CHANNELCONTROL_TYPE controlType,
+    FMOD_CHANNELCONTROL_CALLBACK_TYPE callbackType, void* pCommandData1, void* pCommandData2)
+{
+    UNREFERENCED_VARIABLE(pCommandData1);
+    UNREFERENCED_VARIABLE(pCommandData2);
+
+    if (controlType != FMOD_CHANNELCONTROL_CHANNEL || callbackType != FMOD_CHANNELCONTROL_CALLBACK_END) {
+        return FMOD_OK;
+    }
+
+    // Callbacks are made from within System::update, on the thread updating the backend
+    FMOD::Channel* pChannel = (FMOD::Channel*)pChannelControl;
+    FMOD::System* pSystem = nullptr;
+    void* pBackend = nullptr;
+    void* pVoiceIdx = nullptr;
+    if (pChannel->getSystemObject(&pSystem) != FMOD_OK || pSystem->getUserData(&pBackend) != FMOD_OK || pChannel->getUserData(&pVoiceIdx) != FMOD_OK) {
+        return FMOD_OK;
+    }
+
+    ((AudioBackendFMOD*)pBackend)->ReleaseVoice((uint32_t)(uintptr_t)pVoiceIdx);
+    return FMOD_OK;
+}
+
+uint64_t AudioBackendFMOD::GetDSPClock() const
+{
+    unsigned long long dspClock = 0u;
+    m_pMasterGroup->getDSPClock(&dspClock, nullptr);
+    return (uint64_t)dspClock;
+}
+
+AudioBackendFMOD::VoiceSlot* AudioBackendFMOD::GetVoiceSlot(VoiceHandle voice)
+{
+    const uint32_t voiceIdx = GetVoiceIndex(voice);
+    if (voice == INVALID_AUDIO_HANDLE || voiceIdx >= m_Voices.size() || m_Voices[voiceIdx].Generation != GetVoiceGeneration(voice)) {
+        return nullptr;
+    }
+
+    return &m_Voices[voiceIdx];
+}
+
+void AudioBackendFMOD::ReleaseVoice(uint32_t voiceIdx)
+{
+    VoiceSlot& voiceSlot = m_Voices[voiceIdx];
+    if (voiceSlot.pStream) {
+        m_FinishedStreams.push_back(voiceSlot.pStream);
+    }
+
+    voiceSlot.pChannel = nullptr;
+    voiceSlot.pStream = nullptr;
+    voiceSlot.Generation = (voiceSlot.Generation + 1u) & (UINT32_MAX >> VOICE_HANDLE_INDEX_BITS);
+    m_FreeVoices.push_back(voiceIdx);
+}
+
+bool AudioBackendFMOD::TryStartVoice(uint32_t voiceIdx)
+{
+    VoiceSlot& voiceSlot = m_Voices[voiceIdx];
+    FMOD::Sound* pSound = voiceSlot.pStream ? voiceSlot.pStream : m_Sounds[voiceSlot.VoiceSound].pSound;
+
+    FMOD_OPENSTATE openState = FMOD_OPENSTATE_LOADING;
+    FMOD_RESULT result = pSound->getOpenState(&openState, nullptr, nullptr, nullptr);
+    if (result == FMOD_OK && openState != FMOD_OPENSTATE_READY && openState != FMOD_OPENSTATE_ERROR) {
+        return false;
+    }
+
+    const std::string& filePath = m_Sounds[voiceSlot.VoiceSound].FilePath;
+    if (result == FMOD_OK && openState == FMOD_OPENSTATE_ERROR) {
+        LOG_WARNINGF("Failed to play sound, the sound failed to load [%s]", filePath.c_str());
+        ReleaseVoice(voiceIdx);
+        return true;
+    }
+
+    // Start paused, so that the voice's parameters are set before any of the sound has been mixed
+    FMOD::Channel* pChannel = nullptr;
+    if (result == FMOD_OK) {
+        result = m_pSystem->playSound(pSound, nullptr, true, &pChannel);
+    }
+
+    if (result != FMOD_OK) {
+        LOG_WARNINGF("Failed to play sound [%s]: %s", filePath.c_str(), FMOD_ErrorString(result));
+        ReleaseVoice(voiceIdx);
+        return true;
+    }
+
+    if (voiceSlot.Loop) {
+        pChannel->setMode(FMOD_LOOP_NORMAL);
+        pChannel->setLoopCount(-1);
+    }
+
+    // Voices scheduled in the past, e.g. while their sounds were loading, start right away
+    if (voiceSlot.StartClock != 0u) {
+        pChannel->setDelay(voiceSlot.StartClock, 0u, false);
+    }
+
+    voiceSlot.pChannel = pChannel;
+
+    result = pChannel->getFrequency(&voiceSlot.BaseFrequency);
+    if (result != FMOD_OK) {
+        LOG_WARNINGF("Failed to get sound frequency: %s", FMOD_ErrorString(result));
+    }
+
+    pChannel->setVolume(voiceSlot.Volume);
+    pChannel->setFrequency(voiceSlot.BaseFrequency * voiceSlot.Pitch);
+    if (voiceSlot.HasPan) {
+        pChannel->setMixLevelsOutput(voiceSlot.PanLeft, voiceSlot.PanRight, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    pChannel->setUserData((void*)(uintptr_t)voiceIdx);
+    pChannel->setCallback(OnChannelEvent);
+    pChannel->setPaused(false);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,97 @@
+#pragma once
+
+#ifdef AUDIO_FMOD
+
+#include <Engine/Audio/IAudioBackend.hpp>
+
+#include <fmod.hpp>
+
+#include <vector>
+
+/*  Sounds are loaded by FMOD's loading thread. Sounds larger than SOUND_STREAM_THRESHOLD are streamed instead, where each
+    voice opens its own stream, as a stream can only be played by one channel at a time. Voices of sounds that are still
+    loading are started in a later update, once their sounds are ready. */
+class AudioBackendFMOD : public IAudioBackend
+{
+public:
+    AudioBackendFMOD();
+    ~AudioBackendFMOD();
+
+    bool Init() override final;
+    void Update(float dt) override final;
+
+    SoundHandle CreateSound(const std::string& filePath) override final;
+    bool IsSoundLoaded(SoundHandle sound) const override final;
+    // Blocks until the sound has loaded
+    float GetSoundDuration(SoundHandle sound) const override final;
+    // FMOD's allocated memory, which is mostly the samples of sounds and the buffers of streams
+    size_t GetSoundMemory() const override final;
+
+    VoiceHandle PlaySound(SoundHandle sound, bool loop) override final;
+    // Scheduled channels are delayed using FMOD's DSP clock, which starts them sample accurately
+    VoiceHandle ScheduleSound(SoundHandle sound, bool loop, uint64_t startClock) override final;
+    void StopVoice(VoiceHandle voice) override final;
+    void SetVoiceVolume(VoiceHandle voice, float volume) override final;
+    void SetVoicePan(VoiceHandle voice, float left, float right) override final;
+    void SetVoicePitch(VoiceHandle voice, float pitch) override final;
+
+    // The master channel group's DSP clock
+    uint64_t GetDSPClock() const override final;
+    uint32_t GetDSPSampleRate() const override final { return m_SampleRate; }
+
+private:
+    struct SoundEntry {
+        // Streamed sounds are only opened, to read their lengths
+        FMOD::Sound* pSound;
+        std::string FilePath;
+        bool IsStreamed;
+    };
+
+    struct VoiceSlot {
+        // Null until the voice has started
+        FMOD::Channel* pChannel;
+        // The voice's own stream, if its sound is streamed
+        FMOD::Sound* pStream;
+        SoundHandle VoiceSound;
+        // The channel's frequency before pitch is applied
+        float BaseFrequency;
+        uint32_t Generation;
+
+        // Applied once the voice starts
+        float Volume;
+        float PanLeft, PanRight;
+        bool HasPan;
+        float Pitch;
+        bool Loop;
+        // Zero if the voice starts right away
+        uint64_t StartClock;
+    };
+
+private:
+    // Called by FMOD when a channel stops playing, which frees the channel's voice slot
+    static FMOD_RESULT F_CALLBACK OnChannelEvent(FMOD_CHANNELCONTROL* pChannelControl, FMOD_CHANNELCONTROL_TYPE controlType,
+        FMOD_CHANNELCONTROL_CALLBACK_TYPE callbackType, void* pCommandData1, void* pCommandData2);
+
+    // Returns null if the handle's voice has finished
+    VoiceSlot* GetVoiceSlot(VoiceHandle voice);
+    void ReleaseVoice(uint32_t voiceIdx);
+
+    // Returns false if the voice's sound is still loading. Voices whose sounds failed to load are released.
+    bool TryStartVoice(uint32_t voiceIdx);
+
+private:
+    FMOD::System* m_pSystem;
+    FMOD::ChannelGroup* m_pMasterGroup;
+    uint32_t m_SampleRate;
+
+    std::vector<SoundEntry> m_Sounds;
+
+    std::vector<VoiceSlot> m_Voices;
+    std::vector<uint32_t> m_FreeVoices;
+    // Voices waiting for their sounds to load
+    std::vector<uint32_t> m_PendingVoices;
+    // Streams of finished voices, released after FMOD's update rather than within its channel callbacks
+    std::vector<FMOD::Sound*> m_FinishedStreams;
+};
+
+#endif
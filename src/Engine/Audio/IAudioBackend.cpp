@@ -0,0 +1,27 @@
+#include "IAudioBackend.hpp"
+
+#include <Engine/Audio/FMOD/AudioBackendFMOD.hpp>
+#include <Engine/Audio/Software/AudioBackendSoftware.hpp>
+#include <Engine/Audio/Software/AudioSink.hpp>
+#include <Engine/Utils/Debug.hpp>
+#include <Engine/Utils/Logger.hpp>
+
+IAudioBackend* IAudioBackend::Create(const AudioBackendInfo& backendInfo)
+{
+    switch (backendInfo.Backend) {
+        case AUDIO_BACKEND::FMOD:
+        #ifdef AUDIO_FMOD
+            LOG_INFO("Using the FMOD audio backend");
+            return DBG_NEW AudioBackendFMOD();
+        #else
+            LOG_WARNING("FMOD is not available on this platform, using the software audio backend");
+            return DBG_NEW AudioBackendSoftware(IAudioSink::Create(backendInfo.OutputPath));
+        #endif
+        case AUDIO_BACKEND::SOFTWARE:
+            LOG_INFO("Using the software audio backend");
+            return DBG_NEW AudioBackendSoftware(IAudioSink::Create(backendInfo.OutputPath));
+        default:
+            LOG_ERRORF("Erroneous audio backend: %d", (int)backendInfo.Backend);
+            return nullptr;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+enum class AUDIO_BACKEND {
+    FMOD,
+    // The engine's own mixer, which needs no audio device and optionally writes its output to a WAV file
+    SOFTWARE
+};
+
+// Sounds are indices into the backend's sounds. Voices are indices into the backend's voices paired with the
+// generation of the voice's slot, which is bumped when the slot is reused, so that handles of finished voices are ignored.
+typedef uint32_t SoundHandle;
+typedef uint32_t VoiceHandle;
+
+#define INVALID_AUDIO_HANDLE UINT32_MAX
+
+// Sound files larger than this are streamed from disk in chunks rather than decoded into memory when they are loaded
+#define SOUND_STREAM_THRESHOLD (2u * 1024u * 1024u)
+
+#define VOICE_HANDLE_INDEX_BITS 20u
+#define VOICE_HANDLE_INDEX_MASK ((1u << VOICE_HANDLE_INDEX_BITS) - 1u)
+
+inline VoiceHandle CreateVoiceHandle(uint32_t voiceIdx, uint32_t generation)    { return (generation << VOICE_HANDLE_INDEX_BITS) | voiceIdx; }
+inline uint32_t GetVoiceIndex(VoiceHandle voice)                                { return voice & VOICE_HANDLE_INDEX_MASK; }
+inline uint32_t GetVoiceGeneration(VoiceHandle voice)                           { return voice >> VOICE_HANDLE_INDEX_BITS; }
+
+struct AudioBackendInfo {
+    AUDIO_BACKEND Backend;
+    // Optional, the software backend writes its mixed output to this WAV file. When empty, the output is discarded.
+    std::string OutputPath;
+};
+
+class IAudioBackend
+{
+public:
+    static IAudioBackend* Create(const AudioBackendInfo& backendInfo);
+
+public:
+    IAudioBackend() = default;
+    virtual ~IAudioBackend() = default;
+
+    virtual bool Init() = 0;
+    // Called once per frame, after the voices' parameters have been set
+    virtual void Update(float dt) = 0;
+
+    /*  Starts loading the sound in the background. Returns INVALID_AUDIO_HANDLE if the file could not be opened. Every
+        call loads the file anew, sounds are shared by SoundPlayer's cache. */
+    virtual SoundHandle CreateSound(const std::string& filePath) = 0;
+    virtual bool IsSoundLoaded(SoundHandle sound) const = 0;
+    // Duration is in seconds
+    virtual float GetSoundDuration(SoundHandle sound) const = 0;
+    // Bytes of memory occupied by sounds' samples, including the buffers of streamed sounds
+    virtual size_t GetSoundMemory() const = 0;
+
+    // Voices of sounds that are loading start once their sounds have loaded. Returns INVALID_AUDIO_HANDLE if the sound could not be played.
+    virtual VoiceHandle PlaySound(SoundHandle sound, bool loop) = 0;
+    /*  Starts the voice on the exact frame when the DSP clock reaches startClock, or right away if the clock has passed it.
+        Looping voices loop at the sound's end without gaps, until they are stopped. */
+    virtual VoiceHandle ScheduleSound(SoundHandle sound, bool loop, uint64_t startClock) = 0;
+    virtual void StopVoice(VoiceHandle voice) = 0;
+    virtual void SetVoiceVolume(VoiceHandle voice, float volume) = 0;
+    virtual void SetVoicePan(VoiceHandle voice, float left, float right) = 0;
+    // Multiplier of the sound's sample rate
+    virtual void SetVoicePitch(VoiceHandle voice, float pitch) = 0;
+
+    // The amount of frames the backend has mixed, which advances at the DSP sample rate
+    virtual uint64_t GetDSPClock() const = 0;
+    virtual uint32_t GetDSPSampleRate() const = 0;
+};
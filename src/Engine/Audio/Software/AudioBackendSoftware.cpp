@@ -0,0 +1,456 @@
+#include "AudioBackendSoftware.hpp"
+
+#include <Engine/Audio/Software/AudioSink.hpp>
+#include <Engine/Audio/Software/Mixing.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+
+// Frames repeated past the end of each sound, which lets the interpolation read past the end without checks
+#define SOUND_GUARD_FRAMES 2u
+
+// Voices pitched lower than this are played at this pitch
+#define MIN_VOICE_PITCH 0.001f
+
+namespace
+{
+    /*  Resamples interleaved source frames to the mix's sample rate using linear interpolation, keeping at most two
+        channels. The output starts at the mix rate frame firstFrame, the source frames start at srcFirstFrame. Reads past
+        the last source frame are clamped to it. */
+    void ResampleFrames(const float* pSrcSamples, uint32_t srcChannelCount, size_t srcFirstFrame, size_t srcFrameCount, double resampleStep,
+        size_t firstFrame, size_t frameCount, uint32_t channelCount, float* pSamples)
+    {
+        const size_t srcLastFrame = srcFirstFrame + srcFrameCount - 1u;
+
+        for (size_t frameIdx = 0u; frameIdx < frameCount; frameIdx++) {
+            const double srcPosition = (firstFrame + frameIdx) * resampleStep;
+            const size_t srcFrame0 = std::min((size_t)srcPosition, srcLastFrame);
+            const size_t srcFrame1 = std::min(srcFrame0 + 1u, srcLastFrame);
+            const float weight = float(srcPosition - srcFrame0);
+
+            const float* pSrcFrame0 = pSrcSamples + (srcFrame0 - srcFirstFrame) * srcChannelCount;
+            const float* pSrcFrame1 = pSrcSamples + (srcFrame1 - srcFirstFrame) * srcChannelCount;
+            for (uint32_t channelIdx = 0u; channelIdx < channelCount; channelIdx++) {
+                const float sample0 = pSrcFrame0[channelIdx];
+                const float sample1 = pSrcFrame1[channelIdx];
+                pSamples[frameIdx * channelCount + channelIdx] = sample0 + (sample1 - sample0) * weight;
+            }
+        }
+    }
+
+    // The guard frames continue the sound from its start, which makes loops seamless
+    void WriteGuardFrames(const float* pFirstFrames, uint32_t firstFrameCount, uint32_t channelCount, float* pGuardFrames)
+    {
+        for (uint32_t guardIdx = 0u; guardIdx < SOUND_GUARD_FRAMES; guardIdx++) {
+            for (uint32_t channelIdx = 0u; channelIdx < channelCount; channelIdx++) {
+                pGuardFrames[guardIdx * channelCount + channelIdx] = pFirstFrames[(guardIdx % firstFrameCount) * channelCount + channelIdx];
+            }
+        }
+    }
+}
+
+AudioBackendSoftware::AudioBackendSoftware(IAudioSink* pSink)
+    :m_pSink(pSink),
+    m_SoundMemory(0u),
+    m_RingWriteOffset(0u),
+    m_RingReadOffset(0u),
+    m_PendingFrames(0.0),
+    m_DSPClock(0u),
+    m_Stats({})
+{}
+
+AudioBackendSoftware::~AudioBackendSoftware()
+{
+    // The loading jobs write to the sounds
+    ThreadPool& threadPool = ThreadPool::GetInstance();
+    for (const std::pair<SoundHandle, size_t>& loadingSound : m_LoadingSounds) {
+        threadPool.Join(loadingSound.second);
+    }
+
+    delete m_pSink;
+}
+
+bool AudioBackendSoftware::Init()
+{
+    m_RingBuffer.resize(MIX_RING_FRAMES * 2u, 0.0f);
+    return m_pSink->Init(MIX_SAMPLE_RATE);
+}
+
+void AudioBackendSoftware::Update(float dt)
+{
+    const auto mixStart = std::chrono::high_resolution_clock::now();
+
+    // Join the jobs of sounds that have loaded, which only waits for the jobs to signal that they have finished
+    ThreadPool& threadPool = ThreadPool::GetInstance();
+    std::erase_if(m_LoadingSounds, [&](const std::pair<SoundHandle, size_t>& loadingSound) {
+        if (!m_Sounds[loadingSound.first]->IsLoaded) {
+            return false;
+        }
+
+        threadPool.Join(loadingSound.second);
+        return true;
+    });
+
+    m_PendingFrames += double(dt) * MIX_SAMPLE_RATE;
+    uint32_t framesToMix = (uint32_t)m_PendingFrames;
+    m_PendingFrames -= framesToMix;
+
+    m_Stats.MixedVoices = 0u;
+    m_Stats.MixedFrames = framesToMix;
+
+    while (framesToMix > 0u) {
+        const uint32_t blockFrames = std::min({ framesToMix, MIX_BLOCK_FRAMES, MIX_RING_FRAMES - m_RingWriteOffset });
+        MixBlock(blockFrames);
+        framesToMix -= blockFrames;
+
+        // Drain the ring buffer
+        const float* pRingBuffer = m_RingBuffer.data();
+        if (m_RingWriteOffset < m_RingReadOffset) {
+            m_pSink->Write(pRingBuffer + m_RingReadOffset * 2u, MIX_RING_FRAMES - m_RingReadOffset);
+            m_RingReadOffset = 0u;
+        }
+
+        m_pSink->Write(pRingBuffer + m_RingReadOffset * 2u, m_RingWriteOffset - m_RingReadOffset);
+        m_RingReadOffset = m_RingWriteOffset;
+    }
+
+    const std::chrono::duration<float, std::milli> mixTime = std::chrono::high_resolution_clock::now() - mixStart;
+    m_Stats.MixTime = mixTime.count();
+}
+
+SoundHandle AudioBackendSoftware::CreateSound(const std::string& filePath)
+{
+    const std::string extension = std::filesystem::path(filePath).extension().string();
+    if (extension != ".wav" && extension != ".WAV") {
+        LOG_WARNINGF("The software audio backend only supports WAV files, failed to create sound from file [%s]", filePath.c_str());
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    // The header is parsed right away, which lets invalid files fail here and lets the duration be known while loading
+    std::unique_ptr<Sound> pSound = std::make_unique<Sound>();
+    if (!pSound->File.Open(filePath)) {
+        LOG_WARNINGF("Failed to create sound from file [%s]", filePath.c_str());
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    WaveFormat& format = pSound->Format;
+    if (!ParseWaveFile(pSound->File.GetData(), pSound->File.GetSize(), format) || format.FrameCount == 0u) {
+        LOG_WARNINGF("Failed to create sound, unsupported or empty WAV file [%s]", filePath.c_str());
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    // Sounds with more than two channels are played using their first two channels
+    const double resampleStep = double(format.SampleRate) / MIX_SAMPLE_RATE;
+    pSound->ChannelCount    = std::min(format.ChannelCount, 2u);
+    pSound->FrameCount      = std::max(1u, (uint32_t)std::ceil(format.FrameCount / resampleStep));
+    pSound->IsStreamed      = pSound->File.GetSize() > SOUND_STREAM_THRESHOLD;
+
+    const SoundHandle soundHandle = (SoundHandle)m_Sounds.size();
+    Sound& sound = *m_Sounds.emplace_back(std::move(pSound));
+
+    if (sound.IsStreamed) {
+        // Only the frames following the last chunk are decoded up front
+        const uint32_t firstFrameCount = std::min(SOUND_GUARD_FRAMES, sound.FrameCount);
+        std::vector<float> firstFrames(firstFrameCount * sound.ChannelCount);
+        DecodeSoundFrames(sound, 0u, firstFrameCount, firstFrames.data(), m_StreamSourceSamples);
+
+        sound.Samples.resize(SOUND_GUARD_FRAMES * sound.ChannelCount);
+        WriteGuardFrames(firstFrames.data(), firstFrameCount, sound.ChannelCount, sound.Samples.data());
+        m_SoundMemory += sound.Samples.size() * sizeof(float);
+        sound.IsLoaded = true;
+        return soundHandle;
+    }
+
+    sound.IsLoaded = false;
+    Sound* pLoadingSound = &sound;
+    const size_t joinIdx = ThreadPool::GetInstance().Execute([this, pLoadingSound]() {
+        Sound& loadingSound = *pLoadingSound;
+        std::vector<float>& samples = loadingSound.Samples;
+        const uint32_t channelCount = loadingSound.ChannelCount;
+        const uint32_t frameCount = loadingSound.FrameCount;
+        samples.resize(size_t(frameCount + SOUND_GUARD_FRAMES) * channelCount);
+
+        std::vector<float> srcSamples;
+        DecodeSoundFrames(loadingSound, 0u, frameCount, samples.data(), srcSamples);
+        WriteGuardFrames(samples.data(), frameCount, channelCount, samples.data() + size_t(frameCount) * channelCount);
+
+        loadingSound.File.Close();
+        m_SoundMemory += samples.size() * sizeof(float);
+        loadingSound.IsLoaded = true;
+    });
+
+    m_LoadingSounds.push_back({ soundHandle, joinIdx });
+    return soundHandle;
+}
+
+SoundHandle AudioBackendSoftware::CreateSound(const PCMData& pcmData)
+{
+    if (pcmData.ChannelCount == 0u || pcmData.SampleRate == 0u || pcmData.Samples.size() < pcmData.ChannelCount) {
+        LOG_WARNING("Failed to create sound, the PCM data is empty");
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    // Sounds with more than two channels are played using their first two channels
+    const size_t srcFrameCount = pcmData.Samples.size() / pcmData.ChannelCount;
+    const double resampleStep = double(pcmData.SampleRate) / MIX_SAMPLE_RATE;
+
+    std::unique_ptr<Sound> pSound = std::make_unique<Sound>();
+    Sound& sound = *pSound;
+    sound.ChannelCount  = std::min(pcmData.ChannelCount, 2u);
+    sound.FrameCount    = std::max(1u, (uint32_t)std::ceil(srcFrameCount / resampleStep));
+    sound.Format        = {};
+    sound.IsStreamed    = false;
+    sound.Samples.resize(size_t(sound.FrameCount + SOUND_GUARD_FRAMES) * sound.ChannelCount);
+
+    ResampleFrames(pcmData.Samples.data(), pcmData.ChannelCount, 0u, srcFrameCount, resampleStep, 0u, sound.FrameCount, sound.ChannelCount, sound.Samples.data());
+    WriteGuardFrames(sound.Samples.data(), sound.FrameCount, sound.ChannelCount, sound.Samples.data() + size_t(sound.FrameCount) * sound.ChannelCount);
+
+    m_SoundMemory += sound.Samples.size() * sizeof(float);
+    sound.IsLoaded = true;
+
+    m_Sounds.push_back(std::move(pSound));
+    return (SoundHandle)m_Sounds.size() - 1u;
+}
+
+bool AudioBackendSoftware::IsSoundLoaded(SoundHandle sound) const
+{
+    return sound < m_Sounds.size() && m_Sounds[sound]->IsLoaded;
+}
+
+float AudioBackendSoftware::GetSoundDuration(SoundHandle sound) const
+{
+    return float(m_Sounds[sound]->FrameCount) / MIX_SAMPLE_RATE;
+}
+
+size_t AudioBackendSoftware::GetSoundMemory() const
+{
+    return m_SoundMemory;
+}
+
+VoiceHandle AudioBackendSoftware::PlaySound(SoundHandle sound, bool loop)
+{
+    return ScheduleSound(sound, loop, m_DSPClock);
+}
+
+VoiceHandle AudioBackendSoftware::ScheduleSound(SoundHandle sound, bool loop, uint64_t startClock)
+{
+    if (sound >= m_Sounds.size()) {
+        LOG_WARNINGF("Failed to play sound, invalid sound handle: %d", sound);
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    uint32_t voiceIdx = 0u;
+    if (m_FreeVoices.empty()) {
+        voiceIdx = (uint32_t)m_Voices.size();
+        if (voiceIdx > VOICE_HANDLE_INDEX_MASK) {
+            LOG_WARNING("Failed to play sound, all voices are in use");
+            return INVALID_AUDIO_HANDLE;
+        }
+
+        m_Voices.push_back({ .Generation = 0u });
+    } else {
+        voiceIdx = m_FreeVoices.back();
+        m_FreeVoices.pop_back();
+    }
+
+    Voice& voice = m_Voices[voiceIdx];
+    voice.VoiceSound    = sound;
+    voice.Position      = 0.0;
+    voice.Volume        = 1.0f;
+    voice.PanLeft       = 1.0f;
+    voice.PanRight      = 1.0f;
+    voice.Pitch         = 1.0f;
+    voice.Loop          = loop;
+    voice.Playing       = true;
+    voice.StartClock    = startClock;
+    voice.StreamFrameCount = 0u;
+
+    return CreateVoiceHandle(voiceIdx, voice.Generation);
+}
+
+void AudioBackendSoftware::StopVoice(VoiceHandle voice)
+{
+    if (GetVoice(voice)) {
+        ReleaseVoice(GetVoiceIndex(voice));
+    }
+}
+
+void AudioBackendSoftware::SetVoiceVolume(VoiceHandle voice, float volume)
+{
+    Voice* pVoice = GetVoice(voice);
+    if (pVoice) {
+        pVoice->Volume = volume;
+    }
+}
+
+void AudioBackendSoftware::SetVoicePan(VoiceHandle voice, float left, float right)
+{
+    Voice* pVoice = GetVoice(voice);
+    if (pVoice) {
+        pVoice->PanLeft = left;
+        pVoice->PanRight = right;
+    }
+}
+
+void AudioBackendSoftware::SetVoicePitch(VoiceHandle voice, float pitch)
+{
+    Voice* pVoice = GetVoice(voice);
+    if (pVoice) {
+        pVoice->Pitch = std::max(pitch, MIN_VOICE_PITCH);
+    }
+}
+
+AudioBackendSoftware::Voice* AudioBackendSoftware::GetVoice(VoiceHandle voice)
+{
+    const uint32_t voiceIdx = GetVoiceIndex(voice);
+    if (voice == INVALID_AUDIO_HANDLE || voiceIdx >= m_Voices.size()) {
+        return nullptr;
+    }
+
+    Voice& voiceSlot = m_Voices[voiceIdx];
+    return voiceSlot.Playing && voiceSlot.Generation == GetVoiceGeneration(voice) ? &voiceSlot : nullptr;
+}
+
+void AudioBackendSoftware::ReleaseVoice(uint32_t voiceIdx)
+{
+    Voice& voice = m_Voices[voiceIdx];
+    voice.Playing = false;
+    voice.Generation = (voice.Generation + 1u) & (UINT32_MAX >> VOICE_HANDLE_INDEX_BITS);
+    m_FreeVoices.push_back(voiceIdx);
+
+    if (!voice.StreamBuffer.empty()) {
+        m_SoundMemory -= voice.StreamBuffer.size() * sizeof(float);
+        voice.StreamBuffer.clear();
+        voice.StreamBuffer.shrink_to_fit();
+    }
+}
+
+void AudioBackendSoftware::DecodeSoundFrames(const Sound& sound, uint32_t firstFrame, uint32_t frameCount, float* pSamples, std::vector<float>& srcSamples)
+{
+    const WaveFormat& format = sound.Format;
+    const uint8_t* pFile = sound.File.GetData();
+
+    if (format.SampleRate == MIX_SAMPLE_RATE && format.ChannelCount == sound.ChannelCount) {
+        DecodeWaveFrames(pFile, format, firstFrame, frameCount, pSamples);
+        return;
+    }
+
+    // Decode the source frames that the output frames interpolate between
+    const double resampleStep = double(format.SampleRate) / MIX_SAMPLE_RATE;
+    const size_t srcLastFrame = format.FrameCount - 1u;
+    const size_t srcFirstFrame = std::min((size_t)(firstFrame * resampleStep), srcLastFrame);
+    const size_t srcEndFrame = std::min((size_t)((firstFrame + frameCount - 1u) * resampleStep) + 1u, srcLastFrame) + 1u;
+    const size_t srcFrameCount = srcEndFrame - srcFirstFrame;
+
+    srcSamples.resize(srcFrameCount * format.ChannelCount);
+    DecodeWaveFrames(pFile, format, srcFirstFrame, srcFrameCount, srcSamples.data());
+    ResampleFrames(srcSamples.data(), format.ChannelCount, srcFirstFrame, srcFrameCount, resampleStep, firstFrame, frameCount, sound.ChannelCount, pSamples);
+}
+
+const float* AudioBackendSoftware::GetVoiceSamples(const Sound& sound, Voice& voice, uint32_t soundFrame, uint32_t& endFrame)
+{
+    if (!sound.IsStreamed) {
+        endFrame = sound.FrameCount;
+        return sound.Samples.data() + size_t(soundFrame) * sound.ChannelCount;
+    }
+
+    const uint32_t channelCount = sound.ChannelCount;
+    if (soundFrame < voice.StreamFirstFrame || soundFrame >= voice.StreamFirstFrame + voice.StreamFrameCount) {
+        if (voice.StreamBuffer.empty()) {
+            voice.StreamBuffer.resize((STREAM_CHUNK_FRAMES + SOUND_GUARD_FRAMES) * channelCount);
+            m_SoundMemory += voice.StreamBuffer.size() * sizeof(float);
+        }
+
+        // Chunks end at the end of the sound at the latest, where the guard frames continue from the start
+        const uint32_t framesLeftInSound = sound.FrameCount - soundFrame;
+        const uint32_t chunkFrames = std::min(STREAM_CHUNK_FRAMES, framesLeftInSound);
+        const uint32_t decodedFrames = std::min(chunkFrames + SOUND_GUARD_FRAMES, framesLeftInSound);
+
+        float* pStreamBuffer = voice.StreamBuffer.data();
+        DecodeSoundFrames(sound, soundFrame, decodedFrames, pStreamBuffer, m_StreamSourceSamples);
+        std::copy_n(sound.Samples.data(), (chunkFrames + SOUND_GUARD_FRAMES - decodedFrames) * channelCount, pStreamBuffer + decodedFrames * channelCount);
+
+        voice.StreamFirstFrame = soundFrame;
+        voice.StreamFrameCount = chunkFrames;
+    }
+
+    endFrame = voice.StreamFirstFrame + voice.StreamFrameCount;
+    return voice.StreamBuffer.data() + size_t(soundFrame - voice.StreamFirstFrame) * channelCount;
+}
+
+void AudioBackendSoftware::MixBlock(uint32_t frameCount)
+{
+    float* pOut = m_RingBuffer.data() + m_RingWriteOffset * 2u;
+    std::fill_n(pOut, frameCount * 2u, 0.0f);
+
+    const uint64_t blockEndClock = m_DSPClock + frameCount;
+
+    uint32_t mixedVoices = 0u;
+    for (uint32_t voiceIdx = 0u; voiceIdx < (uint32_t)m_Voices.size(); voiceIdx++) {
+        // Voices of loading sounds start playing once their sounds have loaded
+        Voice& voice = m_Voices[voiceIdx];
+        if (!voice.Playing || voice.StartClock >= blockEndClock || !m_Sounds[voice.VoiceSound]->IsLoaded) {
+            continue;
+        }
+
+        const bool isAudible = voice.Volume * voice.PanLeft != 0.0f || voice.Volume * voice.PanRight != 0.0f;
+        mixedVoices += isAudible;
+
+        // Voices scheduled within the block start on their scheduled frame
+        const uint32_t startOffset = voice.StartClock > m_DSPClock ? uint32_t(voice.StartClock - m_DSPClock) : 0u;
+        if (!MixVoice(voice, isAudible, pOut + startOffset * 2u, frameCount - startOffset)) {
+            ReleaseVoice(voiceIdx);
+        }
+    }
+
+    m_Stats.MixedVoices = std::max(m_Stats.MixedVoices, mixedVoices);
+
+    m_RingWriteOffset = (m_RingWriteOffset + frameCount) % MIX_RING_FRAMES;
+    m_DSPClock = blockEndClock;
+}
+
+bool AudioBackendSoftware::MixVoice(Voice& voice, bool isAudible, float* pOut, uint32_t frameCount)
+{
+    const Sound& sound = *m_Sounds[voice.VoiceSound];
+    const float gainLeft = voice.Volume * voice.PanLeft;
+    const float gainRight = voice.Volume * voice.PanRight;
+
+    /*  Mix the voice in chunks ending where its samples end. That is where the sound ends, at which point the voice loops or
+        stops, or where the streamed chunk ends, at which point the next chunk is decoded. */
+    uint32_t frameIdx = 0u;
+    while (frameIdx < frameCount) {
+        const uint32_t soundFrame = (uint32_t)voice.Position;
+        uint32_t endFrame = sound.FrameCount;
+        const float* pSource = isAudible ? GetVoiceSamples(sound, voice, soundFrame, endFrame) : nullptr;
+
+        const double framesLeftInSamples = double(endFrame) - voice.Position;
+        const uint32_t chunkFrames = (uint32_t)std::min(double(frameCount - frameIdx), std::ceil(framesLeftInSamples / voice.Pitch));
+
+        if (isAudible) {
+            const float fraction = float(voice.Position - soundFrame);
+            float* pChunkOut = pOut + frameIdx * 2u;
+
+            if (sound.ChannelCount == 1u) {
+                MixMono(pSource, fraction, voice.Pitch, gainLeft, gainRight, pChunkOut, chunkFrames);
+            } else {
+                MixStereo(pSource, fraction, voice.Pitch, gainLeft, gainRight, pChunkOut, chunkFrames);
+            }
+        }
+
+        frameIdx += chunkFrames;
+        voice.Position += chunkFrames * double(voice.Pitch);
+
+        if (voice.Position >= sound.FrameCount) {
+            if (!voice.Loop) {
+                return false;
+            }
+
+            voice.Position = std::fmod(voice.Position, double(sound.FrameCount));
+        }
+    }
+
+    return true;
+}
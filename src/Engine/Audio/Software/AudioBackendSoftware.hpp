@@ -0,0 +1,144 @@
+#pragma once
+
+#include <Engine/Audio/IAudioBackend.hpp>
+#include <Engine/Audio/Software/WaveFile.hpp>
+#include <Engine/Utils/MappedFile.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class IAudioSink;
+
+// Sample rate of the mix, sounds are resampled to it when they are loaded
+#define MIX_SAMPLE_RATE 48000u
+// Most frames mixed at a time
+#define MIX_BLOCK_FRAMES 512u
+// Capacity of the ring buffer between the mixer and the sink, in stereo frames
+#define MIX_RING_FRAMES (MIX_BLOCK_FRAMES * 8u)
+// Frames of a streamed sound decoded at a time, per voice, at the mix's sample rate
+#define STREAM_CHUNK_FRAMES 4096u
+
+struct SoftwareMixerStats {
+    // Amount of voices that were audible, and thereby mixed, in the latest update's blocks, at most
+    uint32_t MixedVoices;
+    // Amount of stereo frames mixed in the latest update
+    uint32_t MixedFrames;
+    // Time spent mixing in the latest update, in milliseconds
+    float MixTime;
+};
+
+/*  Mixes the voices on the CPU, without an audio device. Only WAV files are supported. Sounds are decoded to float PCM at
+    the mix's sample rate once, on the thread pool, and voices of a loading sound start once it has loaded. Files larger
+    than SOUND_STREAM_THRESHOLD stay mapped instead, and each audible voice decodes them in chunks into its own buffer.
+    Each update mixes the frames spanned by the update's delta
+    time, in blocks written into a ring buffer which the sink drains. Voices are resampled using linear interpolation,
+    four output frames at a time using SSE2. Silent voices are not mixed, they keep their playback position, which is
+    how the voice manager's virtual voices are skipped. Voices start mixing on their scheduled frame of the DSP clock, which
+    counts the mixed frames, and looping voices wrap their playback position at the end of their sounds. */
+class AudioBackendSoftware : public IAudioBackend
+{
+public:
+    // The backend takes ownership of the sink
+    AudioBackendSoftware(IAudioSink* pSink);
+    ~AudioBackendSoftware();
+
+    bool Init() override final;
+    void Update(float dt) override final;
+
+    SoundHandle CreateSound(const std::string& filePath) override final;
+    // Creates a sound from decoded samples, e.g. procedurally generated ones
+    SoundHandle CreateSound(const PCMData& pcmData);
+    bool IsSoundLoaded(SoundHandle sound) const override final;
+    float GetSoundDuration(SoundHandle sound) const override final;
+    size_t GetSoundMemory() const override final;
+
+    VoiceHandle PlaySound(SoundHandle sound, bool loop) override final;
+    VoiceHandle ScheduleSound(SoundHandle sound, bool loop, uint64_t startClock) override final;
+    void StopVoice(VoiceHandle voice) override final;
+    void SetVoiceVolume(VoiceHandle voice, float volume) override final;
+    void SetVoicePan(VoiceHandle voice, float left, float right) override final;
+    void SetVoicePitch(VoiceHandle voice, float pitch) override final;
+
+    uint64_t GetDSPClock() const override final { return m_DSPClock; }
+    uint32_t GetDSPSampleRate() const override final { return MIX_SAMPLE_RATE; }
+
+    inline const SoftwareMixerStats& GetStats() const { return m_Stats; }
+
+private:
+    struct Sound {
+        /*  Mono or stereo, followed by guard frames repeating the first frames, which the interpolation reads past the end.
+            Streamed sounds only store the guard frames, which follow the last chunk. */
+        std::vector<float> Samples;
+        uint32_t ChannelCount;
+        // At the mix's sample rate
+        uint32_t FrameCount;
+        std::atomic_bool IsLoaded;
+
+        // Sounds loaded from files are decoded from the mapped file, which streamed sounds keep open
+        MappedFile File;
+        WaveFormat Format;
+        bool IsStreamed;
+    };
+
+    struct Voice {
+        SoundHandle VoiceSound;
+        // In frames of the sound
+        double Position;
+        float Volume;
+        float PanLeft, PanRight;
+        float Pitch;
+        bool Loop;
+        bool Playing;
+        uint32_t Generation;
+        // The voice is mixed from this frame of the DSP clock onwards
+        uint64_t StartClock;
+
+        // The chunk of a streamed sound currently decoded, followed by guard frames. Allocated once the voice is audible.
+        std::vector<float> StreamBuffer;
+        uint32_t StreamFirstFrame;
+        uint32_t StreamFrameCount;
+    };
+
+private:
+    // Returns null if the handle's voice has finished
+    Voice* GetVoice(VoiceHandle voice);
+    void ReleaseVoice(uint32_t voiceIdx);
+
+    /*  Resamples the frames [firstFrame, firstFrame + frameCount) of the sound's file to the mix's sample rate. The source
+        frames are decoded into srcSamples first, unless the file's format matches the mix. */
+    static void DecodeSoundFrames(const Sound& sound, uint32_t firstFrame, uint32_t frameCount, float* pSamples, std::vector<float>& srcSamples);
+    // Returns the samples of the voice's sound starting at the sound frame, and the frame at which the samples end
+    const float* GetVoiceSamples(const Sound& sound, Voice& voice, uint32_t soundFrame, uint32_t& endFrame);
+
+    // Mixes the frames into the ring buffer's write position, the frames must not wrap around the end of the ring buffer
+    void MixBlock(uint32_t frameCount);
+    // Inaudible voices only have their positions advanced. Returns false if the voice reached the end of its sound.
+    bool MixVoice(Voice& voice, bool isAudible, float* pOut, uint32_t frameCount);
+
+private:
+    IAudioSink* m_pSink;
+
+    std::vector<std::unique_ptr<Sound>> m_Sounds;
+    // Sounds being decoded on the thread pool, and the join indices of their jobs
+    std::vector<std::pair<SoundHandle, size_t>> m_LoadingSounds;
+    // Updated by the loading jobs as well
+    std::atomic_size_t m_SoundMemory;
+    // Source frames of streamed sounds are decoded into this before they are resampled
+    std::vector<float> m_StreamSourceSamples;
+
+    std::vector<Voice> m_Voices;
+    std::vector<uint32_t> m_FreeVoices;
+
+    // Interleaved stereo frames. The mixer writes blocks at the write offset, the sink reads them from the read offset.
+    std::vector<float> m_RingBuffer;
+    uint32_t m_RingWriteOffset;
+    uint32_t m_RingReadOffset;
+
+    // The fraction of a frame that the previous updates' delta times did not add up to
+    double m_PendingFrames;
+    // Frames mixed so far
+    uint64_t m_DSPClock;
+
+    SoftwareMixerStats m_Stats;
+};
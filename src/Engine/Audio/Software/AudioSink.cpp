@@ -0,0 +1,39 @@
+#include "AudioSink.hpp"
+
+#include <Engine/Utils/Debug.hpp>
+#include <Engine/Utils/GeneralUtils.hpp>
+
+IAudioSink* IAudioSink::Create(const std::string& outputPath)
+{
+    if (outputPath.empty()) {
+        return DBG_NEW AudioSinkNull();
+    }
+
+    return DBG_NEW AudioSinkWave(outputPath);
+}
+
+bool AudioSinkNull::Init(uint32_t sampleRate)
+{
+    UNREFERENCED_VARIABLE(sampleRate);
+    return true;
+}
+
+void AudioSinkNull::Write(const float* pFrames, uint32_t frameCount)
+{
+    UNREFERENCED_VARIABLE(pFrames);
+    UNREFERENCED_VARIABLE(frameCount);
+}
+
+AudioSinkWave::AudioSinkWave(const std::string& filePath)
+    :m_FilePath(filePath)
+{}
+
+bool AudioSinkWave::Init(uint32_t sampleRate)
+{
+    return m_Writer.Open(m_FilePath, 2u, sampleRate);
+}
+
+void AudioSinkWave::Write(const float* pFrames, uint32_t frameCount)
+{
+    m_Writer.Write(pFrames, (size_t)frameCount * 2u);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Engine/Audio/Software/WaveFile.hpp>
+
+// Consumes the software mixer's output, interleaved stereo float frames
+class IAudioSink
+{
+public:
+    // Creates a sink writing to a WAV file, or one discarding the output if the path is empty
+    static IAudioSink* Create(const std::string& outputPath);
+
+public:
+    IAudioSink() = default;
+    virtual ~IAudioSink() = default;
+
+    virtual bool Init(uint32_t sampleRate) = 0;
+    virtual void Write(const float* pFrames, uint32_t frameCount) = 0;
+};
+
+// Discards the mixed audio, used for headless runs where only the mixing cost matters
+class AudioSinkNull : public IAudioSink
+{
+public:
+    AudioSinkNull() = default;
+    ~AudioSinkNull() = default;
+
+    bool Init(uint32_t sampleRate) override final;
+    void Write(const float* pFrames, uint32_t frameCount) override final;
+};
+
+class AudioSinkWave : public IAudioSink
+{
+public:
+    AudioSinkWave(const std::string& filePath);
+    ~AudioSinkWave() = default;
+
+    bool Init(uint32_t sampleRate) override final;
+    void Write(const float* pFrames, uint32_t frameCount) override final;
+
+private:
+    std::string m_FilePath;
+    WaveFileWriter m_Writer;
+};
@@ -0,0 +1,121 @@
+#include "Mixing.hpp"
+
+#if defined(_M_X64) || defined(__SSE2__)
+    #define MIXING_SSE2
+    #include <emmintrin.h>
+#endif
+
+void MixMono(const float* pSource, float fraction, float step, float gainLeft, float gainRight, float* pOut, uint32_t frameCount)
+{
+    uint32_t frameIdx = 0u;
+
+#ifdef MIXING_SSE2
+    const __m128 gains = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+
+    if (step == 1.0f) {
+        // The interpolation weight is the same for every frame, and the source frames are contiguous
+        const __m128 weight = _mm_set1_ps(fraction);
+        for (; frameIdx + 4u <= frameCount; frameIdx += 4u) {
+            const __m128 samples0 = _mm_loadu_ps(pSource + frameIdx);
+            const __m128 samples1 = _mm_loadu_ps(pSource + frameIdx + 1u);
+            const __m128 samples = _mm_add_ps(samples0, _mm_mul_ps(_mm_sub_ps(samples1, samples0), weight));
+
+            float* pOutFrames = pOut + frameIdx * 2u;
+            _mm_storeu_ps(pOutFrames,       _mm_add_ps(_mm_loadu_ps(pOutFrames),      _mm_mul_ps(_mm_unpacklo_ps(samples, samples), gains)));
+            _mm_storeu_ps(pOutFrames + 4u,  _mm_add_ps(_mm_loadu_ps(pOutFrames + 4u), _mm_mul_ps(_mm_unpackhi_ps(samples, samples), gains)));
+        }
+    } else {
+        const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        const __m128 fractions = _mm_set1_ps(fraction);
+        const __m128 steps = _mm_set1_ps(step);
+        alignas(16) int32_t pIndices[4];
+
+        for (; frameIdx + 4u <= frameCount; frameIdx += 4u) {
+            const __m128 positions = _mm_add_ps(fractions, _mm_mul_ps(_mm_add_ps(_mm_set1_ps(float(frameIdx)), laneOffsets), steps));
+            const __m128i indices = _mm_cvttps_epi32(positions);
+            const __m128 weights = _mm_sub_ps(positions, _mm_cvtepi32_ps(indices));
+            _mm_store_si128((__m128i*)pIndices, indices);
+
+            const __m128 samples0 = _mm_setr_ps(pSource[pIndices[0]], pSource[pIndices[1]], pSource[pIndices[2]], pSource[pIndices[3]]);
+            const __m128 samples1 = _mm_setr_ps(pSource[pIndices[0] + 1], pSource[pIndices[1] + 1], pSource[pIndices[2] + 1], pSource[pIndices[3] + 1]);
+            const __m128 samples = _mm_add_ps(samples0, _mm_mul_ps(_mm_sub_ps(samples1, samples0), weights));
+
+            float* pOutFrames = pOut + frameIdx * 2u;
+            _mm_storeu_ps(pOutFrames,       _mm_add_ps(_mm_loadu_ps(pOutFrames),      _mm_mul_ps(_mm_unpacklo_ps(samples, samples), gains)));
+            _mm_storeu_ps(pOutFrames + 4u,  _mm_add_ps(_mm_loadu_ps(pOutFrames + 4u), _mm_mul_ps(_mm_unpackhi_ps(samples, samples), gains)));
+        }
+    }
+#endif
+
+    for (; frameIdx < frameCount; frameIdx++) {
+        const float position = fraction + float(frameIdx) * step;
+        const int32_t sourceIdx = (int32_t)position;
+        const float weight = position - float(sourceIdx);
+
+        const float sample = pSource[sourceIdx] + (pSource[sourceIdx + 1] - pSource[sourceIdx]) * weight;
+        pOut[frameIdx * 2u]         += sample * gainLeft;
+        pOut[frameIdx * 2u + 1u]    += sample * gainRight;
+    }
+}
+
+void MixStereo(const float* pSource, float fraction, float step, float gainLeft, float gainRight, float* pOut, uint32_t frameCount)
+{
+    uint32_t frameIdx = 0u;
+
+#ifdef MIXING_SSE2
+    const __m128 gains = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+
+    if (step == 1.0f) {
+        const __m128 weight = _mm_set1_ps(fraction);
+        for (; frameIdx + 2u <= frameCount; frameIdx += 2u) {
+            const __m128 samples0 = _mm_loadu_ps(pSource + frameIdx * 2u);
+            const __m128 samples1 = _mm_loadu_ps(pSource + frameIdx * 2u + 2u);
+            const __m128 samples = _mm_add_ps(samples0, _mm_mul_ps(_mm_sub_ps(samples1, samples0), weight));
+
+            float* pOutFrames = pOut + frameIdx * 2u;
+            _mm_storeu_ps(pOutFrames, _mm_add_ps(_mm_loadu_ps(pOutFrames), _mm_mul_ps(samples, gains)));
+        }
+    } else {
+        const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        const __m128 fractions = _mm_set1_ps(fraction);
+        const __m128 steps = _mm_set1_ps(step);
+        alignas(16) int32_t pIndices[4];
+
+        // Each frame's left and right samples are loaded together, two frames to a vector
+        auto loadFrames = [pSource](int32_t firstIdx, int32_t secondIdx) {
+            const __m128 firstFrame = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(pSource + firstIdx * 2));
+            return _mm_loadh_pi(firstFrame, (const __m64*)(pSource + secondIdx * 2));
+        };
+
+        for (; frameIdx + 4u <= frameCount; frameIdx += 4u) {
+            const __m128 positions = _mm_add_ps(fractions, _mm_mul_ps(_mm_add_ps(_mm_set1_ps(float(frameIdx)), laneOffsets), steps));
+            const __m128i indices = _mm_cvttps_epi32(positions);
+            const __m128 weights = _mm_sub_ps(positions, _mm_cvtepi32_ps(indices));
+            _mm_store_si128((__m128i*)pIndices, indices);
+
+            const __m128 samples01_0 = loadFrames(pIndices[0], pIndices[1]);
+            const __m128 samples01_1 = loadFrames(pIndices[0] + 1, pIndices[1] + 1);
+            const __m128 samples23_0 = loadFrames(pIndices[2], pIndices[3]);
+            const __m128 samples23_1 = loadFrames(pIndices[2] + 1, pIndices[3] + 1);
+
+            const __m128 samples01 = _mm_add_ps(samples01_0, _mm_mul_ps(_mm_sub_ps(samples01_1, samples01_0), _mm_unpacklo_ps(weights, weights)));
+            const __m128 samples23 = _mm_add_ps(samples23_0, _mm_mul_ps(_mm_sub_ps(samples23_1, samples23_0), _mm_unpackhi_ps(weights, weights)));
+
+            float* pOutFrames = pOut + frameIdx * 2u;
+            _mm_storeu_ps(pOutFrames,       _mm_add_ps(_mm_loadu_ps(pOutFrames),      _mm_mul_ps(samples01, gains)));
+            _mm_storeu_ps(pOutFrames + 4u,  _mm_add_ps(_mm_loadu_ps(pOutFrames + 4u), _mm_mul_ps(samples23, gains)));
+        }
+    }
+#endif
+
+    for (; frameIdx < frameCount; frameIdx++) {
+        const float position = fraction + float(frameIdx) * step;
+        const int32_t sourceIdx = (int32_t)position;
+        const float weight = position - float(sourceIdx);
+
+        const float* pFrame0 = pSource + sourceIdx * 2;
+        const float* pFrame1 = pFrame0 + 2;
+        pOut[frameIdx * 2u]         += (pFrame0[0] + (pFrame1[0] - pFrame0[0]) * weight) * gainLeft;
+        pOut[frameIdx * 2u + 1u]    += (pFrame0[1] + (pFrame1[1] - pFrame0[1]) * weight) * gainRight;
+    }
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+/*  Add a voice's samples, scaled by the voice's gains, to interleaved stereo frames. Output frame i reads the source at
+    position fraction + i * step, in source frames from pSource, linearly interpolating between the two closest frames.
+    The source must hold at least two frames past the last position read. */
+void MixMono(const float* pSource, float fraction, float step, float gainLeft, float gainRight, float* pOut, uint32_t frameCount);
+void MixStereo(const float* pSource, float fraction, float step, float gainLeft, float gainRight, float* pOut, uint32_t frameCount);
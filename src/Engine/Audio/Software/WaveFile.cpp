@@ -0,0 +1,245 @@
+#include "WaveFile.hpp"
+
+#include <Engine/Utils/Logger.hpp>
+#include <Engine/Utils/MappedFile.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+    #define WAVE_FILE_SSE2
+    #include <emmintrin.h>
+#endif
+
+#define WAVE_FORMAT_PCM         0x0001u
+#define WAVE_FORMAT_IEEE_FLOAT  0x0003u
+#define WAVE_FORMAT_EXTENSIBLE  0xFFFEu
+
+// Size of the RIFF header, the fmt chunk of a 16-bit PCM file and the data chunk's header
+#define WAVE_HEADER_SIZE 44u
+
+namespace
+{
+    template <typename T>
+    T ReadLE(const uint8_t* pData)
+    {
+        T value;
+        std::memcpy(&value, pData, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void WriteLE(std::ofstream& file, T value)
+    {
+        file.write((const char*)&value, sizeof(T));
+    }
+
+    void WriteHeader(std::ofstream& file, uint32_t channelCount, uint32_t sampleRate, uint32_t dataSize)
+    {
+        const uint16_t bytesPerSample = sizeof(int16_t);
+
+        file.write("RIFF", 4);
+        WriteLE<uint32_t>(file, WAVE_HEADER_SIZE - 8u + dataSize);
+        file.write("WAVE", 4);
+
+        file.write("fmt ", 4);
+        WriteLE<uint32_t>(file, 16u);
+        WriteLE<uint16_t>(file, (uint16_t)WAVE_FORMAT_PCM);
+        WriteLE<uint16_t>(file, (uint16_t)channelCount);
+        WriteLE<uint32_t>(file, sampleRate);
+        WriteLE<uint32_t>(file, sampleRate * channelCount * bytesPerSample);
+        WriteLE<uint16_t>(file, (uint16_t)(channelCount * bytesPerSample));
+        WriteLE<uint16_t>(file, (uint16_t)(bytesPerSample * 8u));
+
+        file.write("data", 4);
+        WriteLE<uint32_t>(file, dataSize);
+    }
+}
+
+bool ParseWaveFile(const uint8_t* pFile, size_t fileSize, WaveFormat& format)
+{
+    if (fileSize < 12u || std::memcmp(pFile, "RIFF", 4) != 0 || std::memcmp(pFile + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    uint32_t formatTag = 0u;
+    format = {};
+    size_t dataSize = 0u;
+
+    // Chunks are padded to even sizes
+    size_t chunkOffset = 12u;
+    while (chunkOffset + 8u <= fileSize) {
+        const uint8_t* pChunk = pFile + chunkOffset;
+        const size_t chunkSize = std::min<size_t>(ReadLE<uint32_t>(pChunk + 4), fileSize - chunkOffset - 8u);
+
+        if (std::memcmp(pChunk, "fmt ", 4) == 0 && chunkSize >= 16u) {
+            formatTag               = ReadLE<uint16_t>(pChunk + 8);
+            format.ChannelCount     = ReadLE<uint16_t>(pChunk + 10);
+            format.SampleRate       = ReadLE<uint32_t>(pChunk + 12);
+            format.BitsPerSample    = ReadLE<uint16_t>(pChunk + 22);
+
+            // The actual format is the first two bytes of the extensible format's sub-format GUID
+            if (formatTag == WAVE_FORMAT_EXTENSIBLE && chunkSize >= 40u) {
+                formatTag = ReadLE<uint16_t>(pChunk + 32);
+            }
+        } else if (std::memcmp(pChunk, "data", 4) == 0) {
+            format.DataOffset = chunkOffset + 8u;
+            dataSize = chunkSize;
+        }
+
+        chunkOffset += 8u + chunkSize + (chunkSize & 1u);
+    }
+
+    const uint32_t bitsPerSample = format.BitsPerSample;
+    const bool isInteger = formatTag == WAVE_FORMAT_PCM && (bitsPerSample == 8u || bitsPerSample == 16u || bitsPerSample == 24u || bitsPerSample == 32u);
+    format.IsFloat = formatTag == WAVE_FORMAT_IEEE_FLOAT && bitsPerSample == 32u;
+    if (format.DataOffset == 0u || format.ChannelCount == 0u || format.SampleRate == 0u || (!isInteger && !format.IsFloat)) {
+        return false;
+    }
+
+    format.FrameCount = dataSize / (bitsPerSample / 8u * format.ChannelCount);
+    return true;
+}
+
+void DecodeWaveFrames(const uint8_t* pFile, const WaveFormat& format, size_t firstFrame, size_t frameCount, float* pSamples)
+{
+    const uint32_t bytesPerSample = format.BitsPerSample / 8u;
+    const size_t sampleCount = frameCount * format.ChannelCount;
+    const uint8_t* pSampleData = pFile + format.DataOffset + firstFrame * format.ChannelCount * bytesPerSample;
+
+    if (format.IsFloat) {
+        std::memcpy(pSamples, pSampleData, sampleCount * sizeof(float));
+        return;
+    }
+
+    switch (format.BitsPerSample) {
+        case 8u:
+            // 8-bit samples are unsigned
+            for (size_t sampleIdx = 0u; sampleIdx < sampleCount; sampleIdx++) {
+                pSamples[sampleIdx] = float((int)pSampleData[sampleIdx] - 128) * (1.0f / 128.0f);
+            }
+            break;
+        case 16u:
+            for (size_t sampleIdx = 0u; sampleIdx < sampleCount; sampleIdx++) {
+                pSamples[sampleIdx] = float(ReadLE<int16_t>(pSampleData + sampleIdx * 2u)) * (1.0f / 32768.0f);
+            }
+            break;
+        case 24u:
+            for (size_t sampleIdx = 0u; sampleIdx < sampleCount; sampleIdx++) {
+                // Place the three bytes in the upper bytes of an int32 to sign extend them
+                const uint8_t* pSample = pSampleData + sampleIdx * 3u;
+                const int32_t sample = (int32_t)((uint32_t)pSample[0] << 8u | (uint32_t)pSample[1] << 16u | (uint32_t)pSample[2] << 24u);
+                pSamples[sampleIdx] = float(sample) * (1.0f / 2147483648.0f);
+            }
+            break;
+        case 32u:
+            for (size_t sampleIdx = 0u; sampleIdx < sampleCount; sampleIdx++) {
+                pSamples[sampleIdx] = float(ReadLE<int32_t>(pSampleData + sampleIdx * 4u)) * (1.0f / 2147483648.0f);
+            }
+            break;
+    }
+}
+
+bool ReadWaveFile(const std::string& filePath, PCMData& pcmData)
+{
+    MappedFile file;
+    if (!file.Open(filePath)) {
+        LOG_WARNINGF("Failed to open WAV file: %s", filePath.c_str());
+        return false;
+    }
+
+    WaveFormat format = {};
+    if (!ParseWaveFile(file.GetData(), file.GetSize(), format)) {
+        LOG_WARNINGF("Unsupported WAV file: %s", filePath.c_str());
+        return false;
+    }
+
+    pcmData.ChannelCount = format.ChannelCount;
+    pcmData.SampleRate = format.SampleRate;
+    pcmData.Samples.resize(format.FrameCount * format.ChannelCount);
+    DecodeWaveFrames(file.GetData(), format, 0u, format.FrameCount, pcmData.Samples.data());
+
+    return true;
+}
+
+bool WriteWaveFile(const std::string& filePath, const PCMData& pcmData)
+{
+    WaveFileWriter writer;
+    if (!writer.Open(filePath, pcmData.ChannelCount, pcmData.SampleRate)) {
+        return false;
+    }
+
+    writer.Write(pcmData.Samples.data(), pcmData.Samples.size());
+    return true;
+}
+
+WaveFileWriter::WaveFileWriter()
+    :m_ChannelCount(0u),
+    m_SampleRate(0u),
+    m_DataSize(0u)
+{}
+
+WaveFileWriter::~WaveFileWriter()
+{
+    Close();
+}
+
+bool WaveFileWriter::Open(const std::string& filePath, uint32_t channelCount, uint32_t sampleRate)
+{
+    Close();
+
+    m_File.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!m_File.is_open()) {
+        LOG_WARNINGF("Failed to open WAV file for writing: %s", filePath.c_str());
+        return false;
+    }
+
+    m_ChannelCount  = channelCount;
+    m_SampleRate    = sampleRate;
+    m_DataSize      = 0u;
+
+    // Sizes are unknown until the file is closed
+    WriteHeader(m_File, m_ChannelCount, m_SampleRate, 0u);
+    return true;
+}
+
+void WaveFileWriter::Write(const float* pSamples, size_t sampleCount)
+{
+    if (!m_File.is_open()) {
+        return;
+    }
+
+    m_ConvertedSamples.resize(sampleCount);
+    int16_t* pConverted = m_ConvertedSamples.data();
+    size_t sampleIdx = 0u;
+
+#ifdef WAVE_FILE_SSE2
+    // Packing the 32-bit integers to 16 bits saturates the samples that are out of range
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    for (; sampleIdx + 8u <= sampleCount; sampleIdx += 8u) {
+        const __m128i samplesLow    = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(pSamples + sampleIdx), scale));
+        const __m128i samplesHigh   = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(pSamples + sampleIdx + 4u), scale));
+        _mm_storeu_si128((__m128i*)(pConverted + sampleIdx), _mm_packs_epi32(samplesLow, samplesHigh));
+    }
+#endif
+
+    for (; sampleIdx < sampleCount; sampleIdx++) {
+        pConverted[sampleIdx] = (int16_t)std::lround(std::clamp(pSamples[sampleIdx], -1.0f, 1.0f) * 32767.0f);
+    }
+
+    m_File.write((const char*)pConverted, sampleCount * sizeof(int16_t));
+    m_DataSize += sampleCount * sizeof(int16_t);
+}
+
+void WaveFileWriter::Close()
+{
+    if (!m_File.is_open()) {
+        return;
+    }
+
+    // WAV files are limited to 4 GB
+    m_File.seekp(0);
+    WriteHeader(m_File, m_ChannelCount, m_SampleRate, (uint32_t)std::min<size_t>(m_DataSize, UINT32_MAX - WAVE_HEADER_SIZE));
+    m_File.close();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Decoded audio as interleaved 32-bit float samples in [-1, 1]
+struct PCMData {
+    std::vector<float> Samples;
+    uint32_t ChannelCount;
+    uint32_t SampleRate;
+};
+
+// Describes the samples of a WAV file
+struct WaveFormat {
+    uint32_t ChannelCount;
+    uint32_t SampleRate;
+    uint32_t BitsPerSample;
+    bool IsFloat;
+    // Offset of the first sample from the start of the file
+    size_t DataOffset;
+    size_t FrameCount;
+};
+
+// Supports 8, 16, 24 or 32-bit integer samples, and 32-bit float samples
+bool ParseWaveFile(const uint8_t* pFile, size_t fileSize, WaveFormat& format);
+// Converts frames of the mapped WAV file to interleaved float samples, the frames must lie within the file
+void DecodeWaveFrames(const uint8_t* pFile, const WaveFormat& format, size_t firstFrame, size_t frameCount, float* pSamples);
+
+bool ReadWaveFile(const std::string& filePath, PCMData& pcmData);
+bool WriteWaveFile(const std::string& filePath, const PCMData& pcmData);
+
+// Streams float samples to a 16-bit WAV file. The header's sizes are written when the file is closed.
+class WaveFileWriter
+{
+public:
+    WaveFileWriter();
+    ~WaveFileWriter();
+
+    bool Open(const std::string& filePath, uint32_t channelCount, uint32_t sampleRate);
+    void Write(const float* pSamples, size_t sampleCount);
+    void Close();
+
+private:
+    std::ofstream m_File;
+    uint32_t m_ChannelCount;
+    uint32_t m_SampleRate;
+    size_t m_DataSize;
+
+    // Scratch buffer for converting samples to 16-bit integers
+    std::vector<int16_t> m_ConvertedSamples;
+};
@@ -5,10 +5,11 @@
 #include <Engine/Physics/Velocity.hpp>
 #include <Engine/Transform.hpp>
 
-#include <fmod_errors.h>
+#include <chrono>
 
 SoundPlayer::SoundPlayer()
-    :m_pSystem(nullptr)
+    :m_pBackend(nullptr),
+    m_Stats({})
 {
     SystemRegistration sysReg = {};
     sysReg.SubscriberRegistration.EntitySubscriptionRegistrations =
@@ -19,13 +20,16 @@ SoundPlayer::SoundPlayer()
             {
                 { RW, SoundComponent::Type() }, { R, PositionComponent::Type() }
             },
+            .OnEntityAdded = std::bind_front(&VoiceManager::AddVoice, &m_VoiceManager),
+            .OnEntityRemoval = std::bind_front(&VoiceManager::RemoveVoice, &m_VoiceManager)
         },
         {
-            .pSubscriber = &m_LoopedSounds,
+            .pSubscriber = &m_AllSounds,
             .ComponentAccesses =
             {
-                { RW, SoundLooperComponent::Type() }, { RW, SoundComponent::Type() }
+                { R, SoundComponent::Type() }
             },
+            .OnEntityRemoval = std::bind_front(&SoundPlayer::OnSoundRemoved, this)
         },
         {
             .pSubscriber = &m_Cameras,
@@ -42,177 +46,159 @@ SoundPlayer::SoundPlayer()
 
 SoundPlayer::~SoundPlayer()
 {
-    m_pSystem->release();
+    delete m_pBackend;
 }
 
-bool SoundPlayer::Init()
+bool SoundPlayer::Init(const AudioBackendInfo& backendInfo)
 {
-    FMOD_RESULT result = FMOD::System_Create(&m_pSystem);
-    if (result != FMOD_OK) {
-        LOG_ERRORF("Failed to create FMOD system: %s", FMOD_ErrorString(result));
-        return false;
-    }
-
-    const int maxChannels = 512;
-
-    result = m_pSystem->init(maxChannels, FMOD_INIT_NORMAL, nullptr);
-    if (result != FMOD_OK) {
-        LOG_ERRORF("Failed to initialize FMOD system: %s", FMOD_ErrorString(result));
-        return false;
-    }
-
-    return true;
+    m_pBackend = IAudioBackend::Create(backendInfo);
+    return m_pBackend && m_pBackend->Init();
 }
 
 void SoundPlayer::Update(float dt)
 {
-    m_pSystem->update();
-
-    if (m_Cameras.Empty()) {
-        return;
-    }
-
-    ECSCore* pECS = ECSCore::GetInstance();
-    const ComponentArray<PositionComponent>* pPositionComponents = pECS->GetComponentArray<PositionComponent>();
-    const ComponentArray<VelocityComponent>* pVelocityComponents = pECS->GetComponentArray<VelocityComponent>();
-    ComponentArray<SoundComponent>* pSoundComponents = pECS->GetComponentArray<SoundComponent>();
-    ComponentArray<SoundLooperComponent>* pSoundLooperComponents = pECS->GetComponentArray<SoundLooperComponent>();
+    const auto updateStart = std::chrono::high_resolution_clock::now();
 
-    const Entity cameraEntity = m_Cameras[0];
-    const DirectX::XMFLOAT3& cameraPosition = pPositionComponents->GetConstData(cameraEntity).Position;
-    const DirectX::XMFLOAT4& camRotationQuaternion = pECS->GetConstComponent<RotationComponent>(cameraEntity).Quaternion;
-
-    const DirectX::XMVECTOR camPos = DirectX::XMLoadFloat3(&cameraPosition);
-    const DirectX::XMVECTOR camDir = GetForward(camRotationQuaternion);
-    DirectX::XMVECTOR camDirFlat = camDir;
-    camDirFlat = DirectX::XMVector3Normalize(DirectX::XMVectorSetY(camDirFlat, 0.0f));
-
-    const DirectX::XMVECTOR camVelocity = DirectX::XMLoadFloat3(&pVelocityComponents->GetConstData(cameraEntity).Velocity);
-    float camSpeed = DirectX::XMVectorGetX(DirectX::XMVector3Length(camVelocity));
-
-    for (Entity soundEntity : m_Sounds) {
-        SoundComponent& sound = pSoundComponents->GetData(soundEntity);
-        const DirectX::XMFLOAT3& soundPosition = pPositionComponents->GetConstData(soundEntity).Position;
-
-        DirectX::XMVECTOR soundPos = DirectX::XMLoadFloat3(&soundPosition);
-
-        // Calculate volume using distance to camera
-        DirectX::XMVECTOR camToSound = DirectX::XMVectorSubtract(soundPos, camPos);
-        float soundDistance = DirectX::XMVectorGetX(DirectX::XMVector3Length(camToSound));
-        float volume = 1.0f / soundDistance;
-
-        sound.pChannel->setVolume(volume);
-
-        stereoPan(sound, camToSound, camDirFlat);
-
-        const VelocityComponent* pSoundComponent = nullptr;
-        if (pVelocityComponents->GetConstIf(soundEntity, &pSoundComponent)) {
-            dopplerEffect(sound, camPos, camVelocity, camSpeed, soundPos, pSoundComponent->Velocity);
-        }
+    if (!m_Cameras.Empty()) {
+        UpdateVoices();
     }
 
-    for (Entity loopedSoundEntity : m_LoopedSounds) {
-        SoundLooperComponent& soundLooper = pSoundLooperComponents->GetData(loopedSoundEntity);
-        soundLooper.NextLoopCountdown -= dt;
+    m_pBackend->Update(dt);
 
-        if (soundLooper.NextLoopCountdown < 0.0f) {
-            SoundComponent& sound = pSoundComponents->GetData(loopedSoundEntity);
-            PlaySound(sound);
-            soundLooper.NextLoopCountdown = GetSoundDuration(sound);
-        }
-    }
+    const std::chrono::duration<float, std::milli> updateTime = std::chrono::high_resolution_clock::now() - updateStart;
+    m_Stats.UpdateTime = updateTime.count();
 }
 
 SoundComponent SoundPlayer::CreateSound(const std::string& fileName)
 {
-    SoundComponent sound = {};
-    const FMOD_RESULT result = m_pSystem->createSound(fileName.c_str(), FMOD_DEFAULT, nullptr, &sound.pSound);
-    if (result != FMOD_OK) {
-        LOG_WARNINGF("Failed to create sound component from file [%s]: %s", fileName.c_str(), FMOD_ErrorString(result));
+    SoundHandle soundHandle = INVALID_AUDIO_HANDLE;
+
+    auto soundItr = m_SoundCache.find(fileName);
+    if (soundItr != m_SoundCache.end()) {
+        soundHandle = soundItr->second;
+    } else {
+        soundHandle = m_pBackend->CreateSound(fileName);
+        if (soundHandle != INVALID_AUDIO_HANDLE) {
+            m_SoundCache[fileName] = soundHandle;
+        }
     }
 
-    return sound;
+    return SoundComponent{
+        .Sound  = soundHandle,
+        .Voice  = INVALID_AUDIO_HANDLE,
+        .Volume = 1.0f
+    };
 }
 
-bool SoundPlayer::PlaySound(SoundComponent& sound)
+bool SoundPlayer::PlaySound(SoundComponent& sound, bool loop)
 {
-    const FMOD_RESULT result = m_pSystem->playSound(sound.pSound, nullptr, false, &sound.pChannel);
-    if (result != FMOD_OK) {
-        LOG_WARNINGF("Failed to play sound: %s", FMOD_ErrorString(result));
+    if (sound.Sound == INVALID_AUDIO_HANDLE) {
         return false;
     }
 
-    return true;
+    sound.Voice = m_pBackend->PlaySound(sound.Sound, loop);
+    m_Stats.PlayedVoices += 1u;
+    return sound.Voice != INVALID_AUDIO_HANDLE;
 }
 
-bool SoundPlayer::SetVolume(SoundComponent& sound, float volume)
+bool SoundPlayer::ScheduleSound(SoundComponent& sound, uint64_t startClock, bool loop)
 {
-    const FMOD_RESULT result = sound.pChannel->setVolume(volume);
-    if (result != FMOD_OK) {
-        LOG_WARNINGF("Failed to set sound volume: %s", FMOD_ErrorString(result));
+    if (sound.Sound == INVALID_AUDIO_HANDLE) {
         return false;
     }
 
-    return true;
+    sound.Voice = m_pBackend->ScheduleSound(sound.Sound, loop, startClock);
+    m_Stats.PlayedVoices += 1u;
+    return sound.Voice != INVALID_AUDIO_HANDLE;
 }
 
-SoundLooperComponent SoundPlayer::CreateSoundLooper(const SoundComponent& sound)
+void SoundPlayer::StopSound(SoundComponent& sound)
 {
-    return SoundLooperComponent{
-        .NextLoopCountdown = GetSoundDuration(sound)
-    };
+    m_pBackend->StopVoice(sound.Voice);
+    sound.Voice = INVALID_AUDIO_HANDLE;
 }
 
-float SoundPlayer::GetSoundDuration(const SoundComponent& sound)
+bool SoundPlayer::SetVolume(SoundComponent& sound, float volume)
 {
-    unsigned int soundDurationMS = 0;
-    const FMOD_RESULT result = sound.pSound->getLength(&soundDurationMS, FMOD_TIMEUNIT_MS);
-    if (result != FMOD_OK) {
-        LOG_WARNINGF("Failed to get sound duration: %s", FMOD_ErrorString(result));
-        return 0.0f;
-    }
+    sound.Volume = volume;
+    m_pBackend->SetVoiceVolume(sound.Voice, volume);
+    return sound.Voice != INVALID_AUDIO_HANDLE;
+}
 
-    return float(soundDurationMS) * 0.001f;
+float SoundPlayer::GetSoundDuration(const SoundComponent& sound)
+{
+    return sound.Sound == INVALID_AUDIO_HANDLE ? 0.0f : m_pBackend->GetSoundDuration(sound.Sound);
 }
 
-void SoundPlayer::stereoPan(SoundComponent& sound, const DirectX::XMVECTOR& camToSound, const DirectX::XMVECTOR& camDirFlat)
+void SoundPlayer::OnSoundRemoved(Entity entity)
 {
-    // Ignore vertical difference between camera and sound, this allows for calculating the yaw
-    const DirectX::XMVECTOR camToSoundNorm = DirectX::XMVector3Normalize(DirectX::XMVectorSetY(camToSound, 0.0f));
+    // The component is removed after its subscribers have been notified
+    const SoundComponent& sound = ECSCore::GetInstance()->GetConstComponent<SoundComponent>(entity);
+    m_pBackend->StopVoice(sound.Voice);
+}
 
-    const float angle = -GetOrientedAngle(camToSoundNorm, camDirFlat, g_DefaultUp);
-    const float cosAngle = std::cosf(angle);
-    const float sinAngle = std::sinf(angle);
+void SoundPlayer::UpdateVoices()
+{
+    ECSCore* pECS = ECSCore::GetInstance();
+    const ComponentArray<PositionComponent>* pPositionComponents = pECS->GetComponentArray<PositionComponent>();
+    const ComponentArray<VelocityComponent>* pVelocityComponents = pECS->GetComponentArray<VelocityComponent>();
+    const ComponentArray<SoundComponent>* pSoundComponents = pECS->GetComponentArray<SoundComponent>();
 
-    const float sqrtTwoRec = 1.0f / std::sqrtf(2.0f);
-    const float ampLeft   = 0.5f * (sqrtTwoRec * (cosAngle + sinAngle)) + 0.5f;
-    const float ampRight  = 0.5f * (sqrtTwoRec * (cosAngle - sinAngle)) + 0.5f;
+    const Entity cameraEntity = m_Cameras[0];
+    const DirectX::XMFLOAT4& camRotationQuaternion = pECS->GetConstComponent<RotationComponent>(cameraEntity).Quaternion;
+    const DirectX::XMVECTOR camDirFlat = DirectX::XMVector3Normalize(DirectX::XMVectorSetY(GetForward(camRotationQuaternion), 0.0f));
+
+    AudioListener listener = {};
+    listener.Position = pPositionComponents->GetConstData(cameraEntity).Position;
+    listener.Velocity = pVelocityComponents->GetConstData(cameraEntity).Velocity;
+    DirectX::XMStoreFloat3(&listener.ForwardFlat, camDirFlat);
+
+    // Gather the emitters into the voice manager's arrays
+    const std::vector<Entity>& voiceEntities = m_VoiceManager.GetVoiceEntities();
+    for (uint32_t voiceIdx = 0u; voiceIdx < m_VoiceManager.GetVoiceCount(); voiceIdx += 1u) {
+        const Entity soundEntity = voiceEntities[voiceIdx];
+
+        const VelocityComponent* pVelocityComponent = nullptr;
+        pVelocityComponents->GetConstIf(soundEntity, &pVelocityComponent);
+
+        m_VoiceManager.SetEmitter(voiceIdx,
+            pPositionComponents->GetConstData(soundEntity).Position,
+            pVelocityComponent ? &pVelocityComponent->Velocity : nullptr,
+            pSoundComponents->GetConstData(soundEntity).Volume
+        );
+    }
 
-    sound.pChannel->setMixLevelsOutput(ampLeft, ampRight, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+    m_VoiceManager.Update(listener);
+    ApplyVoiceChanges();
+    m_Stats.VoiceStats = m_VoiceManager.GetStats();
 }
 
-void SoundPlayer::dopplerEffect(SoundComponent& sound, const DirectX::XMVECTOR& camPos, const DirectX::XMVECTOR& camVelocity, float camSpeed, const DirectX::XMVECTOR& objectPos, const DirectX::XMFLOAT3& objectVelocity)
+void SoundPlayer::ApplyVoiceChanges()
 {
-    const DirectX::XMVECTOR objVelocity = DirectX::XMLoadFloat3(&objectVelocity);
-
-    // Calculate signs for velocities
-    const DirectX::XMVECTOR camToObject = DirectX::XMVectorSubtract(objectPos, camPos);
-
-    // camVelocity is positive if it is moving towards the sound
-    const float camVelocitySign = DirectX::XMVectorGetX(DirectX::XMVector3Dot(camVelocity, camToObject));
+    const ComponentArray<SoundComponent>* pSoundComponents = ECSCore::GetInstance()->GetComponentArray<SoundComponent>();
 
-    // objectVelocity is positive if it is moving away from the receiver
-    const float objectVelocitySign = DirectX::XMVectorGetX(DirectX::XMVector3Dot(objVelocity, camToObject));
+    for (const VoiceChange& voiceChange : m_VoiceManager.GetChanges()) {
+        const VoiceHandle voice = pSoundComponents->GetConstData(voiceChange.VoiceEntity).Voice;
+        if (voice == INVALID_AUDIO_HANDLE) {
+            continue;
+        }
 
-    camSpeed = camVelocitySign < 0.0f ? -camSpeed : camSpeed;
-    float objSpeed = DirectX::XMVectorGetX(DirectX::XMVector3Length(objVelocity));
-    objSpeed = objectVelocitySign < 0.0f ? -objSpeed : objSpeed;
+        // Virtual voices are silenced, which lets the backend stop mixing them
+        if (HAS_FLAG(voiceChange.Changes, VOICE_CHANGE::VIRTUALIZED)) {
+            m_pBackend->SetVoiceVolume(voice, 0.0f);
+            continue;
+        }
 
-    const float soundPropagation = 343.0f;
-    float frequency = 0.0f;
-    sound.pChannel->getFrequency(&frequency);
+        if (HAS_FLAG(voiceChange.Changes, VOICE_CHANGE::GAIN)) {
+            m_pBackend->SetVoiceVolume(voice, voiceChange.Gain);
+        }
 
-    const float observedFrequency = frequency * (soundPropagation + camSpeed) / (soundPropagation + objSpeed);
+        if (HAS_FLAG(voiceChange.Changes, VOICE_CHANGE::PAN)) {
+            m_pBackend->SetVoicePan(voice, voiceChange.PanLeft, voiceChange.PanRight);
+        }
 
-    sound.pChannel->setFrequency(observedFrequency);
+        if (HAS_FLAG(voiceChange.Changes, VOICE_CHANGE::PITCH)) {
+            m_pBackend->SetVoicePitch(voice, voiceChange.Pitch);
+        }
+    }
 }
@@ -1,21 +1,30 @@
 #pragma once
 
+#include <Engine/Audio/IAudioBackend.hpp>
+#include <Engine/Audio/VoiceManager.hpp>
 #include <Engine/ECS/System.hpp>
 #include <Engine/Utils/IDVector.hpp>
 
-#include <fmod.hpp>
-
 #include <DirectXMath.h>
 
+#include <unordered_map>
+
 struct SoundComponent {
     DECL_COMPONENT(SoundComponent);
-    FMOD::Sound* pSound;
-    FMOD::Channel* pChannel;
+    SoundHandle Sound;
+    // The voice playing the sound, INVALID_AUDIO_HANDLE until the sound is played
+    VoiceHandle Voice;
+    // Positional sounds are attenuated from this volume by their distance to the listener
+    float Volume;
 };
 
-struct SoundLooperComponent {
-    DECL_COMPONENT(SoundLooperComponent);
-    float NextLoopCountdown;
+struct SoundPlayerStats {
+    VoiceManagerStats VoiceStats;
+    // Time spent in the latest update, including sending the voices' parameters to the audio backend and updating it,
+    // which is when the software backend mixes, in milliseconds
+    float UpdateTime;
+    // Amount of voices played or scheduled since the sound player was initialized
+    uint64_t PlayedVoices;
 };
 
 class SoundPlayer : public System
@@ -24,28 +33,47 @@ public:
     SoundPlayer();
     ~SoundPlayer();
 
-    bool Init();
+    bool Init(const AudioBackendInfo& backendInfo);
 
     void Update(float dt) override final;
 
+    // Components created from the same file share the sound, which is loaded once
     SoundComponent CreateSound(const std::string& fileName);
-    bool PlaySound(SoundComponent& sound);
+    // Looping sounds loop in the backend without gaps until they are stopped, or until their sound component is removed
+    bool PlaySound(SoundComponent& sound, bool loop = false);
+    // Starts the sound on the exact frame when the backend's DSP clock reaches startClock
+    bool ScheduleSound(SoundComponent& sound, uint64_t startClock, bool loop = false);
+    void StopSound(SoundComponent& sound);
     bool SetVolume(SoundComponent& sound, float volume);
-    SoundLooperComponent CreateSoundLooper(const SoundComponent& sound);
 
     // Duration is in seconds
     float GetSoundDuration(const SoundComponent& sound);
 
-    FMOD::System* GetSystem() { return m_pSystem; }
+    uint64_t GetDSPClock() const { return m_pBackend->GetDSPClock(); }
+    uint32_t GetDSPSampleRate() const { return m_pBackend->GetDSPSampleRate(); }
+
+    IAudioBackend* GetBackend() { return m_pBackend; }
+    inline const SoundPlayerStats& GetStats() const { return m_Stats; }
+    inline size_t GetCachedSoundCount() const { return m_SoundCache.size(); }
 
 private:
-    void stereoPan(SoundComponent& sound, const DirectX::XMVECTOR& camToSound, const DirectX::XMVECTOR& camDirFlat);
-    void dopplerEffect(SoundComponent& sound, const DirectX::XMVECTOR& camPos, const DirectX::XMVECTOR& camVelocity, float camSpeed, const DirectX::XMVECTOR& objectPos, const DirectX::XMFLOAT3& objectVelocity);
+    void OnSoundRemoved(Entity entity);
+
+    void UpdateVoices();
+    // Sends the parameters that the voice manager found to have changed to the backend
+    void ApplyVoiceChanges();
 
 private:
-    FMOD::System* m_pSystem;
+    IAudioBackend* m_pBackend;
+    VoiceManager m_VoiceManager;
+
+    // Maps file paths to the backend's sounds. Sounds that failed to load are not cached.
+    std::unordered_map<std::string, SoundHandle> m_SoundCache;
 
     IDVector m_Sounds;
-    IDVector m_LoopedSounds;
+    // Every entity with a sound, spatial or not, whose voices are stopped when their sounds are removed
+    IDVector m_AllSounds;
     IDVector m_Cameras;
+
+    SoundPlayerStats m_Stats;
 };
@@ -0,0 +1,281 @@
+#include "VoiceManager.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// Emitters closer than this are attenuated as if they were at this distance
+#define VOICE_MIN_DISTANCE 0.1f
+
+// Relative change in gain, and absolute changes in pan and pitch, below which the parameters are not sent
+#define VOICE_GAIN_THRESHOLD 0.01f
+#define VOICE_PAN_THRESHOLD 0.01f
+#define VOICE_PITCH_THRESHOLD 0.001f
+
+VoiceManager::VoiceManager(uint32_t maxRealVoices)
+    :m_MaxRealVoices(maxRealVoices),
+    m_Stats({})
+{}
+
+void VoiceManager::AddVoice(Entity entity)
+{
+    const uint32_t voiceIdx = (uint32_t)m_Entities.size();
+    m_Entities.push_back(entity);
+    m_EntityToVoice[entity] = voiceIdx;
+
+    ResizeArrays(voiceIdx + 1u);
+    m_Volumes[voiceIdx] = 1.0f;
+    m_Pitches[voiceIdx] = 1.0f;
+    ResendVoice(entity);
+}
+
+void VoiceManager::RemoveVoice(Entity entity)
+{
+    auto voiceItr = m_EntityToVoice.find(entity);
+    if (voiceItr == m_EntityToVoice.end()) {
+        return;
+    }
+
+    // Move the last voice into the removed voice's slot
+    const uint32_t voiceIdx = voiceItr->second;
+    const uint32_t lastIdx = (uint32_t)m_Entities.size() - 1u;
+    m_EntityToVoice.erase(voiceItr);
+
+    if (voiceIdx != lastIdx) {
+        const Entity lastEntity = m_Entities[lastIdx];
+        m_Entities[voiceIdx] = lastEntity;
+        m_EntityToVoice[lastEntity] = voiceIdx;
+
+        std::vector<float>* pFloatArrays[] = {
+            &m_PositionsX, &m_PositionsY, &m_PositionsZ, &m_VelocitiesX, &m_VelocitiesY, &m_VelocitiesZ, &m_Volumes,
+            &m_DopplerScales, &m_Gains, &m_PansLeft, &m_PansRight, &m_Pitches, &m_SentGains, &m_SentPansLeft,
+            &m_SentPansRight, &m_SentPitches
+        };
+
+        for (std::vector<float>* pArray : pFloatArrays) {
+            (*pArray)[voiceIdx] = (*pArray)[lastIdx];
+        }
+
+        m_Real[voiceIdx]        = m_Real[lastIdx];
+        m_SentReal[voiceIdx]    = m_SentReal[lastIdx];
+    }
+
+    m_Entities.pop_back();
+    ResizeArrays(lastIdx);
+}
+
+void VoiceManager::ResendVoice(Entity entity)
+{
+    auto voiceItr = m_EntityToVoice.find(entity);
+    if (voiceItr == m_EntityToVoice.end()) {
+        return;
+    }
+
+    // A fresh channel plays at full volume, so the voice is treated as real until told otherwise
+    const uint32_t voiceIdx = voiceItr->second;
+    m_SentReal[voiceIdx]        = 1u;
+    m_SentGains[voiceIdx]       = -1.0f;
+    m_SentPansLeft[voiceIdx]    = -1.0f;
+    m_SentPansRight[voiceIdx]   = -1.0f;
+    m_SentPitches[voiceIdx]     = -1.0f;
+}
+
+void VoiceManager::SetEmitter(uint32_t voiceIdx, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3* pVelocity, float volume)
+{
+    m_PositionsX[voiceIdx] = position.x;
+    m_PositionsY[voiceIdx] = position.y;
+    m_PositionsZ[voiceIdx] = position.z;
+
+    if (pVelocity) {
+        m_VelocitiesX[voiceIdx]     = pVelocity->x;
+        m_VelocitiesY[voiceIdx]     = pVelocity->y;
+        m_VelocitiesZ[voiceIdx]     = pVelocity->z;
+        m_DopplerScales[voiceIdx]   = 1.0f;
+    } else {
+        m_DopplerScales[voiceIdx]   = 0.0f;
+    }
+
+    m_Volumes[voiceIdx] = volume;
+}
+
+void VoiceManager::Update(const AudioListener& listener)
+{
+    const auto updateStart = std::chrono::high_resolution_clock::now();
+
+    ComputeVoiceParameters(listener);
+    SelectRealVoices();
+    GatherChanges();
+
+    const std::chrono::duration<float, std::milli> updateTime = std::chrono::high_resolution_clock::now() - updateStart;
+    m_Stats.UpdateTime = updateTime.count();
+}
+
+void VoiceManager::ResizeArrays(uint32_t voiceCount)
+{
+    // Padding lanes hold silent, static emitters, which keeps the vectorized pass free of special cases
+    const size_t paddedCount = (voiceCount + 3u) & ~3u;
+
+    std::vector<float>* pFloatArrays[] = {
+        &m_PositionsX, &m_PositionsY, &m_PositionsZ, &m_VelocitiesX, &m_VelocitiesY, &m_VelocitiesZ, &m_Volumes,
+        &m_DopplerScales, &m_Gains, &m_PansLeft, &m_PansRight, &m_Pitches, &m_SentGains, &m_SentPansLeft,
+        &m_SentPansRight, &m_SentPitches
+    };
+
+    for (std::vector<float>* pArray : pFloatArrays) {
+        pArray->resize(paddedCount, 0.0f);
+    }
+
+    m_Real.resize(paddedCount, 0u);
+    m_SentReal.resize(paddedCount, 0u);
+}
+
+void VoiceManager::ComputeVoiceParameters(const AudioListener& listener)
+{
+    using namespace DirectX;
+
+    const XMVECTOR listenerX = XMVectorReplicate(listener.Position.x);
+    const XMVECTOR listenerY = XMVectorReplicate(listener.Position.y);
+    const XMVECTOR listenerZ = XMVectorReplicate(listener.Position.z);
+    const XMVECTOR listenerVelocityX = XMVectorReplicate(listener.Velocity.x);
+    const XMVECTOR listenerVelocityY = XMVectorReplicate(listener.Velocity.y);
+    const XMVECTOR listenerVelocityZ = XMVectorReplicate(listener.Velocity.z);
+    const XMVECTOR listenerSpeed = XMVector3Length(XMLoadFloat3(&listener.Velocity));
+    const XMVECTOR forwardX = XMVectorReplicate(listener.ForwardFlat.x);
+    const XMVECTOR forwardZ = XMVectorReplicate(listener.ForwardFlat.z);
+
+    const XMVECTOR zero = XMVectorZero();
+    const XMVECTOR one = XMVectorSplatOne();
+    const XMVECTOR half = XMVectorReplicate(0.5f);
+    const XMVECTOR halfSqrtTwoRec = XMVectorReplicate(0.5f / std::sqrt(2.0f));
+    const XMVECTOR minDistance = XMVectorReplicate(VOICE_MIN_DISTANCE);
+    const XMVECTOR minFlatDistanceSq = XMVectorReplicate(1e-8f);
+    const XMVECTOR soundPropagation = XMVectorReplicate(343.0f);
+
+    auto load = [](const std::vector<float>& array, size_t voiceIdx) {
+        return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&array[voiceIdx]));
+    };
+
+    auto store = [](std::vector<float>& array, size_t voiceIdx, FXMVECTOR value) {
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&array[voiceIdx]), value);
+    };
+
+    const size_t paddedCount = m_Gains.size();
+    for (size_t voiceIdx = 0u; voiceIdx < paddedCount; voiceIdx += 4u) {
+        // Distance attenuation
+        const XMVECTOR toEmitterX = XMVectorSubtract(load(m_PositionsX, voiceIdx), listenerX);
+        const XMVECTOR toEmitterY = XMVectorSubtract(load(m_PositionsY, voiceIdx), listenerY);
+        const XMVECTOR toEmitterZ = XMVectorSubtract(load(m_PositionsZ, voiceIdx), listenerZ);
+
+        const XMVECTOR flatDistanceSq = XMVectorMultiplyAdd(toEmitterX, toEmitterX, XMVectorMultiply(toEmitterZ, toEmitterZ));
+        const XMVECTOR distanceSq = XMVectorMultiplyAdd(toEmitterY, toEmitterY, flatDistanceSq);
+        const XMVECTOR distance = XMVectorMax(XMVectorSqrt(distanceSq), minDistance);
+        store(m_Gains, voiceIdx, XMVectorDivide(load(m_Volumes, voiceIdx), distance));
+
+        /*  Stereo pan, ignoring the vertical difference between the listener and the emitter. The cosine and sine of the
+            yaw to the emitter are the dot product and the cross product's y component of the flattened directions. */
+        const XMVECTOR flatDistanceRec = XMVectorReciprocalSqrt(XMVectorMax(flatDistanceSq, minFlatDistanceSq));
+        const XMVECTOR cosAngle = XMVectorMultiply(XMVectorMultiplyAdd(toEmitterX, forwardX, XMVectorMultiply(toEmitterZ, forwardZ)), flatDistanceRec);
+        const XMVECTOR sinAngle = XMVectorMultiply(XMVectorNegativeMultiplySubtract(toEmitterX, forwardZ, XMVectorMultiply(toEmitterZ, forwardX)), flatDistanceRec);
+        store(m_PansLeft, voiceIdx, XMVectorMultiplyAdd(halfSqrtTwoRec, XMVectorAdd(cosAngle, sinAngle), half));
+        store(m_PansRight, voiceIdx, XMVectorMultiplyAdd(halfSqrtTwoRec, XMVectorSubtract(cosAngle, sinAngle), half));
+
+        // Doppler. The listener's speed is positive when moving towards the emitter, the emitter's when moving away.
+        const XMVECTOR velocityX = load(m_VelocitiesX, voiceIdx);
+        const XMVECTOR velocityY = load(m_VelocitiesY, voiceIdx);
+        const XMVECTOR velocityZ = load(m_VelocitiesZ, voiceIdx);
+
+        const XMVECTOR listenerDot = XMVectorMultiplyAdd(listenerVelocityX, toEmitterX, XMVectorMultiplyAdd(listenerVelocityY, toEmitterY, XMVectorMultiply(listenerVelocityZ, toEmitterZ)));
+        const XMVECTOR listenerSpeedSigned = XMVectorSelect(listenerSpeed, XMVectorNegate(listenerSpeed), XMVectorLess(listenerDot, zero));
+
+        const XMVECTOR emitterDot = XMVectorMultiplyAdd(velocityX, toEmitterX, XMVectorMultiplyAdd(velocityY, toEmitterY, XMVectorMultiply(velocityZ, toEmitterZ)));
+        const XMVECTOR emitterSpeed = XMVectorSqrt(XMVectorMultiplyAdd(velocityX, velocityX, XMVectorMultiplyAdd(velocityY, velocityY, XMVectorMultiply(velocityZ, velocityZ))));
+        const XMVECTOR emitterSpeedSigned = XMVectorSelect(emitterSpeed, XMVectorNegate(emitterSpeed), XMVectorLess(emitterDot, zero));
+
+        const XMVECTOR dopplerRatio = XMVectorDivide(XMVectorAdd(soundPropagation, listenerSpeedSigned), XMVectorAdd(soundPropagation, emitterSpeedSigned));
+        store(m_Pitches, voiceIdx, XMVectorMultiplyAdd(load(m_DopplerScales, voiceIdx), XMVectorSubtract(dopplerRatio, one), one));
+    }
+}
+
+void VoiceManager::SelectRealVoices()
+{
+    const uint32_t voiceCount = GetVoiceCount();
+    if (voiceCount <= m_MaxRealVoices) {
+        std::fill_n(m_Real.begin(), voiceCount, 1u);
+        return;
+    }
+
+    // Partition the voices by audibility, only the order between the real and the virtual voices matters
+    m_VoicesByAudibility.resize(voiceCount);
+    for (uint32_t voiceIdx = 0u; voiceIdx < voiceCount; voiceIdx += 1u) {
+        m_VoicesByAudibility[voiceIdx] = voiceIdx;
+    }
+
+    std::nth_element(m_VoicesByAudibility.begin(), m_VoicesByAudibility.begin() + m_MaxRealVoices, m_VoicesByAudibility.end(), [this](uint32_t voiceA, uint32_t voiceB) {
+        return m_Gains[voiceA] > m_Gains[voiceB];
+    });
+
+    for (uint32_t sortedIdx = 0u; sortedIdx < voiceCount; sortedIdx += 1u) {
+        m_Real[m_VoicesByAudibility[sortedIdx]] = sortedIdx < m_MaxRealVoices ? 1u : 0u;
+    }
+}
+
+void VoiceManager::GatherChanges()
+{
+    m_Changes.clear();
+    m_Stats.RealVoices = 0u;
+
+    const uint32_t voiceCount = GetVoiceCount();
+    for (uint32_t voiceIdx = 0u; voiceIdx < voiceCount; voiceIdx += 1u) {
+        VOICE_CHANGE changes = VOICE_CHANGE::NONE;
+
+        if (!m_Real[voiceIdx]) {
+            if (m_SentReal[voiceIdx]) {
+                changes = VOICE_CHANGE::VIRTUALIZED;
+                m_SentReal[voiceIdx] = 0u;
+            }
+        } else {
+            m_Stats.RealVoices += 1u;
+
+            // A voice becoming real has all of its parameters sent
+            if (!m_SentReal[voiceIdx]) {
+                m_SentGains[voiceIdx] = -1.0f;
+                m_SentPansLeft[voiceIdx] = -1.0f;
+                m_SentPansRight[voiceIdx] = -1.0f;
+                m_SentPitches[voiceIdx] = -1.0f;
+                m_SentReal[voiceIdx] = 1u;
+            }
+
+            const float gain = m_Gains[voiceIdx], sentGain = m_SentGains[voiceIdx];
+            if (std::abs(gain - sentGain) > VOICE_GAIN_THRESHOLD * std::max(gain, sentGain)) {
+                changes = changes | VOICE_CHANGE::GAIN;
+                m_SentGains[voiceIdx] = gain;
+            }
+
+            if (std::abs(m_PansLeft[voiceIdx] - m_SentPansLeft[voiceIdx]) > VOICE_PAN_THRESHOLD ||
+                std::abs(m_PansRight[voiceIdx] - m_SentPansRight[voiceIdx]) > VOICE_PAN_THRESHOLD) {
+                changes = changes | VOICE_CHANGE::PAN;
+                m_SentPansLeft[voiceIdx] = m_PansLeft[voiceIdx];
+                m_SentPansRight[voiceIdx] = m_PansRight[voiceIdx];
+            }
+
+            if (std::abs(m_Pitches[voiceIdx] - m_SentPitches[voiceIdx]) > VOICE_PITCH_THRESHOLD) {
+                changes = changes | VOICE_CHANGE::PITCH;
+                m_SentPitches[voiceIdx] = m_Pitches[voiceIdx];
+            }
+        }
+
+        if (changes != VOICE_CHANGE::NONE) {
+            m_Changes.push_back({
+                .VoiceEntity    = m_Entities[voiceIdx],
+                .Changes        = changes,
+                .Gain           = m_SentGains[voiceIdx],
+                .PanLeft        = m_SentPansLeft[voiceIdx],
+                .PanRight       = m_SentPansRight[voiceIdx],
+                .Pitch          = m_SentPitches[voiceIdx]
+            });
+        }
+    }
+
+    m_Stats.VirtualVoices = voiceCount - m_Stats.RealVoices;
+    m_Stats.ChangedVoices = (uint32_t)m_Changes.size();
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Engine/ECS/Entity.hpp>
+#include <Engine/Utils/EnumClass.hpp>
+
+#include <DirectXMath.h>
+#include <unordered_map>
+#include <vector>
+
+// Amount of voices that are mixed at a time, the least audible voices beyond this are made virtual
+#define MAX_REAL_VOICES 64u
+
+enum class VOICE_CHANGE : uint32_t {
+    NONE        = 0,
+    GAIN        = 1,
+    PAN         = GAIN << 1,
+    PITCH       = PAN << 1,
+    // The voice keeps playing silently, its parameters are not sent until it becomes real again
+    VIRTUALIZED = PITCH << 1
+};
+
+DEFINE_BITMASK_OPERATIONS(VOICE_CHANGE)
+
+// Parameters to send to the audio engine for a voice
+struct VoiceChange {
+    Entity VoiceEntity;
+    VOICE_CHANGE Changes;
+    float Gain;
+    float PanLeft, PanRight;
+    // Multiplier of the sound's base frequency
+    float Pitch;
+};
+
+struct AudioListener {
+    DirectX::XMFLOAT3 Position;
+    DirectX::XMFLOAT3 Velocity;
+    // The listener's forward direction, projected onto the horizontal plane and normalized
+    DirectX::XMFLOAT3 ForwardFlat;
+};
+
+struct VoiceManagerStats {
+    uint32_t RealVoices;
+    uint32_t VirtualVoices;
+    // Amount of voices whose parameters changed enough to be sent in the latest update
+    uint32_t ChangedVoices;
+    // Time spent in the latest update, in milliseconds
+    float UpdateTime;
+};
+
+/*  Computes distance attenuation, stereo pan and Doppler shift for every voice in a single pass. The emitters are stored
+    as a structure of arrays, padded to a multiple of four, and processed four at a time using DirectXMath's vectors.
+    Only the MAX_REAL_VOICES most audible voices are kept real. Parameters are only sent when they differ noticeably
+    from what was last sent, which keeps calls into the audio engine to a minimum. */
+class VoiceManager
+{
+public:
+    VoiceManager(uint32_t maxRealVoices = MAX_REAL_VOICES);
+    ~VoiceManager() = default;
+
+    void AddVoice(Entity entity);
+    void RemoveVoice(Entity entity);
+    // Sends all of the voice's parameters in the next update, used when the voice's channel has been replaced
+    void ResendVoice(Entity entity);
+
+    inline uint32_t GetVoiceCount() const                       { return (uint32_t)m_Entities.size(); }
+    inline const std::vector<Entity>& GetVoiceEntities() const  { return m_Entities; }
+    // Doppler is only applied to moving emitters, pVelocity is null for emitters without a velocity
+    void SetEmitter(uint32_t voiceIdx, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3* pVelocity, float volume);
+
+    // Computes the voices' parameters, selects the real voices and gathers the changes to send
+    void Update(const AudioListener& listener);
+
+    inline const std::vector<VoiceChange>& GetChanges() const   { return m_Changes; }
+    inline const VoiceManagerStats& GetStats() const            { return m_Stats; }
+
+private:
+    // Resizes the emitter arrays to fit the voices, padded to a multiple of the vector width
+    void ResizeArrays(uint32_t voiceCount);
+    void ComputeVoiceParameters(const AudioListener& listener);
+    // Marks the most audible voices as real
+    void SelectRealVoices();
+    void GatherChanges();
+
+private:
+    uint32_t m_MaxRealVoices;
+
+    std::vector<Entity> m_Entities;
+    std::unordered_map<Entity, uint32_t> m_EntityToVoice;
+
+    // Emitter inputs
+    std::vector<float> m_PositionsX, m_PositionsY, m_PositionsZ;
+    std::vector<float> m_VelocitiesX, m_VelocitiesY, m_VelocitiesZ;
+    std::vector<float> m_Volumes;
+    // 1 for moving emitters, 0 for static ones
+    std::vector<float> m_DopplerScales;
+
+    // Computed parameters
+    std::vector<float> m_Gains;
+    std::vector<float> m_PansLeft, m_PansRight;
+    std::vector<float> m_Pitches;
+    std::vector<uint8_t> m_Real;
+
+    // The parameters that were last sent. Negative values force the parameters to be sent.
+    std::vector<float> m_SentGains;
+    std::vector<float> m_SentPansLeft, m_SentPansRight;
+    std::vector<float> m_SentPitches;
+    std::vector<uint8_t> m_SentReal;
+
+    std::vector<uint32_t> m_VoicesByAudibility;
+    std::vector<VoiceChange> m_Changes;
+
+    VoiceManagerStats m_Stats;
+};
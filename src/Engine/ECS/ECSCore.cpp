@@ -1,5 +1,7 @@
 #include "ECSCore.hpp"
 
+#include "Engine/Utils/Profiler.hpp"
+
 ECSCore* ECSCore::s_pInstance = nullptr;
 
 ECSCore::ECSCore() :
@@ -10,6 +12,7 @@ void ECSCore::Update(float deltaTime)
 {
 	m_DeltaTime = deltaTime;
 	PerformComponentRegistrations();
+	PerformComponentReplacements();
 	PerformComponentDeletions();
 	PerformEntityDeletions();
 	m_JobScheduler.Update(deltaTime);
@@ -194,6 +197,8 @@ bool ECSCore::DeserializeEntity(const uint8_t* pBuffer)
 
 void ECSCore::PerformComponentRegistrations()
 {
+	const ProfileZone profileZone("Component registrations");
+
 	// Register all components first, then publish them
 	for (const std::pair<Entity, const ComponentType*>& component : m_ComponentsToRegister) {
 		m_EntityRegistry.RegisterComponentType(component.first, component.second);
@@ -207,8 +212,38 @@ void ECSCore::PerformComponentRegistrations()
 	m_ComponentsToRegister.clear();
 }
 
+void ECSCore::PerformComponentReplacements()
+{
+	const ProfileZone profileZone("Component replacements");
+
+	// Replacements can be enqueued by threads outside of the job scheduler, e.g. asset loading threads
+	std::vector<ComponentReplacement> componentsToReplace;
+	{
+		std::scoped_lock<std::mutex> lock(m_LockReplaceComponent);
+		componentsToReplace.swap(m_ComponentsToReplace);
+	}
+
+	for (const ComponentReplacement& replacement : componentsToReplace) {
+		// The component might have been deleted since the replacement was enqueued
+		const IComponentArray* pComponentArray = m_ComponentStorage.GetComponentArray(replacement.pComponentType);
+		if (!pComponentArray || !pComponentArray->HasComponent(replacement.Entity)) {
+			continue;
+		}
+
+		m_EntityRegistry.DeregisterComponentType(replacement.Entity, replacement.pComponentType);
+		m_EntityPublisher.UnpublishComponent(replacement.Entity, replacement.pComponentType);
+
+		replacement.Overwrite();
+
+		m_EntityRegistry.RegisterComponentType(replacement.Entity, replacement.pComponentType);
+		m_EntityPublisher.PublishComponent(replacement.Entity, replacement.pComponentType);
+	}
+}
+
 void ECSCore::PerformComponentDeletions()
 {
+	const ProfileZone profileZone("Component deletions");
+
 	for (const std::pair<Entity, const ComponentType*>& component : m_ComponentsToDelete) {
 		if (DeleteComponent(component.first, component.second)) {
 			// If the entity has no more components, delete it
@@ -225,6 +260,8 @@ void ECSCore::PerformComponentDeletions()
 
 void ECSCore::PerformEntityDeletions()
 {
+	const ProfileZone profileZone("Entity deletions");
+
 	const EntityRegistryPage& registryPage = m_EntityRegistry.GetTopRegistryPage();
 	/*	The component types to delete of each entity. It is a copy of the entity's set of component types in
 		the entity registry. Copying the set is necessary as the set is popped each time it is iterated. */
@@ -20,6 +20,14 @@ struct EntitySerializationHeader
 };
 #pragma pack(pop)
 
+struct ComponentReplacement
+{
+	Entity Entity;
+	const ComponentType* pComponentType;
+	// Overwrites the stored component with the replacement
+	std::function<void()> Overwrite;
+};
+
 class ECSCore
 {
 public:
@@ -73,6 +81,11 @@ public:
 	template<typename Comp>
 	void RemoveComponent(Entity entity);
 
+	/*	ReplaceComponent enqueues overwriting an existing component, which is performed at the end of the current/next frame.
+		Subscribers are notified of the component's removal and re-addition, letting them recreate resources derived from it. */
+	template<typename Comp>
+	void ReplaceComponent(Entity entity, const Comp& component);
+
 	// RemoveEntity enqueues the removal of an entity, which is performed at the end of the current/next frame.
 	void RemoveEntity(Entity entity);
 
@@ -112,6 +125,7 @@ public:
 	bool DeserializeEntity(const uint8_t* pBuffer);
 
 	void PerformComponentRegistrations();
+	void PerformComponentReplacements();
 	void PerformComponentDeletions();
 	void PerformEntityDeletions();
 
@@ -142,10 +156,11 @@ private:
 	std::unordered_set<Entity> m_EntitiesToDelete;
 	std::vector<std::pair<Entity, const ComponentType*>> m_ComponentsToDelete;
 	std::vector<std::pair<Entity, const ComponentType*>> m_ComponentsToRegister;
+	std::vector<ComponentReplacement> m_ComponentsToReplace;
 
 	float m_DeltaTime;
 
-	std::mutex m_LockAddComponent, m_LockRemoveComponent, m_LockRemoveEntity;
+	std::mutex m_LockAddComponent, m_LockRemoveComponent, m_LockReplaceComponent, m_LockRemoveEntity;
 
 private:
 	static ECSCore* s_pInstance;
@@ -202,6 +217,17 @@ inline const ComponentArray<Comp>* ECSCore::GetComponentArray() const
 	return m_ComponentStorage.GetComponentArray<Comp>();
 }
 
+template<typename Comp>
+inline void ECSCore::ReplaceComponent(Entity entity, const Comp& component)
+{
+	std::scoped_lock<std::mutex> lock(m_LockReplaceComponent);
+	m_ComponentsToReplace.push_back({
+		.Entity = entity,
+		.pComponentType = Comp::Type(),
+		.Overwrite = [this, entity, component]() { m_ComponentStorage.GetComponent<Comp>(entity) = component; }
+	});
+}
+
 template<typename Comp>
 inline void ECSCore::RemoveComponent(Entity entity)
 {
@@ -9,6 +9,8 @@ struct Job
 {
 	std::vector<ComponentAccess> Components;
 	std::function<void()> Function;
+	// Shown in profiles, null for unnamed jobs. Must outlive the job.
+	const char* pName;
 };
 
 struct RegularJob : Job
@@ -2,6 +2,7 @@
 
 #include "Engine/ECS/ECSCore.hpp"
 #include "Engine/ECS/EntitySubscriber.hpp"
+#include "Engine/Utils/Profiler.hpp"
 #include "Engine/Utils/ThreadPool.hpp"
 
 #include <numeric>
@@ -176,7 +177,11 @@ bool JobScheduler::CanExecuteRegularJob(const RegularJob& job) const
 
 void JobScheduler::ExecuteJob(Job job)
 {
-    job.Function();
+    {
+        const ProfileZone profileZone(job.pName ? job.pName : "Unnamed job");
+        job.Function();
+    }
+
     m_Lock.lock();
     DeregisterJobExecution(job);
     m_Lock.unlock();
@@ -25,6 +25,7 @@ void RegularWorker::ScheduleRegularWork(const RegularWorkInfo& regularWorkInfo)
 	const RegularJob regularJob = {
 		/* Components */	RegularWorker::GetUniqueComponentAccesses(regularWorkInfo.EntitySubscriberRegistration),
 		/* Function */		std::bind(&RegularWorker::Update, this),
+		/* pName */			regularWorkInfo.pName,
 		/* TickPeriod */	m_TickPeriod,
 		/* Accumulator */	0.0f
 	};
@@ -8,6 +8,8 @@ struct RegularWorkInfo {
 	EntitySubscriberRegistration EntitySubscriberRegistration;
 	uint32_t Phase;
 	float TickPeriod;
+	// Names the regular job in profiles
+	const char* pName;
 };
 
 // RegularWorker schedules a regular job and deregisters it upon destruction
@@ -8,7 +8,8 @@ void System::RegisterSystem(const std::string& systemName, SystemRegistration& s
         .TickFunction = std::bind_front(&System::Update, this),
         .EntitySubscriberRegistration = systemRegistration.SubscriberRegistration,
         .Phase = systemRegistration.Phase,
-        .TickPeriod = systemRegistration.TickFrequency == 0 ? 0.0f : 1.0f / systemRegistration.TickFrequency
+        .TickPeriod = systemRegistration.TickFrequency == 0 ? 0.0f : 1.0f / systemRegistration.TickFrequency,
+        .pName = m_SystemName.c_str()
     };
 
     SubscribeToEntities(systemRegistration.SubscriberRegistration);
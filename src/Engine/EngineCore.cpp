@@ -23,20 +23,22 @@ EngineCore::~EngineCore()
     delete m_pRenderingCore;
 }
 
-bool EngineCore::Init()
+bool EngineCore::Init(RuntimeStats* pRuntimeStats)
 {
     EngineConfig engineCFG;
     if (!LoadEngineConfig(engineCFG)) {
         return false;
     }
 
+    pRuntimeStats->setHitchThresholds(engineCFG.HitchThresholds);
+
     m_pRenderingCore = DBG_NEW RenderingCore();
     if (!m_pRenderingCore->Init(engineCFG)) {
         return false;
     }
 
     m_pPhysicsCore  = DBG_NEW PhysicsCore();
-    m_pAssetLoaders = DBG_NEW AssetLoadersCore(m_pRenderingCore);
+    m_pAssetLoaders = DBG_NEW AssetLoadersCore(m_pRenderingCore, engineCFG);
 
     m_pUICore = DBG_NEW UICore(m_pRenderingCore);
     if (!m_pUICore->Init()) {
@@ -44,7 +46,7 @@ bool EngineCore::Init()
     }
 
     m_pAudioCore = DBG_NEW AudioCore();
-    return m_pAudioCore->Init();
+    return m_pAudioCore->Init(engineCFG);
 }
 
 bool EngineCore::LoadEngineConfig(EngineConfig& engineConfig) const
@@ -52,6 +54,18 @@ bool EngineCore::LoadEngineConfig(EngineConfig& engineConfig) const
     // Default config
     engineConfig.RenderingAPI       = RENDERING_API::VULKAN;
     engineConfig.PresentationMode   = PRESENTATION_MODE::MAILBOX;
+    engineConfig.IndirectMeshDrawing = false;
+    engineConfig.BindlessMaterials  = false;
+    engineConfig.PackedVertices     = false;
+    engineConfig.MeshLODs           = true;
+    engineConfig.TextureFormat      = RESOURCE_FORMAT::R8G8B8A8_UNORM;
+    engineConfig.AssetMemoryBudget  = 256u * 1024u * 1024u;
+    engineConfig.HitchThresholds    = { 1.0f / 30.0f, 1.0f / 20.0f, 1.0f / 10.0f };
+    #ifdef AUDIO_FMOD
+        engineConfig.AudioBackend   = AUDIO_BACKEND::FMOD;
+    #else
+        engineConfig.AudioBackend   = AUDIO_BACKEND::SOFTWARE;
+    #endif
 
     using json = nlohmann::json;
 
@@ -84,5 +98,73 @@ bool EngineCore::LoadEngineConfig(EngineConfig& engineConfig) const
         engineConfig.PresentationMode = PRESENTATION_MODE::IMMEDIATE;
     }
 
+    if (configJSON.contains("IndirectMeshDrawing")) {
+        engineConfig.IndirectMeshDrawing = configJSON["IndirectMeshDrawing"].get<bool>();
+    }
+
+    if (configJSON.contains("BindlessMaterials")) {
+        engineConfig.BindlessMaterials = configJSON["BindlessMaterials"].get<bool>();
+    }
+
+    if (configJSON.contains("PackedVertices")) {
+        engineConfig.PackedVertices = configJSON["PackedVertices"].get<bool>();
+    }
+
+    if (configJSON.contains("MeshLODs")) {
+        engineConfig.MeshLODs = configJSON["MeshLODs"].get<bool>();
+    }
+
+    if (configJSON.contains("TextureCompression")) {
+        std::string compressionStr = configJSON["TextureCompression"].get<std::string>();
+        std::transform(compressionStr.begin(), compressionStr.end(), compressionStr.begin(),
+            [](unsigned char c){ return (char)std::tolower(c); });
+
+        const std::unordered_map<std::string, RESOURCE_FORMAT> compressionFormats = {
+            {"bc1", RESOURCE_FORMAT::BC1_UNORM},
+            {"bc3", RESOURCE_FORMAT::BC3_UNORM},
+            {"bc7", RESOURCE_FORMAT::BC7_UNORM}
+        };
+
+        const auto formatItr = compressionFormats.find(compressionStr);
+        if (formatItr != compressionFormats.end()) {
+            engineConfig.TextureFormat = formatItr->second;
+        } else if (compressionStr != "none") {
+            LOG_WARNINGF("Unknown texture compression: %s, textures are left uncompressed", compressionStr.c_str());
+        }
+    }
+
+    if (configJSON.contains("AssetMemoryBudgetMB")) {
+        engineConfig.AssetMemoryBudget = configJSON["AssetMemoryBudgetMB"].get<size_t>() * 1024u * 1024u;
+    }
+
+    if (configJSON.contains("AudioBackend")) {
+        std::string backendStr = configJSON["AudioBackend"].get<std::string>();
+        std::transform(backendStr.begin(), backendStr.end(), backendStr.begin(),
+            [](unsigned char c){ return (char)std::tolower(c); });
+
+        if (backendStr == "software") {
+            engineConfig.AudioBackend = AUDIO_BACKEND::SOFTWARE;
+        } else if (backendStr == "fmod") {
+            engineConfig.AudioBackend = AUDIO_BACKEND::FMOD;
+        } else {
+            LOG_WARNINGF("Unknown audio backend: %s", backendStr.c_str());
+        }
+    }
+
+    if (configJSON.contains("AudioOutput")) {
+        engineConfig.AudioOutputPath = configJSON["AudioOutput"].get<std::string>();
+    }
+
+    if (configJSON.contains("HitchThresholdsMS")) {
+        engineConfig.HitchThresholds.clear();
+        for (const float thresholdMS : configJSON["HitchThresholdsMS"].get<std::vector<float>>()) {
+            if (thresholdMS > 0.0f) {
+                engineConfig.HitchThresholds.push_back(thresholdMS / 1000.0f);
+            } else {
+                LOG_WARNINGF("Ignoring hitch threshold: %.2f ms, thresholds must be positive", thresholdMS);
+            }
+        }
+    }
+
     return true;
 }
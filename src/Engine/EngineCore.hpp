@@ -5,6 +5,7 @@ class AssetLoadersCore;
 class UICore;
 class RenderingCore;
 class AudioCore;
+class RuntimeStats;
 
 struct EngineConfig;
 
@@ -14,7 +15,7 @@ public:
     EngineCore();
     ~EngineCore();
 
-    bool Init();
+    bool Init(RuntimeStats* pRuntimeStats);
 
     PhysicsCore* GetPhysicsCore()           { return m_pPhysicsCore; }
     AssetLoadersCore* GetAssetLoadersCore() { return m_pAssetLoaders; }
@@ -1,6 +1,7 @@
 #include "IGame.hpp"
 
 #include <Engine/Utils/Debug.hpp>
+#include <Engine/Utils/Profiler.hpp>
 
 IGame::IGame()
     :m_pRenderingHandler(nullptr)
@@ -22,17 +23,29 @@ IGame::~IGame()
 
 bool IGame::Init()
 {
+    m_InitStartTime = std::chrono::high_resolution_clock::now();
+
     EngineCore::SetInstance(&m_EngineCore);
-    if (!m_EngineCore.Init()) {
+    if (!m_EngineCore.Init(&m_RuntimeStats)) {
         return false;
     }
 
     RenderingCore* pRenderingCore = m_EngineCore.GetRenderingCore();
-    m_pRenderingHandler = DBG_NEW RenderingHandler(m_EngineCore.GetRenderingCore());
+    m_pRenderingHandler = DBG_NEW RenderingHandler(m_EngineCore.GetRenderingCore(), m_EngineCore.GetUICore());
     if (!m_pRenderingHandler->Init()) {
         return false;
     }
 
+    // The UI handler's and the renderers' pipelines have been compiling in parallel since they were created
+    auto pipelineWaitStart = std::chrono::high_resolution_clock::now();
+    if (!pRenderingCore->GetDevice()->waitForPipelines()) {
+        LOG_ERROR("Failed to compile pipelines");
+        return false;
+    }
+
+    std::chrono::duration<float, std::milli> pipelineWaitTime = std::chrono::high_resolution_clock::now() - pipelineWaitStart;
+    m_RuntimeStats.setPipelineWaitTime(pipelineWaitTime.count());
+
     pRenderingCore->GetWindow()->show();
 
     return true;
@@ -47,6 +60,7 @@ void IGame::Run()
     Window* pWindow = m_EngineCore.GetRenderingCore()->GetWindow();
 
     while (!pWindow->shouldClose()) {
+        const ProfileZone frameZone("Frame");
         pWindow->pollEvents();
 
         timeNow = std::chrono::high_resolution_clock::now();
@@ -59,9 +73,28 @@ void IGame::Run()
         pWindow->GetInputHandler()->update();
 
         // Update logic
-        m_ECS.Update(dt);
-        m_StateManager.Update(dt);
-
-        m_pRenderingHandler->render();
+        {
+            const ProfileZone profileZone("ECS update");
+            m_ECS.Update(dt);
+        }
+
+        {
+            const ProfileZone profileZone("State update");
+            m_StateManager.Update(dt);
+        }
+
+        // Evict the assets released during the update while over the asset memory budget
+        m_EngineCore.GetAssetLoadersCore()->GetResidencyManager()->Trim();
+
+        {
+            const ProfileZone profileZone("Render");
+            m_pRenderingHandler->render();
+        }
+
+        if (m_RuntimeStats.getStartupTime() == 0.0f) {
+            std::chrono::duration<float, std::milli> startupTime = std::chrono::high_resolution_clock::now() - m_InitStartTime;
+            m_RuntimeStats.setStartupTime(startupTime.count());
+            LOG_INFOF("Startup time to first frame: %.2f ms, of which %.2f ms waiting for pipelines", startupTime.count(), m_RuntimeStats.getPipelineWaitTime());
+        }
     }
 }
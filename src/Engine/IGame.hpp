@@ -18,6 +18,23 @@ namespace argh {
 struct EngineConfig {
     RENDERING_API RenderingAPI;
     PRESENTATION_MODE PresentationMode;
+    // Draw meshes using indirect draw calls, reading per-object data from storage buffers
+    bool IndirectMeshDrawing;
+    // Index all materials from a single descriptor set when drawing indirectly
+    bool BindlessMaterials;
+    // Upload mesh vertices with octahedral snorm16 normals and half float texture coordinates
+    bool PackedVertices;
+    // Draw simplified levels of detail of meshes covering little of the screen
+    bool MeshLODs;
+    // Format textures are cooked and uploaded in, either R8G8B8A8_UNORM or a block compressed format
+    RESOURCE_FORMAT TextureFormat;
+    // Bytes of textures and meshes kept loaded after their last user has released them
+    size_t AssetMemoryBudget;
+    AUDIO_BACKEND AudioBackend;
+    // Optional, WAV file that the software audio backend writes its output to
+    std::string AudioOutputPath;
+    // Frame times in seconds above which frames are counted as hitches
+    std::vector<float> HitchThresholds;
 };
 
 class IGame
@@ -38,6 +55,7 @@ protected:
     StateManager m_StateManager;
 
     RuntimeStats m_RuntimeStats;
+    std::chrono::high_resolution_clock::time_point m_InitStartTime;
 
     EngineCore m_EngineCore;
 
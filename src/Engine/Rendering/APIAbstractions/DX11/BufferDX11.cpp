@@ -5,7 +5,8 @@
 #include <Engine/Utils/Logger.hpp>
 
 BufferDX11::BufferDX11(ID3D11Device* pDevice, const BufferInfo& bufferInfo)
-    :m_pBuffer(nullptr)
+    :m_pBuffer(nullptr),
+    m_pSRV(nullptr)
 {
     // The size of DirectX 11 constant buffers needs to be a multiple of 16
     UINT byteSize = (UINT)bufferInfo.ByteSize;
@@ -42,6 +43,16 @@ BufferDX11::BufferDX11(ID3D11Device* pDevice, const BufferInfo& bufferInfo)
         case BUFFER_USAGE::STAGING_BUFFER:
             bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
             break;
+        case BUFFER_USAGE::STORAGE_BUFFER:
+            bufferDesc.BindFlags            = D3D11_BIND_SHADER_RESOURCE;
+            bufferDesc.MiscFlags            = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+            bufferDesc.StructureByteStride  = bufferInfo.StructureStride;
+            break;
+        case BUFFER_USAGE::INDIRECT_BUFFER:
+            // Dynamic buffers require a bind flag, even though the argument buffer is not bound to any shader
+            bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+            bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+            break;
         default:
             LOG_ERRORF("Invalid buffer usage flag: %d", bufferInfo.Usage);
             return;
@@ -49,8 +60,6 @@ BufferDX11::BufferDX11(ID3D11Device* pDevice, const BufferInfo& bufferInfo)
 
     bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ * HAS_FLAG(bufferInfo.CPUAccess, BUFFER_DATA_ACCESS::READ)
                             | D3D11_CPU_ACCESS_WRITE * HAS_FLAG(bufferInfo.CPUAccess, BUFFER_DATA_ACCESS::WRITE);
-    bufferDesc.MiscFlags = 0;
-    bufferDesc.StructureByteStride = 0;
 
     D3D11_SUBRESOURCE_DATA bufferData;
     bufferData.pSysMem = bufferInfo.pData;
@@ -60,10 +69,25 @@ BufferDX11::BufferDX11(ID3D11Device* pDevice, const BufferInfo& bufferInfo)
     HRESULT hr = pDevice->CreateBuffer(&bufferDesc, bufferInfo.pData ? &bufferData : nullptr, &m_pBuffer);
     if (FAILED(hr)) {
         LOG_WARNINGF("Failed to create buffer: %s", hresultToString(hr).c_str());
+        return;
+    }
+
+    if (bufferInfo.Usage == BUFFER_USAGE::STORAGE_BUFFER) {
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format              = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension       = D3D11_SRV_DIMENSION_BUFFER;
+        srvDesc.Buffer.FirstElement = 0u;
+        srvDesc.Buffer.NumElements  = byteSize / bufferInfo.StructureStride;
+
+        hr = pDevice->CreateShaderResourceView(m_pBuffer, &srvDesc, &m_pSRV);
+        if (FAILED(hr)) {
+            LOG_WARNINGF("Failed to create storage buffer SRV: %s", hresultToString(hr).c_str());
+        }
     }
 }
 
 BufferDX11::~BufferDX11()
 {
+    SAFERELEASE(m_pSRV)
     SAFERELEASE(m_pBuffer)
 }
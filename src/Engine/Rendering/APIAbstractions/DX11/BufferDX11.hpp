@@ -5,6 +5,7 @@
 
 struct ID3D11Buffer;
 struct ID3D11Device;
+struct ID3D11ShaderResourceView;
 
 class BufferDX11 : public IBuffer
 {
@@ -13,7 +14,10 @@ public:
     ~BufferDX11();
 
     ID3D11Buffer* getBuffer() { return m_pBuffer; }
+    // Only storage buffers have shader resource views
+    ID3D11ShaderResourceView* getSRV() { return m_pSRV; }
 
 private:
     ID3D11Buffer* m_pBuffer;
+    ID3D11ShaderResourceView* m_pSRV;
 };
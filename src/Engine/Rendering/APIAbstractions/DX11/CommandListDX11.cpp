@@ -155,9 +155,18 @@ void CommandListDX11::draw(size_t vertexCount)
     m_pContext->Draw((UINT)vertexCount, 0);
 }
 
-void CommandListDX11::drawIndexed(size_t indexCount)
+void CommandListDX11::drawIndexed(size_t indexCount, size_t firstIndex)
 {
-    m_pContext->DrawIndexed((UINT)indexCount, 0, 0);
+    m_pContext->DrawIndexed((UINT)indexCount, (UINT)firstIndex, 0);
+}
+
+void CommandListDX11::drawIndexedIndirect(IBuffer* pArgumentBuffer, size_t offset, uint32_t drawCount, uint32_t stride)
+{
+    // DirectX 11 has no multi-draw indirect
+    ID3D11Buffer* pBufferDX = reinterpret_cast<BufferDX11*>(pArgumentBuffer)->getBuffer();
+    for (uint32_t drawIdx = 0u; drawIdx < drawCount; drawIdx += 1u) {
+        m_pContext->DrawIndexedInstancedIndirect(pBufferDX, (UINT)(offset + drawIdx * stride));
+    }
 }
 
 void CommandListDX11::copyBuffer(IBuffer* pSrc, IBuffer* pDst, size_t byteSize)
@@ -165,22 +174,26 @@ void CommandListDX11::copyBuffer(IBuffer* pSrc, IBuffer* pDst, size_t byteSize)
     BufferDX11* pSrcDX = reinterpret_cast<BufferDX11*>(pSrc);
     BufferDX11* pDstDX = reinterpret_cast<BufferDX11*>(pDst);
 
-    copyResource(pSrcDX->getBuffer(), pDstDX->getBuffer(), (UINT)byteSize, 0u);
+    copyResource(pSrcDX->getBuffer(), pDstDX->getBuffer(), (UINT)byteSize, 0u, 0u, 0u);
 }
 
-void CommandListDX11::copyBufferToTexture(IBuffer* pBuffer, Texture* pTexture, uint32_t width, uint32_t height)
+void CommandListDX11::copyBufferToTexture(IBuffer* pBuffer, Texture* pTexture, const TextureCopyRegion* pRegions, uint32_t regionCount)
 {
     ID3D11Resource* pBufferResource = reinterpret_cast<BufferDX11*>(pBuffer)->getBuffer();
     ID3D11Resource* pTextureResource = reinterpret_cast<TextureDX11*>(pTexture)->getResource();
 
-    copyResource(pBufferResource, pTextureResource, (UINT)width, (UINT)height);
+    for (uint32_t regionIdx = 0u; regionIdx < regionCount; regionIdx += 1u) {
+        const TextureCopyRegion& region = pRegions[regionIdx];
+        copyResource(pBufferResource, pTextureResource, (UINT)region.Extent.x, (UINT)region.Extent.y, (UINT)region.BufferOffset, (UINT)region.MipLevel);
+    }
 }
 
-void CommandListDX11::copyResource(ID3D11Resource* pSrc, ID3D11Resource* pDst, UINT width, UINT height)
+void CommandListDX11::copyResource(ID3D11Resource* pSrc, ID3D11Resource* pDst, UINT width, UINT height, UINT srcOffset, UINT dstSubresource)
 {
     D3D11_BOX srcBox = {};
-    srcBox.right    = width;
+    srcBox.left     = srcOffset;
+    srcBox.right    = srcOffset + width;
     srcBox.bottom   = height;
 
-    m_pContext->CopySubresourceRegion(pDst, 0u, 0u, 0u, 0u, pSrc, 0u, &srcBox);
+    m_pContext->CopySubresourceRegion(pDst, dstSubresource, 0u, 0u, 0u, pSrc, 0u, &srcBox);
 }
@@ -41,7 +41,8 @@ public:
     void bindScissor(const Rectangle2D& scissorRectangle) override final;
 
     void draw(size_t vertexCount) override final;
-    void drawIndexed(size_t indexCount) override final;
+    void drawIndexed(size_t indexCount, size_t firstIndex) override final;
+    void drawIndexedIndirect(IBuffer* pArgumentBuffer, size_t offset, uint32_t drawCount, uint32_t stride) override final;
 
     void convertTextureLayout(TEXTURE_LAYOUT oldLayout, TEXTURE_LAYOUT newLayout, Texture* pTexture, PIPELINE_STAGE srcStage, PIPELINE_STAGE dstStage) override final
     {
@@ -53,12 +54,12 @@ public:
     }
 
     void copyBuffer(IBuffer* pSrc, IBuffer* pDst, size_t byteSize) override final;
-    void copyBufferToTexture(IBuffer* pBuffer, Texture* pTexture, uint32_t width, uint32_t height) override final;
+    void copyBufferToTexture(IBuffer* pBuffer, Texture* pTexture, const TextureCopyRegion* pRegions, uint32_t regionCount) override final;
 
     ID3D11CommandList* getCommandList() { return m_pCommandList; }
 
 private:
-    void copyResource(ID3D11Resource* pSrc, ID3D11Resource* pDst, UINT width, UINT height);
+    void copyResource(ID3D11Resource* pSrc, ID3D11Resource* pDst, UINT width, UINT height, UINT srcOffset, UINT dstSubresource);
 
 private:
     // Deferred context
@@ -24,6 +24,20 @@ void DescriptorSetDX11::updateUniformBufferDescriptor(SHADER_BINDING binding, IB
     m_BufferBindings.push_back(bufferBinding);
 }
 
+void DescriptorSetDX11::updateStorageBufferDescriptor(SHADER_BINDING binding, IBuffer* pBuffer)
+{
+    BufferDX11* pBufferDX = reinterpret_cast<BufferDX11*>(pBuffer);
+    const DescriptorSetLayoutDX11* pDescriptorSetLayoutDX = reinterpret_cast<const DescriptorSetLayoutDX11*>(m_pLayout);
+
+    Binding<ID3D11ShaderResourceView*> storageBufferBinding = {
+        .Resource       = pBufferDX->getSRV(),
+        .Binding        = (UINT)binding,
+        .ShaderStages   = pDescriptorSetLayoutDX->getBindingShaderStages((uint32_t)binding)
+    };
+
+    m_StorageBufferBindings.push_back(storageBufferBinding);
+}
+
 void DescriptorSetDX11::updateCombinedTextureSamplerDescriptor(SHADER_BINDING binding, Texture* pTexture, ISampler* pSampler)
 {
     TextureDX11* pTextureDX = reinterpret_cast<TextureDX11*>(pTexture);
@@ -39,6 +53,21 @@ void DescriptorSetDX11::updateCombinedTextureSamplerDescriptor(SHADER_BINDING bi
     m_CombinedTextureSamplerBindings.push_back(combinedTextureSamplerBinding);
 }
 
+void DescriptorSetDX11::updateCombinedTextureSamplerArrayDescriptor(SHADER_BINDING binding, uint32_t arrayIndex, Texture* pTexture, ISampler* pSampler)
+{
+    TextureDX11* pTextureDX = reinterpret_cast<TextureDX11*>(pTexture);
+    SamplerDX11* pSamplerDX = reinterpret_cast<SamplerDX11*>(pSampler);
+    const DescriptorSetLayoutDX11* pDescriptorSetLayoutDX = reinterpret_cast<const DescriptorSetLayoutDX11*>(m_pLayout);
+
+    Binding<std::pair<ID3D11ShaderResourceView*, ID3D11SamplerState*>> combinedTextureSamplerBinding = {
+        .Resource       = { pTextureDX->getSRV(), pSamplerDX->getSamplerState() },
+        .Binding        = (UINT)binding + arrayIndex,
+        .ShaderStages   = pDescriptorSetLayoutDX->getBindingShaderStages((uint32_t)binding)
+    };
+
+    m_CombinedTextureSamplerBindings.push_back(combinedTextureSamplerBinding);
+}
+
 void DescriptorSetDX11::bind(ID3D11DeviceContext* pContext)
 {
     for (const Binding<ID3D11Buffer*>& bufferBinding : m_BufferBindings) {
@@ -51,6 +80,16 @@ void DescriptorSetDX11::bind(ID3D11DeviceContext* pContext)
         )
     }
 
+    for (const Binding<ID3D11ShaderResourceView*>& storageBufferBinding : m_StorageBufferBindings) {
+        ACTION_PER_CONTAINED_SHADER(storageBufferBinding.ShaderStages,
+            pContext->VSSetShaderResources(storageBufferBinding.Binding, 1, &storageBufferBinding.Resource),
+            pContext->HSSetShaderResources(storageBufferBinding.Binding, 1, &storageBufferBinding.Resource),
+            pContext->DSSetShaderResources(storageBufferBinding.Binding, 1, &storageBufferBinding.Resource),
+            pContext->GSSetShaderResources(storageBufferBinding.Binding, 1, &storageBufferBinding.Resource),
+            pContext->PSSetShaderResources(storageBufferBinding.Binding, 1, &storageBufferBinding.Resource)
+        )
+    }
+
     for (const Binding<std::pair<ID3D11ShaderResourceView*, ID3D11SamplerState*>>& combinedTextureSamplerBinding : m_CombinedTextureSamplerBindings) {
         if (HAS_FLAG(combinedTextureSamplerBinding.ShaderStages, SHADER_TYPE::VERTEX_SHADER)) {
             pContext->VSSetShaderResources(combinedTextureSamplerBinding.Binding, 1, &combinedTextureSamplerBinding.Resource.first);
@@ -24,11 +24,15 @@ public:
     ~DescriptorSetDX11() = default;
 
     void updateUniformBufferDescriptor(SHADER_BINDING binding, IBuffer* pBuffer) override final;
+    void updateStorageBufferDescriptor(SHADER_BINDING binding, IBuffer* pBuffer) override final;
     void updateCombinedTextureSamplerDescriptor(SHADER_BINDING binding, Texture* pTexture, ISampler* pSampler) override final;
+    void updateCombinedTextureSamplerArrayDescriptor(SHADER_BINDING binding, uint32_t arrayIndex, Texture* pTexture, ISampler* pSampler) override final;
 
     void bind(ID3D11DeviceContext* pContext);
 
 private:
     std::vector<Binding<ID3D11Buffer*>> m_BufferBindings;
+    // Storage buffers are bound as structured buffer SRVs
+    std::vector<Binding<ID3D11ShaderResourceView*>> m_StorageBufferBindings;
     std::vector<Binding<std::pair<ID3D11ShaderResourceView*, ID3D11SamplerState*>>> m_CombinedTextureSamplerBindings;
 };
@@ -7,6 +7,13 @@ void DescriptorSetLayoutDX11::addBindingUniformBuffer(SHADER_BINDING binding, SH
     m_UniformBufferSlots.push_back({bindingU, shaderStages});
 }
 
+void DescriptorSetLayoutDX11::addBindingStorageBuffer(SHADER_BINDING binding, SHADER_TYPE shaderStages)
+{
+    uint32_t bindingU = (uint32_t)binding;
+    m_BindingShaderMap[bindingU] = shaderStages;
+    m_StorageBufferSlots.push_back({bindingU, shaderStages});
+}
+
 void DescriptorSetLayoutDX11::addBindingCombinedTextureSampler(SHADER_BINDING binding, SHADER_TYPE shaderStages)
 {
     uint32_t bindingU = (uint32_t)binding;
@@ -14,11 +21,22 @@ void DescriptorSetLayoutDX11::addBindingCombinedTextureSampler(SHADER_BINDING bi
     m_CombinedTextureSamplerSlots.push_back({bindingU, shaderStages});
 }
 
+void DescriptorSetLayoutDX11::addBindingCombinedTextureSamplerArray(SHADER_BINDING binding, SHADER_TYPE shaderStages, uint32_t descriptorCount)
+{
+    // Each array element occupies its own slot, following the array's first slot
+    uint32_t bindingU = (uint32_t)binding;
+    m_BindingShaderMap[bindingU] = shaderStages;
+    for (uint32_t arrayIndex = 0u; arrayIndex < descriptorCount; arrayIndex += 1u) {
+        m_CombinedTextureSamplerSlots.push_back({bindingU + arrayIndex, shaderStages});
+    }
+}
+
 bool DescriptorSetLayoutDX11::finalize(Device* pDevice)
 {
     UNREFERENCED_VARIABLE(pDevice);
 
     m_UniformBufferSlots.shrink_to_fit();
+    m_StorageBufferSlots.shrink_to_fit();
     m_CombinedTextureSamplerSlots.shrink_to_fit();
     return true;
 }
@@ -27,6 +45,7 @@ DescriptorCounts DescriptorSetLayoutDX11::getDescriptorCounts() const
 {
     DescriptorCounts descriptorCounts = {};
     descriptorCounts.m_UniformBuffers           = (uint32_t)m_UniformBufferSlots.size();
+    descriptorCounts.m_StorageBuffers           = (uint32_t)m_StorageBufferSlots.size();
     descriptorCounts.m_CombinedTextureSamplers  = (uint32_t)m_CombinedTextureSamplerSlots.size();
 
     return descriptorCounts;
@@ -17,7 +17,9 @@ public:
     ~DescriptorSetLayoutDX11() = default;
 
     void addBindingUniformBuffer(SHADER_BINDING binding, SHADER_TYPE shaderStages) override final;
+    void addBindingStorageBuffer(SHADER_BINDING binding, SHADER_TYPE shaderStages) override final;
     void addBindingCombinedTextureSampler(SHADER_BINDING binding, SHADER_TYPE shaderStages) override final;
+    void addBindingCombinedTextureSamplerArray(SHADER_BINDING binding, SHADER_TYPE shaderStages, uint32_t descriptorCount) override final;
 
     bool finalize(Device* pDevice) override final;
 
@@ -27,6 +29,7 @@ public:
 
 private:
     std::vector<BindingSlot> m_UniformBufferSlots;
+    std::vector<BindingSlot> m_StorageBufferSlots;
     std::vector<BindingSlot> m_CombinedTextureSamplerSlots;
 
     // Maps binding slots to the shader stages they belong to
@@ -22,7 +22,9 @@
 #endif
 
 DeviceDX11::DeviceDX11(const DeviceInfoDX11& deviceInfo)
-    :Device({}),
+    // Indirect drawing is not supported as SV_InstanceID does not include the start instance location in DirectX 11
+    // BC formats are required from feature level 11
+    :Device({}, { .TextureCompressionBC = true }),
     m_pDevice(deviceInfo.pDevice),
     m_pContext(deviceInfo.pImmediateContext),
     m_pDepthStencilState(deviceInfo.pDepthStencilState)
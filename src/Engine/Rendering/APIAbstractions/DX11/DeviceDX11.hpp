@@ -43,6 +43,7 @@ public:
     IRenderPass* createRenderPass(const RenderPassInfo& renderPassInfo) override final;
 
     PipelineDX11* createPipeline(const PipelineInfo& pipelineInfo) override final;
+    bool waitForPipelines() override final { return true; }
     PipelineLayoutDX11* createPipelineLayout(const std::vector<IDescriptorSetLayout*>& descriptorSetLayouts) override final { UNREFERENCED_VARIABLE(descriptorSetLayouts); return DBG_NEW PipelineLayoutDX11(); }
 
     void map(IBuffer* pBuffer, void** ppMappedMemory) override final;
@@ -77,6 +78,8 @@ public:
 
 protected:
     DescriptorPoolDX11* createDescriptorPool(const DescriptorPoolInfo& poolInfo) override final;
+    // Resources are created with their initial data, no upload queue is needed
+    bool initUploadQueue() override final { return true; }
 
 private:
     ShaderDX11* compileShader(SHADER_TYPE shaderType, const std::string& filePath, const InputLayoutInfo* pInputLayoutInfo) override final;
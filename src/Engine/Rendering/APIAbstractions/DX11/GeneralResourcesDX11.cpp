@@ -9,6 +9,12 @@ DXGI_FORMAT convertFormatToDX(RESOURCE_FORMAT textureFormat)
             return DXGI_FORMAT_R32G32B32_FLOAT;
         case RESOURCE_FORMAT::R32G32_FLOAT:
             return DXGI_FORMAT_R32G32_FLOAT;
+        case RESOURCE_FORMAT::R32_FLOAT:
+            return DXGI_FORMAT_R32_FLOAT;
+        case RESOURCE_FORMAT::R16G16_FLOAT:
+            return DXGI_FORMAT_R16G16_FLOAT;
+        case RESOURCE_FORMAT::R16G16_SNORM:
+            return DXGI_FORMAT_R16G16_SNORM;
         case RESOURCE_FORMAT::B8G8R8A8_UNORM:
             return DXGI_FORMAT_B8G8R8A8_UNORM;
         case RESOURCE_FORMAT::B8G8R8A8_SRGB:
@@ -17,8 +23,16 @@ DXGI_FORMAT convertFormatToDX(RESOURCE_FORMAT textureFormat)
             return DXGI_FORMAT_R8G8B8A8_UNORM;
         case RESOURCE_FORMAT::R8G8B8A8_SRGB:
             return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+        case RESOURCE_FORMAT::R8_UNORM:
+            return DXGI_FORMAT_R8_UNORM;
         case RESOURCE_FORMAT::D32_FLOAT:
             return DXGI_FORMAT_D32_FLOAT;
+        case RESOURCE_FORMAT::BC1_UNORM:
+            return DXGI_FORMAT_BC1_UNORM;
+        case RESOURCE_FORMAT::BC3_UNORM:
+            return DXGI_FORMAT_BC3_UNORM;
+        case RESOURCE_FORMAT::BC7_UNORM:
+            return DXGI_FORMAT_BC7_UNORM;
         default:
             LOG_ERROR("Unknown resource format");
             return DXGI_FORMAT_UNKNOWN;
@@ -34,6 +48,12 @@ RESOURCE_FORMAT convertFormatFromDX(DXGI_FORMAT format)
             return RESOURCE_FORMAT::R32G32B32_FLOAT;
         case DXGI_FORMAT_R32G32_FLOAT:
             return RESOURCE_FORMAT::R32G32_FLOAT;
+        case DXGI_FORMAT_R32_FLOAT:
+            return RESOURCE_FORMAT::R32_FLOAT;
+        case DXGI_FORMAT_R16G16_FLOAT:
+            return RESOURCE_FORMAT::R16G16_FLOAT;
+        case DXGI_FORMAT_R16G16_SNORM:
+            return RESOURCE_FORMAT::R16G16_SNORM;
         case DXGI_FORMAT_B8G8R8A8_UNORM:
             return RESOURCE_FORMAT::B8G8R8A8_UNORM;
         case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
@@ -42,8 +62,16 @@ RESOURCE_FORMAT convertFormatFromDX(DXGI_FORMAT format)
             return RESOURCE_FORMAT::R8G8B8A8_UNORM;
         case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
             return RESOURCE_FORMAT::R8G8B8A8_SRGB;
+        case DXGI_FORMAT_R8_UNORM:
+            return RESOURCE_FORMAT::R8_UNORM;
         case DXGI_FORMAT_D32_FLOAT:
             return RESOURCE_FORMAT::D32_FLOAT;
+        case DXGI_FORMAT_BC1_UNORM:
+            return RESOURCE_FORMAT::BC1_UNORM;
+        case DXGI_FORMAT_BC3_UNORM:
+            return RESOURCE_FORMAT::BC3_UNORM;
+        case DXGI_FORMAT_BC7_UNORM:
+            return RESOURCE_FORMAT::BC7_UNORM;
 
         default:
             LOG_ERRORF("Unknown resource format: %d", (int)format);
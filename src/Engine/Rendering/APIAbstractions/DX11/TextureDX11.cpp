@@ -9,6 +9,8 @@
 
 #include <wrl/client.h>
 
+#include <vector>
+
 TextureDX11* TextureDX11::createFromFile(const std::string& filePath, ID3D11Device* pDevice)
 {
     // Convert std::string to const wchar_t*
@@ -36,6 +38,7 @@ TextureDX11* TextureDX11::createFromFile(const std::string& filePath, ID3D11Devi
     TextureInfoDX11 textureInfoDX = {};
     textureInfoDX.Dimensions    = {(uint32_t)txDesc.Width, (uint32_t)txDesc.Height};
     textureInfoDX.Format        = convertFormatFromDX(txDesc.Format);
+    textureInfoDX.MipLevels     = (uint32_t)txDesc.MipLevels;
     textureInfoDX.pSRV          = pSRV;
     textureInfoDX.pDSV          = nullptr;
     textureInfoDX.pRTV          = nullptr;
@@ -49,7 +52,7 @@ TextureDX11* TextureDX11::create(const TextureInfo& textureInfo, ID3D11Device* p
     D3D11_TEXTURE2D_DESC txDesc = {};
     txDesc.Width                = UINT(textureInfo.Dimensions.x);
     txDesc.Height               = UINT(textureInfo.Dimensions.y);
-    txDesc.MipLevels            = 1;
+    txDesc.MipLevels            = UINT(std::max(textureInfo.MipLevels, 1u));
     txDesc.ArraySize            = 1;
     txDesc.Format               = convertFormatToDX(textureInfo.Format);
     txDesc.SampleDesc.Count     = 1;
@@ -59,14 +62,18 @@ TextureDX11* TextureDX11::create(const TextureInfo& textureInfo, ID3D11Device* p
     txDesc.CPUAccessFlags       = 0;
     txDesc.MiscFlags            = 0;
 
-    D3D11_SUBRESOURCE_DATA initialData = {};
+    // One subresource per mip level
+    std::vector<D3D11_SUBRESOURCE_DATA> initialData;
     if (textureInfo.pInitialData) {
-        initialData.pSysMem     = textureInfo.pInitialData->pData;
-        initialData.SysMemPitch = textureInfo.pInitialData->RowSize;
+        initialData.resize((size_t)txDesc.MipLevels);
+        for (UINT mipLevel = 0u; mipLevel < txDesc.MipLevels; mipLevel += 1u) {
+            initialData[mipLevel].pSysMem       = textureInfo.pInitialData[mipLevel].pData;
+            initialData[mipLevel].SysMemPitch   = textureInfo.pInitialData[mipLevel].RowSize;
+        }
     }
 
     Microsoft::WRL::ComPtr<ID3D11Texture2D> texture2D = nullptr;
-    HRESULT hr = pDevice->CreateTexture2D(&txDesc, textureInfo.pInitialData ? &initialData : nullptr, texture2D.GetAddressOf());
+    HRESULT hr = pDevice->CreateTexture2D(&txDesc, textureInfo.pInitialData ? initialData.data() : nullptr, texture2D.GetAddressOf());
     if (FAILED(hr)) {
         LOG_WARNINGF("Failed to create texture2D: %s", hresultToString(hr).c_str());
         return nullptr;
@@ -106,6 +113,7 @@ TextureDX11* TextureDX11::create(const TextureInfo& textureInfo, ID3D11Device* p
     TextureInfoDX11 textureInfoDX = {};
     textureInfoDX.Dimensions    = textureInfo.Dimensions;
     textureInfoDX.Format        = textureInfo.Format;
+    textureInfoDX.MipLevels     = (uint32_t)txDesc.MipLevels;
     textureInfoDX.pSRV          = pSRV;
     textureInfoDX.pDSV          = pDSV;
     textureInfoDX.pRTV          = pRTV;
@@ -115,7 +123,7 @@ TextureDX11* TextureDX11::create(const TextureInfo& textureInfo, ID3D11Device* p
 }
 
 TextureDX11::TextureDX11(const TextureInfoDX11& textureInfo)
-    :Texture(textureInfo.Dimensions, textureInfo.Format),
+    :Texture(textureInfo.Dimensions, textureInfo.Format, textureInfo.MipLevels),
     m_pSRV(textureInfo.pSRV),
     m_pDSV(textureInfo.pDSV),
     m_pRTV(textureInfo.pRTV),
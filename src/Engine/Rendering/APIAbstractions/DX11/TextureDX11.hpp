@@ -8,6 +8,7 @@
 struct TextureInfoDX11 {
     glm::uvec2 Dimensions;
     RESOURCE_FORMAT Format;
+    uint32_t MipLevels;
     ID3D11ShaderResourceView* pSRV;
     ID3D11DepthStencilView* pDSV;
     ID3D11RenderTargetView* pRTV;
@@ -4,12 +4,14 @@
 
 DescriptorCounts::DescriptorCounts()
     :m_UniformBuffers(0),
+    m_StorageBuffers(0),
     m_CombinedTextureSamplers(0)
 {}
 
 DescriptorCounts& DescriptorCounts::operator+=(const DescriptorCounts& other)
 {
     m_UniformBuffers            += other.m_UniformBuffers;
+    m_StorageBuffers            += other.m_StorageBuffers;
     m_CombinedTextureSamplers   += other.m_CombinedTextureSamplers;
     return *this;
 }
@@ -18,6 +20,7 @@ DescriptorCounts& DescriptorCounts::operator-=(const DescriptorCounts& other)
 {
     // Avoid underflow
     m_UniformBuffers            = (uint32_t)std::max(0, (int)m_UniformBuffers - (int)other.m_UniformBuffers);
+    m_StorageBuffers            = (uint32_t)std::max(0, (int)m_StorageBuffers - (int)other.m_StorageBuffers);
     m_CombinedTextureSamplers   = (uint32_t)std::max(0, (int)m_CombinedTextureSamplers - (int)other.m_CombinedTextureSamplers);
     return *this;
 }
@@ -25,6 +28,7 @@ DescriptorCounts& DescriptorCounts::operator-=(const DescriptorCounts& other)
 DescriptorCounts& DescriptorCounts::operator*=(uint32_t factor)
 {
     m_UniformBuffers            *= factor;
+    m_StorageBuffers            *= factor;
     m_CombinedTextureSamplers   *= factor;
     return *this;
 }
@@ -32,12 +36,14 @@ DescriptorCounts& DescriptorCounts::operator*=(uint32_t factor)
 void DescriptorCounts::ceil(const DescriptorCounts& other)
 {
     m_UniformBuffers            = std::max(m_UniformBuffers, other.m_UniformBuffers);
+    m_StorageBuffers            = std::max(m_StorageBuffers, other.m_StorageBuffers);
     m_CombinedTextureSamplers   = std::max(m_CombinedTextureSamplers, other.m_CombinedTextureSamplers);
 }
 
 void DescriptorCounts::setAll(uint32_t descriptorCount)
 {
     m_UniformBuffers            = descriptorCount;
+    m_StorageBuffers            = descriptorCount;
     m_CombinedTextureSamplers   = descriptorCount;
 }
 
@@ -45,6 +51,7 @@ bool DescriptorCounts::contains(const DescriptorCounts& other) const
 {
     return
         m_UniformBuffers            >= other.m_UniformBuffers &&
+        m_StorageBuffers            >= other.m_StorageBuffers &&
         m_CombinedTextureSamplers   >= other.m_CombinedTextureSamplers;
 }
 
@@ -52,6 +59,7 @@ std::string DescriptorCounts::toString() const
 {
     return
         "Uniform Buffers: "             + std::to_string(m_UniformBuffers) + ", " +
+        "Storage Buffers: "             + std::to_string(m_StorageBuffers) + ", " +
         "Combined texture samplers: "   + std::to_string(m_CombinedTextureSamplers);
 }
 
@@ -59,5 +67,6 @@ uint32_t DescriptorCounts::getDescriptorTypeCount() const
 {
     return
         (m_UniformBuffers            != 0u) +
+        (m_StorageBuffers            != 0u) +
         (m_CombinedTextureSamplers   != 0u);
 }
@@ -27,5 +27,6 @@ public:
     uint32_t getDescriptorTypeCount() const;
 
     uint32_t m_UniformBuffers;
+    uint32_t m_StorageBuffers;
     uint32_t m_CombinedTextureSamplers;
 };
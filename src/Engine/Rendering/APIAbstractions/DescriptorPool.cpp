@@ -2,7 +2,8 @@
 
 DescriptorPool::DescriptorPool(const DescriptorPoolInfo& descriptorPoolInfo)
     :m_AvailableDescriptors(descriptorPoolInfo.DescriptorCounts),
-    m_DescriptorSetCapacity(descriptorPoolInfo.MaxSetAllocations)
+    m_DescriptorSetCapacity(descriptorPoolInfo.MaxSetAllocations),
+    m_AllocatedSetCount(0u)
 {}
 
 DescriptorSet* DescriptorPool::allocateDescriptorSet(const IDescriptorSetLayout* pDescriptorSetLayout, const DescriptorCounts& descriptorCounts)
@@ -11,6 +12,7 @@ DescriptorSet* DescriptorPool::allocateDescriptorSet(const IDescriptorSetLayout*
     if (pNewSet) {
         m_AvailableDescriptors -= descriptorCounts;
         m_DescriptorSetCapacity -= 1u;
+        m_AllocatedSetCount += 1u;
     }
 
     return pNewSet;
@@ -22,9 +24,10 @@ void DescriptorPool::deallocateDescriptorSet(const DescriptorSet* pDescriptorSet
 
     m_AvailableDescriptors += descriptorCounts;
     m_DescriptorSetCapacity += 1u;
+    m_AllocatedSetCount -= 1u;
 }
 
-bool DescriptorPool::hasRoomFor(const DescriptorCounts& descriptorCounts)
+bool DescriptorPool::hasRoomFor(const DescriptorCounts& descriptorCounts) const
 {
-    return m_AvailableDescriptors.contains(descriptorCounts);
+    return m_DescriptorSetCapacity > 0u && m_AvailableDescriptors.contains(descriptorCounts);
 }
@@ -20,7 +20,8 @@ public:
     DescriptorSet* allocateDescriptorSet(const IDescriptorSetLayout* pDescriptorSetLayout, const DescriptorCounts& descriptorCounts);
     void deallocateDescriptorSet(const DescriptorSet* pDescriptorSet, const DescriptorCounts& descriptorCounts);
 
-    bool hasRoomFor(const DescriptorCounts& descriptorCounts);
+    bool hasRoomFor(const DescriptorCounts& descriptorCounts) const;
+    inline uint32_t getAllocatedSetCount() const { return m_AllocatedSetCount; }
 
 protected:
     DescriptorCounts m_AvailableDescriptors;
@@ -32,4 +33,5 @@ private:
 private:
     // The amount of additional descriptor sets the pool is able to allocate
     uint32_t m_DescriptorSetCapacity;
+    uint32_t m_AllocatedSetCount;
 };
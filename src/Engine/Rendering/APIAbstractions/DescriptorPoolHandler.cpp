@@ -5,6 +5,12 @@
 
 #include <Engine/Utils/Logger.hpp>
 
+#include <algorithm>
+
+DescriptorPoolHandler::DescriptorPoolHandler()
+    :m_CurrentPoolIdx(0)
+{}
+
 DescriptorPoolHandler::~DescriptorPoolHandler()
 {
     clear();
@@ -24,6 +30,7 @@ void DescriptorPoolHandler::clear()
     }
 
     m_DescriptorPools.clear();
+    m_CurrentPoolIdx = 0;
 }
 
 DescriptorSet* DescriptorPoolHandler::allocateDescriptorSet(const IDescriptorSetLayout* pLayout, Device* pDevice)
@@ -31,25 +38,36 @@ DescriptorSet* DescriptorPoolHandler::allocateDescriptorSet(const IDescriptorSet
     DescriptorCounts descriptorsToAllocate = pLayout->getDescriptorCounts();
     DescriptorSet* pDescriptorSet = nullptr;
 
-    for (DescriptorPool* pDescriptorPool : m_DescriptorPools) {
+    // Start with the pool that allocated most recently, the pools before it are likely full
+    const size_t poolCount = m_DescriptorPools.size();
+    for (size_t poolOffset = 0; poolOffset < poolCount; poolOffset++) {
+        const size_t poolIdx = (m_CurrentPoolIdx + poolOffset) % poolCount;
+        DescriptorPool* pDescriptorPool = m_DescriptorPools[poolIdx];
+
         if (pDescriptorPool->hasRoomFor(descriptorsToAllocate)) {
             pDescriptorSet = pDescriptorPool->allocateDescriptorSet(pLayout, descriptorsToAllocate);
 
             if (pDescriptorSet) {
+                m_CurrentPoolIdx = poolIdx;
                 return pDescriptorSet;
             }
         }
     }
 
     // No descriptor pool was able to allocate the descriptor set, create a new pool
-    // The new pool needs to be at least large enough to fit the new descriptor set
+    // Each new pool is twice as large as the previous one to keep the amount of pools low.
+    // The new pool also needs to be at least large enough to fit the new descriptor set.
+    const uint32_t growthFactor = 1u << std::min((uint32_t)poolCount, 16u);
     DescriptorPoolInfo newPoolInfo = m_PoolInfos;
+    newPoolInfo.DescriptorCounts    = newPoolInfo.DescriptorCounts * growthFactor;
+    newPoolInfo.MaxSetAllocations   *= growthFactor;
     newPoolInfo.DescriptorCounts.ceil(descriptorsToAllocate);
 
     DescriptorCounts newRecommendedPoolSize = m_PoolInfos.DescriptorCounts * (uint32_t)m_DescriptorPools.size() + descriptorsToAllocate;
     LOG_INFOF("Pool size exceeded, new recommended pool size: %s", newRecommendedPoolSize.toString().c_str());
 
     m_DescriptorPools.push_back(pDevice->createDescriptorPool(newPoolInfo));
+    m_CurrentPoolIdx = m_DescriptorPools.size() - 1;
 
     // Last attempt to allocate descriptor set
     pDescriptorSet = m_DescriptorPools.back()->allocateDescriptorSet(pLayout, descriptorsToAllocate);
@@ -59,3 +77,13 @@ DescriptorSet* DescriptorPoolHandler::allocateDescriptorSet(const IDescriptorSet
 
     return pDescriptorSet;
 }
+
+uint32_t DescriptorPoolHandler::getAllocatedSetCount() const
+{
+    uint32_t allocatedSetCount = 0u;
+    for (const DescriptorPool* pDescriptorPool : m_DescriptorPools) {
+        allocatedSetCount += pDescriptorPool->getAllocatedSetCount();
+    }
+
+    return allocatedSetCount;
+}
@@ -10,7 +10,7 @@ class IDescriptorSetLayout;
 class DescriptorPoolHandler
 {
 public:
-    DescriptorPoolHandler() = default;
+    DescriptorPoolHandler();
     ~DescriptorPoolHandler();
 
     // Specify the settingsfor pools that will be created. Optimally, only one pool will be created, but more can be created if needed.
@@ -19,8 +19,13 @@ public:
 
     DescriptorSet* allocateDescriptorSet(const IDescriptorSetLayout* pLayout, Device* pDevice);
 
+    inline uint32_t getPoolCount() const { return (uint32_t)m_DescriptorPools.size(); }
+    uint32_t getAllocatedSetCount() const;
+
 private:
     std::vector<DescriptorPool*> m_DescriptorPools;
 
     DescriptorPoolInfo m_PoolInfos;
+    // The pool that most recently allocated a set, the first pool to try when allocating
+    size_t m_CurrentPoolIdx;
 };
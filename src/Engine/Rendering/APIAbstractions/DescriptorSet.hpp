@@ -15,7 +15,9 @@ public:
     virtual ~DescriptorSet();
 
     virtual void updateUniformBufferDescriptor(SHADER_BINDING binding, IBuffer* pBuffer) = 0;
+    virtual void updateStorageBufferDescriptor(SHADER_BINDING binding, IBuffer* pBuffer) = 0;
     virtual void updateCombinedTextureSamplerDescriptor(SHADER_BINDING binding, Texture* pTexture, ISampler* pSampler) = 0;
+    virtual void updateCombinedTextureSamplerArrayDescriptor(SHADER_BINDING binding, uint32_t arrayIndex, Texture* pTexture, ISampler* pSampler) = 0;
 
     const IDescriptorSetLayout* getLayout() const { return m_pLayout; }
 
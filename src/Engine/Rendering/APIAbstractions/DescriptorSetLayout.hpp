@@ -14,7 +14,10 @@ public:
     virtual bool finalize(Device* pDevice) = 0;
 
     virtual void addBindingUniformBuffer(SHADER_BINDING binding, SHADER_TYPE shaderStages) = 0;
+    virtual void addBindingStorageBuffer(SHADER_BINDING binding, SHADER_TYPE shaderStages) = 0;
     virtual void addBindingCombinedTextureSampler(SHADER_BINDING binding, SHADER_TYPE shaderStages) = 0;
+    // An array of texture-samplers occupying a single binding. Shaders may only index it with dynamically uniform indices.
+    virtual void addBindingCombinedTextureSamplerArray(SHADER_BINDING binding, SHADER_TYPE shaderStages, uint32_t descriptorCount) = 0;
 
     // How many descriptors of each type are involved in the layout
     virtual DescriptorCounts getDescriptorCounts() const = 0;
@@ -5,6 +5,7 @@
 #include <Engine/Rendering/APIAbstractions/DX11/DeviceDX11.hpp>
 #include <Engine/Rendering/APIAbstractions/Swapchain.hpp>
 #include <Engine/Rendering/APIAbstractions/Texture.hpp>
+#include <Engine/Rendering/APIAbstractions/UploadQueue.hpp>
 #include <Engine/Rendering/APIAbstractions/Vulkan/DeviceCreatorVK.hpp>
 #include <Engine/Rendering/APIAbstractions/Vulkan/DeviceVK.hpp>
 #include <Engine/Utils/Debug.hpp>
@@ -35,6 +36,11 @@ Device* Device::create(RENDERING_API API, const SwapchainInfo& swapchainInfo, co
         return nullptr;
     }
 
+    // The swapchain's textures are converted to their initial layouts using the upload queue
+    if (!pDevice->initUploadQueue()) {
+        return nullptr;
+    }
+
     Swapchain* pSwapchain = pDeviceCreator->createSwapchain(pDevice.get());
     if (!pSwapchain) {
         return nullptr;
@@ -45,11 +51,13 @@ Device* Device::create(RENDERING_API API, const SwapchainInfo& swapchainInfo, co
     return pDevice.release();
 }
 
-Device::Device(QueueFamilyIndices queueFamilyIndices)
+Device::Device(QueueFamilyIndices queueFamilyIndices, const DeviceFeatures& features)
     :m_pSwapchain(nullptr),
     m_FrameIndex(0u),
+    m_pUploadQueue(nullptr),
     m_pShaderHandler(nullptr),
-    m_QueueFamilyIndices(queueFamilyIndices)
+    m_QueueFamilyIndices(queueFamilyIndices),
+    m_Features(features)
 {}
 
 Device::~Device()
@@ -126,6 +134,10 @@ Shader* Device::createShader(SHADER_TYPE shaderType, const std::string& filePath
 
 void Device::deleteGraphicsObjects()
 {
+    // Waits for the remaining uploads before their staging memory is freed
+    delete m_pUploadQueue;
+    m_pUploadQueue = nullptr;
+
     delete m_pSwapchain;
     m_DescriptorPoolHandler.clear();
     m_CommandPoolsTempGraphics.clear();
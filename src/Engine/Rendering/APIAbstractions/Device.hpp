@@ -25,6 +25,7 @@ class IRenderPass;
 class ISampler;
 class ISemaphore;
 class Texture;
+class UploadQueue;
 class Window;
 struct BlendStateInfo;
 struct BufferInfo;
@@ -51,12 +52,29 @@ struct QueueFamilyIndices {
     uint32_t Present;
 };
 
+// Optional features, their availability depends on the graphics API and the hardware
+struct DeviceFeatures {
+    // Drawing with arguments read from indirect buffers, using storage buffers for per-draw data indexed by the first instance
+    bool IndirectDrawing;
+    // Issuing multiple indirect draws in a single call, otherwise the draws are issued one by one
+    bool MultiDrawIndirect;
+    // Indexing texture arrays in shaders using dynamically uniform indices, e.g. indices read from buffers
+    bool DynamicTextureArrayIndexing;
+    // Semaphores signaling increasing values, used to let one queue wait for another without binary semaphore pairs
+    bool TimelineSemaphores;
+    // Sampling BC1, BC3 and BC7 block compressed textures
+    bool TextureCompressionBC;
+};
+
 struct SemaphoreSubmitInfo {
     ISemaphore** ppWaitSemaphores;
     uint32_t WaitSemaphoreCount;
     PIPELINE_STAGE* pWaitStageFlags;
     ISemaphore** ppSignalSemaphores;
     uint32_t SignalSemaphoreCount;
+    // Optional values to wait for and signal on timeline semaphores, one per semaphore. Values of binary semaphores are ignored.
+    const uint64_t* pWaitValues;
+    const uint64_t* pSignalValues;
 };
 
 class Device
@@ -65,7 +83,7 @@ public:
     static Device* create(RENDERING_API API, const SwapchainInfo& swapchainInfo, const Window* pWindow);
 
 public:
-    Device(QueueFamilyIndices queueFamilyIndices);
+    Device(QueueFamilyIndices queueFamilyIndices, const DeviceFeatures& features);
     virtual ~Device();
 
     bool init(const DescriptorCounts& descriptorCounts);
@@ -89,6 +107,9 @@ public:
 
     virtual IPipelineLayout* createPipelineLayout(const std::vector<IDescriptorSetLayout*>& descriptorSetLayouts) = 0;
     virtual IPipeline* createPipeline(const PipelineInfo& pipelineInfo) = 0;
+    /*  Pipelines created during initialization may be compiled in parallel, and must not be used before this is called.
+        Pipelines created afterwards are compiled immediately. Returns false if any pipeline failed to compile. */
+    virtual bool waitForPipelines() = 0;
 
     virtual void map(IBuffer* pBuffer, void** ppMappedMemory) = 0;
     virtual void unmap(IBuffer* pBuffer) = 0;
@@ -122,12 +143,18 @@ public:
     inline Texture* getBackbuffer(uint32_t frameIndex)              { return m_pSwapchain->getBackbuffer(frameIndex); }
     inline Texture* getDepthStencil(uint32_t frameIndex)            { return m_pSwapchain->getDepthTexture(frameIndex); }
     inline ShaderHandler* getShaderHandler()                        { return m_pShaderHandler; }
+    // nullptr if the API initializes resources with their initial data immediately
+    inline UploadQueue* getUploadQueue()                            { return m_pUploadQueue; }
     inline const QueueFamilyIndices& getQueueFamilyIndices() const  { return m_QueueFamilyIndices; }
+    inline const DeviceFeatures& getFeatures() const                { return m_Features; }
+    inline const DescriptorPoolHandler& getDescriptorPoolHandler() const { return m_DescriptorPoolHandler; }
 
 protected:
     friend DescriptorPoolHandler;
 
     virtual DescriptorPool* createDescriptorPool(const DescriptorPoolInfo& poolInfo) = 0;
+    // Creates the queue that uploads the initial data of buffers and textures, if the API needs one
+    virtual bool initUploadQueue() = 0;
 
     // VkDevice is deleted before the graphics objects in Device are. This is a workaround for that issue.
     void deleteGraphicsObjects();
@@ -137,6 +164,7 @@ protected:
     uint32_t m_FrameIndex;
 
     DescriptorPoolHandler m_DescriptorPoolHandler;
+    UploadQueue* m_pUploadQueue;
 
     // Each pool contains one command pool for each thread. The generated command lists are temporary, i.e. short lived.
     ResourcePool<ICommandPool> m_CommandPoolsTempGraphics;
@@ -159,4 +187,5 @@ private:
 private:
     ShaderHandler* m_pShaderHandler;
     QueueFamilyIndices m_QueueFamilyIndices;
+    DeviceFeatures m_Features;
 };
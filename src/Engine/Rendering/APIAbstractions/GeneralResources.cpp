@@ -1,5 +1,7 @@
 #include "GeneralResources.hpp"
 
+#include <algorithm>
+
 size_t getFormatSize(RESOURCE_FORMAT format)
 {
     switch (format) {
@@ -9,12 +11,22 @@ size_t getFormatSize(RESOURCE_FORMAT format)
             return 12;
         case RESOURCE_FORMAT::R32G32_FLOAT:
             return 8;
+        case RESOURCE_FORMAT::R32_FLOAT:
+        case RESOURCE_FORMAT::R16G16_FLOAT:
+        case RESOURCE_FORMAT::R16G16_SNORM:
         case RESOURCE_FORMAT::B8G8R8A8_UNORM:
         case RESOURCE_FORMAT::B8G8R8A8_SRGB:
         case RESOURCE_FORMAT::R8G8B8A8_UNORM:
         case RESOURCE_FORMAT::R8G8B8A8_SRGB:
         case RESOURCE_FORMAT::D32_FLOAT:
             return 4;
+        case RESOURCE_FORMAT::R8_UNORM:
+            return 1;
+        case RESOURCE_FORMAT::BC1_UNORM:
+            return 8;
+        case RESOURCE_FORMAT::BC3_UNORM:
+        case RESOURCE_FORMAT::BC7_UNORM:
+            return 16;
         default:
             LOG_WARNINGF("Erroneous resource format: %d", (int)format);
             return 16;
@@ -27,15 +39,54 @@ FORMAT_PRIMITIVE_TYPE getFormatPrimitiveType(RESOURCE_FORMAT format)
         case RESOURCE_FORMAT::R32G32B32A32_FLOAT:
         case RESOURCE_FORMAT::R32G32B32_FLOAT:
         case RESOURCE_FORMAT::R32G32_FLOAT:
+        case RESOURCE_FORMAT::R32_FLOAT:
+        case RESOURCE_FORMAT::R16G16_FLOAT:
+        case RESOURCE_FORMAT::R16G16_SNORM:
         case RESOURCE_FORMAT::D32_FLOAT:
             return FORMAT_PRIMITIVE_TYPE::FLOAT;
         case RESOURCE_FORMAT::B8G8R8A8_UNORM:
         case RESOURCE_FORMAT::B8G8R8A8_SRGB:
         case RESOURCE_FORMAT::R8G8B8A8_UNORM:
         case RESOURCE_FORMAT::R8G8B8A8_SRGB:
+        case RESOURCE_FORMAT::R8_UNORM:
+        case RESOURCE_FORMAT::BC1_UNORM:
+        case RESOURCE_FORMAT::BC3_UNORM:
+        case RESOURCE_FORMAT::BC7_UNORM:
             return FORMAT_PRIMITIVE_TYPE::UNSIGNED_INTEGER;
         default:
             LOG_WARNINGF("Erroneous resource format: %d", (int)format);
             return FORMAT_PRIMITIVE_TYPE::FLOAT;
     }
 }
+
+bool isBlockCompressed(RESOURCE_FORMAT format)
+{
+    return format == RESOURCE_FORMAT::BC1_UNORM || format == RESOURCE_FORMAT::BC3_UNORM || format == RESOURCE_FORMAT::BC7_UNORM;
+}
+
+size_t getTextureRowSize(RESOURCE_FORMAT format, uint32_t width)
+{
+    // Partial blocks at the edges of block compressed textures are stored as whole blocks
+    return isBlockCompressed(format) ? ((width + 3u) / 4u) * getFormatSize(format) : width * getFormatSize(format);
+}
+
+size_t getTextureSize(RESOURCE_FORMAT format, const glm::uvec2& dimensions)
+{
+    const uint32_t rowCount = isBlockCompressed(format) ? (dimensions.y + 3u) / 4u : dimensions.y;
+    return getTextureRowSize(format, dimensions.x) * rowCount;
+}
+
+uint32_t getMipLevelCount(const glm::uvec2& dimensions)
+{
+    uint32_t mipLevels = 1u;
+    for (uint32_t size = std::max(dimensions.x, dimensions.y); size > 1u; size >>= 1u) {
+        mipLevels += 1u;
+    }
+
+    return mipLevels;
+}
+
+glm::uvec2 getMipDimensions(const glm::uvec2& dimensions, uint32_t mipLevel)
+{
+    return { std::max(dimensions.x >> mipLevel, 1u), std::max(dimensions.y >> mipLevel, 1u) };
+}
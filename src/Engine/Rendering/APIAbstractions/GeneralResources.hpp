@@ -11,11 +11,20 @@ enum class RESOURCE_FORMAT {
     R32G32B32A32_FLOAT,
     R32G32B32_FLOAT,
     R32G32_FLOAT,
+    R32_FLOAT,
+    R16G16_FLOAT,
+    R16G16_SNORM,
     B8G8R8A8_UNORM,
     B8G8R8A8_SRGB,
     R8G8B8A8_UNORM,
     R8G8B8A8_SRGB,
-    D32_FLOAT
+    // Single channel, e.g. glyph coverage
+    R8_UNORM,
+    D32_FLOAT,
+    // Block compressed formats, storing 4x4 blocks of pixels
+    BC1_UNORM,
+    BC3_UNORM,
+    BC7_UNORM
 };
 
 enum class FORMAT_PRIMITIVE_TYPE {
@@ -107,6 +116,15 @@ struct Rectangle2D {
     glm::uvec2 Extent;
 };
 
-// Returns size of a format in bytes
+// Returns size of a format in bytes, or the size of a 4x4 block of pixels for block compressed formats
 size_t getFormatSize(RESOURCE_FORMAT format);
 FORMAT_PRIMITIVE_TYPE getFormatPrimitiveType(RESOURCE_FORMAT format);
+bool isBlockCompressed(RESOURCE_FORMAT format);
+
+// Size of a row of pixels, or a row of blocks for block compressed formats
+size_t getTextureRowSize(RESOURCE_FORMAT format, uint32_t width);
+// Size of a texture's mip level
+size_t getTextureSize(RESOURCE_FORMAT format, const glm::uvec2& dimensions);
+// Amount of mip levels in a full mip chain, ending with a 1x1 level
+uint32_t getMipLevelCount(const glm::uvec2& dimensions);
+glm::uvec2 getMipDimensions(const glm::uvec2& dimensions, uint32_t mipLevel);
@@ -25,7 +25,11 @@ enum class BUFFER_USAGE : uint32_t {
     VERTEX_BUFFER   = 1,
     INDEX_BUFFER    = VERTEX_BUFFER << 1,
     UNIFORM_BUFFER  = INDEX_BUFFER  << 1,
-    STAGING_BUFFER  = UNIFORM_BUFFER << 1
+    STAGING_BUFFER  = UNIFORM_BUFFER << 1,
+    // Arrays of structures read by shaders
+    STORAGE_BUFFER  = STAGING_BUFFER << 1,
+    // Draw arguments, see ICommandList::drawIndexedIndirect
+    INDIRECT_BUFFER = STORAGE_BUFFER << 1
 };
 
 struct BufferInfo {
@@ -36,6 +40,8 @@ struct BufferInfo {
     BUFFER_USAGE Usage;
     SHARING_MODE SharingMode;
     std::vector<uint32_t> QueueFamilyIndices;
+    // Size of each element in a storage buffer
+    uint32_t StructureStride;
 };
 
 class IBuffer
@@ -23,6 +23,16 @@ struct CommandListBeginInfo {
     Framebuffer* pFramebuffer; // Optional, but may improve performance if specified
 };
 
+// Arguments of a single indexed draw read from an indirect buffer. The layout matches VkDrawIndexedIndirectCommand
+// and the arguments of ID3D11DeviceContext::DrawIndexedInstancedIndirect.
+struct IndexedIndirectDrawArguments {
+    uint32_t IndexCount;
+    uint32_t InstanceCount;
+    uint32_t FirstIndex;
+    int32_t VertexOffset;
+    uint32_t FirstInstance;
+};
+
 enum class COMMAND_LIST_USAGE : uint32_t {
     ONE_TIME_SUBMIT     = 1,
     WITHIN_RENDER_PASS  = ONE_TIME_SUBMIT << 1,
@@ -59,10 +69,13 @@ public:
     virtual void bindScissor(const Rectangle2D& scissorRectangle) = 0;
 
     virtual void draw(size_t vertexCount) = 0;
-    virtual void drawIndexed(size_t indexCount) = 0;
+    virtual void drawIndexed(size_t indexCount, size_t firstIndex) = 0;
+    // Issues drawCount draws whose arguments are read from the argument buffer, starting at offset and spaced by stride bytes
+    virtual void drawIndexedIndirect(IBuffer* pArgumentBuffer, size_t offset, uint32_t drawCount, uint32_t stride) = 0;
 
     virtual void convertTextureLayout(TEXTURE_LAYOUT oldLayout, TEXTURE_LAYOUT newLayout, Texture* pTexture, PIPELINE_STAGE srcStage, PIPELINE_STAGE dstStage) = 0;
 
     virtual void copyBuffer(IBuffer* pSrc, IBuffer* pDst, size_t byteSize) = 0;
-    virtual void copyBufferToTexture(IBuffer* pBuffer, Texture* pTexture, uint32_t width, uint32_t height) = 0;
+    // The buffer holds each region's rows tightly packed, e.g. every mip level of a texture back to back
+    virtual void copyBufferToTexture(IBuffer* pBuffer, Texture* pTexture, const TextureCopyRegion* pRegions, uint32_t regionCount) = 0;
 };
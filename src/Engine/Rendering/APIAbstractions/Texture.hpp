@@ -4,6 +4,8 @@
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
+
 enum class TEXTURE_LAYOUT : uint32_t {
     UNDEFINED                   = 1,
     SHADER_READ_ONLY            = UNDEFINED << 1,
@@ -28,7 +30,7 @@ DEFINE_BITMASK_OPERATIONS(TEXTURE_USAGE)
 
 struct InitialData {
     const void* pData;
-    uint32_t RowSize;   // Size of a row in the texture in bytes
+    uint32_t RowSize;   // Size of a row in the texture in bytes, or of a row of blocks in block compressed textures
 };
 
 struct TextureInfo {
@@ -36,19 +38,42 @@ struct TextureInfo {
     TEXTURE_USAGE Usage;
     TEXTURE_LAYOUT Layout;
     RESOURCE_FORMAT Format;
-    InitialData* pInitialData;  // Optional
+    // 0 is treated as 1
+    uint32_t MipLevels;
+    InitialData* pInitialData;  // Optional, one element per mip level, starting with the full resolution level
+};
+
+// Copies a buffer region into a mip level of a texture, starting at the mip level's top left corner
+struct TextureCopyRegion {
+    size_t BufferOffset;
+    uint32_t MipLevel;
+    glm::uvec2 Extent;
 };
 
 class Texture
 {
 public:
-    Texture(const glm::uvec2& dimensions, RESOURCE_FORMAT format) :m_Dimensions(dimensions), m_Format(format) {}
+    Texture(const glm::uvec2& dimensions, RESOURCE_FORMAT format, uint32_t mipLevels = 1u) :m_Dimensions(dimensions), m_Format(format), m_MipLevels(std::max(mipLevels, 1u)) {}
     virtual ~Texture() = 0 {};
 
     const glm::uvec2& getDimensions() const { return m_Dimensions; }
     inline RESOURCE_FORMAT getFormat() const { return m_Format; }
+    inline uint32_t getMipLevels() const { return m_MipLevels; }
+    // Size of every mip level
+    size_t getByteSize() const;
 
 protected:
     glm::uvec2 m_Dimensions;
     RESOURCE_FORMAT m_Format;
+    uint32_t m_MipLevels;
 };
+
+inline size_t Texture::getByteSize() const
+{
+    size_t byteSize = 0u;
+    for (uint32_t mipLevel = 0u; mipLevel < m_MipLevels; mipLevel += 1u) {
+        byteSize += getTextureSize(m_Format, getMipDimensions(m_Dimensions, mipLevel));
+    }
+
+    return byteSize;
+}
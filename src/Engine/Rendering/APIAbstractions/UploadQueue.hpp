@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+
+class ISemaphore;
+
+struct UploadQueueStats {
+    // Amount of uploaded resources, and the amount of bytes copied through staging memory
+    uint64_t Uploads;
+    uint64_t UploadedBytes;
+    uint32_t SubmittedBatches;
+    // Batches submitted before the end of the frame because the staging ring was full
+    uint32_t RingFullSubmits;
+};
+
+/*  Uploads the initial data of buffers and textures in batches. The data is copied into a persistently mapped staging
+    ring and the copies are recorded into a single command list per batch. A batch is submitted once per frame, and its
+    staging memory is reclaimed once the GPU has finished the batch. */
+class UploadQueue
+{
+public:
+    virtual ~UploadQueue() = 0 {};
+
+    /*  Submits the uploads recorded since the previous submission. Called once per frame, before the frame's commands are submitted.
+        Returns false if the uploads could not be submitted, in which case they are discarded. */
+    virtual bool submit() = 0;
+    // Reclaims the staging memory of the batches the GPU has finished, without blocking. Called once per frame.
+    virtual void retireCompletedBatches() = 0;
+    // Submits the recorded uploads and blocks until every batch has finished
+    virtual void waitIdle() = 0;
+
+    /*  Work reading uploaded resources has to wait for the semaphore to reach getWaitValue().
+        Returns nullptr if the uploads are executed on the same queue as the work reading them. */
+    virtual ISemaphore* getSemaphore() = 0;
+    virtual uint64_t getWaitValue() = 0;
+
+    virtual UploadQueueStats getStats() = 0;
+};
@@ -30,11 +30,15 @@ BufferVK* BufferVK::create(const BufferInfo& bufferInfo, DeviceVK* pDevice, Stag
         return nullptr;
     }
 
-    std::unique_ptr<BufferVK> pBuffer(DBG_NEW BufferVK(buffer, allocation, pDevice));
+    VkMemoryPropertyFlags memoryFlags = 0u;
+    vmaGetMemoryTypeProperties(vulkanAllocator, allocationInfo.memoryType, &memoryFlags);
+    const bool isCoherent = memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    std::unique_ptr<BufferVK> pBuffer(DBG_NEW BufferVK(buffer, allocation, allocationInfo.pMappedData, isCoherent, pDevice));
 
     if (bufferInfo.pData) {
         if (bufferInfo.CPUAccess == BUFFER_DATA_ACCESS::WRITE) {
-            if (!pBuffer->mapCopyUnmap(bufferInfo.pData, (VkDeviceSize)bufferInfo.ByteSize)) {
+            if (!pBuffer->write(bufferInfo.pData, (VkDeviceSize)bufferInfo.ByteSize)) {
                 return nullptr;
             }
         } else {
@@ -45,7 +49,7 @@ BufferVK* BufferVK::create(const BufferInfo& bufferInfo, DeviceVK* pDevice, Stag
             }
 
             BufferVK* pStagingBuffer = reinterpret_cast<BufferVK*>(pStagingResources->pStagingBuffer);
-            if (!pStagingBuffer->mapCopyUnmap(bufferInfo.pData, (VkDeviceSize)bufferInfo.ByteSize)) {
+            if (!pStagingBuffer->write(bufferInfo.pData, (VkDeviceSize)bufferInfo.ByteSize)) {
                 return nullptr;
             }
 
@@ -56,9 +60,11 @@ BufferVK* BufferVK::create(const BufferInfo& bufferInfo, DeviceVK* pDevice, Stag
     return pBuffer.release();
 }
 
-BufferVK::BufferVK(VkBuffer buffer, VmaAllocation allocation, DeviceVK* pDevice)
+BufferVK::BufferVK(VkBuffer buffer, VmaAllocation allocation, void* pMappedData, bool isCoherent, DeviceVK* pDevice)
     :m_Buffer(buffer),
     m_Allocation(allocation),
+    m_pMappedData(pMappedData),
+    m_IsCoherent(isCoherent),
     m_pDevice(pDevice)
 {}
 
@@ -68,6 +74,26 @@ BufferVK::~BufferVK()
     vkDestroyBuffer(m_pDevice->getDevice(), m_Buffer, nullptr);
 }
 
+void BufferVK::flush(VkDeviceSize offset, VkDeviceSize size)
+{
+    // VMA aligns the range to nonCoherentAtomSize
+    if (!m_IsCoherent && vmaFlushAllocation(m_pDevice->getVulkanAllocator(), m_Allocation, offset, size) != VK_SUCCESS) {
+        LOG_WARNING("Failed to flush buffer memory");
+    }
+}
+
+bool BufferVK::write(const void* pData, VkDeviceSize size)
+{
+    if (!m_pMappedData) {
+        LOG_WARNING("Attempted to write to a buffer that is not CPU-writable");
+        return false;
+    }
+
+    memcpy(m_pMappedData, pData, size);
+    flush(0u, size);
+    return true;
+}
+
 VmaAllocationInfo BufferVK::getAllocationInfo() const
 {
     VmaAllocationInfo allocationInfo = {};
@@ -94,6 +120,12 @@ VkBufferCreateInfo BufferVK::convertBufferInfo(const BufferInfo& bufferInfo)
         case BUFFER_USAGE::STAGING_BUFFER:
             createInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
             break;
+        case BUFFER_USAGE::STORAGE_BUFFER:
+            createInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+            break;
+        case BUFFER_USAGE::INDIRECT_BUFFER:
+            createInfo.usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+            break;
         default:
             LOG_ERRORF("Invalid buffer usage flag: %d", (int)bufferInfo.Usage);
     }
@@ -130,29 +162,18 @@ VmaAllocationCreateInfo BufferVK::writeAllocationInfo(const BufferInfo& bufferIn
     if (bufferInfo.CPUAccess == BUFFER_DATA_ACCESS::NONE) {
         memoryInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
     } else {
-        memoryInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        // Non-coherent memory is flushed explicitly after writes
+        memoryInfo.requiredFlags    = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+        memoryInfo.preferredFlags   = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+        // Mapping is done once, when the buffer is created. VMA reference counts the mappings of shared memory blocks.
+        memoryInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
     }
 
     if (bufferInfo.GPUAccess != BUFFER_DATA_ACCESS::NONE) {
         // AMD GPUs have memory that is device local, and is still mappable by the CPU
-        memoryInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        memoryInfo.preferredFlags |= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
     }
 
     return memoryInfo;
 }
-
-bool BufferVK::mapCopyUnmap(const void* pData, VkDeviceSize size)
-{
-    VmaAllocationInfo allocationInfo = getAllocationInfo();
-    VkDevice device = m_pDevice->getDevice();
-    void* pMappedData = nullptr;
-
-    if (vkMapMemory(device, allocationInfo.deviceMemory, allocationInfo.offset, size, 0, &pMappedData) != VK_SUCCESS) {
-        LOG_WARNING("Failed to map buffer memory");
-        return false;
-    }
-
-    memcpy(pMappedData, pData, size);
-    vkUnmapMemory(device, allocationInfo.deviceMemory);
-    return true;
-}
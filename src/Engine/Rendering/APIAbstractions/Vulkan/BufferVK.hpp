@@ -13,22 +13,29 @@ public:
     static BufferVK* create(const BufferInfo& bufferInfo, DeviceVK* pDevice, StagingResources* pStagingResources);
 
 public:
-    BufferVK(VkBuffer buffer, VmaAllocation allocation, DeviceVK* pDevice);
+    BufferVK(VkBuffer buffer, VmaAllocation allocation, void* pMappedData, bool isCoherent, DeviceVK* pDevice);
     ~BufferVK();
 
+    // Makes CPU writes to the range visible to the GPU. Does nothing if the buffer's memory is host coherent.
+    void flush(VkDeviceSize offset, VkDeviceSize size);
+    // Copies the data into the mapped memory and flushes it
+    bool write(const void* pData, VkDeviceSize size);
+
     inline VkBuffer getBuffer() { return m_Buffer; }
+    // CPU-accessible buffers stay mapped for their entire lifetime. nullptr if the buffer is not CPU-accessible.
+    inline void* getMappedData() { return m_pMappedData; }
     VmaAllocationInfo getAllocationInfo() const;
 
 private:
     static VkBufferCreateInfo convertBufferInfo(const BufferInfo& bufferInfo);
     static VmaAllocationCreateInfo writeAllocationInfo(const BufferInfo& bufferInfo);
 
-private:
-    bool mapCopyUnmap(const void* pData, VkDeviceSize size);
-
 private:
     VkBuffer m_Buffer;
     VmaAllocation m_Allocation;
 
+    void* m_pMappedData;
+    bool m_IsCoherent;
+
     DeviceVK* m_pDevice;
 };
@@ -118,9 +118,23 @@ void CommandListVK::draw(size_t vertexCount)
     vkCmdDraw(m_CommandBuffer, (uint32_t)vertexCount, 1u, 0u, 0u);
 }
 
-void CommandListVK::drawIndexed(size_t indexCount)
+void CommandListVK::drawIndexed(size_t indexCount, size_t firstIndex)
 {
-    vkCmdDrawIndexed(m_CommandBuffer, (uint32_t)indexCount, 1u, 0u, 0u, 0u);
+    vkCmdDrawIndexed(m_CommandBuffer, (uint32_t)indexCount, 1u, (uint32_t)firstIndex, 0u, 0u);
+}
+
+void CommandListVK::drawIndexedIndirect(IBuffer* pArgumentBuffer, size_t offset, uint32_t drawCount, uint32_t stride)
+{
+    VkBuffer argumentBuffer = reinterpret_cast<BufferVK*>(pArgumentBuffer)->getBuffer();
+
+    if (m_pDevice->getFeatures().MultiDrawIndirect) {
+        vkCmdDrawIndexedIndirect(m_CommandBuffer, argumentBuffer, (VkDeviceSize)offset, drawCount, stride);
+    } else {
+        // Without multi-draw indirect, draw count has to be 0 or 1
+        for (uint32_t drawIdx = 0u; drawIdx < drawCount; drawIdx += 1u) {
+            vkCmdDrawIndexedIndirect(m_CommandBuffer, argumentBuffer, (VkDeviceSize)(offset + drawIdx * stride), 1u, stride);
+        }
+    }
 }
 
 void CommandListVK::convertTextureLayout(TEXTURE_LAYOUT oldLayout, TEXTURE_LAYOUT newLayout, Texture* pTexture, PIPELINE_STAGE srcStage, PIPELINE_STAGE dstStage)
@@ -139,25 +153,30 @@ void CommandListVK::copyBuffer(IBuffer* pSrc, IBuffer* pDst, size_t byteSize)
     vkCmdCopyBuffer(m_CommandBuffer, srcBuffer, dstBuffer, 1u, &copyInfo);
 }
 
-void CommandListVK::copyBufferToTexture(IBuffer* pBuffer, Texture* pTexture, uint32_t width, uint32_t height)
+void CommandListVK::copyBufferToTexture(IBuffer* pBuffer, Texture* pTexture, const TextureCopyRegion* pRegions, uint32_t regionCount)
 {
-    VkBufferImageCopy copyInfo = {};
-    copyInfo.bufferOffset       = 0u;
-    copyInfo.bufferRowLength    = 0u;
-    copyInfo.bufferImageHeight  = 0u;
-    copyInfo.imageSubresource.aspectMask        = VK_IMAGE_ASPECT_COLOR_BIT;
-    copyInfo.imageSubresource.mipLevel          = 0u;
-    copyInfo.imageSubresource.baseArrayLayer    = 0u;
-    copyInfo.imageSubresource.layerCount        = 1u;
-    copyInfo.imageOffset    = {0u, 0u, 0u};
-    copyInfo.imageExtent    = {width, height, 1u};
+    std::vector<VkBufferImageCopy> copyInfos(regionCount);
+    for (uint32_t regionIdx = 0u; regionIdx < regionCount; regionIdx += 1u) {
+        const TextureCopyRegion& region = pRegions[regionIdx];
+
+        VkBufferImageCopy& copyInfo = copyInfos[regionIdx];
+        copyInfo.bufferOffset       = (VkDeviceSize)region.BufferOffset;
+        copyInfo.bufferRowLength    = 0u;
+        copyInfo.bufferImageHeight  = 0u;
+        copyInfo.imageSubresource.aspectMask        = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyInfo.imageSubresource.mipLevel          = region.MipLevel;
+        copyInfo.imageSubresource.baseArrayLayer    = 0u;
+        copyInfo.imageSubresource.layerCount        = 1u;
+        copyInfo.imageOffset    = {0u, 0u, 0u};
+        copyInfo.imageExtent    = {region.Extent.x, region.Extent.y, 1u};
+    }
 
     TextureVK* pTextureVK = reinterpret_cast<TextureVK*>(pTexture);
 
     VkBuffer srcBuffer          = reinterpret_cast<BufferVK*>(pBuffer)->getBuffer();
     VkImage dstImage            = pTextureVK->getImage();
 
-    vkCmdCopyBufferToImage(m_CommandBuffer, srcBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1u, &copyInfo);
+    vkCmdCopyBufferToImage(m_CommandBuffer, srcBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regionCount, copyInfos.data());
 }
 
 VkCommandBufferUsageFlags CommandListVK::convertUsageFlags(COMMAND_LIST_USAGE usageFlags)
@@ -21,6 +21,13 @@ DescriptorPoolVK* DescriptorPoolVK::create(const DescriptorPoolInfo& poolInfo, D
         descriptorCounts.push_back(uniformPool);
     }
 
+    if (poolInfo.DescriptorCounts.m_StorageBuffers) {
+        VkDescriptorPoolSize storagePool = {};
+        storagePool.type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        storagePool.descriptorCount = poolInfo.DescriptorCounts.m_StorageBuffers;
+        descriptorCounts.push_back(storagePool);
+    }
+
     if (poolInfo.DescriptorCounts.m_CombinedTextureSamplers) {
         VkDescriptorPoolSize sampledTexturesPool = {};
         sampledTexturesPool.type            = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
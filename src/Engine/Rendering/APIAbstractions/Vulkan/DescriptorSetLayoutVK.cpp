@@ -31,31 +31,43 @@ void DescriptorSetLayoutVK::addBindingUniformBuffer(SHADER_BINDING binding, SHAD
     addBinding((uint32_t)binding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, shaderStages);
 }
 
+void DescriptorSetLayoutVK::addBindingStorageBuffer(SHADER_BINDING binding, SHADER_TYPE shaderStages)
+{
+    addBinding((uint32_t)binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, shaderStages);
+}
+
 void DescriptorSetLayoutVK::addBindingCombinedTextureSampler(SHADER_BINDING binding, SHADER_TYPE shaderStages)
 {
     addBinding((uint32_t)binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, shaderStages);
 }
 
+void DescriptorSetLayoutVK::addBindingCombinedTextureSamplerArray(SHADER_BINDING binding, SHADER_TYPE shaderStages, uint32_t descriptorCount)
+{
+    addBinding((uint32_t)binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, shaderStages, descriptorCount);
+}
+
 DescriptorCounts DescriptorSetLayoutVK::getDescriptorCounts() const
 {
     DescriptorCounts descriptorCounts = {};
     for (const VkDescriptorSetLayoutBinding& binding : m_Bindings) {
         if (binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
-            descriptorCounts.m_UniformBuffers += 1u;
+            descriptorCounts.m_UniformBuffers += binding.descriptorCount;
+        } else if (binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) {
+            descriptorCounts.m_StorageBuffers += binding.descriptorCount;
         } else if (binding.descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
-            descriptorCounts.m_CombinedTextureSamplers += 1u;
+            descriptorCounts.m_CombinedTextureSamplers += binding.descriptorCount;
         }
     }
 
     return descriptorCounts;
 }
 
-void DescriptorSetLayoutVK::addBinding(uint32_t binding, VkDescriptorType descriptorType, SHADER_TYPE shaderStages)
+void DescriptorSetLayoutVK::addBinding(uint32_t binding, VkDescriptorType descriptorType, SHADER_TYPE shaderStages, uint32_t descriptorCount)
 {
     VkDescriptorSetLayoutBinding bindingInfo = {};
     bindingInfo.binding         = binding;
     bindingInfo.descriptorType  = descriptorType;
-    bindingInfo.descriptorCount = 1u;
+    bindingInfo.descriptorCount = descriptorCount;
     bindingInfo.stageFlags      = ShaderVK::convertShaderFlags(shaderStages);
 
     m_Bindings.push_back(bindingInfo);
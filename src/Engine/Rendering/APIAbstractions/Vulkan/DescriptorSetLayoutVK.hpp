@@ -20,13 +20,15 @@ public:
     bool finalize(Device* pDevice) override final;
 
     void addBindingUniformBuffer(SHADER_BINDING binding, SHADER_TYPE shaderStages) override final;
+    void addBindingStorageBuffer(SHADER_BINDING binding, SHADER_TYPE shaderStages) override final;
     void addBindingCombinedTextureSampler(SHADER_BINDING binding, SHADER_TYPE shaderStages) override final;
+    void addBindingCombinedTextureSamplerArray(SHADER_BINDING binding, SHADER_TYPE shaderStages, uint32_t descriptorCount) override final;
 
     DescriptorCounts getDescriptorCounts() const override final;
     inline VkDescriptorSetLayout getDescriptorSetLayout() const { return m_DescriptorSetLayout; }
 
 private:
-    void addBinding(uint32_t binding, VkDescriptorType descriptorType, SHADER_TYPE shaderStages);
+    void addBinding(uint32_t binding, VkDescriptorType descriptorType, SHADER_TYPE shaderStages, uint32_t descriptorCount = 1u);
 
 private:
     VkDescriptorSetLayout m_DescriptorSetLayout;
@@ -21,6 +21,15 @@ void DescriptorSetVK::updateUniformBufferDescriptor(SHADER_BINDING binding, IBuf
     updateDescriptor(binding, nullptr, &bufferInfo, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
 }
 
+void DescriptorSetVK::updateStorageBufferDescriptor(SHADER_BINDING binding, IBuffer* pBuffer)
+{
+    VkDescriptorBufferInfo bufferInfo = {};
+    bufferInfo.buffer = reinterpret_cast<BufferVK*>(pBuffer)->getBuffer();
+    bufferInfo.range  = VK_WHOLE_SIZE;
+
+    updateDescriptor(binding, nullptr, &bufferInfo, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+}
+
 void DescriptorSetVK::updateCombinedTextureSamplerDescriptor(SHADER_BINDING binding, Texture* pTexture, ISampler* pSampler)
 {
     VkDescriptorImageInfo imageInfo = {};
@@ -31,13 +40,23 @@ void DescriptorSetVK::updateCombinedTextureSamplerDescriptor(SHADER_BINDING bind
     updateDescriptor(binding, &imageInfo, nullptr, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
 }
 
-void DescriptorSetVK::updateDescriptor(SHADER_BINDING binding, const VkDescriptorImageInfo* pImageInfo, const VkDescriptorBufferInfo* pBufferInfo, VkDescriptorType descriptorType)
+void DescriptorSetVK::updateCombinedTextureSamplerArrayDescriptor(SHADER_BINDING binding, uint32_t arrayIndex, Texture* pTexture, ISampler* pSampler)
+{
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.sampler       = reinterpret_cast<SamplerVK*>(pSampler)->getSampler();
+    imageInfo.imageView     = reinterpret_cast<TextureVK*>(pTexture)->getImageView();
+    imageInfo.imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    updateDescriptor(binding, &imageInfo, nullptr, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, arrayIndex);
+}
+
+void DescriptorSetVK::updateDescriptor(SHADER_BINDING binding, const VkDescriptorImageInfo* pImageInfo, const VkDescriptorBufferInfo* pBufferInfo, VkDescriptorType descriptorType, uint32_t arrayIndex)
 {
     VkWriteDescriptorSet writeInfo = {};
     writeInfo.sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     writeInfo.dstSet            = m_DescriptorSet;
     writeInfo.dstBinding        = (uint32_t)binding;
-    writeInfo.dstArrayElement   = 0u;
+    writeInfo.dstArrayElement   = arrayIndex;
     writeInfo.descriptorCount   = 1u;
     writeInfo.descriptorType    = descriptorType;
     writeInfo.pImageInfo        = pImageInfo;
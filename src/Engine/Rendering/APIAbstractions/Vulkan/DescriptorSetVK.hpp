@@ -15,12 +15,14 @@ public:
     ~DescriptorSetVK() = default;
 
     void updateUniformBufferDescriptor(SHADER_BINDING binding, IBuffer* pBuffer) override final;
+    void updateStorageBufferDescriptor(SHADER_BINDING binding, IBuffer* pBuffer) override final;
     void updateCombinedTextureSamplerDescriptor(SHADER_BINDING binding, Texture* pTexture, ISampler* pSampler) override final;
+    void updateCombinedTextureSamplerArrayDescriptor(SHADER_BINDING binding, uint32_t arrayIndex, Texture* pTexture, ISampler* pSampler) override final;
 
     inline VkDescriptorSet getDescriptorSet() const { return m_DescriptorSet; }
 
 private:
-    void updateDescriptor(SHADER_BINDING binding, const VkDescriptorImageInfo* pImageInfo, const VkDescriptorBufferInfo* pBufferInfo, VkDescriptorType descriptorType);
+    void updateDescriptor(SHADER_BINDING binding, const VkDescriptorImageInfo* pImageInfo, const VkDescriptorBufferInfo* pBufferInfo, VkDescriptorType descriptorType, uint32_t arrayIndex = 0u);
 
 private:
     VkDescriptorSet m_DescriptorSet;
@@ -66,6 +66,7 @@ Device* DeviceCreatorVK::createDevice(const SwapchainInfo& swapChainInfo, const
     deviceInfo.DebugMessenger       = m_DebugMessenger;
     deviceInfo.QueueFamilyIndices   = m_QueueFamilyIndices;
     deviceInfo.QueueHandles         = m_Queues;
+    deviceInfo.Features             = m_Features;
 
     return DBG_NEW DeviceVK(deviceInfo);
 }
@@ -324,11 +325,46 @@ bool DeviceCreatorVK::initLogicalDevice()
         queueInfos.push_back(queueInfo);
     }
 
+    VkPhysicalDeviceFeatures supportedFeatures = {};
+    vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &supportedFeatures);
+
+    // Timeline semaphores are core in Vulkan 1.2, older devices upload resources on the graphics queue instead
+    VkPhysicalDeviceProperties deviceProperties = {};
+    vkGetPhysicalDeviceProperties(m_PhysicalDevice, &deviceProperties);
+
+    VkPhysicalDeviceVulkan12Features supportedFeatures12 = {};
+    supportedFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    if (deviceProperties.apiVersion >= VK_MAKE_VERSION(1, 2, 0)) {
+        VkPhysicalDeviceFeatures2 supportedFeatures2 = {};
+        supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures2.pNext = &supportedFeatures12;
+        vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &supportedFeatures2);
+    }
+
+    VkPhysicalDeviceVulkan12Features deviceFeatures12 = {};
+    deviceFeatures12.sType              = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    deviceFeatures12.timelineSemaphore  = supportedFeatures12.timelineSemaphore;
+
     VkPhysicalDeviceFeatures deviceFeatures = {};
     deviceFeatures.samplerAnisotropy    = VK_TRUE;
 
+    // Indirect draws identify their per-draw data using the first instance
+    deviceFeatures.drawIndirectFirstInstance    = supportedFeatures.drawIndirectFirstInstance;
+    deviceFeatures.multiDrawIndirect            = supportedFeatures.multiDrawIndirect;
+    deviceFeatures.shaderSampledImageArrayDynamicIndexing = supportedFeatures.shaderSampledImageArrayDynamicIndexing;
+    deviceFeatures.textureCompressionBC         = supportedFeatures.textureCompressionBC;
+
+    m_Features = {};
+    m_Features.IndirectDrawing      = supportedFeatures.drawIndirectFirstInstance;
+    m_Features.MultiDrawIndirect    = supportedFeatures.multiDrawIndirect;
+    m_Features.DynamicTextureArrayIndexing = supportedFeatures.shaderSampledImageArrayDynamicIndexing;
+    m_Features.TimelineSemaphores   = supportedFeatures12.timelineSemaphore;
+    m_Features.TextureCompressionBC = supportedFeatures.textureCompressionBC;
+
     VkDeviceCreateInfo deviceInfo = {};
     deviceInfo.sType                    = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceInfo.pNext                    = deviceProperties.apiVersion >= VK_MAKE_VERSION(1, 2, 0) ? &deviceFeatures12 : nullptr;
     deviceInfo.queueCreateInfoCount     = (uint32_t)queueInfos.size();
     deviceInfo.pQueueCreateInfos        = queueInfos.data();
     deviceInfo.enabledLayerCount        = (uint32_t)g_RequiredLayerNames.size();
@@ -464,7 +500,7 @@ bool DeviceCreatorVK::initBackbuffersAndDepthTextures(DeviceVK* pDevice)
     depthTextureInfo.Usage          = TEXTURE_USAGE::DEPTH_STENCIL;
 
     for (uint32_t backbufferIdx = 0u; backbufferIdx < MAX_FRAMES_IN_FLIGHT; backbufferIdx += 1u) {
-        m_ppBackbuffers[backbufferIdx] = DBG_NEW TextureVK(m_SwapchainResolution, backbufferFormat, pDevice,
+        m_ppBackbuffers[backbufferIdx] = DBG_NEW TextureVK(m_SwapchainResolution, backbufferFormat, 1u, pDevice,
             m_SwapchainImages[backbufferIdx], m_SwapchainImageViews[backbufferIdx], VK_NULL_HANDLE);
 
         m_ppDepthTextures[backbufferIdx] = TextureVK::create(depthTextureInfo, pDevice);
@@ -62,4 +62,5 @@ private:
 
     QueueFamilyIndices m_QueueFamilyIndices;
     Queues m_Queues;
+    DeviceFeatures m_Features;
 };
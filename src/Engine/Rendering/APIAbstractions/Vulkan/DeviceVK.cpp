@@ -15,7 +15,9 @@
 #include <Engine/Rendering/APIAbstractions/Vulkan/ShaderVK.hpp>
 #include <Engine/Rendering/APIAbstractions/Vulkan/SwapchainVK.hpp>
 #include <Engine/Rendering/APIAbstractions/Vulkan/TextureVK.hpp>
+#include <Engine/Rendering/APIAbstractions/Vulkan/UploadQueueVK.hpp>
 #include <Engine/Rendering/Window.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
 
 #define VMA_IMPLEMENTATION
 
@@ -25,20 +27,31 @@
 
 #include <vulkan/vulkan_win32.h>
 
+#include <algorithm>
+#include <fstream>
+
 DeviceVK::DeviceVK(const DeviceInfoVK& deviceInfo)
-    :Device(deviceInfo.QueueFamilyIndices),
+    :Device(deviceInfo.QueueFamilyIndices, deviceInfo.Features),
     m_Instance(deviceInfo.Instance),
     m_PhysicalDevice(deviceInfo.PhysicalDevice),
     m_Device(deviceInfo.Device),
     m_Surface(deviceInfo.Surface),
     m_Allocator(deviceInfo.Allocator),
     m_DebugMessenger(deviceInfo.DebugMessenger),
-    m_QueueHandles(deviceInfo.QueueHandles)
-{}
+    m_QueueHandles(deviceInfo.QueueHandles),
+    m_PipelineCache(VK_NULL_HANDLE),
+    m_CompilePipelinesInParallel(true)
+{
+    initPipelineCache();
+}
 
 DeviceVK::~DeviceVK()
 {
+    joinPipelineCompilations();
     deleteGraphicsObjects();
+
+    savePipelineCache();
+    vkDestroyPipelineCache(m_Device, m_PipelineCache, nullptr);
     vmaDestroyAllocator(m_Allocator);
 
     #ifdef CONFIG_DEBUG
@@ -87,20 +100,17 @@ bool DeviceVK::computeQueueSubmit(ICommandList* pCommandList, IFence* pFence, co
 
 void DeviceVK::map(IBuffer* pBuffer, void** ppMappedMemory)
 {
-    BufferVK* pBufferVK = reinterpret_cast<BufferVK*>(pBuffer);
-    VmaAllocationInfo allocationInfo = pBufferVK->getAllocationInfo();
-
-    if (vkMapMemory(m_Device, allocationInfo.deviceMemory, allocationInfo.offset, VK_WHOLE_SIZE, 0, ppMappedMemory) != VK_SUCCESS) {
-        LOG_WARNING("Failed to map buffer memory");
+    // CPU-accessible buffers are persistently mapped
+    *ppMappedMemory = reinterpret_cast<BufferVK*>(pBuffer)->getMappedData();
+    if (!*ppMappedMemory) {
+        LOG_WARNING("Attempted to map a buffer that is not CPU-accessible");
     }
 }
 
 void DeviceVK::unmap(IBuffer* pBuffer)
 {
-    BufferVK* pBufferVK = reinterpret_cast<BufferVK*>(pBuffer);
-    VmaAllocationInfo allocationInfo = pBufferVK->getAllocationInfo();
-
-    vkUnmapMemory(m_Device, allocationInfo.deviceMemory);
+    // The buffer stays mapped, but writes to non-coherent memory have to be flushed
+    reinterpret_cast<BufferVK*>(pBuffer)->flush(0u, VK_WHOLE_SIZE);
 }
 
 ICommandPool* DeviceVK::createCommandPool(COMMAND_POOL_FLAG creationFlags, uint32_t queueFamilyIndex)
@@ -130,7 +140,46 @@ IPipelineLayout* DeviceVK::createPipelineLayout(const std::vector<IDescriptorSet
 
 IPipeline* DeviceVK::createPipeline(const PipelineInfo& pipelineInfo)
 {
-    return PipelineVK::create(pipelineInfo, this);
+    PipelineVK* pPipeline = PipelineVK::create(pipelineInfo, this);
+    if (!pPipeline) {
+        return nullptr;
+    }
+
+    if (m_CompilePipelinesInParallel) {
+        // The pipeline info is copied as the caller's copy does not outlive the compilation
+        m_PipelineCompilations.push_back(ThreadPool::GetInstance().Execute([pPipeline, pipelineInfo]() {
+            pPipeline->compile(pipelineInfo);
+        }));
+
+        m_CompilingPipelines.push_back(pPipeline);
+    } else if (!pPipeline->compile(pipelineInfo)) {
+        delete pPipeline;
+        return nullptr;
+    }
+
+    return pPipeline;
+}
+
+bool DeviceVK::waitForPipelines()
+{
+    m_CompilePipelinesInParallel = false;
+    return joinPipelineCompilations();
+}
+
+bool DeviceVK::joinPipelineCompilations()
+{
+    ThreadPool& threadPool = ThreadPool::GetInstance();
+    for (size_t compilation : m_PipelineCompilations) {
+        threadPool.Join(compilation);
+    }
+
+    const bool compiledAll = std::all_of(m_CompilingPipelines.begin(), m_CompilingPipelines.end(), [](PipelineVK* pPipeline) {
+        return pPipeline->getPipeline() != VK_NULL_HANDLE;
+    });
+
+    m_PipelineCompilations.clear();
+    m_CompilingPipelines.clear();
+    return compiledAll;
 }
 
 FenceVK* DeviceVK::createFence(bool createSignaled)
@@ -146,45 +195,36 @@ ISemaphore* DeviceVK::createSemaphore()
 BufferVK* DeviceVK::createBuffer(const BufferInfo& bufferInfo, StagingResources* pStagingResources)
 {
     if (bufferInfo.pData && !HAS_FLAG(bufferInfo.CPUAccess, BUFFER_DATA_ACCESS::WRITE) && !pStagingResources) {
-        // Staging resources are needed but none are specified, create temporary ones
-        ICommandList* pTempCommandList = nullptr;
-
-        PooledResource<ICommandPool> tempCommandPool = acquireTempCommandPoolGraphics();
-        if (!tempCommandPool->allocateCommandLists(&pTempCommandList, 1u, COMMAND_LIST_LEVEL::PRIMARY)) {
-            LOG_WARNING("Failed to create temporary command list");
-            return nullptr;
+        // Staging resources are needed but none are specified, upload the data using the upload queue
+        UploadQueueVK* pUploadQueue = getUploadQueueVK();
+
+        BufferInfo uploadedBufferInfo = bufferInfo;
+        uploadedBufferInfo.pData = nullptr;
+        if (pUploadQueue->usesTransferQueue()) {
+            uploadedBufferInfo.SharingMode          = SHARING_MODE::CONCURRENT;
+            uploadedBufferInfo.QueueFamilyIndices   = { getQueueFamilyIndices().Graphics, getQueueFamilyIndices().Transfer };
         }
 
-        CommandListVK* pCommandListVK = reinterpret_cast<CommandListVK*>(pTempCommandList);
-        if (!pCommandListVK->begin(COMMAND_LIST_USAGE::ONE_TIME_SUBMIT, nullptr)) {
+        std::unique_ptr<BufferVK> pBuffer(BufferVK::create(uploadedBufferInfo, this, nullptr));
+        if (!pBuffer) {
             return nullptr;
         }
 
-        StagingResources tempStagingResources = {};
-        tempStagingResources.pCommandList   = pTempCommandList;
-        tempStagingResources.pStagingBuffer = createStagingBuffer(bufferInfo.pData, bufferInfo.ByteSize);
-
-        std::unique_ptr<BufferVK> pBuffer(BufferVK::create(bufferInfo, this, &tempStagingResources));
-
-        if (!pCommandListVK->end()) {
-            return nullptr;
-        }
+        VkBuffer dstBuffer = pBuffer->getBuffer();
+        const VkDeviceSize byteSize = (VkDeviceSize)bufferInfo.ByteSize;
+        const bool uploaded = pUploadQueue->upload(bufferInfo.pData, bufferInfo.ByteSize, [dstBuffer, byteSize](VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize stagingOffset) {
+            VkBufferCopy copyInfo = {};
+            copyInfo.srcOffset  = stagingOffset;
+            copyInfo.size       = byteSize;
 
-        IFence* pFence = createFence(false);
+            vkCmdCopyBuffer(commandBuffer, stagingBuffer, dstBuffer, 1u, &copyInfo);
+        });
 
-        if (!graphicsQueueSubmit(pCommandListVK, pFence, nullptr)) {
+        if (!uploaded) {
+            LOG_WARNING("Failed to upload buffer data");
             return nullptr;
         }
 
-        std::thread deleterThread([pFence, tempStagingResources, pTempCommandList, tempCommandPool, this]() mutable {
-            waitForFences(&pFence, 1u, false, UINT64_MAX);
-            delete pFence;
-            delete tempStagingResources.pStagingBuffer;
-            delete pTempCommandList;
-            tempCommandPool.release();
-        });
-        deleterThread.detach();
-
         return pBuffer.release();
     }
 
@@ -237,16 +277,122 @@ bool DeviceVK::waitForFences(IFence** ppFences, uint32_t fenceCount, bool waitAl
 
 void DeviceVK::waitIdle()
 {
+    // Waiting for the device to become idle accesses all of its queues
+    std::scoped_lock<std::mutex, std::mutex, std::mutex, std::mutex> lock(m_QueueLocks[0], m_QueueLocks[1], m_QueueLocks[2], m_QueueLocks[3]);
     if (vkDeviceWaitIdle(m_Device) != VK_SUCCESS) {
         LOG_ERROR("Failed to wait for device to become idle");
     }
 }
 
+std::mutex& DeviceVK::getQueueLock(VkQueue queue)
+{
+    const std::array<VkQueue, 4u> queues = { m_QueueHandles.Graphics, m_QueueHandles.Transfer, m_QueueHandles.Compute, m_QueueHandles.Present };
+    const size_t queueIdx = size_t(std::find(queues.begin(), queues.end(), queue) - queues.begin());
+    ASSERT_MSG(queueIdx < queues.size(), "Queue does not belong to the device");
+
+    return m_QueueLocks[queueIdx];
+}
+
 DescriptorPool* DeviceVK::createDescriptorPool(const DescriptorPoolInfo& poolInfo)
 {
     return DescriptorPoolVK::create(poolInfo, this);
 }
 
+bool DeviceVK::initUploadQueue()
+{
+    m_pUploadQueue = UploadQueueVK::create(this);
+    return m_pUploadQueue;
+}
+
+void DeviceVK::initPipelineCache()
+{
+    std::vector<char> cacheData;
+
+    std::ifstream file(PIPELINE_CACHE_PATH, std::ios::binary);
+    if (file.is_open()) {
+        const PipelineCacheFileHeader expectedHeader = createPipelineCacheFileHeader();
+        PipelineCacheFileHeader header = {};
+        file.read((char*)&header, sizeof(PipelineCacheFileHeader));
+
+        const bool headerMatches =
+            file.gcount() == sizeof(PipelineCacheFileHeader) &&
+            header.FileVersion      == expectedHeader.FileVersion &&
+            header.VendorID         == expectedHeader.VendorID &&
+            header.DeviceID         == expectedHeader.DeviceID &&
+            header.DriverVersion    == expectedHeader.DriverVersion &&
+            std::memcmp(header.PipelineCacheUUID, expectedHeader.PipelineCacheUUID, VK_UUID_SIZE) == 0;
+
+        if (headerMatches) {
+            cacheData.resize((size_t)header.DataSize);
+            file.read(cacheData.data(), cacheData.size());
+            if ((size_t)file.gcount() != cacheData.size()) {
+                LOG_WARNING("Pipeline cache file is truncated, discarding it");
+                cacheData.clear();
+            }
+        } else {
+            LOG_INFO("Pipeline cache file was written by a different device or driver, discarding it");
+        }
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo = {};
+    cacheInfo.sType             = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize   = cacheData.size();
+    cacheInfo.pInitialData      = cacheData.data();
+
+    if (vkCreatePipelineCache(m_Device, &cacheInfo, nullptr, &m_PipelineCache) != VK_SUCCESS) {
+        LOG_WARNING("Failed to create pipeline cache, pipelines will be compiled without one");
+        m_PipelineCache = VK_NULL_HANDLE;
+    } else {
+        LOG_INFOF("Created pipeline cache with %ld bytes of initial data", cacheData.size());
+    }
+}
+
+void DeviceVK::savePipelineCache()
+{
+    if (m_PipelineCache == VK_NULL_HANDLE) {
+        return;
+    }
+
+    size_t dataSize = 0u;
+    if (vkGetPipelineCacheData(m_Device, m_PipelineCache, &dataSize, nullptr) != VK_SUCCESS) {
+        LOG_WARNING("Failed to retrieve pipeline cache size");
+        return;
+    }
+
+    std::vector<char> cacheData(dataSize);
+    if (vkGetPipelineCacheData(m_Device, m_PipelineCache, &dataSize, cacheData.data()) != VK_SUCCESS) {
+        LOG_WARNING("Failed to retrieve pipeline cache data");
+        return;
+    }
+
+    PipelineCacheFileHeader header = createPipelineCacheFileHeader();
+    header.DataSize = dataSize;
+
+    std::ofstream file(PIPELINE_CACHE_PATH, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_WARNINGF("Failed to open pipeline cache file for writing: %s", PIPELINE_CACHE_PATH);
+        return;
+    }
+
+    file.write((const char*)&header, sizeof(PipelineCacheFileHeader));
+    file.write(cacheData.data(), dataSize);
+}
+
+PipelineCacheFileHeader DeviceVK::createPipelineCacheFileHeader() const
+{
+    VkPhysicalDeviceProperties deviceProperties = {};
+    vkGetPhysicalDeviceProperties(m_PhysicalDevice, &deviceProperties);
+
+    PipelineCacheFileHeader header = {};
+    header.FileVersion      = PIPELINE_CACHE_FILE_VERSION;
+    header.VendorID         = deviceProperties.vendorID;
+    header.DeviceID         = deviceProperties.deviceID;
+    header.DriverVersion    = deviceProperties.driverVersion;
+    std::memcpy(header.PipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    return header;
+}
+
 VKAPI_ATTR VkBool32 VKAPI_CALL DeviceVK::vulkanCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, VkDebugUtilsMessageTypeFlagsEXT messageType, const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, void* pUserData)
 {
     UNREFERENCED_VARIABLE(pUserData);
@@ -291,8 +437,18 @@ bool DeviceVK::executeCommandBuffer(VkQueue queue, ICommandList* pCommandList, I
         signalSemaphores[semaphoreIdx] = reinterpret_cast<SemaphoreVK*>(pSemaphoreInfo->ppSignalSemaphores[semaphoreIdx])->getSemaphore();
     }
 
+    // Timeline semaphore values are only specified if any are given
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount    = pSemaphoreInfo && pSemaphoreInfo->pWaitValues ? (uint32_t)waitSemaphores.size() : 0u;
+    timelineInfo.pWaitSemaphoreValues       = pSemaphoreInfo ? pSemaphoreInfo->pWaitValues : nullptr;
+    timelineInfo.signalSemaphoreValueCount  = pSemaphoreInfo && pSemaphoreInfo->pSignalValues ? (uint32_t)signalSemaphores.size() : 0u;
+    timelineInfo.pSignalSemaphoreValues     = pSemaphoreInfo ? pSemaphoreInfo->pSignalValues : nullptr;
+    const bool hasTimelineValues = timelineInfo.waitSemaphoreValueCount || timelineInfo.signalSemaphoreValueCount;
+
     VkSubmitInfo submitInfo = {};
     submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext                = hasTimelineValues ? &timelineInfo : nullptr;
     submitInfo.commandBufferCount   = 1u;
     submitInfo.pCommandBuffers      = &commandBuffer;
     submitInfo.pWaitSemaphores      = waitSemaphores.data();
@@ -301,5 +457,6 @@ bool DeviceVK::executeCommandBuffer(VkQueue queue, ICommandList* pCommandList, I
     submitInfo.pSignalSemaphores    = signalSemaphores.data();
     submitInfo.signalSemaphoreCount = (uint32_t)signalSemaphores.size();
 
+    std::scoped_lock<std::mutex> lock(getQueueLock(queue));
     return vkQueueSubmit(queue, 1u, &submitInfo, fence) == VK_SUCCESS;
 }
@@ -8,8 +8,17 @@
 
 #include <vma/vk_mem_alloc.h>
 
+#include <array>
+#include <mutex>
+
 class DeviceCreatorVK;
+class PipelineVK;
 class SwapchainVK;
+class UploadQueueVK;
+
+#define PIPELINE_CACHE_PATH "pipeline_cache.bin"
+// Incremented whenever the layout of the pipeline cache file changes
+#define PIPELINE_CACHE_FILE_VERSION 1u
 
 struct Queues {
     VkQueue Graphics;
@@ -27,6 +36,18 @@ struct DeviceInfoVK {
     VkDebugUtilsMessengerEXT DebugMessenger;
     QueueFamilyIndices QueueFamilyIndices;
     Queues QueueHandles;
+    DeviceFeatures Features;
+};
+
+/*  Precedes the pipeline cache data in the cache file. Drivers are supposed to reject incompatible cache data, but not
+    all do, so the cache is discarded unless it was written by the same device and driver. */
+struct PipelineCacheFileHeader {
+    uint32_t FileVersion;
+    uint32_t VendorID;
+    uint32_t DeviceID;
+    uint32_t DriverVersion;
+    uint8_t PipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t DataSize;
 };
 
 class DeviceVK : public Device
@@ -48,6 +69,9 @@ public:
 
     IPipelineLayout* createPipelineLayout(const std::vector<IDescriptorSetLayout*>& descriptorSetLayouts) override final;
     IPipeline* createPipeline(const PipelineInfo& pipelineInfo) override final;
+    bool waitForPipelines() override final;
+    // Waits for pipelines being compiled on the thread pool. Returns false if any of them failed to compile.
+    bool joinPipelineCompilations();
 
     void map(IBuffer* pBuffer, void** ppMappedMemory) override final;
     void unmap(IBuffer* pBuffer) override final;
@@ -71,10 +95,16 @@ public:
 
     VmaAllocator getVulkanAllocator()   { return m_Allocator; }
     VkDevice getDevice()                { return m_Device; }
+    VkPipelineCache getPipelineCache()  { return m_PipelineCache; }
     const Queues& getQueues() const     { return m_QueueHandles; }
+    /*  Vulkan requires access to each queue to be externally synchronized. Hold the queue's lock when submitting to or
+        presenting on it, as uploads are submitted from loading threads as well. */
+    std::mutex& getQueueLock(VkQueue queue);
+    UploadQueueVK* getUploadQueueVK()   { return reinterpret_cast<UploadQueueVK*>(m_pUploadQueue); }
 
 protected:
     DescriptorPool* createDescriptorPool(const DescriptorPoolInfo& poolInfo) override final;
+    bool initUploadQueue() override final;
 
 private:
     friend DeviceCreatorVK;
@@ -84,6 +114,11 @@ private:
     Shader* compileShader(SHADER_TYPE shaderType, const std::string& filePath, const InputLayoutInfo* pInputLayoutInfo) override final;
     bool executeCommandBuffer(VkQueue queue, ICommandList* pCommandList, IFence* pFence, const SemaphoreSubmitInfo* pSemaphoreInfo);
 
+    // Creates the pipeline cache, using the cache file's data if it was written by this device and driver
+    void initPipelineCache();
+    void savePipelineCache();
+    PipelineCacheFileHeader createPipelineCacheFileHeader() const;
+
 private:
     VkInstance m_Instance;
     VkPhysicalDevice m_PhysicalDevice;
@@ -94,4 +129,14 @@ private:
     VkDebugUtilsMessengerEXT m_DebugMessenger;
 
     Queues m_QueueHandles;
+    // One per member of Queues. Queues sharing a handle share the lock of the first of them.
+    std::array<std::mutex, 4u> m_QueueLocks;
+
+    // Shared by all pipelines. VK_NULL_HANDLE if the cache could not be created.
+    VkPipelineCache m_PipelineCache;
+
+    // Pipelines are compiled on the thread pool until waitForPipelines() is called
+    bool m_CompilePipelinesInParallel;
+    std::vector<size_t> m_PipelineCompilations;
+    std::vector<PipelineVK*> m_CompilingPipelines;
 };
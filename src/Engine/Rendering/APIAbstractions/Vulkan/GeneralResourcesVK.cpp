@@ -42,6 +42,12 @@ VkFormat convertFormatToVK(RESOURCE_FORMAT format)
             return VK_FORMAT_R32G32B32_SFLOAT;
         case RESOURCE_FORMAT::R32G32_FLOAT:
             return VK_FORMAT_R32G32_SFLOAT;
+        case RESOURCE_FORMAT::R32_FLOAT:
+            return VK_FORMAT_R32_SFLOAT;
+        case RESOURCE_FORMAT::R16G16_FLOAT:
+            return VK_FORMAT_R16G16_SFLOAT;
+        case RESOURCE_FORMAT::R16G16_SNORM:
+            return VK_FORMAT_R16G16_SNORM;
         case RESOURCE_FORMAT::B8G8R8A8_UNORM:
             return VK_FORMAT_B8G8R8A8_UNORM;
         case RESOURCE_FORMAT::B8G8R8A8_SRGB:
@@ -50,8 +56,16 @@ VkFormat convertFormatToVK(RESOURCE_FORMAT format)
             return VK_FORMAT_R8G8B8A8_UNORM;
         case RESOURCE_FORMAT::R8G8B8A8_SRGB:
             return VK_FORMAT_R8G8B8A8_SRGB;
+        case RESOURCE_FORMAT::R8_UNORM:
+            return VK_FORMAT_R8_UNORM;
         case RESOURCE_FORMAT::D32_FLOAT:
             return VK_FORMAT_D32_SFLOAT;
+        case RESOURCE_FORMAT::BC1_UNORM:
+            return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case RESOURCE_FORMAT::BC3_UNORM:
+            return VK_FORMAT_BC3_UNORM_BLOCK;
+        case RESOURCE_FORMAT::BC7_UNORM:
+            return VK_FORMAT_BC7_UNORM_BLOCK;
         default:
             LOG_ERROR("Unknown resource format");
             return VK_FORMAT_UNDEFINED;
@@ -67,6 +81,12 @@ RESOURCE_FORMAT convertFormatFromVK(VkFormat format)
             return RESOURCE_FORMAT::R32G32B32_FLOAT;
         case VK_FORMAT_R32G32_SFLOAT:
             return RESOURCE_FORMAT::R32G32_FLOAT;
+        case VK_FORMAT_R32_SFLOAT:
+            return RESOURCE_FORMAT::R32_FLOAT;
+        case VK_FORMAT_R16G16_SFLOAT:
+            return RESOURCE_FORMAT::R16G16_FLOAT;
+        case VK_FORMAT_R16G16_SNORM:
+            return RESOURCE_FORMAT::R16G16_SNORM;
         case VK_FORMAT_B8G8R8A8_UNORM:
             return RESOURCE_FORMAT::B8G8R8A8_UNORM;
         case VK_FORMAT_B8G8R8A8_SRGB:
@@ -75,8 +95,16 @@ RESOURCE_FORMAT convertFormatFromVK(VkFormat format)
             return RESOURCE_FORMAT::R8G8B8A8_UNORM;
         case VK_FORMAT_R8G8B8A8_SRGB:
             return RESOURCE_FORMAT::R8G8B8A8_SRGB;
+        case VK_FORMAT_R8_UNORM:
+            return RESOURCE_FORMAT::R8_UNORM;
         case VK_FORMAT_D32_SFLOAT:
             return RESOURCE_FORMAT::D32_FLOAT;
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+            return RESOURCE_FORMAT::BC1_UNORM;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+            return RESOURCE_FORMAT::BC3_UNORM;
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+            return RESOURCE_FORMAT::BC7_UNORM;
         default:
             LOG_ERROR("Unknown resource format");
             return RESOURCE_FORMAT::R8G8B8A8_UNORM;
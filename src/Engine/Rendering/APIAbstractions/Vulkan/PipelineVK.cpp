@@ -14,21 +14,45 @@ PipelineVK* PipelineVK::create(const PipelineInfo& pipelineInfo, DeviceVK* pDevi
     std::vector<std::shared_ptr<Shader>> shaders;
     shaders.reserve(pipelineInfo.ShaderInfos.size());
 
-    std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
-    shaderStages.reserve(shaders.size());
-
-    InputLayoutInfoVK inputLayoutInfoVK = {};
+    const InputLayoutInfo* pInputLayoutInfo = nullptr;
     ShaderHandler* pShaderHandler = pDevice->getShaderHandler();
     for (const ShaderInfo& shaderInfo : pipelineInfo.ShaderInfos) {
         if (shaderInfo.ShaderType == SHADER_TYPE::VERTEX_SHADER) {
-            const InputLayoutInfo& inputLayoutInfo = pShaderHandler->getInputLayoutInfo(shaderInfo.ShaderName);
-            if (!convertInputLayoutInfo(inputLayoutInfoVK, inputLayoutInfo)) {
-                return nullptr;
-            }
+            pInputLayoutInfo = &pShaderHandler->getInputLayoutInfo(shaderInfo.ShaderName);
         }
 
         shaders.push_back(pShaderHandler->loadShader(shaderInfo.ShaderName, shaderInfo.ShaderType));
-        shaderStages.push_back(writeShaderStageInfo(shaders.back().get()));
+    }
+
+    PipelineVK* pPipeline = DBG_NEW PipelineVK(shaders, pDevice);
+    if (pInputLayoutInfo && !convertInputLayoutInfo(pPipeline->m_InputLayoutInfo, *pInputLayoutInfo)) {
+        delete pPipeline;
+        return nullptr;
+    }
+
+    return pPipeline;
+}
+
+PipelineVK::PipelineVK(std::vector<std::shared_ptr<Shader>>& shaders, DeviceVK* pDevice)
+    :m_Pipeline(VK_NULL_HANDLE),
+    m_Shaders(shaders),
+    m_InputLayoutInfo({}),
+    m_pDevice(pDevice)
+{}
+
+PipelineVK::~PipelineVK()
+{
+    // The pipeline might still be compiling if initialization failed before the device finished its compilations
+    m_pDevice->joinPipelineCompilations();
+    vkDestroyPipeline(m_pDevice->getDevice(), m_Pipeline, nullptr);
+}
+
+bool PipelineVK::compile(const PipelineInfo& pipelineInfo)
+{
+    std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
+    shaderStages.reserve(m_Shaders.size());
+    for (const std::shared_ptr<Shader>& shader : m_Shaders) {
+        shaderStages.push_back(writeShaderStageInfo(shader.get()));
     }
 
     VkPipelineInputAssemblyStateCreateInfo inputAssemblyState = {};
@@ -52,7 +76,7 @@ PipelineVK* PipelineVK::create(const PipelineInfo& pipelineInfo, DeviceVK* pDevi
 
     VkPipelineRasterizationStateCreateInfo rasterizerInfo = {};
     if (!convertRasterizerStateInfo(rasterizerInfo, pipelineInfo.RasterizerStateInfo)) {
-        return nullptr;
+        return false;
     }
 
     VkPipelineMultisampleStateCreateInfo multiSampleState = {};
@@ -61,13 +85,13 @@ PipelineVK* PipelineVK::create(const PipelineInfo& pipelineInfo, DeviceVK* pDevi
 
     VkPipelineDepthStencilStateCreateInfo depthStencilState = {};
     if (!convertDepthStencilStateInfo(depthStencilState, pipelineInfo.DepthStencilStateInfo)) {
-        return nullptr;
+        return false;
     }
 
     VkPipelineColorBlendStateCreateInfo blendState = {};
     std::vector<VkPipelineColorBlendAttachmentState> attachmentBlendStates;
     if (!convertBlendStateInfo(blendState, attachmentBlendStates, pipelineInfo.BlendStateInfo)) {
-        return nullptr;
+        return false;
     }
 
     blendState.pAttachments = attachmentBlendStates.data();
@@ -85,9 +109,9 @@ PipelineVK* PipelineVK::create(const PipelineInfo& pipelineInfo, DeviceVK* pDevi
 
     VkGraphicsPipelineCreateInfo pipelineInfoVK = {};
     pipelineInfoVK.sType                = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfoVK.stageCount           = (uint32_t)pipelineInfo.ShaderInfos.size();
+    pipelineInfoVK.stageCount           = (uint32_t)shaderStages.size();
     pipelineInfoVK.pStages              = shaderStages.data();
-    pipelineInfoVK.pVertexInputState    = &inputLayoutInfoVK.VertexInputState;
+    pipelineInfoVK.pVertexInputState    = &m_InputLayoutInfo.VertexInputState;
     pipelineInfoVK.pInputAssemblyState  = &inputAssemblyState;
     pipelineInfoVK.pViewportState       = &viewportState;
     pipelineInfoVK.pRasterizationState  = &rasterizerInfo;
@@ -99,24 +123,13 @@ PipelineVK* PipelineVK::create(const PipelineInfo& pipelineInfo, DeviceVK* pDevi
     pipelineInfoVK.renderPass           = reinterpret_cast<RenderPassVK*>(pipelineInfo.pRenderPass)->getRenderPass();
     pipelineInfoVK.subpass              = pipelineInfo.Subpass;
 
-    VkPipeline pipeline = VK_NULL_HANDLE;
-    if (vkCreateGraphicsPipelines(pDevice->getDevice(), VK_NULL_HANDLE, 1u, &pipelineInfoVK,  nullptr, &pipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(m_pDevice->getDevice(), m_pDevice->getPipelineCache(), 1u, &pipelineInfoVK, nullptr, &m_Pipeline) != VK_SUCCESS) {
         LOG_ERROR("Failed to create graphics pipeline");
-        return nullptr;
+        m_Pipeline = VK_NULL_HANDLE;
+        return false;
     }
 
-    return DBG_NEW PipelineVK(pipeline, shaders, pDevice);
-}
-
-PipelineVK::PipelineVK(VkPipeline pipeline, std::vector<std::shared_ptr<Shader>>& shaders, DeviceVK* pDevice)
-    :m_Pipeline(pipeline),
-    m_Shaders(shaders),
-    m_pDevice(pDevice)
-{}
-
-PipelineVK::~PipelineVK()
-{
-    vkDestroyPipeline(m_pDevice->getDevice(), m_Pipeline, nullptr);
+    return true;
 }
 
 VkPipelineShaderStageCreateInfo PipelineVK::writeShaderStageInfo(const Shader* pShader)
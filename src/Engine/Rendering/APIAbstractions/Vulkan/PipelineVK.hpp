@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Engine/Rendering/APIAbstractions/Pipeline.hpp>
+#include <Engine/Rendering/APIAbstractions/Vulkan/InputLayoutVK.hpp>
 
 #include <vulkan/vulkan.h>
 
@@ -9,12 +10,17 @@ class DeviceVK;
 class PipelineVK : public IPipeline
 {
 public:
+    // Loads the pipeline's shaders. The pipeline is not usable until compile() has been called.
     static PipelineVK* create(const PipelineInfo& pipelineInfo, DeviceVK* pDevice);
 
 public:
-    PipelineVK(VkPipeline pipeline, std::vector<std::shared_ptr<Shader>>& shaders, DeviceVK* pDevice);
+    PipelineVK(std::vector<std::shared_ptr<Shader>>& shaders, DeviceVK* pDevice);
     ~PipelineVK();
 
+    /*  Creates the pipeline object using the device's pipeline cache. Does not access the shader handler, which allows
+        pipelines to be compiled on worker threads. */
+    bool compile(const PipelineInfo& pipelineInfo);
+
     inline VkPipeline getPipeline() { return m_Pipeline; }
 
 private:
@@ -23,7 +29,8 @@ private:
 
 private:
     VkPipeline m_Pipeline;
-    std::vector<std::shared_ptr<Shader>>& m_Shaders;
+    std::vector<std::shared_ptr<Shader>> m_Shaders;
+    InputLayoutInfoVK m_InputLayoutInfo;
 
     DeviceVK* m_pDevice;
 };
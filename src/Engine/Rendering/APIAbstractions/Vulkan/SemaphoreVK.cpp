@@ -16,6 +16,26 @@ SemaphoreVK* SemaphoreVK::create(DeviceVK* pDevice)
     return DBG_NEW SemaphoreVK(semaphore, pDevice);
 }
 
+SemaphoreVK* SemaphoreVK::createTimeline(uint64_t initialValue, DeviceVK* pDevice)
+{
+    VkSemaphoreTypeCreateInfo typeInfo = {};
+    typeInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType  = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue   = initialValue;
+
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    if (vkCreateSemaphore(pDevice->getDevice(), &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+        LOG_ERROR("Failed to create timeline semaphore");
+        return nullptr;
+    }
+
+    return DBG_NEW SemaphoreVK(semaphore, pDevice);
+}
+
 SemaphoreVK::SemaphoreVK(VkSemaphore semaphore, DeviceVK* pDevice)
     :m_Semaphore(semaphore),
     m_pDevice(pDevice)
@@ -8,6 +8,8 @@ class SemaphoreVK : public ISemaphore
 {
 public:
     static SemaphoreVK* create(DeviceVK* pDevice);
+    // Timeline semaphores require DeviceFeatures::TimelineSemaphores
+    static SemaphoreVK* createTimeline(uint64_t initialValue, DeviceVK* pDevice);
 
 public:
     SemaphoreVK(VkSemaphore semaphore, DeviceVK* pDevice);
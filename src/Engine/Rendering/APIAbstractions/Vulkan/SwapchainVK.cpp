@@ -62,6 +62,7 @@ void SwapchainVK::present(ISemaphore** ppWaitSemaphores, uint32_t waitSemaphoreC
     presentInfo.pResults            = nullptr;
 
     const VkQueue presentQueue = m_pDevice->getQueues().Present;
+    std::scoped_lock<std::mutex> lock(m_pDevice->getQueueLock(presentQueue));
     if (vkQueuePresentKHR(presentQueue, &presentInfo) != VK_SUCCESS) {
         LOG_WARNING("Failed to present swapchain image");
     }
@@ -1,17 +1,14 @@
 #include "TextureVK.hpp"
 
-#include <Engine/Rendering/APIAbstractions/Vulkan/BufferVK.hpp>
-#include <Engine/Rendering/APIAbstractions/Vulkan/CommandListVK.hpp>
-#include <Engine/Rendering/APIAbstractions/Vulkan/CommandPoolVK.hpp>
 #include <Engine/Rendering/APIAbstractions/Vulkan/DeviceVK.hpp>
-#include <Engine/Rendering/APIAbstractions/Vulkan/FenceVK.hpp>
 #include <Engine/Rendering/APIAbstractions/Vulkan/GeneralResourcesVK.hpp>
+#include <Engine/Rendering/APIAbstractions/Vulkan/UploadQueueVK.hpp>
 
-#define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
+#include <cstring>
 #include <memory>
-#include <thread>
+#include <vector>
 
 TextureVK* TextureVK::createFromFile(const std::string& filePath, DeviceVK* pDevice)
 {
@@ -56,61 +53,71 @@ TextureVK* TextureVK::create(const TextureInfo& textureInfo, DeviceVK* pDevice)
         return nullptr;
     }
 
-    std::unique_ptr<TextureVK> pTexture(DBG_NEW TextureVK(textureInfo.Dimensions, textureInfo.Format, pDevice, image, imageView, allocation));
+    std::unique_ptr<TextureVK> pTexture(DBG_NEW TextureVK(textureInfo.Dimensions, textureInfo.Format, textureInfoVK.MipLevels, pDevice, image, imageView, allocation));
 
-    // Create temporary command list for layout conversion, and optionally staging buffer copy
-    PooledResource<ICommandPool> commandPoolTemp = pDevice->acquireTempCommandPoolGraphics();
-    CommandPoolVK* pCommandPoolVK = reinterpret_cast<CommandPoolVK*>(commandPoolTemp.get());
+    // The layout conversion, and the optional copy of the initial data, are recorded into the upload queue's current batch
+    UploadQueueVK* pUploadQueue = pDevice->getUploadQueueVK();
+    bool recorded = false;
 
-    ICommandList* pCommandList = nullptr;
-    if (!pCommandPoolVK->allocateCommandLists(&pCommandList, 1u, COMMAND_LIST_LEVEL::PRIMARY)) {
-        LOG_WARNING("Failed to create temporary command list during texture creation");
-        return nullptr;
-    }
-
-    CommandListVK* pCommandListVK = reinterpret_cast<CommandListVK*>(pCommandList);
-    if (!pCommandListVK->begin(COMMAND_LIST_USAGE::ONE_TIME_SUBMIT, nullptr)) {
-        return nullptr;
-    }
-
-    std::unique_ptr<BufferVK> pStagingBuffer(nullptr);
     if (!textureInfoVK.pInitialData) {
-        TextureLayoutConversionInfo conversionInfo = {
-            .CommandBuffer  = pCommandListVK->getCommandBuffer(),
-            .Image          = image,
-            .AspectMask     = textureInfoVK.AspectMask,
-            .SrcLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
-            .DstLayout      = textureInfoVK.Layout,
-            .SrcStage       = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-            .DstStage       = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
-        };
-
-        if (!convertTextureLayout(conversionInfo)) {
-            LOG_WARNING("Failed to convert image to its desired layout");
-            return nullptr;
-        }
+        recorded = pUploadQueue->recordGraphicsCommands([image, &textureInfoVK](VkCommandBuffer commandBuffer) {
+            TextureLayoutConversionInfo conversionInfo = {
+                .CommandBuffer  = commandBuffer,
+                .Image          = image,
+                .AspectMask     = textureInfoVK.AspectMask,
+                .SrcLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
+                .DstLayout      = textureInfoVK.Layout,
+                .SrcStage       = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                .DstStage       = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+            };
+
+            convertTextureLayout(conversionInfo);
+        });
     } else {
-        pStagingBuffer.reset(createStagingBuffer(textureInfoVK, textureInfo.Format, pDevice));
-        if (!pStagingBuffer) {
-            LOG_WARNING("Failed to create staging buffer during texture creation");
-            return nullptr;
+        const bool onTransferQueue = pUploadQueue->usesTransferQueue();
+
+        /*  The mip levels are uploaded in a single staging allocation. Mip levels that are not already stored back to back,
+            or that need padding to keep the following mip level aligned, are packed first. */
+        const void* pData = textureInfoVK.pInitialData[0].pData;
+        std::vector<uint8_t> packedMips;
+
+        size_t byteSize = 0u;
+        bool requiresPacking = false;
+        for (uint32_t mipLevel = 0u; mipLevel < textureInfoVK.MipLevels; mipLevel += 1u) {
+            const glm::uvec2 mipDimensions = getMipDimensions(textureInfoVK.Dimensions, mipLevel);
+            requiresPacking |= textureInfoVK.pInitialData[mipLevel].pData != (const uint8_t*)pData + byteSize;
+            requiresPacking |= getStagingMipSize(textureInfo.Format, mipDimensions) != getTextureSize(textureInfo.Format, mipDimensions);
+            byteSize += getStagingMipSize(textureInfo.Format, mipDimensions);
         }
 
-        if (!setInitialData(pTexture.get(), textureInfoVK, pStagingBuffer.get(), pCommandListVK)) {
-           return nullptr;
+        if (requiresPacking) {
+            packedMips.resize(byteSize, 0u);
+
+            size_t mipOffset = 0u;
+            for (uint32_t mipLevel = 0u; mipLevel < textureInfoVK.MipLevels; mipLevel += 1u) {
+                const glm::uvec2 mipDimensions = getMipDimensions(textureInfoVK.Dimensions, mipLevel);
+                std::memcpy(packedMips.data() + mipOffset, textureInfoVK.pInitialData[mipLevel].pData, getTextureSize(textureInfo.Format, mipDimensions));
+                mipOffset += getStagingMipSize(textureInfo.Format, mipDimensions);
+            }
+
+            pData = packedMips.data();
         }
+
+        recorded = pUploadQueue->upload(pData, byteSize, [image, &textureInfoVK, onTransferQueue](VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize stagingOffset) {
+            setInitialData(commandBuffer, image, textureInfoVK, stagingBuffer, stagingOffset, onTransferQueue);
+        });
     }
 
-    if (!submitTempCommandList(pCommandListVK, commandPoolTemp, pStagingBuffer.get(), pDevice)) {
+    if (!recorded) {
+        LOG_WARNING("Failed to record texture upload");
         return nullptr;
     }
 
-    pStagingBuffer.release();
     return pTexture.release();
 }
 
-TextureVK::TextureVK(const glm::uvec2& dimensions, RESOURCE_FORMAT format, DeviceVK* pDevice, VkImage image, VkImageView imageView, VmaAllocation allocation)
-    :Texture(dimensions, format),
+TextureVK::TextureVK(const glm::uvec2& dimensions, RESOURCE_FORMAT format, uint32_t mipLevels, DeviceVK* pDevice, VkImage image, VkImageView imageView, VmaAllocation allocation)
+    :Texture(dimensions, format, mipLevels),
     m_pDevice(pDevice),
     m_Image(image),
     m_ImageView(imageView),
@@ -147,11 +154,11 @@ bool TextureVK::convertTextureLayout(VkCommandBuffer commandBuffer, TEXTURE_LAYO
     return convertTextureLayout(conversionInfo);
 }
 
-bool TextureVK::setInitialData(TextureVK* pTexture, const TextureInfoVK& textureInfo, BufferVK* pStagingBuffer, CommandListVK* pCommandList)
+bool TextureVK::setInitialData(VkCommandBuffer commandBuffer, VkImage image, const TextureInfoVK& textureInfo, VkBuffer stagingBuffer, VkDeviceSize stagingOffset, bool onTransferQueue)
 {
     TextureLayoutConversionInfo conversionInfo = {
-        .CommandBuffer  = pCommandList->getCommandBuffer(),
-        .Image          = pTexture->getImage(),
+        .CommandBuffer  = commandBuffer,
+        .Image          = image,
         .AspectMask     = textureInfo.AspectMask,
         .SrcLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
         .DstLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -164,12 +171,34 @@ bool TextureVK::setInitialData(TextureVK* pTexture, const TextureInfoVK& texture
         return false;
     }
 
-    pCommandList->copyBufferToTexture(pStagingBuffer, pTexture, textureInfo.Dimensions.x, textureInfo.Dimensions.y);
+    const RESOURCE_FORMAT format = convertFormatFromVK(textureInfo.Format);
+    std::vector<VkBufferImageCopy> copyInfos(textureInfo.MipLevels);
+    VkDeviceSize mipOffset = stagingOffset;
+
+    for (uint32_t mipLevel = 0u; mipLevel < textureInfo.MipLevels; mipLevel += 1u) {
+        const glm::uvec2 mipDimensions = getMipDimensions(textureInfo.Dimensions, mipLevel);
+
+        VkBufferImageCopy& copyInfo = copyInfos[mipLevel];
+        copyInfo.bufferOffset       = mipOffset;
+        copyInfo.bufferRowLength    = 0u;
+        copyInfo.bufferImageHeight  = 0u;
+        copyInfo.imageSubresource.aspectMask        = textureInfo.AspectMask;
+        copyInfo.imageSubresource.mipLevel          = mipLevel;
+        copyInfo.imageSubresource.baseArrayLayer    = 0u;
+        copyInfo.imageSubresource.layerCount        = 1u;
+        copyInfo.imageOffset    = {0u, 0u, 0u};
+        copyInfo.imageExtent    = {mipDimensions.x, mipDimensions.y, 1u};
+
+        mipOffset += (VkDeviceSize)getStagingMipSize(format, mipDimensions);
+    }
+
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, textureInfo.MipLevels, copyInfos.data());
 
     conversionInfo.SrcLayout    = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
     conversionInfo.DstLayout    = textureInfo.Layout;
     conversionInfo.SrcStage     = VK_PIPELINE_STAGE_TRANSFER_BIT;
     conversionInfo.DstStage     = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    conversionInfo.OmitDstAccess = onTransferQueue;
 
     if (!convertTextureLayout(conversionInfo)) {
         LOG_WARNING("Failed to convert image to its desired layout");
@@ -179,50 +208,6 @@ bool TextureVK::setInitialData(TextureVK* pTexture, const TextureInfoVK& texture
     return true;
 }
 
-BufferVK* TextureVK::createStagingBuffer(const TextureInfoVK& textureInfo, RESOURCE_FORMAT format, DeviceVK* pDevice)
-{
-    BufferInfo bufferInfo = {};
-    bufferInfo.ByteSize     = size_t(textureInfo.Dimensions.x) * textureInfo.Dimensions.y * getFormatSize(format);
-    bufferInfo.pData        = textureInfo.pInitialData->pData;
-    bufferInfo.CPUAccess    = BUFFER_DATA_ACCESS::WRITE;
-    bufferInfo.GPUAccess    = BUFFER_DATA_ACCESS::READ;
-    bufferInfo.Usage        = BUFFER_USAGE::STAGING_BUFFER;
-    bufferInfo.QueueFamilyIndices   = { pDevice->getQueueFamilyIndices().Graphics };
-
-    return pDevice->createBuffer(bufferInfo, nullptr);
-}
-
-bool TextureVK::submitTempCommandList(CommandListVK* pCommandList, PooledResource<ICommandPool>& tempCommandPool, BufferVK* pStagingBuffer, DeviceVK* pDevice)
-{
-    if (!pCommandList->end()) {
-        return false;
-    }
-
-    FenceVK* pFence = pDevice->createFence(false);
-    if (!pFence) {
-        return false;
-    }
-
-    if (!pDevice->graphicsQueueSubmit(pCommandList, pFence, nullptr)) {
-        return false;
-    }
-
-    // Have a separate thread delete the temporary command list and fence when the commands have finished
-    std::function<void()> commandsFinishedFnc = [pFence, pDevice, pStagingBuffer, pCommandList, tempCommandPool]() mutable {
-        IFence* pIFence = pFence;
-        pDevice->waitForFences(&pIFence, 1u, false, (uint64_t)std::pow(10u, 10u)); // Wait a maximum of 10 seconds
-        delete pFence;
-        delete pStagingBuffer;
-        delete pCommandList;
-        tempCommandPool.release();
-    };
-
-    std::thread destructorThread(commandsFinishedFnc);
-    destructorThread.detach();
-
-    return true;
-}
-
 bool TextureVK::createImage(VkImage& image, VmaAllocation& allocation, const TextureInfoVK& textureInfo, DeviceVK* pDevice)
 {
     VkImageCreateInfo imageInfo = {};
@@ -231,7 +216,7 @@ bool TextureVK::createImage(VkImage& image, VmaAllocation& allocation, const Tex
     imageInfo.extent.width  = textureInfo.Dimensions.x;
     imageInfo.extent.height = textureInfo.Dimensions.y;
     imageInfo.extent.depth  = 1;
-    imageInfo.mipLevels     = 1;
+    imageInfo.mipLevels     = textureInfo.MipLevels;
     imageInfo.arrayLayers   = 1;
     imageInfo.format        = textureInfo.Format;
     imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
@@ -240,6 +225,15 @@ bool TextureVK::createImage(VkImage& image, VmaAllocation& allocation, const Tex
     imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
     imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
 
+    // Images uploaded on the transfer queue are read on the graphics queue
+    const QueueFamilyIndices& queueFamilyIndices = pDevice->getQueueFamilyIndices();
+    const uint32_t pSharingQueueFamilies[] = { queueFamilyIndices.Graphics, queueFamilyIndices.Transfer };
+    if (textureInfo.pInitialData && pDevice->getUploadQueueVK()->usesTransferQueue()) {
+        imageInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+        imageInfo.queueFamilyIndexCount = 2u;
+        imageInfo.pQueueFamilyIndices   = pSharingQueueFamilies;
+    }
+
     if (vkCreateImage(pDevice->getDevice(), &imageInfo, nullptr, &image) != VK_SUCCESS) {
         LOG_WARNING("Failed to create image");
         return false;
@@ -272,7 +266,7 @@ VkImageView TextureVK::createImageView(VkImage image, const TextureInfoVK& textu
     viewInfo.format     = textureInfo.Format;
     viewInfo.subresourceRange.aspectMask        = textureInfo.AspectMask;
     viewInfo.subresourceRange.baseMipLevel      = 0;
-    viewInfo.subresourceRange.levelCount        = 1;
+    viewInfo.subresourceRange.levelCount        = textureInfo.MipLevels;
     viewInfo.subresourceRange.baseArrayLayer    = 0;
     viewInfo.subresourceRange.layerCount        = 1;
 
@@ -290,7 +284,7 @@ bool TextureVK::convertTextureLayout(const TextureLayoutConversionInfo& conversi
     VkImageMemoryBarrier barrierInfo = {};
     barrierInfo.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrierInfo.srcAccessMask       = layoutToAccessMask(conversionInfo.SrcLayout);
-    barrierInfo.dstAccessMask       = layoutToAccessMask(conversionInfo.DstLayout);
+    barrierInfo.dstAccessMask       = conversionInfo.OmitDstAccess ? 0u : layoutToAccessMask(conversionInfo.DstLayout);
     barrierInfo.oldLayout           = conversionInfo.SrcLayout;
     barrierInfo.newLayout           = conversionInfo.DstLayout;
     barrierInfo.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -298,7 +292,7 @@ bool TextureVK::convertTextureLayout(const TextureLayoutConversionInfo& conversi
     barrierInfo.image               = conversionInfo.Image;
     barrierInfo.subresourceRange.aspectMask     = conversionInfo.AspectMask;
     barrierInfo.subresourceRange.baseMipLevel   = 0u;
-    barrierInfo.subresourceRange.levelCount     = 1u;
+    barrierInfo.subresourceRange.levelCount     = VK_REMAINING_MIP_LEVELS;
     barrierInfo.subresourceRange.baseArrayLayer = 0u;
     barrierInfo.subresourceRange.layerCount     = 1u;
 
@@ -364,7 +358,13 @@ TextureInfoVK TextureVK::convertTextureInfo(const TextureInfo& textureInfo)
     textureInfoVK.Usage         = convertUsageMask(textureInfo.Usage) | ((textureInfo.pInitialData != nullptr) * VK_IMAGE_USAGE_TRANSFER_DST_BIT);
     textureInfoVK.Format        = convertFormatToVK(textureInfo.Format);
     textureInfoVK.AspectMask    = layoutToAspectMask(textureInfoVK.Layout);
+    textureInfoVK.MipLevels     = std::max(textureInfo.MipLevels, 1u);
     textureInfoVK.pInitialData  = textureInfo.pInitialData;
 
     return textureInfoVK;
 }
+
+size_t TextureVK::getStagingMipSize(RESOURCE_FORMAT format, const glm::uvec2& mipDimensions)
+{
+    return (getTextureSize(format, mipDimensions) + 3u) & ~size_t(3u);
+}
@@ -13,7 +13,8 @@ struct TextureInfoVK {
     VkImageUsageFlags Usage;
     VkFormat Format;
     VkImageAspectFlags AspectMask;
-    InitialData* pInitialData;  // Optional
+    uint32_t MipLevels;
+    InitialData* pInitialData;  // Optional, one element per mip level
 };
 
 struct TextureLayoutConversionInfo {
@@ -22,6 +23,8 @@ struct TextureLayoutConversionInfo {
     VkImageAspectFlags AspectMask;
     VkImageLayout SrcLayout, DstLayout;
     VkPipelineStageFlags SrcStage, DstStage;
+    // Set when recording on a transfer queue, which cannot express accesses by shaders. Waiting for the transfer queue's semaphore makes the writes visible instead.
+    bool OmitDstAccess;
 };
 
 class TextureVK : public Texture
@@ -32,7 +35,7 @@ public:
 
 public:
     // TODO: Pack parameter list into struct
-    TextureVK(const glm::uvec2& dimensions, RESOURCE_FORMAT format, DeviceVK* pDevice, VkImage image, VkImageView imageView, VmaAllocation allocation);
+    TextureVK(const glm::uvec2& dimensions, RESOURCE_FORMAT format, uint32_t mipLevels, DeviceVK* pDevice, VkImage image, VkImageView imageView, VmaAllocation allocation);
     ~TextureVK();
 
     bool convertTextureLayout(VkCommandBuffer commandBuffer, TEXTURE_LAYOUT srcLayout, TEXTURE_LAYOUT dstLayout, PIPELINE_STAGE srcStage, PIPELINE_STAGE dstStage);
@@ -43,9 +46,8 @@ public:
     inline VkImageView getImageView() const { return m_ImageView; }
 
 private:
-    static bool setInitialData(TextureVK* pTexture, const TextureInfoVK& textureInfo, BufferVK* pStagingBuffer, CommandListVK* pCommandList);
-    static BufferVK* createStagingBuffer(const TextureInfoVK& textureInfo, RESOURCE_FORMAT format, DeviceVK* pDevice);
-    static bool submitTempCommandList(CommandListVK* pCommandList, PooledResource<ICommandPool>& tempCommandPool, BufferVK* pStagingBuffer, DeviceVK* pDevice);
+    // Records the copy of every mip level from the staging buffer, where each starts at a 4 byte aligned offset, and the layout conversions surrounding it
+    static bool setInitialData(VkCommandBuffer commandBuffer, VkImage image, const TextureInfoVK& textureInfo, VkBuffer stagingBuffer, VkDeviceSize stagingOffset, bool onTransferQueue);
     // Allocates memory for the image and creates image handle
     static bool createImage(VkImage& image, VmaAllocation& allocation, const TextureInfoVK& textureInfo, DeviceVK* pDevice);
     static VkImageView createImageView(VkImage image, const TextureInfoVK& textureInfo, VkDevice device);
@@ -54,6 +56,9 @@ private:
     static VkImageAspectFlags layoutToAspectMask(VkImageLayout layout);
     static VkImageUsageFlags convertUsageMask(TEXTURE_USAGE usage);
     static TextureInfoVK convertTextureInfo(const TextureInfo& textureInfo);
+    /*  Size of a mip level in the staging buffer. Buffer to image copies on transfer queues require offsets aligned to
+        4 bytes, which the mip levels of single channel textures do not necessarily end on. */
+    static size_t getStagingMipSize(RESOURCE_FORMAT format, const glm::uvec2& mipDimensions);
 
 private:
     DeviceVK* m_pDevice;
@@ -0,0 +1,432 @@
+#include "UploadQueueVK.hpp"
+
+#include <Engine/Rendering/APIAbstractions/CommandPool.hpp>
+#include <Engine/Rendering/APIAbstractions/Vulkan/BufferVK.hpp>
+#include <Engine/Rendering/APIAbstractions/Vulkan/CommandListVK.hpp>
+#include <Engine/Rendering/APIAbstractions/Vulkan/DeviceVK.hpp>
+#include <Engine/Rendering/APIAbstractions/Vulkan/FenceVK.hpp>
+#include <Engine/Rendering/APIAbstractions/Vulkan/SemaphoreVK.hpp>
+
+UploadQueueVK* UploadQueueVK::create(DeviceVK* pDevice)
+{
+    BufferInfo ringInfo = {};
+    ringInfo.ByteSize       = UPLOAD_RING_SIZE;
+    ringInfo.CPUAccess      = BUFFER_DATA_ACCESS::WRITE;
+    ringInfo.GPUAccess      = BUFFER_DATA_ACCESS::NONE;
+    ringInfo.Usage          = BUFFER_USAGE::STAGING_BUFFER;
+    ringInfo.SharingMode    = SHARING_MODE::EXCLUSIVE;
+
+    std::unique_ptr<BufferVK> pRingBuffer(pDevice->createBuffer(ringInfo));
+    if (!pRingBuffer) {
+        LOG_ERROR("Failed to create staging ring buffer");
+        return nullptr;
+    }
+
+    // CPU-writable buffers are persistently mapped
+    void* pRingData = pRingBuffer->getMappedData();
+
+    // Uploading on a separate transfer queue requires a timeline semaphore to make the graphics queue wait for the uploads
+    const QueueFamilyIndices& queueFamilyIndices = pDevice->getQueueFamilyIndices();
+    std::unique_ptr<SemaphoreVK> pTimelineSemaphore(nullptr);
+    if (queueFamilyIndices.Transfer != queueFamilyIndices.Graphics && pDevice->getFeatures().TimelineSemaphores) {
+        pTimelineSemaphore.reset(SemaphoreVK::createTimeline(0u, pDevice));
+        if (!pTimelineSemaphore) {
+            return nullptr;
+        }
+    }
+
+    return DBG_NEW UploadQueueVK(pDevice, pRingBuffer.release(), pRingData, pTimelineSemaphore.release());
+}
+
+UploadQueueVK::UploadQueueVK(DeviceVK* pDevice, BufferVK* pRingBuffer, void* pRingData, SemaphoreVK* pTimelineSemaphore)
+    :m_pDevice(pDevice),
+    m_pRingBuffer(pRingBuffer),
+    m_pRingData(reinterpret_cast<uint8_t*>(pRingData)),
+    m_RingHead(0u),
+    m_RingUsedBytes(0u),
+    m_pTimelineSemaphore(pTimelineSemaphore),
+    m_NextBatchID(1u),
+    m_LastSubmittedBatchID(0u),
+    m_pOpenBatch(nullptr),
+    m_Stats({}),
+    m_SubmitThreadID(std::this_thread::get_id())
+{}
+
+UploadQueueVK::~UploadQueueVK()
+{
+    waitIdle();
+
+    for (UploadBatch* pBatch : m_FreeBatches) {
+        deleteBatch(*pBatch);
+        delete pBatch;
+    }
+
+    delete m_pRingBuffer;
+    delete m_pTimelineSemaphore;
+}
+
+bool UploadQueueVK::upload(const void* pData, size_t byteSize, const RecordFunction& recordFunction)
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+
+    UploadBatch* pBatch = nullptr;
+    VkBuffer stagingBuffer = VK_NULL_HANDLE;
+    VkDeviceSize stagingOffset = 0u;
+    if (!allocateStagingMemory(pData, byteSize, pBatch, stagingBuffer, stagingOffset)) {
+        return false;
+    }
+
+    CommandListVK* pCommandList = beginTransferList(pBatch);
+    if (!pCommandList) {
+        return false;
+    }
+
+    recordFunction(pCommandList->getCommandBuffer(), stagingBuffer, stagingOffset);
+
+    m_Stats.Uploads         += 1u;
+    m_Stats.UploadedBytes   += byteSize;
+    return true;
+}
+
+bool UploadQueueVK::recordGraphicsCommands(const std::function<void(VkCommandBuffer)>& recordFunction)
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+
+    UploadBatch* pBatch = getOpenBatch();
+    if (!pBatch) {
+        return false;
+    }
+
+    CommandListVK* pCommandList = beginGraphicsList(pBatch);
+    if (!pCommandList) {
+        return false;
+    }
+
+    recordFunction(pCommandList->getCommandBuffer());
+    return true;
+}
+
+bool UploadQueueVK::submit()
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+    return submitOpenBatch();
+}
+
+void UploadQueueVK::retireCompletedBatches()
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+    retireBatches(false);
+}
+
+void UploadQueueVK::waitIdle()
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+    submitOpenBatch();
+
+    while (!m_SubmittedBatches.empty()) {
+        retireBatches(true);
+    }
+}
+
+ISemaphore* UploadQueueVK::getSemaphore()
+{
+    return m_pTimelineSemaphore;
+}
+
+uint64_t UploadQueueVK::getWaitValue()
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+    return m_LastSubmittedBatchID;
+}
+
+UploadQueueStats UploadQueueVK::getStats()
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+    return m_Stats;
+}
+
+bool UploadQueueVK::allocateStagingMemory(const void* pData, size_t byteSize, UploadBatch*& pBatch, VkBuffer& stagingBuffer, VkDeviceSize& stagingOffset)
+{
+    pBatch = getOpenBatch();
+    if (!pBatch) {
+        return false;
+    }
+
+    if (byteSize > UPLOAD_RING_SIZE / 2u) {
+        // Large uploads would stall the ring, they are given their own staging buffers instead
+        return allocateDedicatedStagingMemory(pData, byteSize, pBatch, stagingBuffer, stagingOffset);
+    }
+
+    size_t consumedBytes = 0u;
+    while (!tryAllocateRingMemory(byteSize, stagingOffset, consumedBytes)) {
+        // Only the render thread submits batches, loading threads never touch the device's queues. The ring is reclaimed
+        // once the render thread has submitted and retired the batches occupying it.
+        if (std::this_thread::get_id() != m_SubmitThreadID) {
+            return allocateDedicatedStagingMemory(pData, byteSize, pBatch, stagingBuffer, stagingOffset);
+        }
+
+        // The ring is full. Submit the open batch if it holds ring memory, and wait for the oldest batch to finish.
+        if (pBatch->RingBytes > 0u) {
+            m_Stats.RingFullSubmits += 1u;
+            if (!submitOpenBatch()) {
+                return false;
+            }
+        }
+
+        if (m_SubmittedBatches.empty()) {
+            LOG_ERRORF("Failed to allocate %d bytes of staging memory", (uint32_t)byteSize);
+            return false;
+        }
+
+        retireBatches(true);
+
+        pBatch = getOpenBatch();
+        if (!pBatch) {
+            return false;
+        }
+    }
+
+    pBatch->RingBytes += consumedBytes;
+    memcpy(m_pRingData + stagingOffset, pData, byteSize);
+    m_pRingBuffer->flush(stagingOffset, (VkDeviceSize)byteSize);
+    stagingBuffer = m_pRingBuffer->getBuffer();
+    return true;
+}
+
+bool UploadQueueVK::allocateDedicatedStagingMemory(const void* pData, size_t byteSize, UploadBatch* pBatch, VkBuffer& stagingBuffer, VkDeviceSize& stagingOffset)
+{
+    BufferVK* pStagingBuffer = m_pDevice->createStagingBuffer(pData, (VkDeviceSize)byteSize);
+    if (!pStagingBuffer) {
+        LOG_WARNING("Failed to create dedicated staging buffer");
+        return false;
+    }
+
+    // Released when the batch is recycled
+    pBatch->DedicatedStagingBuffers.push_back(pStagingBuffer);
+    stagingBuffer = pStagingBuffer->getBuffer();
+    stagingOffset = 0u;
+    return true;
+}
+
+bool UploadQueueVK::tryAllocateRingMemory(size_t byteSize, VkDeviceSize& offset, size_t& consumedBytes)
+{
+    // The used part of the ring starts at the oldest batch's memory and ends at the head
+    size_t allocationStart = (m_RingHead + UPLOAD_ALIGNMENT - 1u) & ~size_t(UPLOAD_ALIGNMENT - 1u);
+    if (allocationStart + byteSize > UPLOAD_RING_SIZE) {
+        // Wrap around, leaving the end of the ring unused
+        allocationStart = 0u;
+        consumedBytes = UPLOAD_RING_SIZE - m_RingHead + byteSize;
+    } else {
+        consumedBytes = allocationStart + byteSize - m_RingHead;
+    }
+
+    if (m_RingUsedBytes + consumedBytes > UPLOAD_RING_SIZE) {
+        return false;
+    }
+
+    m_RingHead      = allocationStart + byteSize;
+    m_RingUsedBytes += consumedBytes;
+    offset          = (VkDeviceSize)allocationStart;
+    return true;
+}
+
+UploadBatch* UploadQueueVK::getOpenBatch()
+{
+    if (m_pOpenBatch) {
+        return m_pOpenBatch;
+    }
+
+    if (m_FreeBatches.empty()) {
+        std::unique_ptr<UploadBatch> pBatch(DBG_NEW UploadBatch());
+        if (!createBatch(*pBatch)) {
+            deleteBatch(*pBatch);
+            return nullptr;
+        }
+
+        m_FreeBatches.push_back(pBatch.release());
+    }
+
+    m_pOpenBatch = m_FreeBatches.back();
+    m_FreeBatches.pop_back();
+
+    m_pOpenBatch->ID = m_NextBatchID;
+    m_NextBatchID += 1u;
+    return m_pOpenBatch;
+}
+
+CommandListVK* UploadQueueVK::beginTransferList(UploadBatch* pBatch)
+{
+    if (!usesTransferQueue()) {
+        return beginGraphicsList(pBatch);
+    }
+
+    if (!pBatch->TransferRecorded) {
+        if (!pBatch->pTransferCommandList->begin(COMMAND_LIST_USAGE::ONE_TIME_SUBMIT, nullptr)) {
+            return nullptr;
+        }
+
+        pBatch->TransferRecorded = true;
+    }
+
+    return pBatch->pTransferCommandList;
+}
+
+CommandListVK* UploadQueueVK::beginGraphicsList(UploadBatch* pBatch)
+{
+    if (!pBatch->GraphicsRecorded) {
+        if (!pBatch->pGraphicsCommandList->begin(COMMAND_LIST_USAGE::ONE_TIME_SUBMIT, nullptr)) {
+            return nullptr;
+        }
+
+        pBatch->GraphicsRecorded = true;
+    }
+
+    return pBatch->pGraphicsCommandList;
+}
+
+bool UploadQueueVK::createBatch(UploadBatch& batch)
+{
+    const QueueFamilyIndices& queueFamilyIndices = m_pDevice->getQueueFamilyIndices();
+    ICommandList* pCommandList = nullptr;
+
+    batch.pGraphicsCommandPool = m_pDevice->createCommandPool(COMMAND_POOL_FLAG::RESETTABLE_COMMAND_LISTS, queueFamilyIndices.Graphics);
+    if (!batch.pGraphicsCommandPool || !batch.pGraphicsCommandPool->allocateCommandLists(&pCommandList, 1u, COMMAND_LIST_LEVEL::PRIMARY)) {
+        LOG_ERROR("Failed to create graphics command list for upload batch");
+        return false;
+    }
+
+    batch.pGraphicsCommandList = reinterpret_cast<CommandListVK*>(pCommandList);
+
+    if (usesTransferQueue()) {
+        batch.pTransferCommandPool = m_pDevice->createCommandPool(COMMAND_POOL_FLAG::RESETTABLE_COMMAND_LISTS, queueFamilyIndices.Transfer);
+        if (!batch.pTransferCommandPool || !batch.pTransferCommandPool->allocateCommandLists(&pCommandList, 1u, COMMAND_LIST_LEVEL::PRIMARY)) {
+            LOG_ERROR("Failed to create transfer command list for upload batch");
+            return false;
+        }
+
+        batch.pTransferCommandList = reinterpret_cast<CommandListVK*>(pCommandList);
+    }
+
+    batch.pFence = m_pDevice->createFence(false);
+    return batch.pFence;
+}
+
+void UploadQueueVK::deleteBatch(UploadBatch& batch)
+{
+    for (BufferVK* pStagingBuffer : batch.DedicatedStagingBuffers) {
+        delete pStagingBuffer;
+    }
+
+    delete batch.pTransferCommandList;
+    delete batch.pTransferCommandPool;
+    delete batch.pGraphicsCommandList;
+    delete batch.pGraphicsCommandPool;
+    delete batch.pFence;
+}
+
+bool UploadQueueVK::submitOpenBatch()
+{
+    if (!m_pOpenBatch) {
+        return true;
+    }
+
+    UploadBatch* pBatch = m_pOpenBatch;
+    m_pOpenBatch = nullptr;
+
+    m_SubmittedBatches.push_back(pBatch);
+
+    ISemaphore* pTimelineSemaphore = m_pTimelineSemaphore;
+    PIPELINE_STAGE waitStage = PIPELINE_STAGE::ALL_COMMANDS;
+
+    if (pBatch->TransferRecorded) {
+        SemaphoreSubmitInfo transferSemaphoreInfo = {};
+        transferSemaphoreInfo.ppSignalSemaphores    = &pTimelineSemaphore;
+        transferSemaphoreInfo.SignalSemaphoreCount  = 1u;
+        transferSemaphoreInfo.pSignalValues         = &pBatch->ID;
+
+        // Without the copies, the graphics list would signal the batch's completion with the resources left uninitialized
+        if (!pBatch->pTransferCommandList->end() || !m_pDevice->transferQueueSubmit(pBatch->pTransferCommandList, nullptr, &transferSemaphoreInfo)) {
+            LOG_ERROR("Failed to submit upload batch to transfer queue");
+            discardSubmittedBatch();
+            return false;
+        }
+    }
+
+    // The graphics list is always submitted as its fence signals the completion of the whole batch
+    CommandListVK* pGraphicsCommandList = beginGraphicsList(pBatch);
+    if (!pGraphicsCommandList || !pGraphicsCommandList->end()) {
+        LOG_ERROR("Failed to end upload batch's graphics command list");
+        discardSubmittedBatch();
+        return false;
+    }
+
+    // With a transfer queue, the graphics list waits for the transfers. Otherwise the graphics list signals the batch's value.
+    SemaphoreSubmitInfo graphicsSemaphoreInfo = {};
+    if (pBatch->TransferRecorded) {
+        graphicsSemaphoreInfo.ppWaitSemaphores      = &pTimelineSemaphore;
+        graphicsSemaphoreInfo.WaitSemaphoreCount    = 1u;
+        graphicsSemaphoreInfo.pWaitStageFlags       = &waitStage;
+        graphicsSemaphoreInfo.pWaitValues           = &pBatch->ID;
+    } else if (pTimelineSemaphore) {
+        graphicsSemaphoreInfo.ppSignalSemaphores    = &pTimelineSemaphore;
+        graphicsSemaphoreInfo.SignalSemaphoreCount  = 1u;
+        graphicsSemaphoreInfo.pSignalValues         = &pBatch->ID;
+    }
+
+    if (!m_pDevice->graphicsQueueSubmit(pGraphicsCommandList, pBatch->pFence, &graphicsSemaphoreInfo)) {
+        LOG_ERROR("Failed to submit upload batch to graphics queue");
+        discardSubmittedBatch();
+        return false;
+    }
+
+    // Only set once the batch is submitted, frames waiting for a discarded batch's value would wait forever
+    m_LastSubmittedBatchID = pBatch->ID;
+    m_Stats.SubmittedBatches += 1u;
+    return true;
+}
+
+void UploadQueueVK::discardSubmittedBatch()
+{
+    // The batch's fence will never be signaled. Wait for anything that was submitted to finish before reusing the batch.
+    m_pDevice->waitIdle();
+
+    UploadBatch* pBatch = m_SubmittedBatches.back();
+    m_SubmittedBatches.pop_back();
+    recycleBatch(pBatch);
+}
+
+void UploadQueueVK::retireBatches(bool waitForOldest)
+{
+    if (waitForOldest && !m_SubmittedBatches.empty()) {
+        IFence* pFence = m_SubmittedBatches.front()->pFence;
+        m_pDevice->waitForFences(&pFence, 1u, false, UINT64_MAX);
+    }
+
+    // Batches finish in submission order, so the staging ring is reclaimed from its tail
+    while (!m_SubmittedBatches.empty() && m_SubmittedBatches.front()->pFence->isSignaled()) {
+        recycleBatch(m_SubmittedBatches.front());
+        m_SubmittedBatches.pop_front();
+    }
+}
+
+void UploadQueueVK::recycleBatch(UploadBatch* pBatch)
+{
+    m_RingUsedBytes -= pBatch->RingBytes;
+    pBatch->RingBytes = 0u;
+
+    if (m_RingUsedBytes == 0u) {
+        // Restarting at the beginning of the ring avoids wrapping around
+        m_RingHead = 0u;
+    }
+
+    for (BufferVK* pStagingBuffer : pBatch->DedicatedStagingBuffers) {
+        delete pStagingBuffer;
+    }
+
+    pBatch->DedicatedStagingBuffers.clear();
+    pBatch->TransferRecorded = false;
+    pBatch->GraphicsRecorded = false;
+    pBatch->pFence->reset();
+
+    m_FreeBatches.push_back(pBatch);
+}
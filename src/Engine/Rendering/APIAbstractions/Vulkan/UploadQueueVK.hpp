@@ -0,0 +1,124 @@
+#pragma once
+
+#include <Engine/Rendering/APIAbstractions/UploadQueue.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class BufferVK;
+class CommandListVK;
+class DeviceVK;
+class FenceVK;
+class ICommandPool;
+class SemaphoreVK;
+
+// Size of the persistently mapped staging ring. Uploads larger than half the ring get dedicated staging buffers.
+#define UPLOAD_RING_SIZE    (64u * 1024u * 1024u)
+// Alignment of staging allocations, satisfies the offset alignment of buffer to image copies for every format
+#define UPLOAD_ALIGNMENT    16u
+
+struct UploadBatch {
+    uint64_t ID;
+
+    // Copies are recorded on the transfer queue's list when the transfer queue is used, otherwise on the graphics queue's list
+    ICommandPool* pTransferCommandPool;
+    CommandListVK* pTransferCommandList;
+    ICommandPool* pGraphicsCommandPool;
+    CommandListVK* pGraphicsCommandList;
+    bool TransferRecorded;
+    bool GraphicsRecorded;
+
+    // Signaled when every list in the batch has finished
+    FenceVK* pFence;
+
+    // Bytes consumed in the staging ring, including alignment and wrap-around padding
+    size_t RingBytes;
+    std::vector<BufferVK*> DedicatedStagingBuffers;
+};
+
+class UploadQueueVK : public UploadQueue
+{
+public:
+    // The recording function is given the command buffer to record into, and the staging buffer region holding the data
+    typedef std::function<void(VkCommandBuffer, VkBuffer, VkDeviceSize)> RecordFunction;
+
+public:
+    static UploadQueueVK* create(DeviceVK* pDevice);
+
+public:
+    UploadQueueVK(DeviceVK* pDevice, BufferVK* pRingBuffer, void* pRingData, SemaphoreVK* pTimelineSemaphore);
+    ~UploadQueueVK();
+
+    // Copies the data into staging memory and records the commands copying it into the destination resource
+    bool upload(const void* pData, size_t byteSize, const RecordFunction& recordFunction);
+    // Records commands that require the graphics queue, e.g. converting the layouts of render targets
+    bool recordGraphicsCommands(const std::function<void(VkCommandBuffer)>& recordFunction);
+
+    bool submit() override final;
+    void retireCompletedBatches() override final;
+    void waitIdle() override final;
+
+    ISemaphore* getSemaphore() override final;
+    uint64_t getWaitValue() override final;
+
+    UploadQueueStats getStats() override final;
+
+    /*  Uploads are recorded on the transfer queue if it belongs to a separate queue family and timeline semaphores are
+        supported. Resources uploaded on the transfer queue are shared concurrently by the graphics and transfer queues. */
+    inline bool usesTransferQueue() const { return m_pTimelineSemaphore; }
+
+private:
+    /*  Allocates staging memory for an upload. If the ring is full, the render thread submits and waits for batches, while
+        loading threads fall back to dedicated staging buffers, as only the render thread submits. */
+    bool allocateStagingMemory(const void* pData, size_t byteSize, UploadBatch*& pBatch, VkBuffer& stagingBuffer, VkDeviceSize& stagingOffset);
+    bool allocateDedicatedStagingMemory(const void* pData, size_t byteSize, UploadBatch* pBatch, VkBuffer& stagingBuffer, VkDeviceSize& stagingOffset);
+    // consumedBytes includes alignment and wrap-around padding
+    bool tryAllocateRingMemory(size_t byteSize, VkDeviceSize& offset, size_t& consumedBytes);
+
+    // Returns the open batch, creating one if there is none
+    UploadBatch* getOpenBatch();
+    CommandListVK* beginTransferList(UploadBatch* pBatch);
+    CommandListVK* beginGraphicsList(UploadBatch* pBatch);
+    bool createBatch(UploadBatch& batch);
+    void deleteBatch(UploadBatch& batch);
+
+    bool submitOpenBatch();
+    // Removes the most recently submitted batch after its submission failed
+    void discardSubmittedBatch();
+    // Retires finished batches in submission order, optionally waiting for the oldest one
+    void retireBatches(bool waitForOldest);
+    // Releases the batch's staging memory and makes the batch reusable
+    void recycleBatch(UploadBatch* pBatch);
+
+private:
+    DeviceVK* m_pDevice;
+
+    // Staging ring
+    BufferVK* m_pRingBuffer;
+    uint8_t* m_pRingData;
+    size_t m_RingHead;
+    size_t m_RingUsedBytes;
+
+    // Signaled with each batch's ID when the batch's copies have finished. nullptr if the graphics queue is used for uploads.
+    SemaphoreVK* m_pTimelineSemaphore;
+    uint64_t m_NextBatchID;
+    uint64_t m_LastSubmittedBatchID;
+
+    UploadBatch* m_pOpenBatch;
+    // Submitted batches, oldest first
+    std::deque<UploadBatch*> m_SubmittedBatches;
+    std::vector<UploadBatch*> m_FreeBatches;
+
+    UploadQueueStats m_Stats;
+
+    // The thread that created the queue, which renders and submits the batches each frame
+    std::thread::id m_SubmitThreadID;
+
+    // Uploads may be recorded from multiple threads
+    std::mutex m_Lock;
+};
@@ -1,30 +1,32 @@
 #pragma once
 
 #include <Engine/Rendering/AssetContainers/Material.hpp>
+#include <Engine/Rendering/AssetContainers/Vertex.hpp>
 #include <Engine/Rendering/APIAbstractions/DX11/BufferDX11.hpp>
 
 #include <DirectXMath.h>
 #include <vector>
 
-struct Vertex2D {
-    DirectX::XMFLOAT2 Position;
-    DirectX::XMFLOAT2 TXCoords;
-};
-
-struct Vertex {
-    DirectX::XMFLOAT3 position;
-    DirectX::XMFLOAT3 normal;
-    DirectX::XMFLOAT2 txCoords;
+// Range of a mesh's index buffer holding one level of detail
+struct MeshLOD {
+    uint32_t FirstIndex;
+    uint32_t IndexCount;
 };
 
 struct Mesh {
     IBuffer* pVertexBuffer, *pIndexBuffer;
+    // The index count includes every LOD's indices
     size_t vertexCount, indexCount, materialIndex;
+    // LOD 0 is the full detail mesh. Every LOD uses the same vertex buffer.
+    std::vector<MeshLOD> LODs;
 };
 
 struct Model {
     std::vector<Mesh> Meshes;
     std::vector<Material> Materials;
+    // Bounding sphere in model space, used to select the meshes' LODs
+    DirectX::XMFLOAT3 BoundsCenter;
+    float BoundsRadius;
 };
 
 struct ModelComponent {
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+struct Vertex2D {
+    DirectX::XMFLOAT2 Position;
+    DirectX::XMFLOAT2 TXCoords;
+};
+
+struct Vertex {
+    DirectX::XMFLOAT3 position;
+    DirectX::XMFLOAT3 normal;
+    DirectX::XMFLOAT2 txCoords;
+};
+
+// Vertex using 20 instead of 32 bytes. Used by meshes when packed vertices are enabled in the engine config.
+struct PackedVertex {
+    DirectX::XMFLOAT3 position;
+    // Octahedral encoding of the unit normal
+    DirectX::PackedVector::XMSHORTN2 normal;
+    DirectX::PackedVector::XMHALF2 txCoords;
+};
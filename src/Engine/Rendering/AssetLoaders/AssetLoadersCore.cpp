@@ -1,6 +1,7 @@
 #include "AssetLoadersCore.hpp"
 
-AssetLoadersCore::AssetLoadersCore(RenderingCore* pRenderingCore)
-    :   m_TextureCache(pRenderingCore->GetDevice())
-    ,   m_ModelLoader(&m_TextureCache, pRenderingCore->GetDevice())
+AssetLoadersCore::AssetLoadersCore(RenderingCore* pRenderingCore, const EngineConfig& engineConfig)
+    :   m_ResidencyManager(engineConfig.AssetMemoryBudget)
+    ,   m_TextureCache(pRenderingCore->GetDevice(), &m_ResidencyManager, pRenderingCore->GetTextureFormat())
+    ,   m_ModelLoader(&m_TextureCache, pRenderingCore->GetDevice(), &m_ResidencyManager, pRenderingCore->IsPackedVerticesEnabled())
 {}
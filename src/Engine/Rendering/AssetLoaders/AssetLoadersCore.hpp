@@ -2,20 +2,25 @@
 
 #include <Engine/Rendering/AssetLoaders/TextureCache.hpp>
 #include <Engine/Rendering/AssetLoaders/ModelLoader.hpp>
+#include <Engine/Utils/ResidencyManager.hpp>
 
 class Device;
 class RenderingCore;
+struct EngineConfig;
 
 class AssetLoadersCore
 {
 public:
-    AssetLoadersCore(RenderingCore* pRenderingCore);
+    AssetLoadersCore(RenderingCore* pRenderingCore, const EngineConfig& engineConfig);
     ~AssetLoadersCore() = default;
 
     TextureCache* GetTextureCache() { return &m_TextureCache; }
     ModelLoader* GetModelLoader()   { return &m_ModelLoader; }
+    ResidencyManager* GetResidencyManager() { return &m_ResidencyManager; }
 
 private:
+    // Outlives the caches, which inform it of their assets
+    ResidencyManager m_ResidencyManager;
     TextureCache m_TextureCache;
     ModelLoader m_ModelLoader;
 };
@@ -0,0 +1,410 @@
+#include "BlockCompressor.hpp"
+
+#include <Engine/Utils/Logger.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // Interpolation weights of BC7's 4-bit indices, out of 64
+    const uint32_t g_BC7Weights[16] = { 0u, 4u, 9u, 13u, 17u, 21u, 26u, 30u, 34u, 38u, 43u, 47u, 51u, 55u, 60u, 64u };
+
+    uint16_t packRGB565(const float* pColor)
+    {
+        const uint32_t r = (uint32_t)std::lround(std::clamp(pColor[0], 0.0f, 255.0f) * 31.0f / 255.0f);
+        const uint32_t g = (uint32_t)std::lround(std::clamp(pColor[1], 0.0f, 255.0f) * 63.0f / 255.0f);
+        const uint32_t b = (uint32_t)std::lround(std::clamp(pColor[2], 0.0f, 255.0f) * 31.0f / 255.0f);
+        return uint16_t((r << 11u) | (g << 5u) | b);
+    }
+
+    void unpackRGB565(uint16_t color, int32_t* pColor)
+    {
+        const int32_t r = (color >> 11u) & 31u, g = (color >> 5u) & 63u, b = color & 31u;
+        pColor[0] = (r << 3) | (r >> 2);
+        pColor[1] = (g << 2) | (g >> 4);
+        pColor[2] = (b << 3) | (b >> 2);
+    }
+
+    // Assigns each pixel the closest of the four BC1 colors, returns the summed squared error
+    uint32_t assignColorIndices(const uint8_t* pPixels, uint16_t color0, uint16_t color1, uint32_t& indices)
+    {
+        int32_t palette[4][3];
+        unpackRGB565(color0, palette[0]);
+        unpackRGB565(color1, palette[1]);
+        for (uint32_t channel = 0u; channel < 3u; channel += 1u) {
+            palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+            palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+        }
+
+        indices = 0u;
+        uint32_t totalError = 0u;
+        for (uint32_t pixelIdx = 0u; pixelIdx < 16u; pixelIdx += 1u) {
+            const uint8_t* pPixel = pPixels + pixelIdx * 4u;
+            uint32_t bestIndex = 0u, bestError = UINT32_MAX;
+
+            for (uint32_t paletteIdx = 0u; paletteIdx < 4u; paletteIdx += 1u) {
+                const int32_t dR = pPixel[0] - palette[paletteIdx][0], dG = pPixel[1] - palette[paletteIdx][1], dB = pPixel[2] - palette[paletteIdx][2];
+                const uint32_t error = uint32_t(dR * dR + dG * dG + dB * dB);
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = paletteIdx;
+                }
+            }
+
+            indices |= bestIndex << (pixelIdx * 2u);
+            totalError += bestError;
+        }
+
+        return totalError;
+    }
+
+    // Orders the colors to select BC1's four color mode, which requires color0 > color1
+    void orderColorEndpoints(uint16_t& color0, uint16_t& color1)
+    {
+        if (color0 < color1) {
+            std::swap(color0, color1);
+        }
+    }
+
+    // Appends bits to a 128-bit BC7 block, starting at the least significant bit
+    struct BlockBitWriter {
+        uint8_t* pBlock;
+        uint32_t BitOffset;
+
+        void write(uint32_t value, uint32_t bitCount)
+        {
+            for (uint32_t bitIdx = 0u; bitIdx < bitCount; bitIdx += 1u) {
+                const uint32_t bit = (value >> bitIdx) & 1u;
+                pBlock[BitOffset / 8u] |= uint8_t(bit << (BitOffset % 8u));
+                BitOffset += 1u;
+            }
+        }
+    };
+}
+
+bool BlockCompressor::CompressTexture(const uint8_t* pPixels, const glm::uvec2& dimensions, RESOURCE_FORMAT format, uint8_t* pBlocks)
+{
+    void (*pCompressBlock)(const uint8_t*, uint8_t*) = nullptr;
+    switch (format) {
+        case RESOURCE_FORMAT::BC1_UNORM:
+            pCompressBlock = CompressBlockBC1;
+            break;
+        case RESOURCE_FORMAT::BC3_UNORM:
+            pCompressBlock = CompressBlockBC3;
+            break;
+        case RESOURCE_FORMAT::BC7_UNORM:
+            pCompressBlock = CompressBlockBC7;
+            break;
+        default:
+            LOG_WARNINGF("Not a block compressed format: %d", (int)format);
+            return false;
+    }
+
+    const uint32_t blockCountX = (dimensions.x + 3u) / 4u;
+    const uint32_t blockCountY = (dimensions.y + 3u) / 4u;
+    const size_t blockSize = getFormatSize(format);
+
+    ThreadPool::GetInstance().ParallelFor((size_t)blockCountY, [&](size_t blockY) {
+        uint8_t blockPixels[16u * 4u];
+
+        for (uint32_t blockX = 0u; blockX < blockCountX; blockX += 1u) {
+            for (uint32_t pixelY = 0u; pixelY < 4u; pixelY += 1u) {
+                const uint32_t y = std::min((uint32_t)blockY * 4u + pixelY, dimensions.y - 1u);
+                for (uint32_t pixelX = 0u; pixelX < 4u; pixelX += 1u) {
+                    const uint32_t x = std::min(blockX * 4u + pixelX, dimensions.x - 1u);
+                    std::memcpy(blockPixels + (pixelY * 4u + pixelX) * 4u, pPixels + ((size_t)y * dimensions.x + x) * 4u, 4u);
+                }
+            }
+
+            pCompressBlock(blockPixels, pBlocks + (blockY * blockCountX + blockX) * blockSize);
+        }
+    });
+
+    return true;
+}
+
+void BlockCompressor::CompressBlockBC1(const uint8_t* pPixels, uint8_t* pBlock)
+{
+    CompressColorBlock(pPixels, pBlock);
+}
+
+void BlockCompressor::CompressBlockBC3(const uint8_t* pPixels, uint8_t* pBlock)
+{
+    CompressAlphaBlock(pPixels, pBlock);
+    CompressColorBlock(pPixels, pBlock + 8u);
+}
+
+void BlockCompressor::CompressBlockBC7(const uint8_t* pPixels, uint8_t* pBlock)
+{
+    float pEndpoints[2][4];
+    FitEndpoints(pPixels, 4u, pEndpoints[0], pEndpoints[1]);
+
+    // Mode 6 stores 7 bits per endpoint channel, and a p-bit per endpoint which is shared as every channel's lowest bit
+    uint32_t pQuantized[2][4];
+    uint32_t pPBits[2];
+    int32_t pExpanded[2][4];
+
+    for (uint32_t endpointIdx = 0u; endpointIdx < 2u; endpointIdx += 1u) {
+        float bestError = FLT_MAX;
+
+        for (uint32_t pBit = 0u; pBit < 2u; pBit += 1u) {
+            uint32_t quantized[4];
+            float error = 0.0f;
+
+            for (uint32_t channel = 0u; channel < 4u; channel += 1u) {
+                quantized[channel] = (uint32_t)std::clamp(std::lround((pEndpoints[endpointIdx][channel] - (float)pBit) * 0.5f), 0l, 127l);
+                const float difference = float((quantized[channel] << 1u) | pBit) - pEndpoints[endpointIdx][channel];
+                error += difference * difference;
+            }
+
+            if (error < bestError) {
+                bestError = error;
+                pPBits[endpointIdx] = pBit;
+                std::copy_n(quantized, 4u, pQuantized[endpointIdx]);
+            }
+        }
+
+        for (uint32_t channel = 0u; channel < 4u; channel += 1u) {
+            pExpanded[endpointIdx][channel] = int32_t((pQuantized[endpointIdx][channel] << 1u) | pPBits[endpointIdx]);
+        }
+    }
+
+    int32_t palette[16][4];
+    for (uint32_t paletteIdx = 0u; paletteIdx < 16u; paletteIdx += 1u) {
+        const int32_t weight = (int32_t)g_BC7Weights[paletteIdx];
+        for (uint32_t channel = 0u; channel < 4u; channel += 1u) {
+            palette[paletteIdx][channel] = ((64 - weight) * pExpanded[0][channel] + weight * pExpanded[1][channel] + 32) >> 6;
+        }
+    }
+
+    uint32_t indices[16];
+    for (uint32_t pixelIdx = 0u; pixelIdx < 16u; pixelIdx += 1u) {
+        const uint8_t* pPixel = pPixels + pixelIdx * 4u;
+        uint32_t bestError = UINT32_MAX;
+
+        for (uint32_t paletteIdx = 0u; paletteIdx < 16u; paletteIdx += 1u) {
+            uint32_t error = 0u;
+            for (uint32_t channel = 0u; channel < 4u; channel += 1u) {
+                const int32_t difference = pPixel[channel] - palette[paletteIdx][channel];
+                error += uint32_t(difference * difference);
+            }
+
+            if (error < bestError) {
+                bestError = error;
+                indices[pixelIdx] = paletteIdx;
+            }
+        }
+    }
+
+    // The first pixel's index is stored without its highest bit, which is implied to be 0. Swapping the endpoints flips the indices.
+    if (indices[0] >= 8u) {
+        std::swap(pQuantized[0], pQuantized[1]);
+        std::swap(pPBits[0], pPBits[1]);
+        for (uint32_t& index : indices) {
+            index = 15u - index;
+        }
+    }
+
+    std::memset(pBlock, 0, 16u);
+    BlockBitWriter writer = { pBlock, 0u };
+
+    // Mode 6 is identified by 6 zero bits followed by a one
+    writer.write(1u << 6u, 7u);
+    for (uint32_t channel = 0u; channel < 4u; channel += 1u) {
+        writer.write(pQuantized[0][channel], 7u);
+        writer.write(pQuantized[1][channel], 7u);
+    }
+
+    writer.write(pPBits[0], 1u);
+    writer.write(pPBits[1], 1u);
+
+    writer.write(indices[0], 3u);
+    for (uint32_t pixelIdx = 1u; pixelIdx < 16u; pixelIdx += 1u) {
+        writer.write(indices[pixelIdx], 4u);
+    }
+}
+
+void BlockCompressor::CompressColorBlock(const uint8_t* pPixels, uint8_t* pBlock)
+{
+    float pEndpoints[2][3];
+    FitEndpoints(pPixels, 3u, pEndpoints[0], pEndpoints[1]);
+
+    uint16_t color0 = packRGB565(pEndpoints[0]);
+    uint16_t color1 = packRGB565(pEndpoints[1]);
+    orderColorEndpoints(color0, color1);
+
+    uint32_t indices = 0u;
+    uint32_t error = assignColorIndices(pPixels, color0, color1, indices);
+
+    // Refit the endpoints to the assigned indices using least squares, keeping the refit endpoints if they reduce the error
+    if (color0 != color1) {
+        const float pIndexWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+        float alpha2 = 0.0f, beta2 = 0.0f, alphaBeta = 0.0f;
+        float alphaX[3] = {}, betaX[3] = {};
+
+        for (uint32_t pixelIdx = 0u; pixelIdx < 16u; pixelIdx += 1u) {
+            const float beta = pIndexWeights[(indices >> (pixelIdx * 2u)) & 3u];
+            const float alpha = 1.0f - beta;
+
+            alpha2      += alpha * alpha;
+            beta2       += beta * beta;
+            alphaBeta   += alpha * beta;
+            for (uint32_t channel = 0u; channel < 3u; channel += 1u) {
+                alphaX[channel] += alpha * pPixels[pixelIdx * 4u + channel];
+                betaX[channel]  += beta * pPixels[pixelIdx * 4u + channel];
+            }
+        }
+
+        const float determinant = alpha2 * beta2 - alphaBeta * alphaBeta;
+        if (std::abs(determinant) > 1e-6f) {
+            float refitEndpoints[2][3];
+            for (uint32_t channel = 0u; channel < 3u; channel += 1u) {
+                refitEndpoints[0][channel] = (alphaX[channel] * beta2 - betaX[channel] * alphaBeta) / determinant;
+                refitEndpoints[1][channel] = (betaX[channel] * alpha2 - alphaX[channel] * alphaBeta) / determinant;
+            }
+
+            uint16_t refitColor0 = packRGB565(refitEndpoints[0]);
+            uint16_t refitColor1 = packRGB565(refitEndpoints[1]);
+            orderColorEndpoints(refitColor0, refitColor1);
+
+            uint32_t refitIndices = 0u;
+            const uint32_t refitError = refitColor0 != refitColor1 ? assignColorIndices(pPixels, refitColor0, refitColor1, refitIndices) : UINT32_MAX;
+            if (refitError < error) {
+                color0  = refitColor0;
+                color1  = refitColor1;
+                indices = refitIndices;
+                error   = refitError;
+            }
+        }
+    }
+
+    // Equal endpoints select the three color mode, where index 0 still refers to color0
+    if (color0 == color1) {
+        indices = 0u;
+    }
+
+    pBlock[0] = uint8_t(color0 & 0xFFu);
+    pBlock[1] = uint8_t(color0 >> 8u);
+    pBlock[2] = uint8_t(color1 & 0xFFu);
+    pBlock[3] = uint8_t(color1 >> 8u);
+    for (uint32_t byteIdx = 0u; byteIdx < 4u; byteIdx += 1u) {
+        pBlock[4u + byteIdx] = uint8_t(indices >> (byteIdx * 8u));
+    }
+}
+
+void BlockCompressor::CompressAlphaBlock(const uint8_t* pPixels, uint8_t* pBlock)
+{
+    uint8_t alpha0 = 0u, alpha1 = 255u;
+    for (uint32_t pixelIdx = 0u; pixelIdx < 16u; pixelIdx += 1u) {
+        alpha0 = std::max(alpha0, pPixels[pixelIdx * 4u + 3u]);
+        alpha1 = std::min(alpha1, pPixels[pixelIdx * 4u + 3u]);
+    }
+
+    // alpha0 > alpha1 selects the eight value mode, where the six values between the endpoints are interpolated
+    int32_t palette[8] = { alpha0, alpha1 };
+    for (int32_t paletteIdx = 2; paletteIdx < 8; paletteIdx += 1) {
+        palette[paletteIdx] = ((8 - paletteIdx) * alpha0 + (paletteIdx - 1) * alpha1) / 7;
+    }
+
+    uint64_t indices = 0u;
+    if (alpha0 != alpha1) {
+        for (uint32_t pixelIdx = 0u; pixelIdx < 16u; pixelIdx += 1u) {
+            const int32_t alpha = pPixels[pixelIdx * 4u + 3u];
+            uint64_t bestIndex = 0u;
+            int32_t bestError = INT32_MAX;
+
+            for (uint32_t paletteIdx = 0u; paletteIdx < 8u; paletteIdx += 1u) {
+                const int32_t error = std::abs(alpha - palette[paletteIdx]);
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = paletteIdx;
+                }
+            }
+
+            indices |= bestIndex << (pixelIdx * 3u);
+        }
+    }
+
+    pBlock[0] = alpha0;
+    pBlock[1] = alpha1;
+    for (uint32_t byteIdx = 0u; byteIdx < 6u; byteIdx += 1u) {
+        pBlock[2u + byteIdx] = uint8_t(indices >> (byteIdx * 8u));
+    }
+}
+
+void BlockCompressor::FitEndpoints(const uint8_t* pPixels, uint32_t channelCount, float* pEndpoint0, float* pEndpoint1)
+{
+    float mean[4] = {};
+    for (uint32_t pixelIdx = 0u; pixelIdx < 16u; pixelIdx += 1u) {
+        for (uint32_t channel = 0u; channel < channelCount; channel += 1u) {
+            mean[channel] += pPixels[pixelIdx * 4u + channel];
+        }
+    }
+
+    for (uint32_t channel = 0u; channel < channelCount; channel += 1u) {
+        mean[channel] /= 16.0f;
+    }
+
+    float covariance[4][4] = {};
+    for (uint32_t pixelIdx = 0u; pixelIdx < 16u; pixelIdx += 1u) {
+        float offset[4];
+        for (uint32_t channel = 0u; channel < channelCount; channel += 1u) {
+            offset[channel] = pPixels[pixelIdx * 4u + channel] - mean[channel];
+        }
+
+        for (uint32_t row = 0u; row < channelCount; row += 1u) {
+            for (uint32_t column = 0u; column < channelCount; column += 1u) {
+                covariance[row][column] += offset[row] * offset[column];
+            }
+        }
+    }
+
+    // Power iteration converges on the eigenvector with the largest eigenvalue, i.e. the axis along which the pixels vary the most
+    float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    for (uint32_t iteration = 0u; iteration < 8u; iteration += 1u) {
+        float product[4] = {};
+        float length = 0.0f;
+
+        for (uint32_t row = 0u; row < channelCount; row += 1u) {
+            for (uint32_t column = 0u; column < channelCount; column += 1u) {
+                product[row] += covariance[row][column] * axis[column];
+            }
+
+            length = std::max(length, std::abs(product[row]));
+        }
+
+        if (length < 1e-6f) {
+            break;
+        }
+
+        for (uint32_t channel = 0u; channel < channelCount; channel += 1u) {
+            axis[channel] = product[channel] / length;
+        }
+    }
+
+    float axisLengthSquared = 0.0f;
+    for (uint32_t channel = 0u; channel < channelCount; channel += 1u) {
+        axisLengthSquared += axis[channel] * axis[channel];
+    }
+
+    float minProjection = 0.0f, maxProjection = 0.0f;
+    for (uint32_t pixelIdx = 0u; pixelIdx < 16u; pixelIdx += 1u) {
+        float projection = 0.0f;
+        for (uint32_t channel = 0u; channel < channelCount; channel += 1u) {
+            projection += (pPixels[pixelIdx * 4u + channel] - mean[channel]) * axis[channel];
+        }
+
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+
+    const float axisScale = axisLengthSquared > 0.0f ? 1.0f / axisLengthSquared : 0.0f;
+    for (uint32_t channel = 0u; channel < channelCount; channel += 1u) {
+        pEndpoint0[channel] = std::clamp(mean[channel] + axis[channel] * maxProjection * axisScale, 0.0f, 255.0f);
+        pEndpoint1[channel] = std::clamp(mean[channel] + axis[channel] * minProjection * axisScale, 0.0f, 255.0f);
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Engine/Rendering/APIAbstractions/GeneralResources.hpp>
+
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+
+/*  Encodes R8G8B8A8 pixels into BC1, BC3 or BC7 blocks, each storing 4x4 pixels. Endpoints are fit along the principal
+    axis of each block's colors. BC1 stores opaque colors only, BC3 adds an interpolated alpha block and BC7 is encoded
+    using mode 6, which stores RGBA endpoints with 16 interpolated values. */
+class BlockCompressor
+{
+public:
+    /*  Compresses a whole texture, block rows are compressed in parallel on the thread pool. Blocks reaching past the
+        texture's edges repeat the edge pixels. pBlocks must fit getTextureSize(format, dimensions) bytes. */
+    static bool CompressTexture(const uint8_t* pPixels, const glm::uvec2& dimensions, RESOURCE_FORMAT format, uint8_t* pBlocks);
+
+    // pPixels holds the block's 16 pixels row by row
+    static void CompressBlockBC1(const uint8_t* pPixels, uint8_t* pBlock);
+    static void CompressBlockBC3(const uint8_t* pPixels, uint8_t* pBlock);
+    static void CompressBlockBC7(const uint8_t* pPixels, uint8_t* pBlock);
+
+private:
+    // Writes the 8-byte color part of BC1 and BC3 blocks
+    static void CompressColorBlock(const uint8_t* pPixels, uint8_t* pBlock);
+    // Writes the 8-byte alpha part of BC3 blocks
+    static void CompressAlphaBlock(const uint8_t* pPixels, uint8_t* pBlock);
+
+    // Finds the extremes of the pixels' projections onto their principal axis. Only the first channelCount channels are considered.
+    static void FitEndpoints(const uint8_t* pPixels, uint32_t channelCount, float* pEndpoint0, float* pEndpoint1);
+};
@@ -0,0 +1,355 @@
+#include "MeshOptimizer.hpp"
+
+#include <Engine/Utils/Logger.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Size of the LRU cache modeled when scoring vertices in the vertex cache optimization
+#define FORSYTH_CACHE_SIZE          32u
+#define FORSYTH_LAST_TRIANGLE_SCORE 0.75f
+#define FORSYTH_CACHE_DECAY_POWER   1.5f
+#define FORSYTH_VALENCE_BOOST_SCALE 2.0f
+#define FORSYTH_VALENCE_BOOST_POWER 0.5f
+
+#define INVALID_INDEX UINT32_MAX
+
+namespace
+{
+    // Vertices that are recently used, or used by few remaining triangles, score higher
+    float ScoreVertex(int32_t cachePosition, uint32_t remainingTriangles)
+    {
+        if (remainingTriangles == 0u) {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // The vertices of the previous triangle score equally, to avoid favoring any direction
+                score = FORSYTH_LAST_TRIANGLE_SCORE;
+            } else {
+                const float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3u);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+            }
+        }
+
+        return score + FORSYTH_VALENCE_BOOST_SCALE * std::pow((float)remainingTriangles, -FORSYTH_VALENCE_BOOST_POWER);
+    }
+}
+
+MeshOptimizationStats MeshOptimizer::OptimizeMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    MeshOptimizationStats stats = {};
+    stats.ACMRBefore        = CalculateACMR(indices.data(), indices.size(), vertices.size());
+    stats.VertexBytesBefore = vertices.size() * sizeof(Vertex);
+
+    OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+    OptimizeOverdraw(indices.data(), indices.size(), vertices.data(), vertices.size());
+    vertices.resize(OptimizeVertexFetch(vertices.data(), vertices.size(), indices.data(), indices.size()));
+
+    stats.ACMRAfter         = CalculateACMR(indices.data(), indices.size(), vertices.size());
+    stats.VertexBytesAfter  = vertices.size() * sizeof(Vertex);
+    stats.PackedVertexBytes = vertices.size() * sizeof(PackedVertex);
+    return stats;
+}
+
+void MeshOptimizer::LogStats(const std::string& meshName, const MeshOptimizationStats& stats)
+{
+    LOG_INFOF("Optimized mesh [%s]: ACMR %.3f -> %.3f, vertex bytes %zu -> %zu (%zu packed)",
+        meshName.c_str(), stats.ACMRBefore, stats.ACMRAfter, stats.VertexBytesBefore, stats.VertexBytesAfter, stats.PackedVertexBytes);
+}
+
+void MeshOptimizer::OptimizeVertexCache(uint32_t* pIndices, size_t indexCount, size_t vertexCount)
+{
+    const size_t triangleCount = indexCount / 3u;
+    if (triangleCount == 0u) {
+        return;
+    }
+
+    // List the triangles using each vertex. Emitted triangles are swapped to the back of each list.
+    std::vector<uint32_t> remainingTriangles(vertexCount, 0u);
+    for (size_t indexIdx = 0u; indexIdx < triangleCount * 3u; indexIdx += 1u) {
+        remainingTriangles[pIndices[indexIdx]] += 1u;
+    }
+
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1u, 0u);
+    for (size_t vertexIdx = 0u; vertexIdx < vertexCount; vertexIdx += 1u) {
+        adjacencyOffsets[vertexIdx + 1u] = adjacencyOffsets[vertexIdx] + remainingTriangles[vertexIdx];
+    }
+
+    std::vector<uint32_t> adjacentTriangles(triangleCount * 3u);
+    std::vector<uint32_t> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t indexIdx = 0u; indexIdx < triangleCount * 3u; indexIdx += 1u) {
+        adjacentTriangles[adjacencyFill[pIndices[indexIdx]]++] = (uint32_t)(indexIdx / 3u);
+    }
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t vertexIdx = 0u; vertexIdx < vertexCount; vertexIdx += 1u) {
+        vertexScores[vertexIdx] = ScoreVertex(-1, remainingTriangles[vertexIdx]);
+    }
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> emittedTriangles(triangleCount, false);
+    for (size_t triangleIdx = 0u; triangleIdx < triangleCount; triangleIdx += 1u) {
+        const uint32_t* pTriangle = &pIndices[triangleIdx * 3u];
+        triangleScores[triangleIdx] = vertexScores[pTriangle[0]] + vertexScores[pTriangle[1]] + vertexScores[pTriangle[2]];
+    }
+
+    std::vector<uint32_t> optimizedIndices;
+    optimizedIndices.reserve(triangleCount * 3u);
+
+    // The emitted triangle's vertices are pushed to the front of the cache, the last three entries overflow
+    uint32_t cache[FORSYTH_CACHE_SIZE + 3u];
+    uint32_t newCache[FORSYTH_CACHE_SIZE + 3u];
+    uint32_t cacheSize = 0u;
+
+    uint32_t bestTriangle = INVALID_INDEX;
+    size_t scanCursor = 0u;
+
+    for (size_t emittedCount = 0u; emittedCount < triangleCount; emittedCount += 1u) {
+        if (bestTriangle == INVALID_INDEX) {
+            // No cached vertex has remaining triangles, continue from the next triangle in the original order
+            while (emittedTriangles[scanCursor]) {
+                scanCursor += 1u;
+            }
+
+            bestTriangle = (uint32_t)scanCursor;
+        }
+
+        emittedTriangles[bestTriangle] = true;
+        uint32_t newCacheSize = 0u;
+
+        for (uint32_t cornerIdx = 0u; cornerIdx < 3u; cornerIdx += 1u) {
+            const uint32_t vertexIdx = pIndices[bestTriangle * 3u + cornerIdx];
+            optimizedIndices.push_back(vertexIdx);
+
+            // Remove the triangle from the vertex's remaining triangles
+            uint32_t* pAdjacency = &adjacentTriangles[adjacencyOffsets[vertexIdx]];
+            uint32_t* pLastRemaining = pAdjacency + remainingTriangles[vertexIdx] - 1u;
+            std::iter_swap(std::find(pAdjacency, pLastRemaining + 1, bestTriangle), pLastRemaining);
+            remainingTriangles[vertexIdx] -= 1u;
+
+            // Degenerate triangles refer to a vertex more than once
+            if (std::find(newCache, newCache + newCacheSize, vertexIdx) == newCache + newCacheSize) {
+                newCache[newCacheSize++] = vertexIdx;
+            }
+        }
+
+        const uint32_t triangleVertexCount = newCacheSize;
+        for (uint32_t cacheIdx = 0u; cacheIdx < cacheSize; cacheIdx += 1u) {
+            const uint32_t vertexIdx = cache[cacheIdx];
+            if (std::find(newCache, newCache + triangleVertexCount, vertexIdx) == newCache + triangleVertexCount) {
+                newCache[newCacheSize++] = vertexIdx;
+            }
+        }
+
+        // Rescore the vertices whose cache positions changed, including those pushed out of the cache
+        for (uint32_t cacheIdx = 0u; cacheIdx < newCacheSize; cacheIdx += 1u) {
+            const uint32_t vertexIdx = newCache[cacheIdx];
+            cachePositions[vertexIdx] = cacheIdx < FORSYTH_CACHE_SIZE ? (int32_t)cacheIdx : -1;
+
+            const float newScore = ScoreVertex(cachePositions[vertexIdx], remainingTriangles[vertexIdx]);
+            const float scoreDelta = newScore - vertexScores[vertexIdx];
+            vertexScores[vertexIdx] = newScore;
+
+            const uint32_t adjacencyBegin = adjacencyOffsets[vertexIdx];
+            for (uint32_t adjacencyIdx = adjacencyBegin; adjacencyIdx < adjacencyBegin + remainingTriangles[vertexIdx]; adjacencyIdx += 1u) {
+                triangleScores[adjacentTriangles[adjacencyIdx]] += scoreDelta;
+            }
+        }
+
+        cacheSize = std::min(newCacheSize, FORSYTH_CACHE_SIZE);
+        std::copy(newCache, newCache + cacheSize, cache);
+
+        // Only triangles using cached vertices are considered for the next triangle
+        bestTriangle = INVALID_INDEX;
+        float bestScore = -FLT_MAX;
+
+        for (uint32_t cacheIdx = 0u; cacheIdx < cacheSize; cacheIdx += 1u) {
+            const uint32_t vertexIdx = cache[cacheIdx];
+            const uint32_t adjacencyBegin = adjacencyOffsets[vertexIdx];
+
+            for (uint32_t adjacencyIdx = adjacencyBegin; adjacencyIdx < adjacencyBegin + remainingTriangles[vertexIdx]; adjacencyIdx += 1u) {
+                const uint32_t triangleIdx = adjacentTriangles[adjacencyIdx];
+                if (triangleScores[triangleIdx] > bestScore) {
+                    bestScore = triangleScores[triangleIdx];
+                    bestTriangle = triangleIdx;
+                }
+            }
+        }
+    }
+
+    std::copy(optimizedIndices.begin(), optimizedIndices.end(), pIndices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(uint32_t* pIndices, size_t indexCount, const Vertex* pVertices, size_t vertexCount)
+{
+    const size_t triangleCount = indexCount / 3u;
+    if (triangleCount == 0u || vertexCount == 0u) {
+        return;
+    }
+
+    // Clusters begin where every vertex of a triangle misses the simulated cache
+    std::vector<uint32_t> clusterStarts;
+    std::vector<uint32_t> cacheTimestamps(vertexCount, 0u);
+    uint32_t timestamp = MESH_OPTIMIZER_ACMR_CACHE_SIZE + 1u;
+
+    for (size_t triangleIdx = 0u; triangleIdx < triangleCount; triangleIdx += 1u) {
+        uint32_t misses = 0u;
+        for (uint32_t cornerIdx = 0u; cornerIdx < 3u; cornerIdx += 1u) {
+            const uint32_t vertexIdx = pIndices[triangleIdx * 3u + cornerIdx];
+            if (timestamp - cacheTimestamps[vertexIdx] > MESH_OPTIMIZER_ACMR_CACHE_SIZE) {
+                cacheTimestamps[vertexIdx] = timestamp++;
+                misses += 1u;
+            }
+        }
+
+        if (misses == 3u) {
+            clusterStarts.push_back((uint32_t)triangleIdx);
+        }
+    }
+
+    if (clusterStarts.size() < 2u) {
+        return;
+    }
+
+    DirectX::XMVECTOR meshCenter = DirectX::XMVectorZero();
+    for (size_t vertexIdx = 0u; vertexIdx < vertexCount; vertexIdx += 1u) {
+        meshCenter = DirectX::XMVectorAdd(meshCenter, DirectX::XMLoadFloat3(&pVertices[vertexIdx].position));
+    }
+
+    meshCenter = DirectX::XMVectorScale(meshCenter, 1.0f / vertexCount);
+
+    // Sort key: the distance the cluster's area weighted center lies in front of the mesh's center, along the cluster's normal
+    std::vector<float> clusterSortKeys(clusterStarts.size());
+    for (size_t clusterIdx = 0u; clusterIdx < clusterStarts.size(); clusterIdx += 1u) {
+        const size_t triangleEnd = clusterIdx + 1u < clusterStarts.size() ? clusterStarts[clusterIdx + 1u] : triangleCount;
+
+        DirectX::XMVECTOR weightedCenter = DirectX::XMVectorZero();
+        DirectX::XMVECTOR normalSum = DirectX::XMVectorZero();
+        float areaSum = 0.0f;
+
+        for (size_t triangleIdx = clusterStarts[clusterIdx]; triangleIdx < triangleEnd; triangleIdx += 1u) {
+            const uint32_t* pTriangle = &pIndices[triangleIdx * 3u];
+            const DirectX::XMVECTOR p0 = DirectX::XMLoadFloat3(&pVertices[pTriangle[0]].position);
+            const DirectX::XMVECTOR p1 = DirectX::XMLoadFloat3(&pVertices[pTriangle[1]].position);
+            const DirectX::XMVECTOR p2 = DirectX::XMLoadFloat3(&pVertices[pTriangle[2]].position);
+
+            // The cross product's length is twice the triangle's area
+            const DirectX::XMVECTOR areaNormal = DirectX::XMVector3Cross(DirectX::XMVectorSubtract(p1, p0), DirectX::XMVectorSubtract(p2, p0));
+            const float area = DirectX::XMVectorGetX(DirectX::XMVector3Length(areaNormal));
+
+            const DirectX::XMVECTOR triangleCenter = DirectX::XMVectorScale(DirectX::XMVectorAdd(DirectX::XMVectorAdd(p0, p1), p2), 1.0f / 3.0f);
+            weightedCenter = DirectX::XMVectorAdd(weightedCenter, DirectX::XMVectorScale(triangleCenter, area));
+            normalSum = DirectX::XMVectorAdd(normalSum, areaNormal);
+            areaSum += area;
+        }
+
+        if (areaSum <= 0.0f) {
+            clusterSortKeys[clusterIdx] = -FLT_MAX;
+            continue;
+        }
+
+        weightedCenter = DirectX::XMVectorScale(weightedCenter, 1.0f / areaSum);
+        const DirectX::XMVECTOR clusterNormal = DirectX::XMVector3Normalize(normalSum);
+        clusterSortKeys[clusterIdx] = DirectX::XMVectorGetX(DirectX::XMVector3Dot(DirectX::XMVectorSubtract(weightedCenter, meshCenter), clusterNormal));
+    }
+
+    std::vector<uint32_t> clusterOrder(clusterStarts.size());
+    for (uint32_t clusterIdx = 0u; clusterIdx < (uint32_t)clusterOrder.size(); clusterIdx += 1u) {
+        clusterOrder[clusterIdx] = clusterIdx;
+    }
+
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterSortKeys](uint32_t clusterA, uint32_t clusterB) {
+        return clusterSortKeys[clusterA] > clusterSortKeys[clusterB];
+    });
+
+    std::vector<uint32_t> sortedIndices;
+    sortedIndices.reserve(triangleCount * 3u);
+
+    for (uint32_t clusterIdx : clusterOrder) {
+        const size_t triangleEnd = clusterIdx + 1u < clusterStarts.size() ? clusterStarts[clusterIdx + 1u] : triangleCount;
+        sortedIndices.insert(sortedIndices.end(), pIndices + clusterStarts[clusterIdx] * 3u, pIndices + triangleEnd * 3u);
+    }
+
+    std::copy(sortedIndices.begin(), sortedIndices.end(), pIndices);
+}
+
+size_t MeshOptimizer::OptimizeVertexFetch(Vertex* pVertices, size_t vertexCount, uint32_t* pIndices, size_t indexCount)
+{
+    std::vector<uint32_t> remappedIndices(vertexCount, INVALID_INDEX);
+    uint32_t usedVertexCount = 0u;
+
+    for (size_t indexIdx = 0u; indexIdx < indexCount; indexIdx += 1u) {
+        uint32_t& remappedIndex = remappedIndices[pIndices[indexIdx]];
+        if (remappedIndex == INVALID_INDEX) {
+            remappedIndex = usedVertexCount++;
+        }
+
+        pIndices[indexIdx] = remappedIndex;
+    }
+
+    std::vector<Vertex> reorderedVertices(usedVertexCount);
+    for (size_t vertexIdx = 0u; vertexIdx < vertexCount; vertexIdx += 1u) {
+        if (remappedIndices[vertexIdx] != INVALID_INDEX) {
+            reorderedVertices[remappedIndices[vertexIdx]] = pVertices[vertexIdx];
+        }
+    }
+
+    std::copy(reorderedVertices.begin(), reorderedVertices.end(), pVertices);
+    return usedVertexCount;
+}
+
+float MeshOptimizer::CalculateACMR(const uint32_t* pIndices, size_t indexCount, size_t vertexCount, uint32_t cacheSize)
+{
+    const size_t triangleCount = indexCount / 3u;
+    if (triangleCount == 0u) {
+        return 0.0f;
+    }
+
+    // A vertex is cached if fewer than cacheSize vertices have been transformed since it was
+    std::vector<uint32_t> cacheTimestamps(vertexCount, 0u);
+    uint32_t timestamp = cacheSize + 1u;
+    uint32_t misses = 0u;
+
+    for (size_t indexIdx = 0u; indexIdx < triangleCount * 3u; indexIdx += 1u) {
+        const uint32_t vertexIdx = pIndices[indexIdx];
+        if (timestamp - cacheTimestamps[vertexIdx] > cacheSize) {
+            cacheTimestamps[vertexIdx] = timestamp++;
+            misses += 1u;
+        }
+    }
+
+    return (float)misses / triangleCount;
+}
+
+std::vector<PackedVertex> MeshOptimizer::PackVertices(const Vertex* pVertices, size_t vertexCount)
+{
+    std::vector<PackedVertex> packedVertices(vertexCount);
+
+    for (size_t vertexIdx = 0u; vertexIdx < vertexCount; vertexIdx += 1u) {
+        const Vertex& vertex = pVertices[vertexIdx];
+        PackedVertex& packedVertex = packedVertices[vertexIdx];
+        packedVertex.position = vertex.position;
+
+        // Project the normal onto the octahedron |x| + |y| + |z| = 1, and fold the lower hemisphere over the upper one
+        const DirectX::XMFLOAT3& normal = vertex.normal;
+        const float normalL1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        DirectX::XMFLOAT2 octahedral = normalL1 > 0.0f ? DirectX::XMFLOAT2(normal.x / normalL1, normal.y / normalL1) : DirectX::XMFLOAT2(0.0f, 0.0f);
+
+        if (normal.z < 0.0f) {
+            octahedral = {
+                (1.0f - std::abs(octahedral.y)) * (octahedral.x >= 0.0f ? 1.0f : -1.0f),
+                (1.0f - std::abs(octahedral.x)) * (octahedral.y >= 0.0f ? 1.0f : -1.0f)
+            };
+        }
+
+        DirectX::PackedVector::XMStoreShortN2(&packedVertex.normal, DirectX::XMLoadFloat2(&octahedral));
+        DirectX::PackedVector::XMStoreHalf2(&packedVertex.txCoords, DirectX::XMLoadFloat2(&vertex.txCoords));
+    }
+
+    return packedVertices;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Engine/Rendering/AssetContainers/Vertex.hpp>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Size of the FIFO post-transform vertex cache simulated when measuring ACMR
+#define MESH_OPTIMIZER_ACMR_CACHE_SIZE 16u
+
+struct MeshOptimizationStats {
+    // Average cache miss ratio: transformed vertices per triangle
+    float ACMRBefore;
+    float ACMRAfter;
+    size_t VertexBytesBefore;
+    size_t VertexBytesAfter;
+    // Bytes of the optimized vertices once packed
+    size_t PackedVertexBytes;
+};
+
+/*  Reorders meshes' indices and vertices to reduce the work of drawing them. Indices are ordered to reuse transformed
+    vertices from the post-transform cache, and then by cluster to draw outward-facing triangles first. Vertices are
+    ordered by first use to improve the locality of vertex fetches. */
+class MeshOptimizer
+{
+public:
+    // Runs every optimization pass, removing vertices no triangle refers to
+    static MeshOptimizationStats OptimizeMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+    static void LogStats(const std::string& meshName, const MeshOptimizationStats& stats);
+
+    // Tom Forsyth's linear-speed vertex cache optimization
+    static void OptimizeVertexCache(uint32_t* pIndices, size_t indexCount, size_t vertexCount);
+    /*  Splits the index buffer into clusters where the vertex cache would have to be refilled anyway, and sorts the clusters
+        by how far out they face from the mesh's center. Expects vertex cache optimized indices, whose ACMR is mostly kept. */
+    static void OptimizeOverdraw(uint32_t* pIndices, size_t indexCount, const Vertex* pVertices, size_t vertexCount);
+    // Orders vertices by first use and remaps the indices. Returns the amount of vertices in use, which are moved to the front.
+    static size_t OptimizeVertexFetch(Vertex* pVertices, size_t vertexCount, uint32_t* pIndices, size_t indexCount);
+
+    static float CalculateACMR(const uint32_t* pIndices, size_t indexCount, size_t vertexCount, uint32_t cacheSize = MESH_OPTIMIZER_ACMR_CACHE_SIZE);
+
+    static std::vector<PackedVertex> PackVertices(const Vertex* pVertices, size_t vertexCount);
+};
@@ -0,0 +1,316 @@
+#include "MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+// Collapses are rejected if they turn a triangle's normal by more than ~85 degrees
+#define SIMPLIFIER_MIN_NORMAL_DOT 0.1f
+
+namespace
+{
+    // Sum of squared distances to a set of planes, weighted by the areas of the triangles spanning the planes
+    struct Quadric {
+        double A00, A01, A02, A11, A12, A22;
+        double B0, B1, B2;
+        double C;
+        double Weight;
+    };
+
+    struct Collapse {
+        uint32_t From, To;
+        float Error;
+    };
+
+    void AddPlane(Quadric& quadric, double nx, double ny, double nz, double d, double weight)
+    {
+        quadric.A00 += weight * nx * nx;
+        quadric.A01 += weight * nx * ny;
+        quadric.A02 += weight * nx * nz;
+        quadric.A11 += weight * ny * ny;
+        quadric.A12 += weight * ny * nz;
+        quadric.A22 += weight * nz * nz;
+        quadric.B0  += weight * nx * d;
+        quadric.B1  += weight * ny * d;
+        quadric.B2  += weight * nz * d;
+        quadric.C   += weight * d * d;
+        quadric.Weight += weight;
+    }
+
+    void AddQuadric(Quadric& quadric, const Quadric& other)
+    {
+        const double* pOther = &other.A00;
+        double* pQuadric = &quadric.A00;
+        for (size_t elementIdx = 0u; elementIdx < sizeof(Quadric) / sizeof(double); elementIdx += 1u) {
+            pQuadric[elementIdx] += pOther[elementIdx];
+        }
+    }
+
+    // Mean squared distance from the point to the quadric's planes
+    float EvaluateQuadric(const Quadric& quadric, const DirectX::XMFLOAT3& point)
+    {
+        if (quadric.Weight <= 0.0) {
+            return 0.0f;
+        }
+
+        const double x = point.x, y = point.y, z = point.z;
+        const double error =
+            quadric.A00 * x * x + quadric.A11 * y * y + quadric.A22 * z * z +
+            2.0 * (quadric.A01 * x * y + quadric.A02 * x * z + quadric.A12 * y * z) +
+            2.0 * (quadric.B0 * x + quadric.B1 * y + quadric.B2 * z) +
+            quadric.C;
+
+        return (float)(std::abs(error) / quadric.Weight);
+    }
+
+    DirectX::XMFLOAT3 TriangleNormal(const DirectX::XMFLOAT3& p0, const DirectX::XMFLOAT3& p1, const DirectX::XMFLOAT3& p2)
+    {
+        const float e1x = p1.x - p0.x, e1y = p1.y - p0.y, e1z = p1.z - p0.z;
+        const float e2x = p2.x - p0.x, e2y = p2.y - p0.y, e2z = p2.z - p0.z;
+        return { e1y * e2z - e1z * e2y, e1z * e2x - e1x * e2z, e1x * e2y - e1y * e2x };
+    }
+
+    uint64_t EdgeKey(uint32_t positionA, uint32_t positionB)
+    {
+        return positionA < positionB ? (uint64_t(positionA) << 32u) | positionB : (uint64_t(positionB) << 32u) | positionA;
+    }
+}
+
+std::vector<uint32_t> MeshSimplifier::Simplify(const Vertex* pVertices, size_t vertexCount, const uint32_t* pIndices, size_t indexCount, size_t targetIndexCount, float maxError)
+{
+    std::vector<uint32_t> indices(pIndices, pIndices + indexCount - indexCount % 3u);
+    if (indices.size() <= targetIndexCount || vertexCount == 0u) {
+        return indices;
+    }
+
+    // Give vertices sharing a position the same position ID
+    struct PositionHash {
+        size_t operator()(const DirectX::XMFLOAT3& position) const {
+            uint32_t bits[3];
+            std::memcpy(bits, &position, sizeof(bits));
+            return (size_t)bits[0] * 73856093u ^ (size_t)bits[1] * 19349663u ^ (size_t)bits[2] * 83492791u;
+        }
+    };
+
+    struct PositionEqual {
+        bool operator()(const DirectX::XMFLOAT3& positionA, const DirectX::XMFLOAT3& positionB) const {
+            return positionA.x == positionB.x && positionA.y == positionB.y && positionA.z == positionB.z;
+        }
+    };
+
+    std::unordered_map<DirectX::XMFLOAT3, uint32_t, PositionHash, PositionEqual> positionIDMap;
+    positionIDMap.reserve(vertexCount);
+
+    std::vector<uint32_t> positionIDs(vertexCount);
+    std::vector<uint32_t> positionVertexCounts;
+    for (size_t vertexIdx = 0u; vertexIdx < vertexCount; vertexIdx += 1u) {
+        const auto [positionItr, isNewPosition] = positionIDMap.insert({ pVertices[vertexIdx].position, (uint32_t)positionVertexCounts.size() });
+        if (isNewPosition) {
+            positionVertexCounts.push_back(0u);
+        }
+
+        positionIDs[vertexIdx] = positionItr->second;
+        positionVertexCounts[positionItr->second] += 1u;
+    }
+
+    // Seam vertices, and vertices on edges not shared by exactly two triangles, are locked in place
+    std::unordered_map<uint64_t, uint32_t> edgeTriangleCounts;
+    edgeTriangleCounts.reserve(indices.size());
+    for (size_t indexIdx = 0u; indexIdx < indices.size(); indexIdx += 3u) {
+        for (uint32_t cornerIdx = 0u; cornerIdx < 3u; cornerIdx += 1u) {
+            const uint32_t positionA = positionIDs[indices[indexIdx + cornerIdx]];
+            const uint32_t positionB = positionIDs[indices[indexIdx + (cornerIdx + 1u) % 3u]];
+            edgeTriangleCounts[EdgeKey(positionA, positionB)] += 1u;
+        }
+    }
+
+    std::vector<bool> lockedPositions(positionVertexCounts.size(), false);
+    for (size_t positionID = 0u; positionID < positionVertexCounts.size(); positionID += 1u) {
+        lockedPositions[positionID] = positionVertexCounts[positionID] > 1u;
+    }
+
+    for (const auto& edge : edgeTriangleCounts) {
+        if (edge.second != 2u) {
+            lockedPositions[uint32_t(edge.first >> 32u)] = true;
+            lockedPositions[uint32_t(edge.first & UINT32_MAX)] = true;
+        }
+    }
+
+    // Every position's quadric holds the planes of the triangles around it
+    std::vector<Quadric> quadrics(positionVertexCounts.size(), Quadric());
+    DirectX::XMFLOAT3 boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+    DirectX::XMFLOAT3 boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (size_t indexIdx = 0u; indexIdx < indices.size(); indexIdx += 3u) {
+        const DirectX::XMFLOAT3& p0 = pVertices[indices[indexIdx]].position;
+        const DirectX::XMFLOAT3 normal = TriangleNormal(p0, pVertices[indices[indexIdx + 1u]].position, pVertices[indices[indexIdx + 2u]].position);
+        const double length = std::sqrt((double)normal.x * normal.x + (double)normal.y * normal.y + (double)normal.z * normal.z);
+        if (length <= 0.0) {
+            continue;
+        }
+
+        const double nx = normal.x / length, ny = normal.y / length, nz = normal.z / length;
+        const double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+
+        for (uint32_t cornerIdx = 0u; cornerIdx < 3u; cornerIdx += 1u) {
+            AddPlane(quadrics[positionIDs[indices[indexIdx + cornerIdx]]], nx, ny, nz, d, length * 0.5);
+        }
+    }
+
+    for (size_t vertexIdx = 0u; vertexIdx < vertexCount; vertexIdx += 1u) {
+        const DirectX::XMFLOAT3& position = pVertices[vertexIdx].position;
+        boundsMin = { std::min(boundsMin.x, position.x), std::min(boundsMin.y, position.y), std::min(boundsMin.z, position.z) };
+        boundsMax = { std::max(boundsMax.x, position.x), std::max(boundsMax.y, position.y), std::max(boundsMax.z, position.z) };
+    }
+
+    const float boundsX = boundsMax.x - boundsMin.x, boundsY = boundsMax.y - boundsMin.y, boundsZ = boundsMax.z - boundsMin.z;
+    const float maxDistance = maxError * 0.5f * std::sqrt(boundsX * boundsX + boundsY * boundsY + boundsZ * boundsZ);
+    const float maxSquaredError = maxDistance * maxDistance;
+
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1u);
+    std::vector<uint32_t> adjacentTriangles;
+    std::vector<Collapse> collapses;
+    std::vector<uint32_t> remappedVertices(vertexCount);
+    std::vector<bool> touchedVertices(vertexCount);
+
+    // Each pass collapses a set of edges whose neighborhoods do not overlap
+    while (indices.size() > targetIndexCount) {
+        const size_t triangleCount = indices.size() / 3u;
+
+        // List the triangles around each vertex
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0u);
+        for (uint32_t index : indices) {
+            adjacencyOffsets[index + 1u] += 1u;
+        }
+
+        for (size_t vertexIdx = 0u; vertexIdx < vertexCount; vertexIdx += 1u) {
+            adjacencyOffsets[vertexIdx + 1u] += adjacencyOffsets[vertexIdx];
+        }
+
+        adjacentTriangles.resize(indices.size());
+        std::vector<uint32_t> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t indexIdx = 0u; indexIdx < indices.size(); indexIdx += 1u) {
+            adjacentTriangles[adjacencyFill[indices[indexIdx]]++] = (uint32_t)(indexIdx / 3u);
+        }
+
+        // Find the cheapest direction of each edge. Each edge is listed by both of its triangles, the duplicate is skipped later.
+        collapses.clear();
+        for (size_t indexIdx = 0u; indexIdx < indices.size(); indexIdx += 1u) {
+            const uint32_t vertexA = indices[indexIdx];
+            const uint32_t vertexB = indices[indexIdx - indexIdx % 3u + (indexIdx + 1u) % 3u];
+            const uint32_t positionA = positionIDs[vertexA], positionB = positionIDs[vertexB];
+            if (positionA == positionB || (lockedPositions[positionA] && lockedPositions[positionB])) {
+                continue;
+            }
+
+            Quadric edgeQuadric = quadrics[positionA];
+            AddQuadric(edgeQuadric, quadrics[positionB]);
+
+            const float errorAToB = lockedPositions[positionA] ? FLT_MAX : EvaluateQuadric(edgeQuadric, pVertices[vertexB].position);
+            const float errorBToA = lockedPositions[positionB] ? FLT_MAX : EvaluateQuadric(edgeQuadric, pVertices[vertexA].position);
+            const Collapse collapse = errorAToB <= errorBToA ? Collapse{ vertexA, vertexB, errorAToB } : Collapse{ vertexB, vertexA, errorBToA };
+
+            if (collapse.Error <= maxSquaredError) {
+                collapses.push_back(collapse);
+            }
+        }
+
+        if (collapses.empty()) {
+            break;
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& collapseA, const Collapse& collapseB) {
+            return collapseA.Error < collapseB.Error;
+        });
+
+        for (size_t vertexIdx = 0u; vertexIdx < vertexCount; vertexIdx += 1u) {
+            remappedVertices[vertexIdx] = (uint32_t)vertexIdx;
+        }
+
+        std::fill(touchedVertices.begin(), touchedVertices.end(), false);
+
+        const size_t trianglesToRemove = (indices.size() - targetIndexCount + 2u) / 3u;
+        size_t removedTriangles = 0u;
+
+        for (const Collapse& collapse : collapses) {
+            if (removedTriangles >= trianglesToRemove) {
+                break;
+            }
+
+            if (touchedVertices[collapse.From] || touchedVertices[collapse.To]) {
+                continue;
+            }
+
+            // Reject collapses that flip or fold any of the remaining triangles around the moved vertex
+            const uint32_t targetPosition = positionIDs[collapse.To];
+            const DirectX::XMFLOAT3& newPosition = pVertices[collapse.To].position;
+            size_t collapsedTriangles = 0u;
+            bool isValid = true;
+
+            for (uint32_t adjacencyIdx = adjacencyOffsets[collapse.From]; adjacencyIdx < adjacencyOffsets[collapse.From + 1u] && isValid; adjacencyIdx += 1u) {
+                const uint32_t* pTriangle = &indices[adjacentTriangles[adjacencyIdx] * 3u];
+                if (positionIDs[pTriangle[0]] == targetPosition || positionIDs[pTriangle[1]] == targetPosition || positionIDs[pTriangle[2]] == targetPosition) {
+                    collapsedTriangles += 1u;
+                    continue;
+                }
+
+                DirectX::XMFLOAT3 corners[3] = { pVertices[pTriangle[0]].position, pVertices[pTriangle[1]].position, pVertices[pTriangle[2]].position };
+                const DirectX::XMFLOAT3 oldNormal = TriangleNormal(corners[0], corners[1], corners[2]);
+                for (uint32_t cornerIdx = 0u; cornerIdx < 3u; cornerIdx += 1u) {
+                    if (pTriangle[cornerIdx] == collapse.From) {
+                        corners[cornerIdx] = newPosition;
+                    }
+                }
+
+                const DirectX::XMFLOAT3 newNormal = TriangleNormal(corners[0], corners[1], corners[2]);
+                const float normalDot = oldNormal.x * newNormal.x + oldNormal.y * newNormal.y + oldNormal.z * newNormal.z;
+                const float oldLength = std::sqrt(oldNormal.x * oldNormal.x + oldNormal.y * oldNormal.y + oldNormal.z * oldNormal.z);
+                const float newLength = std::sqrt(newNormal.x * newNormal.x + newNormal.y * newNormal.y + newNormal.z * newNormal.z);
+                isValid = normalDot > SIMPLIFIER_MIN_NORMAL_DOT * oldLength * newLength;
+            }
+
+            if (!isValid || collapsedTriangles == 0u) {
+                continue;
+            }
+
+            // The triangles around the moved vertex change, the rest of their vertices wait for the next pass
+            for (uint32_t adjacencyIdx = adjacencyOffsets[collapse.From]; adjacencyIdx < adjacencyOffsets[collapse.From + 1u]; adjacencyIdx += 1u) {
+                const uint32_t* pTriangle = &indices[adjacentTriangles[adjacencyIdx] * 3u];
+                touchedVertices[pTriangle[0]] = true;
+                touchedVertices[pTriangle[1]] = true;
+                touchedVertices[pTriangle[2]] = true;
+            }
+
+            remappedVertices[collapse.From] = collapse.To;
+            AddQuadric(quadrics[targetPosition], quadrics[positionIDs[collapse.From]]);
+            removedTriangles += collapsedTriangles;
+        }
+
+        if (removedTriangles == 0u) {
+            break;
+        }
+
+        // Remap the indices and remove the collapsed triangles
+        size_t writeIdx = 0u;
+        for (size_t triangleIdx = 0u; triangleIdx < triangleCount; triangleIdx += 1u) {
+            const uint32_t vertex0 = remappedVertices[indices[triangleIdx * 3u]];
+            const uint32_t vertex1 = remappedVertices[indices[triangleIdx * 3u + 1u]];
+            const uint32_t vertex2 = remappedVertices[indices[triangleIdx * 3u + 2u]];
+
+            const uint32_t position0 = positionIDs[vertex0], position1 = positionIDs[vertex1], position2 = positionIDs[vertex2];
+            if (position0 == position1 || position0 == position2 || position1 == position2) {
+                continue;
+            }
+
+            indices[writeIdx++] = vertex0;
+            indices[writeIdx++] = vertex1;
+            indices[writeIdx++] = vertex2;
+        }
+
+        indices.resize(writeIdx);
+    }
+
+    return indices;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Engine/Rendering/AssetContainers/Vertex.hpp>
+
+#include <stdint.h>
+#include <vector>
+
+/*  Simplifies meshes by collapsing edges in order of their quadric error (Garland and Heckbert). A collapse moves one of
+    the edge's vertices onto the other, no vertices are moved or created. The simplified indices therefore refer to the
+    original vertices, which lets each level of detail share the mesh's vertex buffer. Vertices on borders and on
+    attribute seams, i.e. vertices sharing their position with other vertices, are never moved. */
+class MeshSimplifier
+{
+public:
+    /*  Returns at most targetIndexCount indices, unless the target can not be reached without exceeding the maximum error.
+        The error is the distance between the simplified and original surfaces, relative to the mesh's bounding radius. */
+    static std::vector<uint32_t> Simplify(const Vertex* pVertices, size_t vertexCount, const uint32_t* pIndices, size_t indexCount, size_t targetIndexCount, float maxError);
+};
@@ -0,0 +1,350 @@
+#include "ModelCooker.hpp"
+
+#include <Engine/Rendering/AssetLoaders/MeshOptimizer.hpp>
+#include <Engine/Rendering/AssetLoaders/MeshSimplifier.hpp>
+#include <Engine/Utils/Logger.hpp>
+#include <Engine/Utils/MappedFile.hpp>
+
+#include <vendor/assimp/Importer.hpp>
+#include <vendor/assimp/postprocess.h>
+
+#include <assimp/material.h>
+#include <assimp/mesh.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <filesystem>
+#include <fstream>
+
+bool ModelCooker::ImportModel(const std::string& filePath, ModelData& modelData)
+{
+    Assimp::Importer importer;
+    const aiScene* pScene = importer.ReadFile(filePath, aiProcess_GenUVCoords | aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenNormals | aiProcess_FlipUVs);
+
+    if (!pScene) {
+        LOG_WARNINGF("Model could not be imported: [%s]", filePath.c_str());
+        return false;
+    }
+
+    LOG_INFOF("Importing model [%s] containing [%d] meshes and [%d] materials", filePath.c_str(), pScene->mNumMeshes, pScene->mNumMaterials);
+
+    // Materials lacking a diffuse texture are skipped, the meshes' material indices are remapped accordingly
+    std::vector<uint32_t> materialIndices(pScene->mNumMaterials, 0u);
+    modelData.Materials.reserve(pScene->mNumMaterials);
+
+    for (unsigned int materialIdx = 0; materialIdx < pScene->mNumMaterials; materialIdx += 1) {
+        MaterialData materialData = {};
+        if (ImportMaterial(pScene->mMaterials[materialIdx], materialData)) {
+            materialIndices[materialIdx] = (uint32_t)modelData.Materials.size();
+            modelData.Materials.push_back(materialData);
+        }
+    }
+
+    // Traverse nodes to find which meshes to import
+    std::vector<unsigned int> meshIndices;
+    FindUsedMeshes(meshIndices, pScene->mRootNode, pScene);
+
+    modelData.Meshes.reserve(meshIndices.size());
+    for (unsigned int meshIndex : meshIndices) {
+        MeshData meshData = {};
+        if (ImportMesh(pScene->mMeshes[meshIndex], meshData)) {
+            meshData.MaterialIndex = materialIndices[pScene->mMeshes[meshIndex]->mMaterialIndex];
+
+            const MeshOptimizationStats optimizationStats = MeshOptimizer::OptimizeMesh(meshData.Vertices, meshData.Indices);
+            MeshOptimizer::LogStats(filePath + " mesh " + std::to_string(meshIndex), optimizationStats);
+
+            GenerateLODs(meshData);
+            std::string lodTriangleCounts;
+            for (uint32_t lodIndexCount : meshData.LODIndexCounts) {
+                lodTriangleCounts += " " + std::to_string(lodIndexCount / 3u);
+            }
+
+            LOG_INFOF("Mesh [%d] LOD triangle counts:%s", meshIndex, lodTriangleCounts.c_str());
+            modelData.Meshes.push_back(std::move(meshData));
+        }
+    }
+
+    return true;
+}
+
+bool ModelCooker::WriteCookedModel(const std::string& filePath, const ModelData& modelData)
+{
+    CookedModelHeader header = {};
+    header.Magic            = COOKED_MODEL_MAGIC;
+    header.Version          = COOKED_MODEL_VERSION;
+    header.MeshCount        = (uint32_t)modelData.Meshes.size();
+    header.MaterialCount    = (uint32_t)modelData.Materials.size();
+    header.BoundsMin        = { FLT_MAX, FLT_MAX, FLT_MAX };
+    header.BoundsMax        = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    if (!GetSourceFileInfo(filePath, header.SourceSize, header.SourceWriteTime)) {
+        LOG_WARNINGF("Failed to retrieve file info of model: [%s]", filePath.c_str());
+        return false;
+    }
+
+    auto alignOffset = [](uint64_t offset) {
+        return (offset + COOKED_MODEL_ALIGNMENT - 1u) & ~uint64_t(COOKED_MODEL_ALIGNMENT - 1u);
+    };
+
+    // Lay out the vertex and index arrays after the mesh and material tables
+    uint64_t dataOffset = sizeof(CookedModelHeader) + sizeof(CookedMesh) * modelData.Meshes.size() + sizeof(CookedMaterial) * modelData.Materials.size();
+    std::vector<CookedMesh> cookedMeshes;
+    cookedMeshes.reserve(modelData.Meshes.size());
+
+    for (const MeshData& meshData : modelData.Meshes) {
+        CookedMesh cookedMesh = {};
+        cookedMesh.VertexCount      = (uint32_t)meshData.Vertices.size();
+        cookedMesh.IndexCount       = (uint32_t)meshData.Indices.size();
+        cookedMesh.MaterialIndex    = meshData.MaterialIndex;
+        cookedMesh.LODCount         = (uint32_t)meshData.LODIndexCounts.size();
+        std::copy(meshData.LODIndexCounts.begin(), meshData.LODIndexCounts.end(), cookedMesh.LODIndexCounts);
+        cookedMesh.BoundsMin        = meshData.BoundsMin;
+        cookedMesh.BoundsMax        = meshData.BoundsMax;
+
+        cookedMesh.VerticesOffset   = alignOffset(dataOffset);
+        dataOffset = cookedMesh.VerticesOffset + sizeof(Vertex) * meshData.Vertices.size();
+        cookedMesh.IndicesOffset    = alignOffset(dataOffset);
+        dataOffset = cookedMesh.IndicesOffset + sizeof(uint32_t) * meshData.Indices.size();
+
+        header.BoundsMin = { std::min(header.BoundsMin.x, meshData.BoundsMin.x), std::min(header.BoundsMin.y, meshData.BoundsMin.y), std::min(header.BoundsMin.z, meshData.BoundsMin.z) };
+        header.BoundsMax = { std::max(header.BoundsMax.x, meshData.BoundsMax.x), std::max(header.BoundsMax.y, meshData.BoundsMax.y), std::max(header.BoundsMax.z, meshData.BoundsMax.z) };
+
+        cookedMeshes.push_back(cookedMesh);
+    }
+
+    std::vector<CookedMaterial> cookedMaterials;
+    cookedMaterials.reserve(modelData.Materials.size());
+
+    for (const MaterialData& materialData : modelData.Materials) {
+        if (materialData.DiffuseTexture.size() >= COOKED_MODEL_PATH_LENGTH) {
+            LOG_WARNINGF("Texture path is too long to be cooked: [%s]", materialData.DiffuseTexture.c_str());
+            return false;
+        }
+
+        CookedMaterial cookedMaterial = {};
+        cookedMaterial.Specular = materialData.Specular;
+        std::copy(materialData.DiffuseTexture.begin(), materialData.DiffuseTexture.end(), cookedMaterial.DiffuseTexture);
+        cookedMaterials.push_back(cookedMaterial);
+    }
+
+    const std::string cookedPath = GetCookedPath(filePath);
+    std::ofstream file(cookedPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_WARNINGF("Failed to open cooked model for writing: [%s]", cookedPath.c_str());
+        return false;
+    }
+
+    file.write((const char*)&header, sizeof(CookedModelHeader));
+    file.write((const char*)cookedMeshes.data(), sizeof(CookedMesh) * cookedMeshes.size());
+    file.write((const char*)cookedMaterials.data(), sizeof(CookedMaterial) * cookedMaterials.size());
+
+    // Pad to each array's offset
+    const char padding[COOKED_MODEL_ALIGNMENT] = {};
+    for (size_t meshIdx = 0u; meshIdx < cookedMeshes.size(); meshIdx += 1u) {
+        const CookedMesh& cookedMesh = cookedMeshes[meshIdx];
+        const MeshData& meshData = modelData.Meshes[meshIdx];
+
+        file.write(padding, cookedMesh.VerticesOffset - (uint64_t)file.tellp());
+        file.write((const char*)meshData.Vertices.data(), sizeof(Vertex) * meshData.Vertices.size());
+        file.write(padding, cookedMesh.IndicesOffset - (uint64_t)file.tellp());
+        file.write((const char*)meshData.Indices.data(), sizeof(uint32_t) * meshData.Indices.size());
+    }
+
+    if (!file.good()) {
+        LOG_WARNINGF("Failed to write cooked model: [%s]", cookedPath.c_str());
+        file.close();
+        std::filesystem::remove(cookedPath);
+        return false;
+    }
+
+    return true;
+}
+
+bool ModelCooker::CookModel(const std::string& filePath)
+{
+    ModelData modelData;
+    return ImportModel(filePath, modelData) && WriteCookedModel(filePath, modelData);
+}
+
+const CookedModelHeader* ModelCooker::ValidateCookedModel(const MappedFile& cookedFile, const std::string& sourcePath)
+{
+    if (cookedFile.GetSize() < sizeof(CookedModelHeader)) {
+        return nullptr;
+    }
+
+    const CookedModelHeader* pHeader = reinterpret_cast<const CookedModelHeader*>(cookedFile.GetData());
+    if (pHeader->Magic != COOKED_MODEL_MAGIC || pHeader->Version != COOKED_MODEL_VERSION) {
+        return nullptr;
+    }
+
+    const uint64_t tablesSize = sizeof(CookedModelHeader) + sizeof(CookedMesh) * pHeader->MeshCount + sizeof(CookedMaterial) * pHeader->MaterialCount;
+    if (cookedFile.GetSize() < tablesSize) {
+        return nullptr;
+    }
+
+    // Make sure every array is within the file
+    const CookedMesh* pMeshes = reinterpret_cast<const CookedMesh*>(pHeader + 1);
+    for (uint32_t meshIdx = 0u; meshIdx < pHeader->MeshCount; meshIdx += 1u) {
+        const CookedMesh& mesh = pMeshes[meshIdx];
+        if (mesh.VerticesOffset + sizeof(Vertex) * mesh.VertexCount > cookedFile.GetSize() ||
+            mesh.IndicesOffset + sizeof(uint32_t) * mesh.IndexCount > cookedFile.GetSize()) {
+            return nullptr;
+        }
+
+        if (mesh.LODCount == 0u || mesh.LODCount > MAX_MESH_LODS) {
+            return nullptr;
+        }
+
+        uint64_t lodIndexCount = 0u;
+        for (uint32_t lodIdx = 0u; lodIdx < mesh.LODCount; lodIdx += 1u) {
+            lodIndexCount += mesh.LODIndexCounts[lodIdx];
+        }
+
+        if (lodIndexCount != mesh.IndexCount) {
+            return nullptr;
+        }
+    }
+
+    uint64_t sourceSize = 0u;
+    int64_t sourceWriteTime = 0;
+    if (GetSourceFileInfo(sourcePath, sourceSize, sourceWriteTime) && (sourceSize != pHeader->SourceSize || sourceWriteTime != pHeader->SourceWriteTime)) {
+        return nullptr;
+    }
+
+    return pHeader;
+}
+
+bool ModelCooker::ImportMesh(const aiMesh* pAssimpMesh, MeshData& meshData)
+{
+    if (!pAssimpMesh->HasPositions()) {
+        LOG_WARNING("Assimp mesh is missing vertex positions");
+        return false;
+    }
+
+    if (!pAssimpMesh->HasNormals()) {
+        LOG_WARNING("Assimp mesh is missing normals");
+        return false;
+    }
+
+    meshData.Vertices.resize(pAssimpMesh->mNumVertices);
+    meshData.BoundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+    meshData.BoundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    // Read vertex data
+    for (unsigned int i = 0; i < pAssimpMesh->mNumVertices; i += 1) {
+        Vertex& vertex = meshData.Vertices[i];
+        vertex.position = { pAssimpMesh->mVertices[i].x, pAssimpMesh->mVertices[i].y, pAssimpMesh->mVertices[i].z };
+        vertex.normal   = { pAssimpMesh->mNormals[i].x, pAssimpMesh->mNormals[i].y, pAssimpMesh->mNormals[i].z };
+        vertex.txCoords = { pAssimpMesh->mTextureCoords[0][i].x, pAssimpMesh->mTextureCoords[0][i].y };
+
+        meshData.BoundsMin = { std::min(meshData.BoundsMin.x, vertex.position.x), std::min(meshData.BoundsMin.y, vertex.position.y), std::min(meshData.BoundsMin.z, vertex.position.z) };
+        meshData.BoundsMax = { std::max(meshData.BoundsMax.x, vertex.position.x), std::max(meshData.BoundsMax.y, vertex.position.y), std::max(meshData.BoundsMax.z, vertex.position.z) };
+    }
+
+    // Read indices
+    meshData.Indices.resize(size_t(pAssimpMesh->mNumFaces) * 3u);
+
+    for (size_t faceIdx = 0; faceIdx < pAssimpMesh->mNumFaces; faceIdx += 1) {
+        const aiFace* face = &pAssimpMesh->mFaces[faceIdx];
+
+        if (face->mNumIndices != 3) {
+            LOG_WARNINGF("Mesh face has an unexpected amount of indices: %d", face->mNumIndices);
+            return false;
+        }
+
+        meshData.Indices[faceIdx * 3]       = face->mIndices[0];
+        meshData.Indices[faceIdx * 3 + 1]   = face->mIndices[1];
+        meshData.Indices[faceIdx * 3 + 2]   = face->mIndices[2];
+    }
+
+    return true;
+}
+
+bool ModelCooker::ImportMaterial(const aiMaterial* pAssimpMaterial, MaterialData& materialData)
+{
+    // Get diffuse texture
+    if (pAssimpMaterial->GetTextureCount(aiTextureType_DIFFUSE) == 0) {
+        LOG_WARNING("Loading material lacks a diffuse texture");
+        return false;
+    }
+
+    // Get file path of a desired texture
+    aiString textureName;
+    pAssimpMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &textureName);
+
+    materialData.DiffuseTexture = textureName.C_Str();
+
+    // Remove all whitespaces from the texture name
+    std::replace(materialData.DiffuseTexture.begin(), materialData.DiffuseTexture.end(), ' ', '_');
+
+    // Load material attributes
+    aiColor3D aiSpecular;
+    ai_real aiShininess = 0.0f, aiShininessStrength = 0.0f;
+
+    pAssimpMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aiSpecular);
+    pAssimpMaterial->Get(AI_MATKEY_SHININESS, aiShininess);
+    pAssimpMaterial->Get(AI_MATKEY_SHININESS_STRENGTH, aiShininessStrength);
+
+    // Set shininess factor to 0.5 if there is none
+    aiShininessStrength = aiShininessStrength < 0.01f || aiShininessStrength > 1.0f ? 0.5f : aiShininessStrength;
+
+    materialData.Specular = DirectX::XMFLOAT4(aiShininess, aiShininessStrength, 0.0f, 0.0f);
+    return true;
+}
+
+void ModelCooker::GenerateLODs(MeshData& meshData)
+{
+    meshData.LODIndexCounts = { (uint32_t)meshData.Indices.size() };
+    std::vector<uint32_t> previousLOD = meshData.Indices;
+
+    while (meshData.LODIndexCounts.size() < MAX_MESH_LODS) {
+        const size_t targetIndexCount = size_t(previousLOD.size() / 3u * MESH_LOD_REDUCTION) * 3u;
+        std::vector<uint32_t> lodIndices = MeshSimplifier::Simplify(meshData.Vertices.data(), meshData.Vertices.size(), previousLOD.data(), previousLOD.size(), targetIndexCount, MESH_LOD_MAX_ERROR);
+        if (lodIndices.empty() || lodIndices.size() > previousLOD.size() * MESH_LOD_MIN_REDUCTION) {
+            break;
+        }
+
+        MeshOptimizer::OptimizeVertexCache(lodIndices.data(), lodIndices.size(), meshData.Vertices.size());
+
+        meshData.Indices.insert(meshData.Indices.end(), lodIndices.begin(), lodIndices.end());
+        meshData.LODIndexCounts.push_back((uint32_t)lodIndices.size());
+        previousLOD = std::move(lodIndices);
+    }
+}
+
+void ModelCooker::FindUsedMeshes(std::vector<unsigned int>& meshIndices, const aiNode* pNode, const aiScene* pScene)
+{
+    meshIndices.reserve(meshIndices.size() + pNode->mNumMeshes);
+
+    // Insert this node's mesh indices
+    for (unsigned int i = 0; i < pNode->mNumMeshes; i += 1) {
+        // Make sure the mesh has texture coordinates
+        if (!pScene->mMeshes[pNode->mMeshes[i]]->HasTextureCoords(0)) {
+            LOG_WARNINGF("Ignoring mesh [%d]: missing texture coordinates", pNode->mMeshes[i]);
+            continue;
+        }
+
+        // Make sure the mesh index is not already listed
+        if (std::find(meshIndices.begin(), meshIndices.end(), pNode->mMeshes[i]) == meshIndices.end()) {
+            meshIndices.push_back(pNode->mMeshes[i]);
+        }
+    }
+
+    // Insert childrens' mesh indices
+    for (unsigned int i = 0; i < pNode->mNumChildren; i += 1) {
+        FindUsedMeshes(meshIndices, pNode->mChildren[i], pScene);
+    }
+}
+
+bool ModelCooker::GetSourceFileInfo(const std::string& sourcePath, uint64_t& size, int64_t& writeTime)
+{
+    std::error_code errorCode;
+    size = (uint64_t)std::filesystem::file_size(sourcePath, errorCode);
+    if (errorCode) {
+        return false;
+    }
+
+    writeTime = (int64_t)std::filesystem::last_write_time(sourcePath, errorCode).time_since_epoch().count();
+    return !errorCode;
+}
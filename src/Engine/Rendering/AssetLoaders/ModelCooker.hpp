@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Engine/Rendering/AssetContainers/Vertex.hpp>
+
+#include <DirectXMath.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class MappedFile;
+struct aiMaterial;
+struct aiMesh;
+struct aiNode;
+struct aiScene;
+
+#define COOKED_MODEL_MAGIC          0x4C444D53u // "SMDL"
+// Incremented whenever the layout of cooked models changes, which invalidates previously cooked models
+#define COOKED_MODEL_VERSION        3u
+#define COOKED_MODEL_EXTENSION      ".cooked"
+#define COOKED_MODEL_PATH_LENGTH    256u
+// Alignment of the vertex and index arrays within the file
+#define COOKED_MODEL_ALIGNMENT      16u
+
+// Levels of detail per mesh, including the full detail mesh
+#define MAX_MESH_LODS               4u
+// Each LOD targets this fraction of the previous LOD's triangles
+#define MESH_LOD_REDUCTION          0.5f
+// LODs keeping more than this fraction of the previous LOD's triangles are discarded, ending the mesh's LOD chain
+#define MESH_LOD_MIN_REDUCTION      0.8f
+// Maximum distance between a LOD's surface and the full detail surface, relative to the mesh's bounding radius
+#define MESH_LOD_MAX_ERROR          0.05f
+
+/*  Cooked model layout: CookedModelHeader, CookedMesh[MeshCount], CookedMaterial[MaterialCount], followed by the
+    meshes' vertex and index arrays. Vertices and indices are stored in the layout they are uploaded in, which lets the
+    loader upload them straight from the mapped file. */
+struct CookedModelHeader {
+    uint32_t Magic;
+    uint32_t Version;
+    // Used to detect when the source model has changed since it was cooked
+    uint64_t SourceSize;
+    int64_t SourceWriteTime;
+    uint32_t MeshCount;
+    uint32_t MaterialCount;
+    DirectX::XMFLOAT3 BoundsMin;
+    DirectX::XMFLOAT3 BoundsMax;
+};
+
+struct CookedMesh {
+    // Byte offsets from the start of the file
+    uint64_t VerticesOffset;
+    uint64_t IndicesOffset;
+    uint32_t VertexCount;
+    // Total amount of indices of every LOD
+    uint32_t IndexCount;
+    uint32_t MaterialIndex;
+    uint32_t LODCount;
+    uint32_t LODIndexCounts[MAX_MESH_LODS];
+    DirectX::XMFLOAT3 BoundsMin;
+    DirectX::XMFLOAT3 BoundsMax;
+};
+
+struct CookedMaterial {
+    DirectX::XMFLOAT4 Specular;
+    // Relative to the model's directory
+    char DiffuseTexture[COOKED_MODEL_PATH_LENGTH];
+};
+
+// CPU-side model data, produced by importing a model with Assimp
+struct MeshData {
+    std::vector<Vertex> Vertices;
+    // The indices of every LOD back to back, starting with the full detail mesh. Every LOD uses the same vertices.
+    std::vector<uint32_t> Indices;
+    std::vector<uint32_t> LODIndexCounts;
+    uint32_t MaterialIndex;
+    DirectX::XMFLOAT3 BoundsMin;
+    DirectX::XMFLOAT3 BoundsMax;
+};
+
+struct MaterialData {
+    DirectX::XMFLOAT4 Specular;
+    std::string DiffuseTexture;
+};
+
+struct ModelData {
+    std::vector<MeshData> Meshes;
+    std::vector<MaterialData> Materials;
+};
+
+// Converts models into the cooked format offline using the asset cooker. The engine only reads cooked models.
+class ModelCooker
+{
+public:
+    // Imports the model using Assimp, skipping meshes and materials the engine can not use
+    static bool ImportModel(const std::string& filePath, ModelData& modelData);
+    static bool WriteCookedModel(const std::string& filePath, const ModelData& modelData);
+
+    // Imports the model and writes its cooked version next to it
+    static bool CookModel(const std::string& filePath);
+
+    static std::string GetCookedPath(const std::string& filePath) { return filePath + COOKED_MODEL_EXTENSION; }
+
+    /*  Returns the header if the mapped file is a cooked model of the current version, and if it is up to date with the
+        source model. Models shipped without their source are considered up to date. */
+    static const CookedModelHeader* ValidateCookedModel(const MappedFile& cookedFile, const std::string& sourcePath);
+
+private:
+    static bool ImportMesh(const aiMesh* pAssimpMesh, MeshData& meshData);
+    static bool ImportMaterial(const aiMaterial* pAssimpMaterial, MaterialData& materialData);
+    // Appends simplified versions of the mesh's indices until the LOD limit is reached or simplification stops paying off
+    static void GenerateLODs(MeshData& meshData);
+    // Recursively traverse assimp scene nodes to find out which meshes are used
+    static void FindUsedMeshes(std::vector<unsigned int>& meshIndices, const aiNode* pNode, const aiScene* pScene);
+
+    static bool GetSourceFileInfo(const std::string& sourcePath, uint64_t& size, int64_t& writeTime);
+};
@@ -4,37 +4,183 @@
 #include <Engine/Rendering/APIAbstractions/Device.hpp>
 #include <Engine/Rendering/APIAbstractions/IBuffer.hpp>
 #include <Engine/Rendering/AssetContainers/Model.hpp>
+#include <Engine/Rendering/AssetLoaders/MeshOptimizer.hpp>
+#include <Engine/Rendering/AssetLoaders/ModelCooker.hpp>
 #include <Engine/Rendering/AssetLoaders/TextureCache.hpp>
 #include <Engine/Utils/Debug.hpp>
 #include <Engine/Utils/DirectXUtils.hpp>
 #include <Engine/Utils/ECSUtils.hpp>
-
-#include <vendor/assimp/Importer.hpp>
-#include <vendor/assimp/postprocess.h>
+#include <Engine/Utils/MappedFile.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
 
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 
-ModelLoader::ModelLoader(TextureCache* pTextureCache, Device* pDevice)
+ModelLoader::ModelLoader(TextureCache* pTextureCache, Device* pDevice, ResidencyManager* pResidencyManager, bool packedVertices)
     :m_pTextureCache(pTextureCache),
-    m_pDevice(pDevice)
-{}
+    m_pDevice(pDevice),
+    m_PackedVertices(packedVertices)
+{
+    // The materials' textures are tracked by the texture cache
+    const size_t vertexSize = packedVertices ? sizeof(PackedVertex) : sizeof(Vertex);
+    m_ModelCache.SetResidencyManager(pResidencyManager, [vertexSize](const Model& model) {
+        size_t byteSize = 0u;
+        for (const Mesh& mesh : model.Meshes) {
+            byteSize += mesh.vertexCount * vertexSize + mesh.indexCount * sizeof(uint32_t);
+        }
+
+        return byteSize;
+    });
+}
 
 ModelComponent ModelLoader::LoadModel(const std::string& filePath)
 {
-    auto itr = m_ModelCache.find(filePath);
-    if (itr != m_ModelCache.end()) {
-        std::weak_ptr<Model>& modelPtr = itr->second;
-
-        if (modelPtr.expired()) {
-            // The model used to exist but has been deleted
-            m_ModelCache.erase(itr);
-        } else {
-            return ModelComponent{
-                .ModelPtr = modelPtr.lock()
-            };
+    const auto loadModel = [this, &filePath]() {
+        std::vector<std::string> texturePaths;
+        std::shared_ptr<Model> model = CreateModel(filePath, texturePaths);
+        if (!model) {
+            return model;
+        }
+
+        for (uint32_t materialIdx = 0u; materialIdx < (uint32_t)texturePaths.size(); materialIdx += 1u) {
+            model->Materials[materialIdx].textures.push_back(m_pTextureCache->LoadTexture(texturePaths[materialIdx]));
+        }
+
+        return model;
+    };
+
+    return ModelComponent{
+        .ModelPtr = m_ModelCache.Load(filePath, loadModel)
+    };
+}
+
+ModelFuture ModelLoader::LoadModelAsync(const std::string& filePath, const ModelCallback& onLoaded)
+{
+    const auto startLoad = [this, &filePath]() {
+        ThreadPool::GetInstance().ExecuteDetached([this, filePath]() {
+            ExecuteAsyncLoad(filePath);
+        });
+    };
+
+    return m_ModelCache.LoadAsync(filePath, startLoad, onLoaded);
+}
+
+void ModelLoader::LoadModelAsync(const std::string& filePath, Entity entity)
+{
+    ECSCore* pECS = ECSCore::GetInstance();
+
+    std::shared_ptr<Model> model = m_ModelCache.Find(filePath);
+    if (model) {
+        pECS->AddComponent(entity, ModelComponent({ .ModelPtr = model }));
+        return;
+    }
+
+    std::shared_ptr<Model> placeholderModel = GetPlaceholderModel();
+    if (!placeholderModel) {
+        // Without a placeholder, the entity could not be told apart from a later entity reusing its ID
+        pECS->AddComponent(entity, LoadModel(filePath));
+        return;
+    }
+
+    /*  The entity might be deleted and its ID reused before the model has loaded. Each request's placeholder gets a
+        control block of its own, so that the loaded model only replaces the placeholder of this request. */
+    std::shared_ptr<Model> requestPlaceholder(placeholderModel.get(), [placeholderModel](Model*) {});
+    pECS->AddComponent(entity, ModelComponent({ .ModelPtr = requestPlaceholder }));
+
+    std::weak_ptr<Model> weakPlaceholder = requestPlaceholder;
+    LoadModelAsync(filePath, [entity, weakPlaceholder](const std::shared_ptr<Model>& loadedModel) {
+        if (!loadedModel) {
+            // Keep rendering the placeholder
+            return;
+        }
+
+        // The callback runs on a worker thread, the component is inspected in a job that is scheduled alongside the systems
+        ECSCore::GetInstance()->ScheduleJobASAP({
+            .Components = { { R, ModelComponent::Type() } },
+            .Function = [entity, weakPlaceholder, loadedModel]() {
+                ECSCore* pECS = ECSCore::GetInstance();
+
+                const ModelComponent* pModelComponent = nullptr;
+                const bool holdsPlaceholder = pECS->GetConstComponentIf(entity, &pModelComponent)
+                    && !weakPlaceholder.owner_before(pModelComponent->ModelPtr) && !pModelComponent->ModelPtr.owner_before(weakPlaceholder);
+
+                if (holdsPlaceholder) {
+                    pECS->ReplaceComponent(entity, ModelComponent({ .ModelPtr = loadedModel }));
+                }
+            },
+            .pName = "Replace placeholder model"
+        });
+    });
+}
+
+std::shared_ptr<Model> ModelLoader::GetPlaceholderModel()
+{
+    std::shared_ptr<Texture> placeholderTexture = m_pTextureCache->GetPlaceholderTexture();
+
+    std::scoped_lock<std::mutex> lock(m_PlaceholderLock);
+    if (m_PlaceholderModel || !placeholderTexture) {
+        return m_PlaceholderModel;
+    }
+
+    // Each face has its own vertices to give the faces flat normals
+    constexpr const uint32_t faceCount = 6u;
+    const DirectX::XMFLOAT3 faceNormals[faceCount] = {
+        { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+    };
+
+    const DirectX::XMFLOAT2 cornerTXCoords[4u] = { { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f } };
+
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    vertices.reserve(faceCount * 4u);
+    indices.reserve(faceCount * 6u);
+
+    for (const DirectX::XMFLOAT3& faceNormal : faceNormals) {
+        // The face's U and V axes are perpendicular to the normal, and U x V = normal
+        const DirectX::XMVECTOR normal = DirectX::XMLoadFloat3(&faceNormal);
+        const DirectX::XMVECTOR axisU = DirectX::XMVectorSwizzle<DirectX::XM_SWIZZLE_Y, DirectX::XM_SWIZZLE_Z, DirectX::XM_SWIZZLE_X, DirectX::XM_SWIZZLE_W>(normal);
+        const DirectX::XMVECTOR axisV = DirectX::XMVector3Cross(normal, axisU);
+
+        const uint32_t firstVertex = (uint32_t)vertices.size();
+        for (uint32_t cornerIdx = 0u; cornerIdx < 4u; cornerIdx += 1u) {
+            const float u = cornerIdx == 1u || cornerIdx == 2u ? 0.5f : -0.5f;
+            const float v = cornerIdx >= 2u ? 0.5f : -0.5f;
+            const DirectX::XMVECTOR position = DirectX::XMVectorAdd(DirectX::XMVectorScale(normal, 0.5f), DirectX::XMVectorAdd(DirectX::XMVectorScale(axisU, u), DirectX::XMVectorScale(axisV, v)));
+
+            Vertex vertex = {};
+            DirectX::XMStoreFloat3(&vertex.position, position);
+            vertex.normal   = faceNormal;
+            vertex.txCoords = cornerTXCoords[cornerIdx];
+            vertices.push_back(vertex);
+        }
+
+        for (uint32_t cornerIdx : { 0u, 1u, 2u, 0u, 2u, 3u }) {
+            indices.push_back(firstVertex + cornerIdx);
         }
     }
 
+    std::shared_ptr<Model> placeholderModel(DBG_NEW Model(), ReleaseModel);
+    placeholderModel->BoundsCenter = { 0.0f, 0.0f, 0.0f };
+    placeholderModel->BoundsRadius = std::sqrt(0.75f);
+
+    const uint32_t indexCount = (uint32_t)indices.size();
+    if (!CreateMesh(vertices.data(), (uint32_t)vertices.size(), indices.data(), &indexCount, 1u, 0u, placeholderModel->Meshes)) {
+        LOG_ERROR("Failed to create placeholder model");
+        return nullptr;
+    }
+
+    CreateMaterial({ 1.0f, 0.0f, 0.0f, 0.0f }, placeholderModel->Materials);
+    placeholderModel->Materials.back().textures.push_back(placeholderTexture);
+
+    m_PlaceholderModel = placeholderModel;
+    return m_PlaceholderModel;
+}
+
+std::shared_ptr<Model> ModelLoader::CreateModel(const std::string& filePath, std::vector<std::string>& texturePaths)
+{
     // Get the directory path
     size_t lastDivider = filePath.find_last_of('/');
 
@@ -49,189 +195,193 @@ ModelComponent ModelLoader::LoadModel(const std::string& filePath)
         directory = filePath.substr(0, lastDivider) + "/";
     }
 
-    // Load the model
-    Assimp::Importer importer;
-    const aiScene* pScene = importer.ReadFile(filePath, aiProcess_GenUVCoords | aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenNormals | aiProcess_FlipUVs);
+    std::shared_ptr<Model> model(DBG_NEW Model(), ReleaseModel);
 
-    if (!pScene) {
-        LOG_WARNINGF("Model could not be loaded: [%s]", filePath.c_str());
-        return { };
-    } else {
-        LOG_INFOF("Loading model [%s] containing [%d] meshes and [%d] materials", filePath.c_str(), pScene->mNumMeshes, pScene->mNumMaterials);
+    if (!LoadCookedModel(filePath, directory, *model, texturePaths)) {
+        ModelData modelData;
+        if (!ModelCooker::ImportModel(filePath, modelData)) {
+            LOG_WARNINGF("Model could not be loaded: [%s]", filePath.c_str());
+            return nullptr;
+        }
+
+        if (!LoadImportedModel(modelData, directory, *model, texturePaths)) {
+            return nullptr;
+        }
     }
 
-    ModelComponent modelComponent = {
-        .ModelPtr = std::shared_ptr<Model>(DBG_NEW Model(), ReleaseModel)
-    };
+    return model;
+}
 
-    Model* pModel = modelComponent.ModelPtr.get();
+bool ModelLoader::LoadCookedModel(const std::string& filePath, const std::string& directory, Model& model, std::vector<std::string>& texturePaths)
+{
+    MappedFile cookedFile;
+    if (!cookedFile.Open(ModelCooker::GetCookedPath(filePath))) {
+        return false;
+    }
 
-    // Traverse nodes to find which meshes to load
-    std::vector<unsigned int> meshIndices;
-    LoadNode(meshIndices, pScene->mRootNode, pScene);
+    const CookedModelHeader* pHeader = ModelCooker::ValidateCookedModel(cookedFile, filePath);
+    if (!pHeader) {
+        LOG_INFOF("Cooked model is outdated: [%s]", filePath.c_str());
+        return false;
+    }
 
-    // Load meshes
-    pModel->Meshes.reserve(meshIndices.size());
+    LOG_INFOF("Loading cooked model [%s] containing [%d] meshes and [%d] materials", filePath.c_str(), pHeader->MeshCount, pHeader->MaterialCount);
 
-    for (unsigned int meshIndex : meshIndices) {
-        LoadMesh(pScene->mMeshes[meshIndex], pModel->Meshes);
-    }
+    const uint8_t* pFileData = cookedFile.GetData();
+    const CookedMesh* pMeshes = reinterpret_cast<const CookedMesh*>(pHeader + 1);
+    const CookedMaterial* pMaterials = reinterpret_cast<const CookedMaterial*>(pMeshes + pHeader->MeshCount);
 
-    // Load materials
-    pModel->Materials.reserve(pScene->mNumMaterials);
+    model.Meshes.reserve(pHeader->MeshCount);
+    for (uint32_t meshIdx = 0u; meshIdx < pHeader->MeshCount; meshIdx += 1u) {
+        const CookedMesh& mesh = pMeshes[meshIdx];
+        const Vertex* pVertices = reinterpret_cast<const Vertex*>(pFileData + mesh.VerticesOffset);
+        const uint32_t* pIndices = reinterpret_cast<const uint32_t*>(pFileData + mesh.IndicesOffset);
 
-    for (unsigned int i = 0; i < pScene->mNumMaterials; i += 1) {
-        LoadMaterial(pScene->mMaterials[i], pModel->Materials, directory);
-    }
+        if (!CreateMesh(pVertices, mesh.VertexCount, pIndices, mesh.LODIndexCounts, mesh.LODCount, mesh.MaterialIndex, model.Meshes)) {
+            // Leave the model empty for the Assimp fallback
+            for (Mesh& createdMesh : model.Meshes) {
+                delete createdMesh.pVertexBuffer;
+                delete createdMesh.pIndexBuffer;
+            }
 
-    // Not all materials might have been loaded, subtract the material indices to compensate
-    size_t materialIndexOffset = pScene->mNumMaterials - pModel->Materials.size();
-    if (materialIndexOffset > 0) {
-        for (Mesh& mesh : pModel->Meshes) {
-            mesh.materialIndex -= materialIndexOffset;
+            model.Meshes.clear();
+            return false;
         }
     }
 
-    m_ModelCache[filePath] = modelComponent.ModelPtr;
-    return modelComponent;
-}
+    SetModelBounds(pHeader->BoundsMin, pHeader->BoundsMax, model);
 
-void ModelLoader::LoadMesh(const aiMesh* pAssimpMesh, std::vector<Mesh>& meshes)
-{
-    if (!pAssimpMesh->HasPositions()) {
-        LOG_WARNING("Assimp mesh is missing vertex positions");
-        return;
+    model.Materials.reserve(pHeader->MaterialCount);
+    for (uint32_t materialIdx = 0u; materialIdx < pHeader->MaterialCount; materialIdx += 1u) {
+        const CookedMaterial& material = pMaterials[materialIdx];
+        CreateMaterial(material.Specular, model.Materials);
+        texturePaths.push_back(directory + material.DiffuseTexture);
     }
 
-    if (!pAssimpMesh->HasNormals()) {
-        LOG_WARNING("Assimp mesh is missing normals");
-        return;
-    }
+    return true;
+}
 
-    Mesh mesh;
-    mesh.materialIndex = pAssimpMesh->mMaterialIndex;
+bool ModelLoader::LoadImportedModel(const ModelData& modelData, const std::string& directory, Model& model, std::vector<std::string>& texturePaths)
+{
+    DirectX::XMFLOAT3 boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+    DirectX::XMFLOAT3 boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
 
-    std::vector<Vertex> vertices;
-    vertices.resize(pAssimpMesh->mNumVertices);
+    model.Meshes.reserve(modelData.Meshes.size());
+    for (const MeshData& meshData : modelData.Meshes) {
+        if (!CreateMesh(meshData.Vertices.data(), (uint32_t)meshData.Vertices.size(), meshData.Indices.data(), meshData.LODIndexCounts.data(), (uint32_t)meshData.LODIndexCounts.size(), meshData.MaterialIndex, model.Meshes)) {
+            return false;
+        }
 
-    // Read vertex data
-    for (unsigned int i = 0; i < pAssimpMesh->mNumVertices; i += 1) {
-        vertices[i].position.x = pAssimpMesh->mVertices[i].x;
-        vertices[i].position.y = pAssimpMesh->mVertices[i].y;
-        vertices[i].position.z = pAssimpMesh->mVertices[i].z;
+        boundsMin = { std::min(boundsMin.x, meshData.BoundsMin.x), std::min(boundsMin.y, meshData.BoundsMin.y), std::min(boundsMin.z, meshData.BoundsMin.z) };
+        boundsMax = { std::max(boundsMax.x, meshData.BoundsMax.x), std::max(boundsMax.y, meshData.BoundsMax.y), std::max(boundsMax.z, meshData.BoundsMax.z) };
+    }
 
-        vertices[i].normal.x = pAssimpMesh->mNormals[i].x;
-        vertices[i].normal.y = pAssimpMesh->mNormals[i].y;
-        vertices[i].normal.z = pAssimpMesh->mNormals[i].z;
+    SetModelBounds(boundsMin, boundsMax, model);
 
-        vertices[i].txCoords.x = pAssimpMesh->mTextureCoords[0][i].x;
-        vertices[i].txCoords.y = pAssimpMesh->mTextureCoords[0][i].y;
+    model.Materials.reserve(modelData.Materials.size());
+    for (const MaterialData& materialData : modelData.Materials) {
+        CreateMaterial(materialData.Specular, model.Materials);
+        texturePaths.push_back(directory + materialData.DiffuseTexture);
     }
 
-    mesh.vertexCount = vertices.size();
-
-    // Read indices
-    std::vector<unsigned int> indices;
-    indices.resize(size_t(pAssimpMesh->mNumFaces) * 3u);
+    return true;
+}
 
-    for (size_t faceIdx = 0; faceIdx < pAssimpMesh->mNumFaces; faceIdx += 1) {
-        const aiFace* face = &pAssimpMesh->mFaces[faceIdx];
+bool ModelLoader::CreateMesh(const Vertex* pVertices, uint32_t vertexCount, const uint32_t* pIndices, const uint32_t* pLODIndexCounts, uint32_t lodCount, uint32_t materialIndex, std::vector<Mesh>& meshes)
+{
+    Mesh mesh = {};
+    mesh.vertexCount    = vertexCount;
+    mesh.materialIndex  = materialIndex;
+
+    uint32_t indexCount = 0u;
+    mesh.LODs.reserve(lodCount);
+    for (uint32_t lodIdx = 0u; lodIdx < lodCount; lodIdx += 1u) {
+        mesh.LODs.push_back({ indexCount, pLODIndexCounts[lodIdx] });
+        indexCount += pLODIndexCounts[lodIdx];
+    }
 
-        if (face->mNumIndices != 3) {
-            LOG_WARNINGF("Mesh face has an unexpected amount of indices: %d", face->mNumIndices);
-            return;
-        }
+    mesh.indexCount = indexCount;
 
-        indices[faceIdx * 3]        = face->mIndices[0];
-        indices[faceIdx * 3 + 1]    = face->mIndices[1];
-        indices[faceIdx * 3 + 2]    = face->mIndices[2];
+    if (m_PackedVertices) {
+        const std::vector<PackedVertex> packedVertices = MeshOptimizer::PackVertices(pVertices, vertexCount);
+        mesh.pVertexBuffer = m_pDevice->createVertexBuffer(packedVertices.data(), sizeof(PackedVertex), vertexCount);
+    } else {
+        mesh.pVertexBuffer = m_pDevice->createVertexBuffer(pVertices, sizeof(Vertex), vertexCount);
     }
 
-    mesh.indexCount = indices.size();
-
-    mesh.pVertexBuffer = m_pDevice->createVertexBuffer(&vertices.front(), sizeof(Vertex), vertices.size());
     if (!mesh.pVertexBuffer) {
-        return;
+        return false;
     }
 
-    mesh.pIndexBuffer = m_pDevice->createIndexBuffer(&indices.front(), indices.size());
+    mesh.pIndexBuffer = m_pDevice->createIndexBuffer(pIndices, indexCount);
     if (!mesh.pIndexBuffer) {
-        return;
+        delete mesh.pVertexBuffer;
+        return false;
     }
 
     meshes.push_back(mesh);
+    return true;
 }
 
-void ModelLoader::LoadMaterial(const aiMaterial* pAssimpMaterial, std::vector<Material>& materials, const std::string& directory)
+void ModelLoader::SetModelBounds(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax, Model& model)
 {
-    Material material;
-
-    // Get diffuse texture
-    if (pAssimpMaterial->GetTextureCount(aiTextureType_DIFFUSE) == 0) {
-        LOG_WARNING("Loading material lacks a diffuse texture");
+    if (boundsMin.x > boundsMax.x) {
+        model.BoundsCenter = { 0.0f, 0.0f, 0.0f };
+        model.BoundsRadius = 0.0f;
         return;
     }
 
-    // Get file path of a desired texture
-    aiString textureName;
-    pAssimpMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &textureName);
-
-    std::string textureNameStd = textureName.C_Str();
-
-    // Remove all whitespaces from the texture name
-    std::replace(textureNameStd.begin(), textureNameStd.end(), ' ', '_');
-
-    std::string texturePath = directory + textureNameStd;
-
-    material.textures.push_back(m_pTextureCache->LoadTexture(texturePath));
-
-    // Load material attributes
-    aiColor3D aiAmbient, aiSpecular;
-    ai_real aiShininess, aiShininessStrength;
-
-    //assimpMaterial->Get(AI_MATKEY_COLOR_AMBIENT, aiAmbient);
-    pAssimpMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aiSpecular);
-    pAssimpMaterial->Get(AI_MATKEY_SHININESS, aiShininess);
-    pAssimpMaterial->Get(AI_MATKEY_SHININESS_STRENGTH, aiShininessStrength);
-
-    // Set shininess factor to 0.5 if there is none
-    aiShininessStrength = aiShininessStrength < 0.01f || aiShininessStrength > 1.0f ? 0.5f : aiShininessStrength;
+    const DirectX::XMVECTOR minVec = DirectX::XMLoadFloat3(&boundsMin);
+    const DirectX::XMVECTOR maxVec = DirectX::XMLoadFloat3(&boundsMax);
+    DirectX::XMStoreFloat3(&model.BoundsCenter, DirectX::XMVectorScale(DirectX::XMVectorAdd(minVec, maxVec), 0.5f));
+    model.BoundsRadius = 0.5f * DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(maxVec, minVec)));
+}
 
-    //material.attributes.ambient = DirectX::XMFLOAT3(aiAmbient.r, aiAmbient.g, aiAmbient.b);
-    material.attributes.specular = DirectX::XMFLOAT4(aiShininess, aiShininessStrength, 0.0f, 0.0f);
+void ModelLoader::CreateMaterial(const DirectX::XMFLOAT4& specular, std::vector<Material>& materials)
+{
+    Material material;
+    material.attributes.specular = specular;
 
     materials.push_back(material);
 }
 
-void ModelLoader::LoadNode(std::vector<unsigned int>& meshIndices, aiNode* pNode, const aiScene* pScene)
+void ModelLoader::ExecuteAsyncLoad(const std::string& filePath)
 {
-    meshIndices.reserve(meshIndices.size() + pNode->mNumMeshes);
-
-    // Insert this node's mesh indices
-    for (unsigned int i = 0; i < pNode->mNumMeshes; i += 1) {
+    std::shared_ptr<AsyncModelLoad> load = std::make_shared<AsyncModelLoad>();
+    load->FilePath = filePath;
+    load->ModelPtr = CreateModel(filePath, load->TexturePaths);
+    if (!load->ModelPtr || load->TexturePaths.empty()) {
+        FinishAsyncLoad(filePath, load->ModelPtr);
+        return;
+    }
 
-        // Make sure the mesh has texture coordinates
-        if (!pScene->mMeshes[pNode->mMeshes[i]]->HasTextureCoords(0)) {
-            LOG_WARNINGF("Ignoring mesh [%d]: missing texture coordinates", pNode->mMeshes[i]);
-            continue;
-        }
+    /*  Load the materials' textures in parallel rather than waiting for them, which could deadlock the thread pool.
+        The last texture to finish loading finishes the model's load. */
+    const uint32_t materialCount = (uint32_t)load->TexturePaths.size();
+    load->RemainingTextures = materialCount;
 
-        // Make sure the mesh index is not already listed
-        bool alreadyExists = false;
+    for (uint32_t materialIdx = 0u; materialIdx < materialCount; materialIdx += 1u) {
+        m_pTextureCache->LoadTextureAsync(load->TexturePaths[materialIdx], [this, load, materialIdx](const std::shared_ptr<Texture>& texture) {
+            OnTextureLoaded(load, materialIdx, texture);
+        });
+    }
+}
 
-        for (size_t j = 0; j < meshIndices.size() && !alreadyExists; j += 1) {
-            if (meshIndices[j] == pNode->mMeshes[i]) {
-                alreadyExists = true;
-            }
-        }
+void ModelLoader::OnTextureLoaded(const std::shared_ptr<AsyncModelLoad>& load, uint32_t materialIdx, const std::shared_ptr<Texture>& texture)
+{
+    // Each material is written by a single texture load
+    load->ModelPtr->Materials[materialIdx].textures.push_back(texture ? texture : m_pTextureCache->GetPlaceholderTexture());
 
-        if (!alreadyExists) {
-            meshIndices.push_back(pNode->mMeshes[i]);
-        }
+    if (load->RemainingTextures.fetch_sub(1u) == 1u) {
+        FinishAsyncLoad(load->FilePath, load->ModelPtr);
     }
+}
 
-    // Insert childrens' mesh indices
-    for (unsigned int i = 0; i < pNode->mNumChildren; i += 1) {
-        LoadNode(meshIndices, pNode->mChildren[i], pScene);
+void ModelLoader::FinishAsyncLoad(const std::string& filePath, const std::shared_ptr<Model>& model)
+{
+    if (model) {
+        LOG_INFOF("Loaded model asynchronously: [%s]", filePath.c_str());
     }
+
+    m_ModelCache.Finish(filePath, model);
 }
@@ -1,43 +1,83 @@
 #pragma once
 
+#include <Engine/ECS/Entity.hpp>
 #include <Engine/Rendering/AssetContainers/Material.hpp>
 #include <Engine/Rendering/AssetContainers/Model.hpp>
+#include <Engine/Utils/AssetCache.hpp>
 #include <Engine/Utils/ECSUtils.hpp>
 #include <Engine/Utils/IDVector.hpp>
 
-#include <assimp/material.h>
-#include <assimp/mesh.h>
-#include <assimp/scene.h>
-
+#include <atomic>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 class Device;
+class ResidencyManager;
 class TextureCache;
+struct ModelData;
+
+typedef AssetCache<Model>::Future ModelFuture;
+typedef AssetCache<Model>::Callback ModelCallback;
 
 class ModelLoader
 {
 public:
-    ModelLoader(TextureCache* pTextureCache, Device* pDevice);
+    // Meshes are uploaded using PackedVertex rather than Vertex when packedVertices is set
+    ModelLoader(TextureCache* pTextureCache, Device* pDevice, ResidencyManager* pResidencyManager, bool packedVertices);
     ~ModelLoader() = default;
 
+    /*  Loads the model's cooked version if there is an up to date one. Otherwise, the model is imported using Assimp.
+        Cooked models are written offline by the asset cooker, the loader never writes them. */
     ModelComponent LoadModel(const std::string& filePath);
+    /*  Loads the model's meshes on a worker thread, and its materials' textures in parallel on further worker threads.
+        Concurrent loads of the same model share one load. The callback is called right away if the model is already
+        loaded. */
+    ModelFuture LoadModelAsync(const std::string& filePath, const ModelCallback& onLoaded = nullptr);
+    /*  Gives the entity a model component without blocking. Unless the model is already loaded, the component holds the
+        placeholder model until the model has loaded, after which the component is replaced. The component is left as
+        it is if it no longer holds this request's placeholder, e.g. if the entity was deleted and its ID reused. */
+    void LoadModelAsync(const std::string& filePath, Entity entity);
+
+    // Unit cube using the placeholder texture, rendered in place of models that are loading
+    std::shared_ptr<Model> GetPlaceholderModel();
 
 private:
-    /*
-        Functions for converting assimp structures to engine's structures
-    */
-    void LoadMesh(const aiMesh* pAssimpMesh, std::vector<Mesh>& meshes);
-    void LoadMaterial(const aiMaterial* pAssimpMaterial, std::vector<Material>& materials, const std::string& directory);
+    // Shared by the texture loads of an asynchronously loaded model
+    struct AsyncModelLoad {
+        std::string FilePath;
+        std::shared_ptr<Model> ModelPtr;
+        std::vector<std::string> TexturePaths;
+        std::atomic_uint32_t RemainingTextures;
+    };
 
-    // Recursively traverse assimp scene nodes to find out which meshes are used
-    void LoadNode(std::vector<unsigned int>& meshIndices, aiNode* pNode, const aiScene* pScene);
+private:
+    /*  Creates the model's meshes and materials, without loading the materials' textures. The texture paths are
+        written per material. */
+    std::shared_ptr<Model> CreateModel(const std::string& filePath, std::vector<std::string>& texturePaths);
+    // Uploads the vertices and indices straight from the mapped cooked model
+    bool LoadCookedModel(const std::string& filePath, const std::string& directory, Model& model, std::vector<std::string>& texturePaths);
+    bool LoadImportedModel(const ModelData& modelData, const std::string& directory, Model& model, std::vector<std::string>& texturePaths);
+
+    // The indices hold every LOD's indices back to back
+    bool CreateMesh(const Vertex* pVertices, uint32_t vertexCount, const uint32_t* pIndices, const uint32_t* pLODIndexCounts, uint32_t lodCount, uint32_t materialIndex, std::vector<Mesh>& meshes);
+    void CreateMaterial(const DirectX::XMFLOAT4& specular, std::vector<Material>& materials);
+    // Encloses the bounding box in the model's bounding sphere
+    static void SetModelBounds(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax, Model& model);
+
+    // Runs on a worker thread
+    void ExecuteAsyncLoad(const std::string& filePath);
+    void OnTextureLoaded(const std::shared_ptr<AsyncModelLoad>& load, uint32_t materialIdx, const std::shared_ptr<Texture>& texture);
+    void FinishAsyncLoad(const std::string& filePath, const std::shared_ptr<Model>& model);
 
 private:
-    // The same model can be used by multiple entities, hence the weak pointer
-    std::unordered_map<std::string, std::weak_ptr<Model>> m_ModelCache;
+    std::shared_ptr<Model> m_PlaceholderModel;
+    std::mutex m_PlaceholderLock;
 
     TextureCache* m_pTextureCache;
     Device* m_pDevice;
+    const bool m_PackedVertices;
+
+    /*  The same model can be used by multiple entities, hence the weak pointers in the cache. Declared last to finish
+        in-flight loads before the other members are destroyed. */
+    AssetCache<Model> m_ModelCache;
 };
@@ -2,31 +2,130 @@
 
 #include <Engine/Rendering/APIAbstractions/Device.hpp>
 #include <Engine/Rendering/APIAbstractions/Texture.hpp>
+#include <Engine/Rendering/AssetLoaders/TextureCooker.hpp>
 #include <Engine/Utils/ECSUtils.hpp>
+#include <Engine/Utils/MappedFile.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
 
-TextureCache::TextureCache(Device* pDevice)
-    :m_pDevice(pDevice)
-{}
+TextureCache::TextureCache(Device* pDevice, ResidencyManager* pResidencyManager, RESOURCE_FORMAT textureFormat)
+    :m_pDevice(pDevice),
+    m_TextureFormat(textureFormat)
+{
+    m_Textures.SetResidencyManager(pResidencyManager, [](const Texture& texture) {
+        return texture.getByteSize();
+    });
+}
 
 std::shared_ptr<Texture> TextureCache::LoadTexture(const std::string& filePath)
 {
-    // See if the texture is already loaded
-    auto itr = m_Textures.find(filePath);
-    if (itr != m_Textures.end()) {
-        std::weak_ptr<Texture>& texturePtr = itr->second;
-
-        if (texturePtr.expired()) {
-            // The texture used to exist but has been deleted
-            m_Textures.erase(itr);
-        } else {
-            return texturePtr.lock();
-        }
+    return m_Textures.Load(filePath, [this, &filePath]() { return CreateTexture(filePath); });
+}
+
+TextureFuture TextureCache::LoadTextureAsync(const std::string& filePath, const TextureCallback& onLoaded)
+{
+    const auto startLoad = [this, &filePath]() {
+        ThreadPool::GetInstance().ExecuteDetached([this, filePath]() {
+            m_Textures.Finish(filePath, CreateTexture(filePath));
+        });
+    };
+
+    return m_Textures.LoadAsync(filePath, startLoad, onLoaded);
+}
+
+std::shared_ptr<Texture> TextureCache::GetPlaceholderTexture()
+{
+    std::scoped_lock<std::mutex> lock(m_PlaceholderLock);
+    if (m_PlaceholderTexture) {
+        return m_PlaceholderTexture;
     }
 
-    std::shared_ptr<Texture> texture(m_pDevice->createTextureFromFile(filePath));
-    LOG_INFOF("Loaded texture: [%s]", filePath.c_str());
+    const uint32_t whitePixel = 0xFFFFFFFFu;
 
-    m_Textures.insert({filePath, texture});
+    InitialData textureData = {};
+    textureData.pData   = &whitePixel;
+    textureData.RowSize = sizeof(uint32_t);
+
+    TextureInfo textureInfo = {};
+    textureInfo.Dimensions      = { 1u, 1u };
+    textureInfo.Usage           = TEXTURE_USAGE::SAMPLED | TEXTURE_USAGE::TRANSFER_DST;
+    textureInfo.Layout          = TEXTURE_LAYOUT::SHADER_READ_ONLY;
+    textureInfo.Format          = RESOURCE_FORMAT::R8G8B8A8_UNORM;
+    textureInfo.pInitialData    = &textureData;
+
+    m_PlaceholderTexture.reset(m_pDevice->createTexture(textureInfo));
+    if (!m_PlaceholderTexture) {
+        LOG_ERROR("Failed to create placeholder texture");
+    }
+
+    return m_PlaceholderTexture;
+}
+
+std::shared_ptr<Texture> TextureCache::CreateTexture(const std::string& filePath)
+{
+    std::shared_ptr<Texture> texture(LoadCookedTexture(filePath));
+    if (!texture) {
+        TextureData textureData;
+        if (!TextureCooker::ImportTexture(filePath, m_TextureFormat, textureData)) {
+            LOG_WARNINGF("Failed to load texture: [%s]", filePath.c_str());
+            return nullptr;
+        }
+
+        std::vector<const uint8_t*> mipData;
+        mipData.reserve(textureData.MipOffsets.size());
+        for (size_t mipOffset : textureData.MipOffsets) {
+            mipData.push_back(&textureData.Data[mipOffset]);
+        }
+
+        texture.reset(UploadTexture(textureData.Dimensions, (uint32_t)mipData.size(), mipData.data()));
+    }
+
+    if (texture) {
+        LOG_INFOF("Loaded texture: [%s]", filePath.c_str());
+    } else {
+        LOG_WARNINGF("Failed to load texture: [%s]", filePath.c_str());
+    }
 
     return texture;
 }
+
+Texture* TextureCache::LoadCookedTexture(const std::string& filePath)
+{
+    MappedFile cookedFile;
+    if (!cookedFile.Open(TextureCooker::GetCookedPath(filePath))) {
+        return nullptr;
+    }
+
+    const CookedTextureHeader* pHeader = TextureCooker::ValidateCookedTexture(cookedFile, filePath, m_TextureFormat);
+    if (!pHeader) {
+        LOG_INFOF("Cooked texture is outdated: [%s]", filePath.c_str());
+        return nullptr;
+    }
+
+    // The mip levels are uploaded straight from the mapped file
+    const CookedTextureMip* pMips = reinterpret_cast<const CookedTextureMip*>(pHeader + 1);
+    std::vector<const uint8_t*> mipData(pHeader->MipLevels);
+    for (uint32_t mipLevel = 0u; mipLevel < pHeader->MipLevels; mipLevel += 1u) {
+        mipData[mipLevel] = cookedFile.GetData() + pMips[mipLevel].Offset;
+    }
+
+    return UploadTexture({ pHeader->Width, pHeader->Height }, pHeader->MipLevels, mipData.data());
+}
+
+Texture* TextureCache::UploadTexture(const glm::uvec2& dimensions, uint32_t mipLevels, const uint8_t* const* ppMipData)
+{
+    std::vector<InitialData> initialData(mipLevels);
+    for (uint32_t mipLevel = 0u; mipLevel < mipLevels; mipLevel += 1u) {
+        initialData[mipLevel].pData     = ppMipData[mipLevel];
+        initialData[mipLevel].RowSize   = (uint32_t)getTextureRowSize(m_TextureFormat, getMipDimensions(dimensions, mipLevel).x);
+    }
+
+    TextureInfo textureInfo = {};
+    textureInfo.Dimensions      = dimensions;
+    textureInfo.Usage           = TEXTURE_USAGE::SAMPLED | TEXTURE_USAGE::TRANSFER_DST;
+    textureInfo.Layout          = TEXTURE_LAYOUT::SHADER_READ_ONLY;
+    textureInfo.Format          = m_TextureFormat;
+    textureInfo.MipLevels       = mipLevels;
+    textureInfo.pInitialData    = initialData.data();
+
+    return m_pDevice->createTexture(textureInfo);
+}
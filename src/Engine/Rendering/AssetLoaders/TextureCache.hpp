@@ -1,20 +1,48 @@
 #pragma once
 
-#include <unordered_map>
+#include <Engine/Rendering/APIAbstractions/GeneralResources.hpp>
+#include <Engine/Utils/AssetCache.hpp>
 
 class Device;
+class ResidencyManager;
 class Texture;
 
+typedef AssetCache<Texture>::Future TextureFuture;
+typedef AssetCache<Texture>::Callback TextureCallback;
+
 class TextureCache
 {
 public:
-    TextureCache(Device* pDevice);
+    /*  Textures are loaded with a full mip chain in the given format. Textures cooked by the asset cooker are uploaded
+        straight from their cooked files, other textures are imported each time they are loaded. The cache never writes
+        cooked files, as the assets might be read-only. */
+    TextureCache(Device* pDevice, ResidencyManager* pResidencyManager, RESOURCE_FORMAT textureFormat);
     ~TextureCache() = default;
 
     std::shared_ptr<Texture> LoadTexture(const std::string& filePath);
+    /*  Decodes and creates the texture on a worker thread. Concurrent loads of the same texture share one load. The
+        callback is called right away if the texture is already loaded. */
+    TextureFuture LoadTextureAsync(const std::string& filePath, const TextureCallback& onLoaded = nullptr);
+
+    // 1x1 white texture, used in place of textures that are loading or failed to load
+    std::shared_ptr<Texture> GetPlaceholderTexture();
+
+    inline RESOURCE_FORMAT GetTextureFormat() const { return m_TextureFormat; }
 
 private:
-    std::unordered_map<std::string, std::weak_ptr<Texture>> m_Textures;
+    std::shared_ptr<Texture> CreateTexture(const std::string& filePath);
+    // Creates the texture from its cooked version, if the cooked version is up to date
+    Texture* LoadCookedTexture(const std::string& filePath);
+    // Creates a texture in the texture format, given a pointer to each mip level's data
+    Texture* UploadTexture(const glm::uvec2& dimensions, uint32_t mipLevels, const uint8_t* const* ppMipData);
+
+private:
+    std::shared_ptr<Texture> m_PlaceholderTexture;
+    std::mutex m_PlaceholderLock;
 
     Device* m_pDevice;
+    const RESOURCE_FORMAT m_TextureFormat;
+
+    // Declared last to finish in-flight loads before the other members are destroyed
+    AssetCache<Texture> m_Textures;
 };
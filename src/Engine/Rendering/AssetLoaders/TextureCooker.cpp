@@ -0,0 +1,221 @@
+#include "TextureCooker.hpp"
+
+#include <Engine/Rendering/AssetLoaders/BlockCompressor.hpp>
+#include <Engine/Utils/Logger.hpp>
+#include <Engine/Utils/MappedFile.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+bool TextureCooker::ImportTexture(const std::string& filePath, RESOURCE_FORMAT format, TextureData& textureData)
+{
+    if (format != RESOURCE_FORMAT::R8G8B8A8_UNORM && !isBlockCompressed(format)) {
+        LOG_WARNINGF("Textures can not be cooked in format: %d", (int)format);
+        return false;
+    }
+
+    int width = 0, height = 0, texChannels = 0;
+    stbi_uc* pPixelData = stbi_load(filePath.c_str(), &width, &height, &texChannels, STBI_rgb_alpha);
+    if (!pPixelData) {
+        LOG_WARNINGF("Texture could not be imported: [%s]", filePath.c_str());
+        return false;
+    }
+
+    const glm::uvec2 dimensions((uint32_t)width, (uint32_t)height);
+    std::vector<uint8_t> pixels(pPixelData, pPixelData + size_t(width) * height * 4u);
+    stbi_image_free(pPixelData);
+
+    std::vector<size_t> pixelMipOffsets;
+    GenerateMips(pixels, dimensions, pixelMipOffsets);
+
+    textureData.Dimensions  = dimensions;
+    textureData.Format      = format;
+
+    if (!isBlockCompressed(format)) {
+        textureData.Data        = std::move(pixels);
+        textureData.MipOffsets  = std::move(pixelMipOffsets);
+        return true;
+    }
+
+    // Compress each mip level separately, levels smaller than a block are padded to a whole block
+    const uint32_t mipLevels = (uint32_t)pixelMipOffsets.size();
+    textureData.MipOffsets.resize(mipLevels);
+
+    size_t byteSize = 0u;
+    for (uint32_t mipLevel = 0u; mipLevel < mipLevels; mipLevel += 1u) {
+        textureData.MipOffsets[mipLevel] = byteSize;
+        byteSize += getTextureSize(format, getMipDimensions(dimensions, mipLevel));
+    }
+
+    textureData.Data.resize(byteSize);
+    for (uint32_t mipLevel = 0u; mipLevel < mipLevels; mipLevel += 1u) {
+        BlockCompressor::CompressTexture(&pixels[pixelMipOffsets[mipLevel]], getMipDimensions(dimensions, mipLevel), format, &textureData.Data[textureData.MipOffsets[mipLevel]]);
+    }
+
+    return true;
+}
+
+bool TextureCooker::WriteCookedTexture(const std::string& filePath, const TextureData& textureData)
+{
+    CookedTextureHeader header = {};
+    header.Magic        = COOKED_TEXTURE_MAGIC;
+    header.Version      = COOKED_TEXTURE_VERSION;
+    header.Width        = textureData.Dimensions.x;
+    header.Height       = textureData.Dimensions.y;
+    header.Format       = textureData.Format;
+    header.MipLevels    = (uint32_t)textureData.MipOffsets.size();
+
+    if (!GetSourceFileInfo(filePath, header.SourceSize, header.SourceWriteTime)) {
+        LOG_WARNINGF("Failed to retrieve file info of texture: [%s]", filePath.c_str());
+        return false;
+    }
+
+    auto alignOffset = [](uint64_t offset) {
+        return (offset + COOKED_TEXTURE_ALIGNMENT - 1u) & ~uint64_t(COOKED_TEXTURE_ALIGNMENT - 1u);
+    };
+
+    // Lay out the mip levels after the mip table
+    uint64_t dataOffset = sizeof(CookedTextureHeader) + sizeof(CookedTextureMip) * header.MipLevels;
+    std::vector<CookedTextureMip> cookedMips(header.MipLevels);
+
+    for (uint32_t mipLevel = 0u; mipLevel < header.MipLevels; mipLevel += 1u) {
+        CookedTextureMip& cookedMip = cookedMips[mipLevel];
+        cookedMip.Offset    = alignOffset(dataOffset);
+        cookedMip.ByteSize  = getTextureSize(textureData.Format, getMipDimensions(textureData.Dimensions, mipLevel));
+        dataOffset = cookedMip.Offset + cookedMip.ByteSize;
+    }
+
+    const std::string cookedPath = GetCookedPath(filePath);
+    std::ofstream file(cookedPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_WARNINGF("Failed to open cooked texture for writing: [%s]", cookedPath.c_str());
+        return false;
+    }
+
+    file.write((const char*)&header, sizeof(CookedTextureHeader));
+    file.write((const char*)cookedMips.data(), sizeof(CookedTextureMip) * cookedMips.size());
+
+    // Pad to each mip level's offset
+    const char padding[COOKED_TEXTURE_ALIGNMENT] = {};
+    for (uint32_t mipLevel = 0u; mipLevel < header.MipLevels; mipLevel += 1u) {
+        const CookedTextureMip& cookedMip = cookedMips[mipLevel];
+
+        file.write(padding, cookedMip.Offset - (uint64_t)file.tellp());
+        file.write((const char*)&textureData.Data[textureData.MipOffsets[mipLevel]], cookedMip.ByteSize);
+    }
+
+    if (!file.good()) {
+        LOG_WARNINGF("Failed to write cooked texture: [%s]", cookedPath.c_str());
+        file.close();
+        std::filesystem::remove(cookedPath);
+        return false;
+    }
+
+    return true;
+}
+
+bool TextureCooker::CookTexture(const std::string& filePath, RESOURCE_FORMAT format)
+{
+    TextureData textureData;
+    return ImportTexture(filePath, format, textureData) && WriteCookedTexture(filePath, textureData);
+}
+
+const CookedTextureHeader* TextureCooker::ValidateCookedTexture(const MappedFile& cookedFile, const std::string& sourcePath, RESOURCE_FORMAT format)
+{
+    if (cookedFile.GetSize() < sizeof(CookedTextureHeader)) {
+        return nullptr;
+    }
+
+    const CookedTextureHeader* pHeader = reinterpret_cast<const CookedTextureHeader*>(cookedFile.GetData());
+    if (pHeader->Magic != COOKED_TEXTURE_MAGIC || pHeader->Version != COOKED_TEXTURE_VERSION || pHeader->Format != format) {
+        return nullptr;
+    }
+
+    const glm::uvec2 dimensions(pHeader->Width, pHeader->Height);
+    if (pHeader->MipLevels == 0u || pHeader->MipLevels > getMipLevelCount(dimensions)) {
+        return nullptr;
+    }
+
+    if (cookedFile.GetSize() < sizeof(CookedTextureHeader) + sizeof(CookedTextureMip) * pHeader->MipLevels) {
+        return nullptr;
+    }
+
+    // Make sure every mip level is within the file
+    const CookedTextureMip* pMips = reinterpret_cast<const CookedTextureMip*>(pHeader + 1);
+    for (uint32_t mipLevel = 0u; mipLevel < pHeader->MipLevels; mipLevel += 1u) {
+        const CookedTextureMip& mip = pMips[mipLevel];
+        if (mip.ByteSize != getTextureSize(format, getMipDimensions(dimensions, mipLevel)) || mip.Offset + mip.ByteSize > cookedFile.GetSize()) {
+            return nullptr;
+        }
+    }
+
+    uint64_t sourceSize = 0u;
+    int64_t sourceWriteTime = 0;
+    if (GetSourceFileInfo(sourcePath, sourceSize, sourceWriteTime) && (sourceSize != pHeader->SourceSize || sourceWriteTime != pHeader->SourceWriteTime)) {
+        return nullptr;
+    }
+
+    return pHeader;
+}
+
+void TextureCooker::GenerateMips(std::vector<uint8_t>& pixels, const glm::uvec2& dimensions, std::vector<size_t>& mipOffsets)
+{
+    using namespace DirectX;
+    using namespace DirectX::PackedVector;
+
+    const uint32_t mipLevels = getMipLevelCount(dimensions);
+    mipOffsets.resize(mipLevels);
+
+    size_t byteSize = 0u;
+    for (uint32_t mipLevel = 0u; mipLevel < mipLevels; mipLevel += 1u) {
+        mipOffsets[mipLevel] = byteSize;
+        byteSize += getTextureSize(RESOURCE_FORMAT::R8G8B8A8_UNORM, getMipDimensions(dimensions, mipLevel));
+    }
+
+    pixels.resize(byteSize);
+
+    for (uint32_t mipLevel = 1u; mipLevel < mipLevels; mipLevel += 1u) {
+        const glm::uvec2 srcDimensions = getMipDimensions(dimensions, mipLevel - 1u);
+        const glm::uvec2 dstDimensions = getMipDimensions(dimensions, mipLevel);
+        const XMUBYTEN4* pSrc = reinterpret_cast<const XMUBYTEN4*>(&pixels[mipOffsets[mipLevel - 1u]]);
+        XMUBYTEN4* pDst = reinterpret_cast<XMUBYTEN4*>(&pixels[mipOffsets[mipLevel]]);
+
+        // Odd dimensions clamp the filter's second row or column to the edge of the source level
+        ThreadPool::GetInstance().ParallelFor((size_t)dstDimensions.y, [&](size_t dstY) {
+            const XMUBYTEN4* pSrcRow0 = pSrc + size_t(std::min(uint32_t(dstY * 2u), srcDimensions.y - 1u)) * srcDimensions.x;
+            const XMUBYTEN4* pSrcRow1 = pSrc + size_t(std::min(uint32_t(dstY * 2u + 1u), srcDimensions.y - 1u)) * srcDimensions.x;
+            XMUBYTEN4* pDstRow = pDst + dstY * dstDimensions.x;
+
+            for (uint32_t dstX = 0u; dstX < dstDimensions.x; dstX += 1u) {
+                const uint32_t srcX0 = std::min(dstX * 2u, srcDimensions.x - 1u);
+                const uint32_t srcX1 = std::min(dstX * 2u + 1u, srcDimensions.x - 1u);
+
+                XMVECTOR sum = XMVectorAdd(XMLoadUByteN4(pSrcRow0 + srcX0), XMLoadUByteN4(pSrcRow0 + srcX1));
+                sum = XMVectorAdd(sum, XMLoadUByteN4(pSrcRow1 + srcX0));
+                sum = XMVectorAdd(sum, XMLoadUByteN4(pSrcRow1 + srcX1));
+
+                XMStoreUByteN4(pDstRow + dstX, XMVectorScale(sum, 0.25f));
+            }
+        });
+    }
+}
+
+bool TextureCooker::GetSourceFileInfo(const std::string& sourcePath, uint64_t& size, int64_t& writeTime)
+{
+    std::error_code errorCode;
+    size = (uint64_t)std::filesystem::file_size(sourcePath, errorCode);
+    if (errorCode) {
+        return false;
+    }
+
+    writeTime = (int64_t)std::filesystem::last_write_time(sourcePath, errorCode).time_since_epoch().count();
+    return !errorCode;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Engine/Rendering/APIAbstractions/GeneralResources.hpp>
+
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+#define COOKED_TEXTURE_MAGIC        0x58455453u // "STEX"
+// Incremented whenever the layout of cooked textures changes, which invalidates previously cooked textures
+#define COOKED_TEXTURE_VERSION      1u
+#define COOKED_TEXTURE_EXTENSION    ".cooked"
+// Alignment of each mip level within the file
+#define COOKED_TEXTURE_ALIGNMENT    16u
+
+/*  Cooked texture layout: CookedTextureHeader, CookedTextureMip[MipLevels], followed by the mip levels' pixels or blocks.
+    Mip levels are stored in the layout they are uploaded in, which lets the loader upload them straight from the mapped
+    file. */
+struct CookedTextureHeader {
+    uint32_t Magic;
+    uint32_t Version;
+    // Used to detect when the source image has changed since it was cooked
+    uint64_t SourceSize;
+    int64_t SourceWriteTime;
+    uint32_t Width;
+    uint32_t Height;
+    RESOURCE_FORMAT Format;
+    uint32_t MipLevels;
+};
+
+struct CookedTextureMip {
+    // Byte offset from the start of the file
+    uint64_t Offset;
+    uint64_t ByteSize;
+};
+
+// CPU-side texture data, produced by importing an image using stb_image
+struct TextureData {
+    glm::uvec2 Dimensions;
+    RESOURCE_FORMAT Format;
+    // Every mip level back to back, starting with the full resolution level
+    std::vector<uint8_t> Data;
+    std::vector<size_t> MipOffsets;
+};
+
+// Converts images into the cooked format offline using the asset cooker. The engine only reads cooked textures.
+class TextureCooker
+{
+public:
+    /*  Imports the image as R8G8B8A8 pixels and generates its mip chain. Block compressed formats are encoded once the
+        mip chain is generated, any other format keeps the R8G8B8A8 pixels. */
+    static bool ImportTexture(const std::string& filePath, RESOURCE_FORMAT format, TextureData& textureData);
+    static bool WriteCookedTexture(const std::string& filePath, const TextureData& textureData);
+
+    // Imports the texture and writes its cooked version next to it
+    static bool CookTexture(const std::string& filePath, RESOURCE_FORMAT format);
+
+    static std::string GetCookedPath(const std::string& filePath) { return filePath + COOKED_TEXTURE_EXTENSION; }
+
+    /*  Returns the header if the mapped file is a cooked texture of the current version and the requested format, and if it
+        is up to date with the source image. Textures shipped without their source are considered up to date. */
+    static const CookedTextureHeader* ValidateCookedTexture(const MappedFile& cookedFile, const std::string& sourcePath, RESOURCE_FORMAT format);
+
+    /*  Appends the mip chain of R8G8B8A8 pixels, where the full resolution level is stored at the start of pixels. Each
+        level is downsampled from the previous level using a 2x2 box filter, rows are downsampled in parallel. */
+    static void GenerateMips(std::vector<uint8_t>& pixels, const glm::uvec2& dimensions, std::vector<size_t>& mipOffsets);
+
+private:
+    static bool GetSourceFileInfo(const std::string& sourcePath, uint64_t& size, int64_t& writeTime);
+};
@@ -0,0 +1,224 @@
+#include "CommandBuckets.hpp"
+
+#include <Engine/Rendering/APIAbstractions/CommandPool.hpp>
+#include <Engine/Rendering/APIAbstractions/Device.hpp>
+#include <Engine/Rendering/APIAbstractions/ICommandList.hpp>
+#include <Engine/Utils/Logger.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
+
+#include <algorithm>
+
+CommandBuckets::CommandBuckets(uint32_t bucketCapacity)
+    :m_pDevice(nullptr),
+    m_BucketCapacity(bucketCapacity)
+{}
+
+CommandBuckets::~CommandBuckets()
+{
+    for (CommandBucket& bucket : m_Buckets) {
+        for (ICommandList* pCommandList : bucket.ppCommandLists) {
+            delete pCommandList;
+        }
+
+        delete bucket.pCommandPool;
+    }
+}
+
+void CommandBuckets::Init(Device* pDevice)
+{
+    m_pDevice = pDevice;
+}
+
+bool CommandBuckets::Insert(Entity entity, const void* pGroupKey)
+{
+    uint32_t bucketIdx = 0u;
+    if (!findFreeBucket(pGroupKey, bucketIdx)) {
+        return false;
+    }
+
+    CommandBucket& bucket = m_Buckets[bucketIdx];
+    m_EntitySlots.push_back({ bucketIdx, (uint32_t)bucket.Entities.size() }, entity);
+    bucket.Entities.push_back(entity);
+
+    if (bucket.Entities.size() == m_BucketCapacity) {
+        std::vector<uint32_t>& freeBuckets = m_FreeBuckets[pGroupKey];
+        freeBuckets.erase(std::find(freeBuckets.begin(), freeBuckets.end(), bucketIdx));
+    }
+
+    if (bucket.ListsToReset == 0u) {
+        m_DirtyBuckets.push_back(bucketIdx);
+    }
+
+    bucket.ListsToReset = MAX_FRAMES_IN_FLIGHT;
+    return true;
+}
+
+void CommandBuckets::Remove(Entity entity)
+{
+    if (!m_EntitySlots.HasElement(entity)) {
+        return;
+    }
+
+    const BucketSlot slot = m_EntitySlots.IndexID(entity);
+    m_EntitySlots.Pop(entity);
+
+    CommandBucket& bucket = m_Buckets[slot.BucketIndex];
+    const bool wasFull = bucket.Entities.size() == m_BucketCapacity;
+
+    // Move the bucket's last entity into the freed slot
+    const Entity movedEntity = bucket.Entities.back();
+    bucket.Entities[slot.SlotIndex] = movedEntity;
+    bucket.Entities.pop_back();
+    if (movedEntity != entity) {
+        m_EntitySlots.IndexID(movedEntity).SlotIndex = slot.SlotIndex;
+    }
+
+    if (bucket.Entities.empty()) {
+        if (!wasFull) {
+            std::vector<uint32_t>& freeBuckets = m_FreeBuckets[bucket.pGroupKey];
+            freeBuckets.erase(std::find(freeBuckets.begin(), freeBuckets.end(), slot.BucketIndex));
+        }
+
+        m_EmptyBuckets.push_back(slot.BucketIndex);
+    } else if (wasFull) {
+        m_FreeBuckets[bucket.pGroupKey].push_back(slot.BucketIndex);
+    }
+
+    if (bucket.ListsToReset == 0u) {
+        m_DirtyBuckets.push_back(slot.BucketIndex);
+    }
+
+    bucket.ListsToReset = MAX_FRAMES_IN_FLIGHT;
+}
+
+void CommandBuckets::MarkDirty(Entity entity)
+{
+    if (!m_EntitySlots.HasElement(entity)) {
+        return;
+    }
+
+    const uint32_t bucketIdx = m_EntitySlots.IndexID(entity).BucketIndex;
+    CommandBucket& bucket = m_Buckets[bucketIdx];
+    if (bucket.ListsToReset == 0u) {
+        m_DirtyBuckets.push_back(bucketIdx);
+    }
+
+    bucket.ListsToReset = MAX_FRAMES_IN_FLIGHT;
+}
+
+uint32_t CommandBuckets::RecordDirtyBuckets(uint32_t frameIndex, CommandListBeginInfo& beginInfo, const RecordFunction& recordFunction)
+{
+    // Empty buckets are not executed, so their lists do not need recording
+    std::vector<uint32_t> bucketsToRecord;
+    bucketsToRecord.reserve(m_DirtyBuckets.size());
+
+    for (uint32_t bucketIdx : m_DirtyBuckets) {
+        CommandBucket& bucket = m_Buckets[bucketIdx];
+        bucket.ListsToReset -= 1u;
+
+        if (!bucket.Entities.empty()) {
+            bucketsToRecord.push_back(bucketIdx);
+        }
+    }
+
+    m_DirtyBuckets.erase(std::remove_if(m_DirtyBuckets.begin(), m_DirtyBuckets.end(), [this](uint32_t bucketIdx) {
+        return m_Buckets[bucketIdx].ListsToReset == 0u;
+    }), m_DirtyBuckets.end());
+
+    const uint32_t bucketCount = (uint32_t)bucketsToRecord.size();
+    if (bucketCount == 0u) {
+        return 0u;
+    }
+
+    // Each worker records a contiguous range of buckets. Buckets own their command pools, so any worker may record any bucket.
+    const uint32_t workerCount      = std::min(bucketCount, GetWorkerCount());
+    const uint32_t bucketsPerWorker = (bucketCount + workerCount - 1u) / workerCount;
+
+    auto recordBuckets = [&](uint32_t workerIdx) {
+        const uint32_t rangeEnd = std::min(bucketCount, (workerIdx + 1u) * bucketsPerWorker);
+        for (uint32_t rangeIdx = workerIdx * bucketsPerWorker; rangeIdx < rangeEnd; rangeIdx += 1u) {
+            const uint32_t bucketIdx = bucketsToRecord[rangeIdx];
+            ICommandList* pCommandList = m_Buckets[bucketIdx].ppCommandLists[frameIndex];
+
+            CommandListBeginInfo workerBeginInfo = beginInfo;
+            pCommandList->begin(COMMAND_LIST_USAGE::WITHIN_RENDER_PASS, &workerBeginInfo);
+            recordFunction(bucketIdx, pCommandList, workerIdx);
+            pCommandList->end();
+        }
+    };
+
+    /*  Buckets are recorded from within the renderers' jobs on the thread pool. Blocking on nested jobs could occupy every
+        pool thread, so the calling thread records ranges alongside the pool instead. Each range is recorded by a
+        single thread, which keeps per-worker resources exclusive. */
+    ThreadPool::GetInstance().ParallelFor(workerCount, [&](size_t workerIdx) {
+        recordBuckets((uint32_t)workerIdx);
+    });
+
+    return bucketCount;
+}
+
+void CommandBuckets::ExecuteBuckets(ICommandList* pPrimaryCommandList, uint32_t frameIndex) const
+{
+    for (const CommandBucket& bucket : m_Buckets) {
+        if (!bucket.Entities.empty()) {
+            pPrimaryCommandList->executeSecondaryCommandList(bucket.ppCommandLists[frameIndex]);
+        }
+    }
+}
+
+uint32_t CommandBuckets::GetOccupiedBucketCount() const
+{
+    return (uint32_t)std::count_if(m_Buckets.begin(), m_Buckets.end(), [](const CommandBucket& bucket) {
+        return !bucket.Entities.empty();
+    });
+}
+
+uint32_t CommandBuckets::GetWorkerCount() const
+{
+    return std::max(1u, (uint32_t)ThreadPool::GetInstance().GetThreadCount());
+}
+
+bool CommandBuckets::findFreeBucket(const void* pGroupKey, uint32_t& bucketIdx)
+{
+    std::vector<uint32_t>& freeBuckets = m_FreeBuckets[pGroupKey];
+    if (!freeBuckets.empty()) {
+        bucketIdx = freeBuckets.back();
+        return true;
+    }
+
+    if (!m_EmptyBuckets.empty()) {
+        bucketIdx = m_EmptyBuckets.back();
+        m_EmptyBuckets.pop_back();
+    } else if (createBucket(pGroupKey)) {
+        bucketIdx = (uint32_t)m_Buckets.size() - 1u;
+    } else {
+        return false;
+    }
+
+    m_Buckets[bucketIdx].pGroupKey = pGroupKey;
+    freeBuckets.push_back(bucketIdx);
+    return true;
+}
+
+bool CommandBuckets::createBucket(const void* pGroupKey)
+{
+    CommandBucket bucket = {};
+    bucket.pGroupKey = pGroupKey;
+    bucket.Entities.reserve(m_BucketCapacity);
+
+    // Lists allocated from the same pool must not be recorded concurrently, the bucket owns its pool to let any worker record it
+    bucket.pCommandPool = m_pDevice->createCommandPool(COMMAND_POOL_FLAG::RESETTABLE_COMMAND_LISTS, m_pDevice->getQueueFamilyIndices().Graphics);
+    if (!bucket.pCommandPool) {
+        LOG_ERROR("Failed to create command pool for command bucket");
+        return false;
+    }
+
+    if (!bucket.pCommandPool->allocateCommandLists(bucket.ppCommandLists, MAX_FRAMES_IN_FLIGHT, COMMAND_LIST_LEVEL::SECONDARY)) {
+        LOG_ERROR("Failed to allocate command lists for command bucket");
+        delete bucket.pCommandPool;
+        return false;
+    }
+
+    m_Buckets.push_back(bucket);
+    return true;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Engine/ECS/EntitySubscriber.hpp>
+#include <Engine/Rendering/APIAbstractions/GeneralResources.hpp>
+#include <Engine/Utils/IDVector.hpp>
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+class Device;
+class ICommandList;
+class ICommandPool;
+struct CommandListBeginInfo;
+
+// A fixed-capacity page of entities whose draws are recorded into their own secondary command lists
+struct CommandBucket {
+    std::vector<Entity> Entities;
+    // Entities sharing a group key are packed into the same buckets, e.g. entities using the same model
+    const void* pGroupKey;
+
+    ICommandPool* pCommandPool;
+    ICommandList* ppCommandLists[MAX_FRAMES_IN_FLIGHT];
+    // Amount of command lists to reset and re-record
+    uint32_t ListsToReset;
+};
+
+/*  Organizes a renderer's entities into stable buckets. Adding or removing an entity only dirties the bucket it
+    belongs to, the command lists of all other buckets are reused as they are. Buckets are never deleted, emptied
+    buckets are reused by later insertions. */
+class CommandBuckets
+{
+public:
+    // The bucket index, the bucket's command list to record into, and the index of the recording worker
+    typedef std::function<void(uint32_t, ICommandList*, uint32_t)> RecordFunction;
+
+public:
+    CommandBuckets(uint32_t bucketCapacity);
+    ~CommandBuckets();
+
+    void Init(Device* pDevice);
+
+    bool Insert(Entity entity, const void* pGroupKey);
+    void Remove(Entity entity);
+    // Re-records the entity's bucket, e.g. when the entity's draws change
+    void MarkDirty(Entity entity);
+
+    /*  Records the dirty buckets of the current frame in parallel, using at most GetWorkerCount() workers.
+        Returns the amount of buckets that were recorded. */
+    uint32_t RecordDirtyBuckets(uint32_t frameIndex, CommandListBeginInfo& beginInfo, const RecordFunction& recordFunction);
+    // Executes the non-empty buckets' command lists in bucket order
+    void ExecuteBuckets(ICommandList* pPrimaryCommandList, uint32_t frameIndex) const;
+
+    // Amount of buckets containing entities
+    uint32_t GetOccupiedBucketCount() const;
+
+    inline const CommandBucket& GetBucket(uint32_t bucketIdx) const { return m_Buckets[bucketIdx]; }
+    inline uint32_t GetBucketCount() const                          { return (uint32_t)m_Buckets.size(); }
+    uint32_t GetWorkerCount() const;
+
+private:
+    struct BucketSlot {
+        uint32_t BucketIndex;
+        uint32_t SlotIndex;
+    };
+
+private:
+    // Returns the index of a bucket with free space, creates a bucket if there are none
+    bool findFreeBucket(const void* pGroupKey, uint32_t& bucketIdx);
+    bool createBucket(const void* pGroupKey);
+
+private:
+    Device* m_pDevice;
+    const uint32_t m_BucketCapacity;
+
+    std::vector<CommandBucket> m_Buckets;
+    IDDVector<BucketSlot> m_EntitySlots;
+
+    // Indices of buckets with free space, per group key
+    std::unordered_map<const void*, std::vector<uint32_t>> m_FreeBuckets;
+    // Indices of empty buckets, these can be assigned to any group
+    std::vector<uint32_t> m_EmptyBuckets;
+
+    std::vector<uint32_t> m_DirtyBuckets;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdint.h>
+
+/*  Draw sort keys order draws to minimize state changes. From the most to the least significant bits:
+    [ Pipeline: 8 | Material: 20 | Mesh: 20 ]
+    Sorting by the key groups draws sharing a pipeline, then a material descriptor set, then vertex and index buffers.
+    Draws are not ordered by depth: command buckets are only re-recorded when their renderables or LODs change, so a
+    depth order would be stale as soon as the camera moves. */
+#define DRAW_SORT_KEY_PIPELINE_BITS 8u
+#define DRAW_SORT_KEY_MATERIAL_BITS 20u
+#define DRAW_SORT_KEY_MESH_BITS     20u
+
+inline uint64_t CreateDrawSortKey(uint32_t pipelineID, uint32_t materialID, uint32_t meshID)
+{
+    constexpr const uint64_t pipelineMask   = (1ull << DRAW_SORT_KEY_PIPELINE_BITS) - 1ull;
+    constexpr const uint64_t materialMask   = (1ull << DRAW_SORT_KEY_MATERIAL_BITS) - 1ull;
+    constexpr const uint64_t meshMask       = (1ull << DRAW_SORT_KEY_MESH_BITS) - 1ull;
+
+    return
+        ((pipelineID & pipelineMask) << (DRAW_SORT_KEY_MATERIAL_BITS + DRAW_SORT_KEY_MESH_BITS)) |
+        ((materialID & materialMask) << DRAW_SORT_KEY_MESH_BITS) |
+        (meshID & meshMask);
+}
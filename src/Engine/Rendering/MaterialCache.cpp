@@ -0,0 +1,141 @@
+#include "MaterialCache.hpp"
+
+#include <Engine/Rendering/APIAbstractions/DescriptorSet.hpp>
+#include <Engine/Rendering/APIAbstractions/Device.hpp>
+#include <Engine/Rendering/ShaderBindings.hpp>
+#include <Engine/Utils/Logger.hpp>
+
+#include <cstring>
+#include <functional>
+
+bool MaterialCache::MaterialKey::operator==(const MaterialKey& other) const
+{
+    return pDiffuseTexture == other.pDiffuseTexture && std::memcmp(&Attributes, &other.Attributes, sizeof(MaterialAttributes)) == 0;
+}
+
+size_t MaterialCache::MaterialKeyHasher::operator()(const MaterialKey& key) const
+{
+    // Textures are deduplicated by the texture cache, so equal textures share the same address
+    size_t hash = std::hash<const Texture*>()(key.pDiffuseTexture);
+
+    const float* pAttributes = reinterpret_cast<const float*>(&key.Attributes);
+    for (size_t attributeIdx = 0; attributeIdx < sizeof(MaterialAttributes) / sizeof(float); attributeIdx++) {
+        hash ^= std::hash<float>()(pAttributes[attributeIdx]) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+
+    return hash;
+}
+
+MaterialCache::MaterialCache()
+    :m_Version(0u),
+    m_pDevice(nullptr),
+    m_pMaterialLayout(nullptr),
+    m_pSampler(nullptr)
+{}
+
+MaterialCache::~MaterialCache()
+{
+    for (std::pair<const MaterialKey, MaterialResources>& material : m_Materials) {
+        delete material.second.pDescriptorSet;
+        delete material.second.pMaterialBuffer;
+    }
+}
+
+void MaterialCache::Init(Device* pDevice, const IDescriptorSetLayout* pMaterialLayout, ISampler* pSampler)
+{
+    m_pDevice           = pDevice;
+    m_pMaterialLayout   = pMaterialLayout;
+    m_pSampler          = pSampler;
+}
+
+MaterialResources* MaterialCache::Acquire(const Material& material)
+{
+    const MaterialKey key = {
+        .pDiffuseTexture    = material.textures[0].get(),
+        .Attributes         = material.attributes
+    };
+
+    auto materialItr = m_Materials.find(key);
+    if (materialItr != m_Materials.end()) {
+        materialItr->second.RefCount += 1u;
+        return &materialItr->second;
+    }
+
+    MaterialResources materialResources = {
+        .pDescriptorSet     = nullptr,
+        .pMaterialBuffer    = nullptr,
+        .pDiffuseTexture    = material.textures[0].get(),
+        .Attributes         = material.attributes,
+        .MaterialIndex      = 0u,
+        .RefCount           = 1u
+    };
+
+    if (!createResources(materialResources)) {
+        return nullptr;
+    }
+
+    if (m_FreeMaterialIndices.empty()) {
+        materialResources.MaterialIndex = (uint32_t)m_MaterialSlots.size();
+        m_MaterialSlots.push_back(nullptr);
+    } else {
+        materialResources.MaterialIndex = m_FreeMaterialIndices.back();
+        m_FreeMaterialIndices.pop_back();
+    }
+
+    MaterialResources* pMaterialResources = &m_Materials.insert({ key, materialResources }).first->second;
+    m_MaterialSlots[materialResources.MaterialIndex] = pMaterialResources;
+    m_Version += 1u;
+
+    return pMaterialResources;
+}
+
+void MaterialCache::Release(MaterialResources* pMaterialResources)
+{
+    pMaterialResources->RefCount -= 1u;
+    if (pMaterialResources->RefCount > 0u) {
+        return;
+    }
+
+    delete pMaterialResources->pDescriptorSet;
+    delete pMaterialResources->pMaterialBuffer;
+
+    m_MaterialSlots[pMaterialResources->MaterialIndex] = nullptr;
+    m_FreeMaterialIndices.push_back(pMaterialResources->MaterialIndex);
+
+    const MaterialKey key = {
+        .pDiffuseTexture    = pMaterialResources->pDiffuseTexture,
+        .Attributes         = pMaterialResources->Attributes
+    };
+
+    m_Materials.erase(key);
+    m_Version += 1u;
+}
+
+bool MaterialCache::createResources(MaterialResources& materialResources)
+{
+    // Create material attributes uniform buffer
+    const BufferInfo bufferInfo = {
+        .ByteSize   = sizeof(MaterialAttributes),
+        .pData      = &materialResources.Attributes,
+        .CPUAccess  = BUFFER_DATA_ACCESS::WRITE,
+        .GPUAccess  = BUFFER_DATA_ACCESS::READ,
+        .Usage      = BUFFER_USAGE::UNIFORM_BUFFER
+    };
+
+    materialResources.pMaterialBuffer = m_pDevice->createBuffer(bufferInfo);
+    if (!materialResources.pMaterialBuffer) {
+        LOG_ERROR("Failed to create material uniform buffer");
+        return false;
+    }
+
+    // Create material descriptor set
+    materialResources.pDescriptorSet = m_pDevice->allocateDescriptorSet(m_pMaterialLayout);
+    if (!materialResources.pDescriptorSet) {
+        delete materialResources.pMaterialBuffer;
+        return false;
+    }
+
+    materialResources.pDescriptorSet->updateUniformBufferDescriptor(SHADER_BINDING::MATERIAL_CONSTANTS, materialResources.pMaterialBuffer);
+    materialResources.pDescriptorSet->updateCombinedTextureSamplerDescriptor(SHADER_BINDING::TEXTURE_ONE, materialResources.pDiffuseTexture, m_pSampler);
+    return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Engine/Rendering/AssetContainers/Material.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+class DescriptorSet;
+class Device;
+class IBuffer;
+class IDescriptorSetLayout;
+class ISampler;
+
+// The rendering resources shared by every mesh using a material
+struct MaterialResources {
+    // Points at the material attributes buffer and diffuse texture
+    DescriptorSet* pDescriptorSet;
+    IBuffer* pMaterialBuffer;
+
+    Texture* pDiffuseTexture;
+    MaterialAttributes Attributes;
+
+    // Stable index of the material while it is in use, e.g. an index into a bindless material table
+    uint32_t MaterialIndex;
+    uint32_t RefCount;
+};
+
+/*  Deduplicates material descriptor sets and uniform buffers by material content. Meshes with equal diffuse textures and
+    attributes share the same resources, which are deleted once the last mesh using them releases them. */
+class MaterialCache
+{
+public:
+    MaterialCache();
+    ~MaterialCache();
+
+    void Init(Device* pDevice, const IDescriptorSetLayout* pMaterialLayout, ISampler* pSampler);
+
+    // The material must have a diffuse texture. Returns nullptr if creating the material's resources failed.
+    MaterialResources* Acquire(const Material& material);
+    void Release(MaterialResources* pMaterialResources);
+
+    // Materials indexed by their material indices. Unused indices contain nullptr.
+    inline const std::vector<MaterialResources*>& GetMaterials() const  { return m_MaterialSlots; }
+    inline uint32_t GetMaterialCount() const                            { return (uint32_t)m_Materials.size(); }
+    // Incremented whenever a material is added or removed, used to detect outdated material tables
+    inline uint32_t GetVersion() const                                  { return m_Version; }
+
+private:
+    struct MaterialKey {
+        const Texture* pDiffuseTexture;
+        MaterialAttributes Attributes;
+
+        bool operator==(const MaterialKey& other) const;
+    };
+
+    struct MaterialKeyHasher {
+        size_t operator()(const MaterialKey& key) const;
+    };
+
+private:
+    bool createResources(MaterialResources& materialResources);
+
+private:
+    std::unordered_map<MaterialKey, MaterialResources, MaterialKeyHasher> m_Materials;
+    std::vector<MaterialResources*> m_MaterialSlots;
+    std::vector<uint32_t> m_FreeMaterialIndices;
+    uint32_t m_Version;
+
+    Device* m_pDevice;
+    const IDescriptorSetLayout* m_pMaterialLayout;
+    ISampler* m_pSampler;
+};
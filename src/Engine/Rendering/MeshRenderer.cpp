@@ -1,31 +1,60 @@
 #include "MeshRenderer.hpp"
 
+#include <Engine/Rendering/APIAbstractions/CommandPool.hpp>
 #include <Engine/Rendering/AssetContainers/Material.hpp>
 #include <Engine/Rendering/AssetContainers/Model.hpp>
 #include <Engine/Rendering/Components/VPMatrices.hpp>
+#include <Engine/Rendering/DrawSortKey.hpp>
 #include <Engine/Rendering/RenderingHandler.hpp>
 #include <Engine/Rendering/ShaderBindings.hpp>
 #include <Engine/Rendering/ShaderResourceHandler.hpp>
 #include <Engine/Transform.hpp>
+#include <Engine/Utils/ECSUtils.hpp>
 
 #include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <tuple>
 
-MeshRenderer::MeshRenderer(Device* pDevice, RenderingHandler* pRenderingHandler)
+MeshRenderer::MeshRenderer(Device* pDevice, RenderingHandler* pRenderingHandler, bool indirectDrawing, bool bindlessMaterials, bool packedVertices, bool meshLODs)
     :Renderer(pDevice, pRenderingHandler),
     m_pDevice(pDevice),
-    m_CommandListsToReset(MAX_FRAMES_IN_FLIGHT),
+    m_CommandBuckets(MESH_BUCKET_CAPACITY),
+    m_IndirectDrawing(indirectDrawing),
+    m_BindlessMaterials(indirectDrawing && bindlessMaterials),
+    m_PackedVertices(packedVertices),
+    m_MeshLODs(meshLODs),
+    m_IndirectGroupsDirty(true),
+    m_pIndirectCommandPool(nullptr),
     m_pDescriptorSetLayoutCommon(nullptr),
     m_pDescriptorSetLayoutModel(nullptr),
     m_pDescriptorSetLayoutMesh(nullptr),
+    m_pDescriptorSetLayoutObjects(nullptr),
+    m_pDescriptorSetLayoutMaterialTable(nullptr),
     m_pDescriptorSetCommon(nullptr),
     m_pAniSampler(nullptr),
     m_pRenderPass(nullptr),
     m_pPipeline(nullptr),
-    m_pPipelineLayout(nullptr)
+    m_pPipelineLayout(nullptr),
+    m_pIndirectPipeline(nullptr),
+    m_pIndirectPipelineLayout(nullptr),
+    m_pOverflowMaterialPipeline(nullptr),
+    m_pOverflowMaterialPipelineLayout(nullptr),
+    m_Stats({})
 {
-    std::fill_n(m_ppCommandPools, MAX_FRAMES_IN_FLIGHT, nullptr);
-    std::fill_n(m_ppCommandLists, MAX_FRAMES_IN_FLIGHT, nullptr);
     std::fill_n(m_ppFramebuffers, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_ppObjectBuffers, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_ppIndirectArgumentBuffers, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_ppObjectDescriptorSets, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_pObjectCapacities, MAX_FRAMES_IN_FLIGHT, 0u);
+    std::fill_n(m_pIndirectArgumentCapacities, MAX_FRAMES_IN_FLIGHT, 0u);
+    std::fill_n(m_ppIndirectCommandLists, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_pIndirectListsDirty, MAX_FRAMES_IN_FLIGHT, true);
+    std::fill_n(m_ppMaterialTableBuffers, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_ppMaterialTableSets, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_pMaterialTableVersions, MAX_FRAMES_IN_FLIGHT, UINT32_MAX);
 
     EntitySubscriberRegistration entitySubscriberRegistration = {
         {
@@ -55,7 +84,7 @@ MeshRenderer::MeshRenderer(Device* pDevice, RenderingHandler* pRenderingHandler)
         }
     };
 
-    RegisterRenderer(entitySubscriberRegistration);
+    RegisterRenderer(TYPE_NAME(MeshRenderer), entitySubscriberRegistration);
 }
 
 MeshRenderer::~MeshRenderer()
@@ -66,34 +95,36 @@ MeshRenderer::~MeshRenderer()
     }
 
     for (uint32_t frameIndex = 0u; frameIndex < MAX_FRAMES_IN_FLIGHT; frameIndex += 1u) {
-        delete m_ppCommandLists[frameIndex];
-        delete m_ppCommandPools[frameIndex];
         delete m_ppFramebuffers[frameIndex];
+        delete m_ppObjectDescriptorSets[frameIndex];
+        delete m_ppObjectBuffers[frameIndex];
+        delete m_ppIndirectArgumentBuffers[frameIndex];
+        delete m_ppIndirectCommandLists[frameIndex];
+        delete m_ppMaterialTableSets[frameIndex];
+        delete m_ppMaterialTableBuffers[frameIndex];
     }
 
+    delete m_pIndirectCommandPool;
     delete m_pRenderPass;
     delete m_pPointLightBuffer;
     delete m_pDescriptorSetCommon;
     delete m_pDescriptorSetLayoutCommon;
     delete m_pDescriptorSetLayoutModel;
     delete m_pDescriptorSetLayoutMesh;
+    delete m_pDescriptorSetLayoutObjects;
+    delete m_pDescriptorSetLayoutMaterialTable;
     delete m_pPipelineLayout;
     delete m_pPipeline;
+    delete m_pIndirectPipelineLayout;
+    delete m_pIndirectPipeline;
+    delete m_pOverflowMaterialPipelineLayout;
+    delete m_pOverflowMaterialPipeline;
 }
 
 bool MeshRenderer::Init()
 {
-    for (uint32_t frameIndex = 0u; frameIndex < MAX_FRAMES_IN_FLIGHT; frameIndex += 1u) {
-        m_ppCommandPools[frameIndex] = m_pDevice->createCommandPool(COMMAND_POOL_FLAG::RESETTABLE_COMMAND_LISTS, m_pDevice->getQueueFamilyIndices().Graphics);
-        if (!m_ppCommandPools[frameIndex]) {
-            return false;
-        }
-
-        m_ppCommandPools[frameIndex]->allocateCommandLists(&m_ppCommandLists[frameIndex], 1u, COMMAND_LIST_LEVEL::SECONDARY);
-        if (!m_ppCommandLists[frameIndex]) {
-            return false;
-        }
-    }
+    m_CommandBuckets.Init(m_pDevice);
+    m_DrawScratches.resize(m_CommandBuckets.GetWorkerCount());
 
     m_pAniSampler = ShaderResourceHandler::GetInstance()->GetAniSampler();
 
@@ -105,6 +136,11 @@ bool MeshRenderer::Init()
         return false;
     }
 
+    m_MaterialCache.Init(m_pDevice, m_pDescriptorSetLayoutMesh, m_pAniSampler);
+    if (m_BindlessMaterials && !createMaterialTables()) {
+        return false;
+    }
+
     if (!createCommonDescriptorSet()) {
         return false;
     }
@@ -117,16 +153,34 @@ bool MeshRenderer::Init()
         return false;
     }
 
+    if (m_IndirectDrawing && !createIndirectCommandLists()) {
+        return false;
+    }
+
     return createPipeline();
 }
 
 void MeshRenderer::UpdateBuffers()
 {
+    const auto updateStart = std::chrono::high_resolution_clock::now();
+    ECSCore* pECS = ECSCore::GetInstance();
+
+    // LOD changes alter the draws, so LODs are selected before the indirect draw groups are built
+    m_Stats.LODChanges = 0u;
+    if (m_MeshLODs && !m_Renderables.Empty() && !m_Camera.Empty()) {
+        const ViewProjectionMatricesComponent& vpMatrices = pECS->GetConstComponent<ViewProjectionMatricesComponent>(m_Camera[0]);
+        selectLODs(vpMatrices.View, vpMatrices.Projection);
+    }
+
+    if (m_IndirectDrawing && m_IndirectGroupsDirty) {
+        buildIndirectDrawGroups();
+    }
+
     if (m_Renderables.Empty() || m_Camera.Empty()) {
+       m_Stats.UpdateTime = 0.0f;
        return;
     }
 
-    ECSCore* pECS = ECSCore::GetInstance();
     const ComponentArray<PointLightComponent>* pPointLightComponents = pECS->GetComponentArray<PointLightComponent>();
     const ComponentArray<PositionComponent>* pPositionComponents = pECS->GetComponentArray<PositionComponent>();
 
@@ -155,17 +209,23 @@ void MeshRenderer::UpdateBuffers()
     memcpy(pMappedMemory, &perFrame, sizeof(PerFrameBuffer));
     m_pDevice->unmap(m_pPointLightBuffer);
 
-    const ComponentArray<ViewProjectionMatricesComponent>* pVPMatricesComponents = pECS->GetComponentArray<ViewProjectionMatricesComponent>();
+    // Prepare camera's view*proj matrix
+    const ViewProjectionMatricesComponent& vpMatrices = pECS->GetConstComponent<ViewProjectionMatricesComponent>(cameraEntity);
+    const DirectX::XMMATRIX camVP = DirectX::XMLoadFloat4x4(&vpMatrices.View) * DirectX::XMLoadFloat4x4(&vpMatrices.Projection);
+
+    if (m_IndirectDrawing) {
+        updateIndirectBuffers(m_pDevice->getFrameIndex(), camVP);
+
+        const std::chrono::duration<float, std::milli> updateTime = std::chrono::high_resolution_clock::now() - updateStart;
+        m_Stats.UpdateTime = updateTime.count();
+        return;
+    }
+
     const ComponentArray<WorldMatrixComponent>* pWorldMatrixComponents = pECS->GetComponentArray<WorldMatrixComponent>();
 
     for (Entity renderableEntity : m_Renderables) {
         ModelRenderResources& modelRenderResources = m_ModelRenderResources.IndexID(renderableEntity);
 
-        // Prepare camera's view*proj matrix
-        const ViewProjectionMatricesComponent& vpMatrices = pVPMatricesComponents->GetConstData(cameraEntity);
-
-        DirectX::XMMATRIX camVP = DirectX::XMLoadFloat4x4(&vpMatrices.View) * DirectX::XMLoadFloat4x4(&vpMatrices.Projection);
-
         // Update per-object matrices uniform buffer
         PerObjectMatrices matrices;
         matrices.World = pWorldMatrixComponents->GetConstData(renderableEntity).WorldMatrix;
@@ -177,70 +237,592 @@ void MeshRenderer::UpdateBuffers()
         memcpy(pMappedMemory, &matrices, sizeof(PerObjectMatrices));
         m_pDevice->unmap(modelRenderResources.pWVPBuffer);
     }
+
+    const std::chrono::duration<float, std::milli> updateTime = std::chrono::high_resolution_clock::now() - updateStart;
+    m_Stats.UpdateTime = updateTime.count();
 }
 
 void MeshRenderer::RecordCommands()
 {
-    if (m_CommandListsToReset == 0u) {
+    if (m_Camera.Empty()) {
         return;
     }
 
-    m_CommandListsToReset -= 1u;
-
+    const auto recordStart = std::chrono::high_resolution_clock::now();
     const uint32_t frameIndex = m_pDevice->getFrameIndex();
-    ICommandList* pCommandList = m_ppCommandLists[frameIndex];
 
     CommandListBeginInfo beginInfo = {};
     beginInfo.pRenderPass   = m_pRenderPass;
     beginInfo.Subpass       = 0u;
     beginInfo.pFramebuffer  = m_ppFramebuffers[frameIndex];
-    pCommandList->begin(COMMAND_LIST_USAGE::WITHIN_RENDER_PASS, &beginInfo);
 
-    if (m_Renderables.Empty() || m_Camera.Empty()) {
+    if (m_IndirectDrawing) {
+        if (!hasIndirectDraws(frameIndex) || !m_pIndirectListsDirty[frameIndex]) {
+            m_Stats.BucketsRecorded = 0u;
+            m_Stats.RecordTime      = 0.0f;
+            return;
+        }
+
+        MeshRendererStats stats = {};
+        ICommandList* pCommandList = m_ppIndirectCommandLists[frameIndex];
+        pCommandList->begin(COMMAND_LIST_USAGE::WITHIN_RENDER_PASS, &beginInfo);
+        recordIndirectDraws(pCommandList, frameIndex, stats);
         pCommandList->end();
+        m_pIndirectListsDirty[frameIndex] = false;
+
+        const std::chrono::duration<float, std::milli> recordTime = std::chrono::high_resolution_clock::now() - recordStart;
+        stats.CommandListCount  = 1u;
+        stats.BucketsRecorded   = 1u;
+        stats.RecordTime        = recordTime.count();
+        stats.UpdateTime        = m_Stats.UpdateTime;
+        stats.LODChanges        = m_Stats.LODChanges;
+        m_Stats = stats;
         return;
     }
 
-    pCommandList->bindPipeline(m_pPipeline);
-    pCommandList->bindDescriptorSet(m_pDescriptorSetCommon, m_pPipelineLayout, 0u);
+    m_BucketStats.resize(m_CommandBuckets.GetBucketCount());
+
+    const uint32_t bucketsRecorded = m_CommandBuckets.RecordDirtyBuckets(frameIndex, beginInfo,
+        [&](uint32_t bucketIdx, ICommandList* pCommandList, uint32_t workerIdx) {
+            DrawScratch& scratch = m_DrawScratches[workerIdx];
+            gatherDraws(m_CommandBuckets.GetBucket(bucketIdx), scratch);
+            recordDraws(pCommandList, scratch, m_BucketStats[bucketIdx]);
+        }
+    );
+
+    if (bucketsRecorded == 0u) {
+        m_Stats.BucketsRecorded = 0u;
+        m_Stats.RecordTime      = 0.0f;
+        return;
+    }
+
+    MeshRendererStats stats = {};
+    for (uint32_t bucketIdx = 0u; bucketIdx < m_CommandBuckets.GetBucketCount(); bucketIdx += 1u) {
+        if (m_CommandBuckets.GetBucket(bucketIdx).Entities.empty()) {
+            continue;
+        }
+
+        const MeshRendererStats& bucketStats = m_BucketStats[bucketIdx];
+        stats.DrawCount             += bucketStats.DrawCount;
+        stats.DrawCalls             += bucketStats.DrawCalls;
+        stats.PipelineBinds         += bucketStats.PipelineBinds;
+        stats.DescriptorSetBinds    += bucketStats.DescriptorSetBinds;
+        stats.VertexBufferBinds     += bucketStats.VertexBufferBinds;
+        stats.IndexBufferBinds      += bucketStats.IndexBufferBinds;
+        stats.BindsSaved            += bucketStats.BindsSaved;
+        stats.TriangleCount         += bucketStats.TriangleCount;
+        stats.FullDetailTriangleCount += bucketStats.FullDetailTriangleCount;
+        stats.CommandListCount      += 1u;
+    }
+
+    const std::chrono::duration<float, std::milli> recordTime = std::chrono::high_resolution_clock::now() - recordStart;
+    stats.BucketsRecorded   = bucketsRecorded;
+    stats.RecordTime        = recordTime.count();
+    stats.UpdateTime        = m_Stats.UpdateTime;
+    stats.LODChanges        = m_Stats.LODChanges;
+    m_Stats = stats;
+}
+
+void MeshRenderer::ExecuteCommands(ICommandList* pPrimaryCommandList)
+{
+    if (m_Camera.Empty()) {
+        return;
+    }
 
+    const uint32_t frameIndex = m_pDevice->getFrameIndex();
+    if (!m_IndirectDrawing) {
+        m_CommandBuckets.ExecuteBuckets(pPrimaryCommandList, frameIndex);
+    } else if (hasIndirectDraws(frameIndex)) {
+        pPrimaryCommandList->executeSecondaryCommandList(m_ppIndirectCommandLists[frameIndex]);
+    }
+}
+
+void MeshRenderer::selectLODs(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection)
+{
     ECSCore* pECS = ECSCore::GetInstance();
     const ComponentArray<ModelComponent>* pModelComponents = pECS->GetComponentArray<ModelComponent>();
+    const ComponentArray<WorldMatrixComponent>* pWorldMatrixComponents = pECS->GetComponentArray<WorldMatrixComponent>();
+
+    const DirectX::XMMATRIX viewMatrix = DirectX::XMLoadFloat4x4(&view);
+    // Cotangent of half the vertical field of view: converts a radius divided by its depth into a fraction of the screen height
+    const float projectionScale = projection._22;
+
+    // The size below which a renderable switches from the previous LOD to the given LOD
+    const auto getLODThreshold = [](uint32_t lod) {
+        return MESH_LOD_SCREEN_SIZE * std::pow(MESH_LOD_SCREEN_SIZE_RATIO, float(lod - 1u));
+    };
 
     for (Entity renderableEntity : m_Renderables) {
+        const Model* pModel = pModelComponents->GetConstData(renderableEntity).ModelPtr.get();
+        ModelRenderResources& modelRenderResources = m_ModelRenderResources.IndexID(renderableEntity);
+
+        uint32_t lodCount = 1u;
+        for (const Mesh& mesh : pModel->Meshes) {
+            lodCount = std::max(lodCount, (uint32_t)mesh.LODs.size());
+        }
+
+        if (lodCount == 1u || pModel->BoundsRadius <= 0.0f) {
+            continue;
+        }
+
+        const DirectX::XMFLOAT4X4& world = pWorldMatrixComponents->GetConstData(renderableEntity).WorldMatrix;
+        const DirectX::XMVECTOR center = DirectX::XMVector3TransformCoord(
+            DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&pModel->BoundsCenter), DirectX::XMLoadFloat4x4(&world)),
+            viewMatrix
+        );
+
+        // The largest axis scale of the world matrix bounds the radius of the transformed sphere
+        const float maxScaleSq = std::max({
+            world._11 * world._11 + world._12 * world._12 + world._13 * world._13,
+            world._21 * world._21 + world._22 * world._22 + world._23 * world._23,
+            world._31 * world._31 + world._32 * world._32 + world._33 * world._33
+        });
+
+        const float radius = pModel->BoundsRadius * std::sqrt(maxScaleSq);
+        const float depth = DirectX::XMVectorGetZ(center);
+        if (depth < -radius) {
+            // Renderables behind the camera keep their LOD until they are visible again
+            continue;
+        }
+
+        // Spheres containing the camera are drawn in full detail
+        const float screenSize = depth > radius ? radius * projectionScale / depth : FLT_MAX;
+
+        const uint32_t previousLOD = std::min(modelRenderResources.LOD, lodCount - 1u);
+        uint32_t lod = previousLOD;
+        while (lod + 1u < lodCount && screenSize < getLODThreshold(lod + 1u) * (1.0f - MESH_LOD_HYSTERESIS)) {
+            lod += 1u;
+        }
+
+        while (lod > 0u && screenSize > getLODThreshold(lod) * (1.0f + MESH_LOD_HYSTERESIS)) {
+            lod -= 1u;
+        }
+
+        if (lod == modelRenderResources.LOD) {
+            continue;
+        }
+
+        modelRenderResources.LOD = lod;
+        m_Stats.LODChanges += 1u;
+
+        if (m_IndirectDrawing) {
+            m_IndirectGroupsDirty = true;
+        } else {
+            m_CommandBuckets.MarkDirty(renderableEntity);
+        }
+    }
+}
+
+void MeshRenderer::gatherDraws(const CommandBucket& bucket, DrawScratch& scratch) const
+{
+    ECSCore* pECS = ECSCore::GetInstance();
+    const ComponentArray<ModelComponent>* pModelComponents = pECS->GetComponentArray<ModelComponent>();
+
+    scratch.Draws.clear();
+    scratch.DrawOrder.clear();
+    scratch.MaterialIDs.clear();
+    scratch.MeshIDs.clear();
+
+    // There is only one mesh pipeline for now
+    constexpr const uint32_t pipelineID = 0u;
+
+    for (Entity renderableEntity : bucket.Entities) {
         const ModelComponent& modelComp         = pModelComponents->GetConstData(renderableEntity);
         const Model* pModel                     = modelComp.ModelPtr.get();
-        const std::vector<Mesh>& meshes         = pModel->Meshes;
         const std::vector<Material>& materials  = pModel->Materials;
 
         const ModelRenderResources& modelRenderResources = m_ModelRenderResources.IndexID(renderableEntity);
 
-        pCommandList->bindDescriptorSet(modelRenderResources.pDescriptorSet, m_pPipelineLayout, 1u);
-
         size_t meshIdx = 0;
-        for (const Mesh& mesh : meshes) {
+        for (const Mesh& mesh : pModel->Meshes) {
             if (materials[mesh.materialIndex].textures.empty()) {
                 // Will not render the mesh if it does not have a texture
                 continue;
             }
 
-            const MeshRenderResources& meshRenderResources = modelRenderResources.MeshRenderResources[meshIdx++];
+            DescriptorSet* pMaterialSet = modelRenderResources.MeshMaterials[meshIdx++]->pDescriptorSet;
+
+            const uint32_t materialID   = scratch.MaterialIDs.insert({ pMaterialSet, (uint32_t)scratch.MaterialIDs.size() }).first->second;
+            const uint32_t meshID       = scratch.MeshIDs.insert({ mesh.pVertexBuffer, (uint32_t)scratch.MeshIDs.size() }).first->second;
+
+            scratch.DrawOrder.push_back({ CreateDrawSortKey(pipelineID, materialID, meshID), (uint32_t)scratch.Draws.size() });
+            scratch.Draws.push_back({
+                .pMesh                  = &mesh,
+                .pLOD                   = &mesh.LODs[std::min<size_t>(modelRenderResources.LOD, mesh.LODs.size() - 1u)],
+                .pModelDescriptorSet    = modelRenderResources.pDescriptorSet,
+                .pMeshDescriptorSet     = pMaterialSet
+            });
+        }
+    }
+
+    RadixSort(scratch.DrawOrder, scratch.DrawOrderScratch);
+}
+
+void MeshRenderer::recordDraws(ICommandList* pCommandList, const DrawScratch& scratch, MeshRendererStats& stats) const
+{
+    stats = {};
+    stats.DrawCount = (uint32_t)scratch.DrawOrder.size();
+    stats.DrawCalls = stats.DrawCount;
+
+    // Secondary command lists do not inherit bound state, so each list binds the common state
+    pCommandList->bindPipeline(m_pPipeline);
+    pCommandList->bindDescriptorSet(m_pDescriptorSetCommon, m_pPipelineLayout, 0u);
+    stats.PipelineBinds         = 1u;
+    stats.DescriptorSetBinds    = 1u;
+
+    const DescriptorSet* pBoundModelSet = nullptr;
+    const DescriptorSet* pBoundMeshSet  = nullptr;
+    const IBuffer* pBoundVertexBuffer   = nullptr;
+    const IBuffer* pBoundIndexBuffer    = nullptr;
+
+    for (const SortPair& sortPair : scratch.DrawOrder) {
+        const MeshDraw& draw = scratch.Draws[sortPair.Value];
+        const Mesh& mesh = *draw.pMesh;
+
+        if (draw.pModelDescriptorSet != pBoundModelSet) {
+            pCommandList->bindDescriptorSet(draw.pModelDescriptorSet, m_pPipelineLayout, 1u);
+            pBoundModelSet = draw.pModelDescriptorSet;
+            stats.DescriptorSetBinds += 1u;
+        }
+
+        if (draw.pMeshDescriptorSet != pBoundMeshSet) {
+            pCommandList->bindDescriptorSet(draw.pMeshDescriptorSet, m_pPipelineLayout, 2u);
+            pBoundMeshSet = draw.pMeshDescriptorSet;
+            stats.DescriptorSetBinds += 1u;
+        }
 
+        if (mesh.pVertexBuffer != pBoundVertexBuffer) {
             pCommandList->bindVertexBuffer(0, mesh.pVertexBuffer);
+            pBoundVertexBuffer = mesh.pVertexBuffer;
+            stats.VertexBufferBinds += 1u;
+        }
+
+        if (mesh.pIndexBuffer != pBoundIndexBuffer) {
             pCommandList->bindIndexBuffer(mesh.pIndexBuffer);
+            pBoundIndexBuffer = mesh.pIndexBuffer;
+            stats.IndexBufferBinds += 1u;
+        }
+
+        pCommandList->drawIndexed(draw.pLOD->IndexCount, draw.pLOD->FirstIndex);
+        stats.TriangleCount             += draw.pLOD->IndexCount / 3u;
+        stats.FullDetailTriangleCount   += mesh.LODs.front().IndexCount / 3u;
+    }
+
+    // Binding every draw's state means binding the common state once, then two descriptor sets and two buffers per draw
+    const uint32_t naiveBindCount = 2u + stats.DrawCount * 4u;
+    stats.BindsSaved = naiveBindCount - (stats.PipelineBinds + stats.DescriptorSetBinds + stats.VertexBufferBinds + stats.IndexBufferBinds);
+}
+
+void MeshRenderer::buildIndirectDrawGroups()
+{
+    const ComponentArray<ModelComponent>* pModelComponents = ECSCore::GetInstance()->GetComponentArray<ModelComponent>();
 
-            pCommandList->bindDescriptorSet(meshRenderResources.pDescriptorSet, m_pPipelineLayout, 2u);
+    m_IndirectDrawGroups.clear();
+    m_IndirectObjects.clear();
+
+    // Each LOD of a mesh is drawn by its own group
+    std::unordered_map<const MeshLOD*, uint32_t> groupIndices;
+    // Group index and renderable of each object, in renderable order
+    std::vector<std::pair<uint32_t, Entity>> objectGroups;
+    objectGroups.reserve(m_Renderables.Size());
+
+    for (Entity renderableEntity : m_Renderables) {
+        const Model* pModel = pModelComponents->GetConstData(renderableEntity).ModelPtr.get();
+        const ModelRenderResources& modelRenderResources = m_ModelRenderResources.IndexID(renderableEntity);
+
+        size_t meshIdx = 0;
+        for (const Mesh& mesh : pModel->Meshes) {
+            if (pModel->Materials[mesh.materialIndex].textures.empty()) {
+                continue;
+            }
 
-            pCommandList->drawIndexed(mesh.indexCount);
+            const MaterialResources* pMaterial = modelRenderResources.MeshMaterials[meshIdx++];
+            const MeshLOD* pLOD = &mesh.LODs[std::min<size_t>(modelRenderResources.LOD, mesh.LODs.size() - 1u)];
+
+            const auto [groupItr, isNewGroup] = groupIndices.insert({ pLOD, (uint32_t)m_IndirectDrawGroups.size() });
+            if (isNewGroup) {
+                m_IndirectDrawGroups.push_back({
+                    .pMesh              = &mesh,
+                    .pLOD               = pLOD,
+                    .pMaterial          = pMaterial,
+                    .FirstObject        = 0u,
+                    .ObjectCount        = 0u
+                });
+            }
+
+            m_IndirectDrawGroups[groupItr->second].ObjectCount += 1u;
+            objectGroups.push_back({ groupItr->second, renderableEntity });
         }
     }
 
-    pCommandList->end();
+    /*  Order the groups by mesh, placing the LODs of a mesh next to each other to draw them with a single multi-draw.
+        Groups whose materials do not fit in the bindless material table are placed last, as they use another pipeline. */
+    std::vector<uint32_t> groupOrder(m_IndirectDrawGroups.size());
+    std::iota(groupOrder.begin(), groupOrder.end(), 0u);
+    std::sort(groupOrder.begin(), groupOrder.end(), [this](uint32_t groupA, uint32_t groupB) {
+        const IndirectDrawGroup& a = m_IndirectDrawGroups[groupA];
+        const IndirectDrawGroup& b = m_IndirectDrawGroups[groupB];
+        const bool aOverflows = overflowsMaterialTable(a.pMaterial), bOverflows = overflowsMaterialTable(b.pMaterial);
+        return std::tie(aOverflows, a.pMesh, a.pMaterial, a.pLOD) < std::tie(bOverflows, b.pMesh, b.pMaterial, b.pLOD);
+    });
+
+    std::vector<IndirectDrawGroup> sortedGroups;
+    sortedGroups.reserve(m_IndirectDrawGroups.size());
+    std::vector<uint32_t> sortedGroupIndices(m_IndirectDrawGroups.size());
+    for (uint32_t groupIdx : groupOrder) {
+        sortedGroupIndices[groupIdx] = (uint32_t)sortedGroups.size();
+        sortedGroups.push_back(m_IndirectDrawGroups[groupIdx]);
+    }
+
+    m_IndirectDrawGroups.swap(sortedGroups);
+    for (std::pair<uint32_t, Entity>& objectGroup : objectGroups) {
+        objectGroup.first = sortedGroupIndices[objectGroup.first];
+    }
+
+    // Place each group's objects contiguously
+    uint32_t objectCount = 0u;
+    for (IndirectDrawGroup& group : m_IndirectDrawGroups) {
+        group.FirstObject = objectCount;
+        objectCount += group.ObjectCount;
+    }
+
+    std::vector<uint32_t> groupCursors(m_IndirectDrawGroups.size());
+    m_IndirectObjects.resize(objectCount);
+    for (const std::pair<uint32_t, Entity>& objectGroup : objectGroups) {
+        const IndirectDrawGroup& group = m_IndirectDrawGroups[objectGroup.first];
+        m_IndirectObjects[group.FirstObject + groupCursors[objectGroup.first]++] = objectGroup.second;
+    }
+
+    m_IndirectGroupsDirty = false;
+    std::fill_n(m_pIndirectListsDirty, MAX_FRAMES_IN_FLIGHT, true);
 }
 
-void MeshRenderer::ExecuteCommands(ICommandList* pPrimaryCommandList)
+bool MeshRenderer::reserveIndirectBuffers(uint32_t frameIndex)
 {
-    pPrimaryCommandList->executeSecondaryCommandList(m_ppCommandLists[m_pDevice->getFrameIndex()]);
+    constexpr const uint32_t minCapacity = 64u;
+    const uint32_t objectCount  = (uint32_t)m_IndirectObjects.size();
+    const uint32_t groupCount   = (uint32_t)m_IndirectDrawGroups.size();
+
+    if (objectCount > m_pObjectCapacities[frameIndex] || !m_ppObjectBuffers[frameIndex]) {
+        delete m_ppObjectDescriptorSets[frameIndex];
+        delete m_ppObjectBuffers[frameIndex];
+        m_ppObjectDescriptorSets[frameIndex] = nullptr;
+
+        // Grow geometrically to avoid reallocating every time renderables are added
+        m_pObjectCapacities[frameIndex] = std::max({ minCapacity, objectCount, m_pObjectCapacities[frameIndex] * 2u });
+
+        const BufferInfo bufferInfo = {
+            .ByteSize           = m_pObjectCapacities[frameIndex] * sizeof(IndirectObject),
+            .CPUAccess          = BUFFER_DATA_ACCESS::WRITE,
+            .GPUAccess          = BUFFER_DATA_ACCESS::READ,
+            .Usage              = BUFFER_USAGE::STORAGE_BUFFER,
+            .StructureStride    = sizeof(IndirectObject)
+        };
+
+        m_ppObjectBuffers[frameIndex] = m_pDevice->createBuffer(bufferInfo);
+        if (!m_ppObjectBuffers[frameIndex]) {
+            LOG_ERROR("Failed to create per-object storage buffer");
+            return false;
+        }
+
+        m_ppObjectDescriptorSets[frameIndex] = m_pDevice->allocateDescriptorSet(m_pDescriptorSetLayoutObjects);
+        if (!m_ppObjectDescriptorSets[frameIndex]) {
+            return false;
+        }
+
+        m_ppObjectDescriptorSets[frameIndex]->updateStorageBufferDescriptor(SHADER_BINDING::PER_OBJECT, m_ppObjectBuffers[frameIndex]);
+        m_pIndirectListsDirty[frameIndex] = true;
+    }
+
+    if (groupCount > m_pIndirectArgumentCapacities[frameIndex] || !m_ppIndirectArgumentBuffers[frameIndex]) {
+        delete m_ppIndirectArgumentBuffers[frameIndex];
+        m_pIndirectArgumentCapacities[frameIndex] = std::max({ minCapacity, groupCount, m_pIndirectArgumentCapacities[frameIndex] * 2u });
+
+        const BufferInfo bufferInfo = {
+            .ByteSize   = m_pIndirectArgumentCapacities[frameIndex] * sizeof(IndexedIndirectDrawArguments),
+            .CPUAccess  = BUFFER_DATA_ACCESS::WRITE,
+            .GPUAccess  = BUFFER_DATA_ACCESS::READ,
+            .Usage      = BUFFER_USAGE::INDIRECT_BUFFER
+        };
+
+        m_ppIndirectArgumentBuffers[frameIndex] = m_pDevice->createBuffer(bufferInfo);
+        if (!m_ppIndirectArgumentBuffers[frameIndex]) {
+            LOG_ERROR("Failed to create indirect argument buffer");
+            return false;
+        }
+
+        m_pIndirectListsDirty[frameIndex] = true;
+    }
+
+    return true;
+}
+
+void MeshRenderer::updateIndirectBuffers(uint32_t frameIndex, DirectX::FXMMATRIX camVP)
+{
+    if (m_IndirectDrawGroups.empty() || !reserveIndirectBuffers(frameIndex)) {
+        return;
+    }
+
+    if (m_BindlessMaterials) {
+        updateMaterialTable(frameIndex);
+    }
+
+    const ComponentArray<WorldMatrixComponent>* pWorldMatrixComponents = ECSCore::GetInstance()->GetComponentArray<WorldMatrixComponent>();
+
+    void* pMappedMemory = nullptr;
+    m_pDevice->map(m_ppObjectBuffers[frameIndex], &pMappedMemory);
+    IndirectObject* pObjects = reinterpret_cast<IndirectObject*>(pMappedMemory);
+
+    for (const IndirectDrawGroup& group : m_IndirectDrawGroups) {
+        // Materials outside of the table bind their own descriptor sets, their shader does not read the index
+        const uint32_t materialIndex = overflowsMaterialTable(group.pMaterial) ? 0u : group.pMaterial->MaterialIndex;
+
+        const uint32_t objectEnd = group.FirstObject + group.ObjectCount;
+        for (uint32_t objectIdx = group.FirstObject; objectIdx < objectEnd; objectIdx += 1u) {
+            const DirectX::XMMATRIX world = DirectX::XMLoadFloat4x4(&pWorldMatrixComponents->GetConstData(m_IndirectObjects[objectIdx]).WorldMatrix);
+            DirectX::XMStoreFloat4x4(&pObjects->WVP, DirectX::XMMatrixTranspose(world * camVP));
+            DirectX::XMStoreFloat4x4(&pObjects->World, DirectX::XMMatrixTranspose(world));
+            pObjects->MaterialIndex = materialIndex;
+            pObjects += 1;
+        }
+    }
+
+    m_pDevice->unmap(m_ppObjectBuffers[frameIndex]);
+
+    // The instance index of each group's first instance is the index of the group's first object
+    m_pDevice->map(m_ppIndirectArgumentBuffers[frameIndex], &pMappedMemory);
+    IndexedIndirectDrawArguments* pArguments = reinterpret_cast<IndexedIndirectDrawArguments*>(pMappedMemory);
+
+    for (const IndirectDrawGroup& group : m_IndirectDrawGroups) {
+        *pArguments = {
+            .IndexCount     = group.pLOD->IndexCount,
+            .InstanceCount  = group.ObjectCount,
+            .FirstIndex     = group.pLOD->FirstIndex,
+            .VertexOffset   = 0,
+            .FirstInstance  = group.FirstObject
+        };
+
+        pArguments += 1;
+    }
+
+    m_pDevice->unmap(m_ppIndirectArgumentBuffers[frameIndex]);
+}
+
+void MeshRenderer::updateMaterialTable(uint32_t frameIndex)
+{
+    if (m_pMaterialTableVersions[frameIndex] == m_MaterialCache.GetVersion()) {
+        return;
+    }
+
+    const std::vector<MaterialResources*>& materials = m_MaterialCache.GetMaterials();
+    if (materials.size() > MAX_BINDLESS_MATERIALS) {
+        LOG_WARNINGF("%d materials are in use, only %d fit in the bindless material table. The rest bind their own descriptor sets.", (uint32_t)materials.size(), MAX_BINDLESS_MATERIALS);
+    }
+
+    // Every element of the texture array has to be valid, unused elements point at any used texture
+    Texture* pFallbackTexture = nullptr;
+    for (const MaterialResources* pMaterial : materials) {
+        if (pMaterial) {
+            pFallbackTexture = pMaterial->pDiffuseTexture;
+            break;
+        }
+    }
+
+    if (!pFallbackTexture) {
+        return;
+    }
+
+    void* pMappedMemory = nullptr;
+    m_pDevice->map(m_ppMaterialTableBuffers[frameIndex], &pMappedMemory);
+    MaterialAttributes* pMaterialAttributes = reinterpret_cast<MaterialAttributes*>(pMappedMemory);
+
+    DescriptorSet* pMaterialTableSet = m_ppMaterialTableSets[frameIndex];
+    for (uint32_t materialIdx = 0u; materialIdx < MAX_BINDLESS_MATERIALS; materialIdx += 1u) {
+        const MaterialResources* pMaterial = materialIdx < materials.size() ? materials[materialIdx] : nullptr;
+
+        pMaterialAttributes[materialIdx] = pMaterial ? pMaterial->Attributes : MaterialAttributes();
+        pMaterialTableSet->updateCombinedTextureSamplerArrayDescriptor(SHADER_BINDING::TEXTURE_ONE, materialIdx, pMaterial ? pMaterial->pDiffuseTexture : pFallbackTexture, m_pAniSampler);
+    }
+
+    m_pDevice->unmap(m_ppMaterialTableBuffers[frameIndex]);
+
+    // Updating a descriptor set invalidates the command lists it is bound in
+    m_pMaterialTableVersions[frameIndex] = m_MaterialCache.GetVersion();
+    m_pIndirectListsDirty[frameIndex] = true;
+}
+
+void MeshRenderer::recordIndirectDraws(ICommandList* pCommandList, uint32_t frameIndex, MeshRendererStats& stats) const
+{
+    stats.DrawCount = (uint32_t)m_IndirectObjects.size();
+
+    pCommandList->bindPipeline(m_pIndirectPipeline);
+    pCommandList->bindDescriptorSet(m_pDescriptorSetCommon, m_pIndirectPipelineLayout, 0u);
+    pCommandList->bindDescriptorSet(m_ppObjectDescriptorSets[frameIndex], m_pIndirectPipelineLayout, 1u);
+    stats.PipelineBinds         = 1u;
+    stats.DescriptorSetBinds    = 2u;
+
+    // Bindless draws index a single material table rather than binding each group's material
+    if (m_BindlessMaterials) {
+        pCommandList->bindDescriptorSet(m_ppMaterialTableSets[frameIndex], m_pIndirectPipelineLayout, 2u);
+        stats.DescriptorSetBinds += 1u;
+    }
+
+    IBuffer* pArgumentBuffer = m_ppIndirectArgumentBuffers[frameIndex];
+    constexpr const uint32_t argumentStride = (uint32_t)sizeof(IndexedIndirectDrawArguments);
+
+    /*  Meshes keep their own vertex and index buffers, so each mesh binds its buffers and is drawn separately. The groups
+        of a mesh's LODs are adjacent and are drawn by a single multi-draw. Without multi-draw indirect support, the
+        command list issues one indirect draw per group instead. */
+    const uint32_t groupCount = (uint32_t)m_IndirectDrawGroups.size();
+    IPipelineLayout* pPipelineLayout = m_pIndirectPipelineLayout;
+    bool bindMaterials = !m_BindlessMaterials;
+
+    uint32_t runStart = 0u;
+    while (runStart < groupCount) {
+        const IndirectDrawGroup& firstGroup = m_IndirectDrawGroups[runStart];
+
+        // The groups whose materials do not fit in the table come last, and are drawn like non-bindless groups
+        if (!bindMaterials && overflowsMaterialTable(firstGroup.pMaterial)) {
+            pPipelineLayout = m_pOverflowMaterialPipelineLayout;
+            bindMaterials = true;
+
+            pCommandList->bindPipeline(m_pOverflowMaterialPipeline);
+            pCommandList->bindDescriptorSet(m_pDescriptorSetCommon, pPipelineLayout, 0u);
+            pCommandList->bindDescriptorSet(m_ppObjectDescriptorSets[frameIndex], pPipelineLayout, 1u);
+            stats.PipelineBinds         += 1u;
+            stats.DescriptorSetBinds    += 2u;
+        }
+
+        if (bindMaterials) {
+            pCommandList->bindDescriptorSet(firstGroup.pMaterial->pDescriptorSet, pPipelineLayout, 2u);
+            stats.DescriptorSetBinds += 1u;
+        }
+
+        pCommandList->bindVertexBuffer(0, firstGroup.pMesh->pVertexBuffer);
+        pCommandList->bindIndexBuffer(firstGroup.pMesh->pIndexBuffer);
+        stats.VertexBufferBinds     += 1u;
+        stats.IndexBufferBinds      += 1u;
+
+        uint32_t runEnd = runStart;
+        while (runEnd < groupCount && m_IndirectDrawGroups[runEnd].pMesh == firstGroup.pMesh && m_IndirectDrawGroups[runEnd].pMaterial == firstGroup.pMaterial) {
+            const IndirectDrawGroup& group = m_IndirectDrawGroups[runEnd];
+            stats.TriangleCount             += group.pLOD->IndexCount / 3u * group.ObjectCount;
+            stats.FullDetailTriangleCount   += group.pMesh->LODs.front().IndexCount / 3u * group.ObjectCount;
+            runEnd += 1u;
+        }
+
+        pCommandList->drawIndexedIndirect(pArgumentBuffer, runStart * argumentStride, runEnd - runStart, argumentStride);
+        stats.DrawCalls += 1u;
+        runStart = runEnd;
+    }
+
+    const uint32_t naiveBindCount = 2u + stats.DrawCount * 4u;
+    stats.BindsSaved = naiveBindCount - (stats.PipelineBinds + stats.DescriptorSetBinds + stats.VertexBufferBinds + stats.IndexBufferBinds);
+}
+
+bool MeshRenderer::hasIndirectDraws(uint32_t frameIndex) const
+{
+    return !m_IndirectDrawGroups.empty() && m_ppObjectDescriptorSets[frameIndex] && m_ppIndirectArgumentBuffers[frameIndex];
 }
 
 bool MeshRenderer::createBuffers()
@@ -287,7 +869,34 @@ bool MeshRenderer::createDescriptorSetLayouts()
     m_pDescriptorSetLayoutMesh->addBindingUniformBuffer(SHADER_BINDING::MATERIAL_CONSTANTS, SHADER_TYPE::FRAGMENT_SHADER);
     m_pDescriptorSetLayoutMesh->addBindingCombinedTextureSampler(SHADER_BINDING::TEXTURE_ONE, SHADER_TYPE::FRAGMENT_SHADER);
 
-    return m_pDescriptorSetLayoutMesh->finalize(m_pDevice);
+    if (!m_pDescriptorSetLayoutMesh->finalize(m_pDevice)) {
+        return false;
+    }
+
+    if (!m_IndirectDrawing) {
+        return true;
+    }
+
+    // Per-frame descriptor set layout for indirect drawing
+    m_pDescriptorSetLayoutObjects = m_pDevice->createDescriptorSetLayout();
+
+    m_pDescriptorSetLayoutObjects->addBindingStorageBuffer(SHADER_BINDING::PER_OBJECT, SHADER_TYPE::VERTEX_SHADER);
+
+    if (!m_pDescriptorSetLayoutObjects->finalize(m_pDevice)) {
+        return false;
+    }
+
+    if (!m_BindlessMaterials) {
+        return true;
+    }
+
+    // Per-frame bindless material table layout
+    m_pDescriptorSetLayoutMaterialTable = m_pDevice->createDescriptorSetLayout();
+
+    m_pDescriptorSetLayoutMaterialTable->addBindingStorageBuffer(SHADER_BINDING::MATERIAL_CONSTANTS, SHADER_TYPE::FRAGMENT_SHADER);
+    m_pDescriptorSetLayoutMaterialTable->addBindingCombinedTextureSamplerArray(SHADER_BINDING::TEXTURE_ONE, SHADER_TYPE::FRAGMENT_SHADER, MAX_BINDLESS_MATERIALS);
+
+    return m_pDescriptorSetLayoutMaterialTable->finalize(m_pDevice);
 }
 
 bool MeshRenderer::createCommonDescriptorSet()
@@ -374,6 +983,45 @@ bool MeshRenderer::createFramebuffers()
     return true;
 }
 
+bool MeshRenderer::createIndirectCommandLists()
+{
+    m_pIndirectCommandPool = m_pDevice->createCommandPool(COMMAND_POOL_FLAG::RESETTABLE_COMMAND_LISTS, m_pDevice->getQueueFamilyIndices().Graphics);
+    if (!m_pIndirectCommandPool) {
+        LOG_ERROR("Failed to create command pool for indirect mesh drawing");
+        return false;
+    }
+
+    return m_pIndirectCommandPool->allocateCommandLists(m_ppIndirectCommandLists, MAX_FRAMES_IN_FLIGHT, COMMAND_LIST_LEVEL::SECONDARY);
+}
+
+bool MeshRenderer::createMaterialTables()
+{
+    const BufferInfo bufferInfo = {
+        .ByteSize           = MAX_BINDLESS_MATERIALS * sizeof(MaterialAttributes),
+        .CPUAccess          = BUFFER_DATA_ACCESS::WRITE,
+        .GPUAccess          = BUFFER_DATA_ACCESS::READ,
+        .Usage              = BUFFER_USAGE::STORAGE_BUFFER,
+        .StructureStride    = sizeof(MaterialAttributes)
+    };
+
+    for (uint32_t frameIndex = 0u; frameIndex < MAX_FRAMES_IN_FLIGHT; frameIndex += 1u) {
+        m_ppMaterialTableBuffers[frameIndex] = m_pDevice->createBuffer(bufferInfo);
+        if (!m_ppMaterialTableBuffers[frameIndex]) {
+            LOG_ERROR("Failed to create bindless material storage buffer");
+            return false;
+        }
+
+        m_ppMaterialTableSets[frameIndex] = m_pDevice->allocateDescriptorSet(m_pDescriptorSetLayoutMaterialTable);
+        if (!m_ppMaterialTableSets[frameIndex]) {
+            return false;
+        }
+
+        m_ppMaterialTableSets[frameIndex]->updateStorageBufferDescriptor(SHADER_BINDING::MATERIAL_CONSTANTS, m_ppMaterialTableBuffers[frameIndex]);
+    }
+
+    return true;
+}
+
 bool MeshRenderer::createPipeline()
 {
     m_pPipelineLayout = m_pDevice->createPipelineLayout({ m_pDescriptorSetLayoutCommon, m_pDescriptorSetLayoutModel, m_pDescriptorSetLayoutMesh });
@@ -383,7 +1031,7 @@ bool MeshRenderer::createPipeline()
 
     PipelineInfo pipelineInfo = {};
     pipelineInfo.ShaderInfos = {
-        {"Mesh", SHADER_TYPE::VERTEX_SHADER},
+        {m_PackedVertices ? "MeshPacked" : "Mesh", SHADER_TYPE::VERTEX_SHADER},
         {"Mesh", SHADER_TYPE::FRAGMENT_SHADER}
     };
 
@@ -436,13 +1084,49 @@ bool MeshRenderer::createPipeline()
     pipelineInfo.Subpass        = 0u;
 
     m_pPipeline = m_pDevice->createPipeline(pipelineInfo);
-    return m_pPipeline;
+    if (!m_pPipeline || !m_IndirectDrawing) {
+        return m_pPipeline;
+    }
+
+    // The indirect pipeline reads per-object matrices from a storage buffer rather than a per-model uniform buffer
+    IDescriptorSetLayout* pMaterialLayout = m_BindlessMaterials ? m_pDescriptorSetLayoutMaterialTable : m_pDescriptorSetLayoutMesh;
+    m_pIndirectPipelineLayout = m_pDevice->createPipelineLayout({ m_pDescriptorSetLayoutCommon, m_pDescriptorSetLayoutObjects, pMaterialLayout });
+    if (!m_pIndirectPipelineLayout) {
+        return false;
+    }
+
+    pipelineInfo.ShaderInfos = {
+        {m_PackedVertices ? "MeshIndirectPacked" : "MeshIndirect", SHADER_TYPE::VERTEX_SHADER},
+        {m_BindlessMaterials ? "MeshBindless" : "Mesh", SHADER_TYPE::FRAGMENT_SHADER}
+    };
+
+    pipelineInfo.pLayout = m_pIndirectPipelineLayout;
+
+    m_pIndirectPipeline = m_pDevice->createPipeline(pipelineInfo);
+    if (!m_pIndirectPipeline || !m_BindlessMaterials) {
+        return m_pIndirectPipeline;
+    }
+
+    // Materials that do not fit in the bindless material table are drawn using their own descriptor sets
+    m_pOverflowMaterialPipelineLayout = m_pDevice->createPipelineLayout({ m_pDescriptorSetLayoutCommon, m_pDescriptorSetLayoutObjects, m_pDescriptorSetLayoutMesh });
+    if (!m_pOverflowMaterialPipelineLayout) {
+        return false;
+    }
+
+    pipelineInfo.ShaderInfos = {
+        {m_PackedVertices ? "MeshIndirectPacked" : "MeshIndirect", SHADER_TYPE::VERTEX_SHADER},
+        {"Mesh", SHADER_TYPE::FRAGMENT_SHADER}
+    };
+
+    pipelineInfo.pLayout = m_pOverflowMaterialPipelineLayout;
+
+    m_pOverflowMaterialPipeline = m_pDevice->createPipeline(pipelineInfo);
+    return m_pOverflowMaterialPipeline;
 }
 
 void MeshRenderer::OnMeshAdded(Entity entity)
 {
     LOG_INFO("hello there");
-    m_CommandListsToReset = MAX_FRAMES_IN_FLIGHT;
 
     ModelComponent& modelComp           = ECSCore::GetInstance()->GetComponent<ModelComponent>(entity);
     Model* pModel                       = modelComp.ModelPtr.get();
@@ -451,7 +1135,7 @@ void MeshRenderer::OnMeshAdded(Entity entity)
 
     // Create buffers and descriptor sets for the model and its meshes
     ModelRenderResources modelRenderResources = {};
-    modelRenderResources.MeshRenderResources.reserve(meshes.size());
+    modelRenderResources.MeshMaterials.reserve(meshes.size());
 
     BufferInfo bufferInfo   = {
         .ByteSize     = sizeof(PerObjectMatrices),
@@ -460,53 +1144,56 @@ void MeshRenderer::OnMeshAdded(Entity entity)
         .Usage        = BUFFER_USAGE::UNIFORM_BUFFER
     };
 
-    modelRenderResources.pWVPBuffer = m_pDevice->createBuffer(bufferInfo);
-    if (!modelRenderResources.pWVPBuffer) {
-        LOG_ERROR("Failed to create per-object matrices uniform buffer");
-        return;
-    }
+    // Indirect drawing stores the matrices of all renderables in shared storage buffers
+    if (!m_IndirectDrawing) {
+        modelRenderResources.pWVPBuffer = m_pDevice->createBuffer(bufferInfo);
+        if (!modelRenderResources.pWVPBuffer) {
+            LOG_ERROR("Failed to create per-object matrices uniform buffer");
+            return;
+        }
 
-    // Per-model descriptor set
-    modelRenderResources.pDescriptorSet = m_pDevice->allocateDescriptorSet(m_pDescriptorSetLayoutModel);
-    modelRenderResources.pDescriptorSet->updateUniformBufferDescriptor(SHADER_BINDING::PER_OBJECT, modelRenderResources.pWVPBuffer);
+        // Per-model descriptor set
+        modelRenderResources.pDescriptorSet = m_pDevice->allocateDescriptorSet(m_pDescriptorSetLayoutModel);
+        modelRenderResources.pDescriptorSet->updateUniformBufferDescriptor(SHADER_BINDING::PER_OBJECT, modelRenderResources.pWVPBuffer);
+    }
 
-    // Per-mesh resources
+    // Per-mesh materials, shared with every other mesh using an equal material
     for (const Mesh& mesh : meshes) {
-        MeshRenderResources meshRenderResources = {};
-
-        // Create material attributes uniform buffer
         const Material& material = materials[mesh.materialIndex];
-        bufferInfo.ByteSize = sizeof(MaterialAttributes);
-        bufferInfo.pData    = &material.attributes;
+        if (material.textures.empty()) {
+            // Meshes without textures are not rendered
+            continue;
+        }
 
-        meshRenderResources.pMaterialBuffer = m_pDevice->createBuffer(bufferInfo);
-        if (!meshRenderResources.pMaterialBuffer) {
-            LOG_ERROR("Failed to create material uniform buffer");
+        MaterialResources* pMaterial = m_MaterialCache.Acquire(material);
+        if (!pMaterial) {
+            LOG_ERROR("Failed to create material resources");
             return;
         }
 
-        // Create per-mesh descriptor set
-        meshRenderResources.pDescriptorSet = m_pDevice->allocateDescriptorSet(m_pDescriptorSetLayoutMesh);
-        meshRenderResources.pDescriptorSet->updateUniformBufferDescriptor(SHADER_BINDING::MATERIAL_CONSTANTS, meshRenderResources.pMaterialBuffer);
-        meshRenderResources.pDescriptorSet->updateCombinedTextureSamplerDescriptor(SHADER_BINDING::TEXTURE_ONE, material.textures[0].get(), m_pAniSampler);
-
-        modelRenderResources.MeshRenderResources.push_back(meshRenderResources);
+        modelRenderResources.MeshMaterials.push_back(pMaterial);
     }
 
     m_ModelRenderResources.push_back(modelRenderResources, entity);
+
+    if (m_IndirectDrawing) {
+        m_IndirectGroupsDirty = true;
+    } else if (!m_CommandBuckets.Insert(entity, pModel)) {
+        LOG_ERROR("Failed to insert renderable into a command bucket");
+    }
 }
 
 void MeshRenderer::OnMeshRemoved(Entity entity)
 {
-    m_CommandListsToReset = MAX_FRAMES_IN_FLIGHT;
+    m_CommandBuckets.Remove(entity);
+    m_IndirectGroupsDirty = true;
 
     ModelRenderResources& modelRenderResources = m_ModelRenderResources.IndexID(entity);
     delete modelRenderResources.pDescriptorSet;
     delete modelRenderResources.pWVPBuffer;
 
-    for (MeshRenderResources& meshRenderResources : modelRenderResources.MeshRenderResources) {
-        delete meshRenderResources.pDescriptorSet;
-        delete meshRenderResources.pMaterialBuffer;
+    for (MaterialResources* pMaterial : modelRenderResources.MeshMaterials) {
+        m_MaterialCache.Release(pMaterial);
     }
 
     m_ModelRenderResources.Pop(entity);
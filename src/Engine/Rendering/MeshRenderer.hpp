@@ -1,31 +1,97 @@
 #pragma once
 
+#include <Engine/Rendering/CommandBuckets.hpp>
+#include <Engine/Rendering/MaterialCache.hpp>
 #include <Engine/Rendering/Renderer.hpp>
 #include <Engine/Rendering/APIAbstractions/Viewport.hpp>
 #include <Engine/Rendering/Components/PointLight.hpp>
+#include <Engine/Utils/RadixSort.hpp>
 
 #include <DirectXMath.h>
 
 #define MAX_POINTLIGHTS 7u
 
-struct MeshRenderResources {
-    // Points at the mesh's material attributes buffer and diffuse texture
-    DescriptorSet* pDescriptorSet;
-    IBuffer* pMaterialBuffer;
-};
+// Maximum amount of renderables per command bucket. Adding or removing a renderable re-records its bucket only.
+#define MESH_BUCKET_CAPACITY 256u
+
+// Size of the bindless material table, has to match MAX_MATERIALS in MeshBindless_fs.glsl. Further materials are drawn
+// using a pipeline that binds each material's descriptor set.
+#define MAX_BINDLESS_MATERIALS 256u
+
+/*  Projected bounding sphere diameter, as a fraction of the screen height, below which renderables switch to their first
+    simplified LOD. Each further LOD's threshold is scaled by the ratio. A renderable only switches LOD once its size has
+    crossed a threshold by the hysteresis fraction, to avoid flickering between LODs around the threshold. */
+#define MESH_LOD_SCREEN_SIZE        0.25f
+#define MESH_LOD_SCREEN_SIZE_RATIO  0.5f
+#define MESH_LOD_HYSTERESIS         0.1f
 
 struct ModelRenderResources {
     // Points at the WVP buffer
     DescriptorSet* pDescriptorSet;
     IBuffer* pWVPBuffer;
 
-    std::vector<MeshRenderResources> MeshRenderResources;
+    // Shared material resources of each textured mesh
+    std::vector<MaterialResources*> MeshMaterials;
+
+    // The selected level of detail, clamped to each mesh's amount of LODs
+    uint32_t LOD;
+};
+
+struct Mesh;
+struct MeshLOD;
+
+// A single mesh draw, gathered from the renderables when command lists are recorded
+struct MeshDraw {
+    const Mesh* pMesh;
+    const MeshLOD* pLOD;
+    DescriptorSet* pModelDescriptorSet;
+    DescriptorSet* pMeshDescriptorSet;
+};
+
+/*  Instances of a mesh's LOD, described by one set of indirect draw arguments. Groups of the same mesh are adjacent and
+    share its buffers, so they are drawn by a single multi-draw. */
+struct IndirectDrawGroup {
+    const Mesh* pMesh;
+    const MeshLOD* pLOD;
+    // Renderables using the same mesh share its material
+    const MaterialResources* pMaterial;
+    // Range of the group's objects in the per-object storage buffer
+    uint32_t FirstObject;
+    uint32_t ObjectCount;
+};
+
+// Statistics of the mesh command lists, which are replayed every frame
+struct MeshRendererStats {
+    uint32_t DrawCount;
+    // Amount of draw commands recorded, an indirect draw of several groups counts once
+    uint32_t DrawCalls;
+    uint32_t PipelineBinds;
+    uint32_t DescriptorSetBinds;
+    uint32_t VertexBufferBinds;
+    uint32_t IndexBufferBinds;
+    // Amount of binds skipped compared to binding every draw's state
+    uint32_t BindsSaved;
+    // Amount of triangles drawn at the selected LODs, and the amount drawn if every mesh used its full detail LOD
+    uint32_t TriangleCount;
+    uint32_t FullDetailTriangleCount;
+    // Amount of renderables that switched LOD in the latest frame
+    uint32_t LODChanges;
+    // Amount of secondary command lists executed each frame, one per occupied bucket
+    uint32_t CommandListCount;
+    // Amount of buckets re-recorded in the latest frame
+    uint32_t BucketsRecorded;
+    // Time spent gathering, sorting and recording draws in the latest frame, in milliseconds
+    float RecordTime;
+    // Time spent writing per-object data in the latest frame, in milliseconds
+    float UpdateTime;
 };
 
 class MeshRenderer : public Renderer
 {
 public:
-    MeshRenderer(Device* pDevice, RenderingHandler* pRenderingHandler);
+    /*  Bindless materials require indirect drawing. Packed vertices select the vertex shaders reading PackedVertex.
+        Without mesh LODs, every mesh is drawn at full detail. */
+    MeshRenderer(Device* pDevice, RenderingHandler* pRenderingHandler, bool indirectDrawing, bool bindlessMaterials, bool packedVertices, bool meshLODs);
     ~MeshRenderer();
 
     bool Init() override final;
@@ -36,6 +102,11 @@ public:
 
     inline IRenderPass* getRenderPass()                     { return m_pRenderPass; }
     inline Framebuffer* getFramebuffer(uint32_t frameIndex) { return m_ppFramebuffers[frameIndex]; }
+    inline const MeshRendererStats& getStats() const        { return m_Stats; }
+    inline bool isIndirectDrawing() const                   { return m_IndirectDrawing; }
+    inline bool isBindlessMaterials() const                 { return m_BindlessMaterials; }
+    inline bool isMeshLODs() const                          { return m_MeshLODs; }
+    inline uint32_t getMaterialCount() const                { return m_MaterialCache.GetMaterialCount(); }
 
 private:
     struct PointLightBuffer {
@@ -49,6 +120,14 @@ private:
         DirectX::XMFLOAT4X4 WVP, World;
     };
 
+    // Per-object data read by indirect draws
+    struct IndirectObject {
+        DirectX::XMFLOAT4X4 WVP, World;
+        // Index into the bindless material table
+        uint32_t MaterialIndex;
+        uint32_t Padding[3];
+    };
+
     struct PerFrameBuffer {
         PointLightBuffer PointLights[MAX_POINTLIGHTS];
         alignas(16) DirectX::XMFLOAT3 CameraPosition;
@@ -62,6 +141,42 @@ private:
     bool createRenderPass();
     bool createFramebuffers();
     bool createPipeline();
+    bool createIndirectCommandLists();
+    bool createMaterialTables();
+
+    // Per-worker storage for gathering and sorting a bucket's draws
+    struct DrawScratch {
+        std::vector<MeshDraw> Draws;
+        // Sort keys paired with indices into Draws
+        std::vector<SortPair> DrawOrder;
+        std::vector<SortPair> DrawOrderScratch;
+        // Compact IDs used in sort keys, reassigned each time a bucket's draws are gathered
+        std::unordered_map<const void*, uint32_t> MaterialIDs;
+        std::unordered_map<const void*, uint32_t> MeshIDs;
+    };
+
+    /*  Selects each renderable's LOD from the size of its bounding sphere projected onto the screen. Renderables switching
+        LOD dirty their command bucket, or the indirect draw groups. */
+    void selectLODs(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection);
+
+    // Gathers the draws of a bucket's renderables and sorts them by their sort keys
+    void gatherDraws(const CommandBucket& bucket, DrawScratch& scratch) const;
+    // Records the sorted draws, skipping binds of state that is already bound
+    void recordDraws(ICommandList* pCommandList, const DrawScratch& scratch, MeshRendererStats& stats) const;
+
+    /*  Indirect drawing: every renderable's matrices are written to a storage buffer each frame, and each mesh's
+        instances are drawn using a single indirect draw. The command lists only need recording when the set of
+        drawn meshes changes, regardless of the amount of renderables. */
+    // Groups the renderables' meshes into indirect draw groups and assigns their object slots
+    void buildIndirectDrawGroups();
+    // Grows the frame's storage and argument buffers to fit the indirect draw groups
+    bool reserveIndirectBuffers(uint32_t frameIndex);
+    void updateIndirectBuffers(uint32_t frameIndex, DirectX::FXMMATRIX camVP);
+    // Rewrites the frame's bindless material table if materials have been added or removed since it was last written
+    void updateMaterialTable(uint32_t frameIndex);
+    void recordIndirectDraws(ICommandList* pCommandList, uint32_t frameIndex, MeshRendererStats& stats) const;
+    inline bool overflowsMaterialTable(const MaterialResources* pMaterial) const { return m_BindlessMaterials && pMaterial->MaterialIndex >= MAX_BINDLESS_MATERIALS; }
+    bool hasIndirectDraws(uint32_t frameIndex) const;
 
     void OnMeshAdded(Entity entity);
     void OnMeshRemoved(Entity entity);
@@ -73,15 +188,50 @@ private:
 
     IDDVector<ModelRenderResources> m_ModelRenderResources;
 
+    MaterialCache m_MaterialCache;
+
+    // Renderables are grouped into buckets by model
+    CommandBuckets m_CommandBuckets;
+    std::vector<DrawScratch> m_DrawScratches;
+    // Statistics from each bucket's latest recording
+    std::vector<MeshRendererStats> m_BucketStats;
+
+    MeshRendererStats m_Stats;
+
+    const bool m_IndirectDrawing;
+    const bool m_BindlessMaterials;
+    const bool m_PackedVertices;
+    const bool m_MeshLODs;
+    std::vector<IndirectDrawGroup> m_IndirectDrawGroups;
+    // The renderable whose matrices are written to each object slot
+    std::vector<Entity> m_IndirectObjects;
+    // Set when renderables are added or removed
+    bool m_IndirectGroupsDirty;
+
+    // Per-frame indirect drawing resources. Each frame's buffers are only resized once the frame's fence is signaled.
+    IBuffer* m_ppObjectBuffers[MAX_FRAMES_IN_FLIGHT];
+    IBuffer* m_ppIndirectArgumentBuffers[MAX_FRAMES_IN_FLIGHT];
+    DescriptorSet* m_ppObjectDescriptorSets[MAX_FRAMES_IN_FLIGHT];
+    uint32_t m_pObjectCapacities[MAX_FRAMES_IN_FLIGHT];
+    uint32_t m_pIndirectArgumentCapacities[MAX_FRAMES_IN_FLIGHT];
+
+    ICommandPool* m_pIndirectCommandPool;
+    ICommandList* m_ppIndirectCommandLists[MAX_FRAMES_IN_FLIGHT];
+    bool m_pIndirectListsDirty[MAX_FRAMES_IN_FLIGHT];
+
+    // Per-frame bindless material tables: every material's attributes and diffuse texture
+    IBuffer* m_ppMaterialTableBuffers[MAX_FRAMES_IN_FLIGHT];
+    DescriptorSet* m_ppMaterialTableSets[MAX_FRAMES_IN_FLIGHT];
+    // The material cache version each table was written at
+    uint32_t m_pMaterialTableVersions[MAX_FRAMES_IN_FLIGHT];
+
     Device* m_pDevice;
-    ICommandPool* m_ppCommandPools[MAX_FRAMES_IN_FLIGHT];
-    ICommandList* m_ppCommandLists[MAX_FRAMES_IN_FLIGHT];
-    // Amount of command lists to reset and re-record
-    uint32_t m_CommandListsToReset;
 
     IDescriptorSetLayout* m_pDescriptorSetLayoutCommon; // Common for all models and mesh: Sampler and point lights
     IDescriptorSetLayout* m_pDescriptorSetLayoutModel;  // Per model: WVP matrices
     IDescriptorSetLayout* m_pDescriptorSetLayoutMesh;   // Per mesh: Material attributes and diffuse texture
+    IDescriptorSetLayout* m_pDescriptorSetLayoutObjects;    // Per frame when drawing indirectly: All objects' matrices
+    IDescriptorSetLayout* m_pDescriptorSetLayoutMaterialTable;  // Per frame when using bindless materials: All materials
 
     DescriptorSet* m_pDescriptorSetCommon;
 
@@ -94,4 +244,9 @@ private:
     IRenderPass* m_pRenderPass;
     IPipeline* m_pPipeline;
     IPipelineLayout* m_pPipelineLayout;
+    IPipeline* m_pIndirectPipeline;
+    IPipelineLayout* m_pIndirectPipelineLayout;
+    // Draws the indirect groups whose materials do not fit in the bindless material table
+    IPipeline* m_pOverflowMaterialPipeline;
+    IPipelineLayout* m_pOverflowMaterialPipelineLayout;
 };
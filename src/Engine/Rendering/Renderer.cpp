@@ -8,7 +8,8 @@ Renderer::Renderer(Device* pDevice, RenderingHandler* pRenderingHandler)
     m_pRenderingHandler(pRenderingHandler)
 {}
 
-void Renderer::RegisterRenderer(EntitySubscriberRegistration& subscriberRegistration)
+void Renderer::RegisterRenderer(const std::string& rendererName, EntitySubscriberRegistration& subscriberRegistration)
 {
+    m_RendererName = rendererName;
     SubscribeToEntities(subscriberRegistration);
 }
@@ -2,6 +2,8 @@
 
 #include <Engine/ECS/EntitySubscriber.hpp>
 
+#include <string>
+
 class Device;
 class RenderingHandler;
 
@@ -17,10 +19,16 @@ public:
     virtual void RecordCommands() = 0;
     virtual void ExecuteCommands(ICommandList* pPrimaryCommandList) = 0;
 
+    const std::string& GetName() const { return m_RendererName; }
+
 protected:
-    void RegisterRenderer(EntitySubscriberRegistration& subscriberRegistration);
+    void RegisterRenderer(const std::string& rendererName, EntitySubscriberRegistration& subscriberRegistration);
 
 protected:
     Device* m_pDevice;
     RenderingHandler* m_pRenderingHandler;
+
+private:
+    // Names the renderer's jobs in profiles
+    std::string m_RendererName;
 };
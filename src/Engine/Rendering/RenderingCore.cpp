@@ -8,6 +8,11 @@
 RenderingCore::RenderingCore()
     :   m_Window(720u, 16.0f / 9.0f)
     ,   m_pDevice(nullptr)
+    ,   m_IndirectMeshDrawing(false)
+    ,   m_BindlessMaterials(false)
+    ,   m_PackedVertices(false)
+    ,   m_MeshLODs(false)
+    ,   m_TextureFormat(RESOURCE_FORMAT::R8G8B8A8_UNORM)
     ,   m_pCameraSystem(nullptr)
 {}
 
@@ -43,5 +48,24 @@ bool RenderingCore::Init(const EngineConfig& engineConfig)
         return false;
     }
 
+    m_IndirectMeshDrawing = engineConfig.IndirectMeshDrawing && m_pDevice->getFeatures().IndirectDrawing;
+    if (engineConfig.IndirectMeshDrawing && !m_IndirectMeshDrawing) {
+        LOG_WARNING("Indirect mesh drawing is not supported by the device, falling back to direct draws");
+    }
+
+    m_BindlessMaterials = engineConfig.BindlessMaterials && m_IndirectMeshDrawing && m_pDevice->getFeatures().DynamicTextureArrayIndexing;
+    if (engineConfig.BindlessMaterials && !m_BindlessMaterials) {
+        LOG_WARNING("Bindless materials require indirect mesh drawing and dynamic texture array indexing, binding materials per draw");
+    }
+
+    m_PackedVertices = engineConfig.PackedVertices;
+    m_MeshLODs = engineConfig.MeshLODs;
+
+    m_TextureFormat = engineConfig.TextureFormat;
+    if (isBlockCompressed(m_TextureFormat) && !m_pDevice->getFeatures().TextureCompressionBC) {
+        LOG_WARNING("Block compressed textures are not supported by the device, textures are left uncompressed");
+        m_TextureFormat = RESOURCE_FORMAT::R8G8B8A8_UNORM;
+    }
+
     return ShaderResourceHandler::GetInstance()->Init(m_pDevice);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Engine/Rendering/Window.hpp>
+#include <Engine/Rendering/APIAbstractions/GeneralResources.hpp>
 
 class CameraSystem;
 class Device;
@@ -18,10 +19,21 @@ public:
     Window* GetWindow()             { return &m_Window; }
     Device* GetDevice()             { return m_pDevice; }
     CameraSystem* GetCameraSystem() { return m_pCameraSystem; }
+    bool IsIndirectMeshDrawingEnabled() const { return m_IndirectMeshDrawing; }
+    bool IsBindlessMaterialsEnabled() const { return m_BindlessMaterials; }
+    bool IsPackedVerticesEnabled() const { return m_PackedVertices; }
+    bool IsMeshLODsEnabled() const { return m_MeshLODs; }
+    RESOURCE_FORMAT GetTextureFormat() const { return m_TextureFormat; }
 
 private:
     Window m_Window;
     Device* m_pDevice;
+    // Requested in the engine config and supported by the device
+    bool m_IndirectMeshDrawing;
+    bool m_BindlessMaterials;
+    bool m_PackedVertices;
+    bool m_MeshLODs;
+    RESOURCE_FORMAT m_TextureFormat;
 
     // Systems
     CameraSystem* m_pCameraSystem;
@@ -2,13 +2,17 @@
 
 #include <Engine/Rendering/Renderer.hpp>
 #include <Engine/Rendering/APIAbstractions/DX11/DeviceDX11.hpp>
+#include <Engine/Rendering/APIAbstractions/UploadQueue.hpp>
+#include <Engine/UI/UICore.hpp>
 
+#include <Engine/Utils/Logger.hpp>
+#include <Engine/Utils/Profiler.hpp>
 #include <Engine/Utils/ThreadPool.hpp>
 
-RenderingHandler::RenderingHandler(RenderingCore* pRenderingCore)
+RenderingHandler::RenderingHandler(RenderingCore* pRenderingCore, UICore* pUICore)
     :   m_pDevice(pRenderingCore->GetDevice())
-    ,   m_pMeshRenderer(new MeshRenderer(pRenderingCore->GetDevice(), this))
-    ,   m_pUIRenderer(new UIRenderer(pRenderingCore->GetDevice(), this))
+    ,   m_pMeshRenderer(new MeshRenderer(pRenderingCore->GetDevice(), this, pRenderingCore->IsIndirectMeshDrawingEnabled(), pRenderingCore->IsBindlessMaterialsEnabled(), pRenderingCore->IsPackedVerticesEnabled(), pRenderingCore->IsMeshLODsEnabled()))
+    ,   m_pUIRenderer(new UIRenderer(pRenderingCore->GetDevice(), this, pUICore->GetFontCache()))
 {
     std::fill_n(m_ppCommandPools, MAX_FRAMES_IN_FLIGHT, nullptr);
     std::fill_n(m_ppCommandLists, MAX_FRAMES_IN_FLIGHT, nullptr);
@@ -92,6 +96,8 @@ void RenderingHandler::waitAllFrames()
 
 void RenderingHandler::beginFrame()
 {
+    const ProfileZone profileZone("Begin frame");
+
     Swapchain* pSwapchain = m_pDevice->getSwapchain();
     uint32_t& frameIndex = m_pDevice->getFrameIndex();
     pSwapchain->acquireNextBackbuffer(frameIndex, SYNC_OPTION::SEMAPHORE);
@@ -99,20 +105,46 @@ void RenderingHandler::beginFrame()
     m_pDevice->waitForFences(&m_ppPrimaryBufferFences[frameIndex], 1u, false, UINT64_MAX);
     m_ppPrimaryBufferFences[frameIndex]->reset();
 
+    UploadQueue* pUploadQueue = m_pDevice->getUploadQueue();
+    if (pUploadQueue) {
+        pUploadQueue->retireCompletedBatches();
+    }
+
     m_ppCommandLists[frameIndex]->begin({}, nullptr);
 }
 
 void RenderingHandler::endFrame()
 {
+    const ProfileZone profileZone("End frame");
+
     const uint32_t frameIndex = m_pDevice->getFrameIndex();
     ISemaphore* pBackbufferReadySemaphore = m_pDevice->getSwapchain()->getCurrentSemaphore();
 
-    PIPELINE_STAGE waitStage = PIPELINE_STAGE::COLOR_ATTACHMENT_OUTPUT;
+    std::array<ISemaphore*, 2u> waitSemaphores = { pBackbufferReadySemaphore, nullptr };
+    std::array<PIPELINE_STAGE, 2u> waitStages = { PIPELINE_STAGE::COLOR_ATTACHMENT_OUTPUT, PIPELINE_STAGE::VERTEX_INPUT };
+    std::array<uint64_t, 2u> waitValues = { 0u, 0u };
+    uint32_t waitSemaphoreCount = 1u;
+
+    // Submit the uploads recorded during the frame, the frame's commands wait for them to finish
+    UploadQueue* pUploadQueue = m_pDevice->getUploadQueue();
+    if (pUploadQueue) {
+        if (!pUploadQueue->submit()) {
+            LOG_ERROR("Failed to submit uploads, resources created during the frame are left without their initial data");
+        }
+
+        ISemaphore* pUploadSemaphore = pUploadQueue->getSemaphore();
+        if (pUploadSemaphore) {
+            waitSemaphores[1]   = pUploadSemaphore;
+            waitValues[1]       = pUploadQueue->getWaitValue();
+            waitSemaphoreCount  = 2u;
+        }
+    }
 
     SemaphoreSubmitInfo semaphoreInfo = {};
-    semaphoreInfo.ppWaitSemaphores      = &pBackbufferReadySemaphore;
-    semaphoreInfo.WaitSemaphoreCount    = 1u;
-    semaphoreInfo.pWaitStageFlags       = &waitStage;
+    semaphoreInfo.ppWaitSemaphores      = waitSemaphores.data();
+    semaphoreInfo.WaitSemaphoreCount    = waitSemaphoreCount;
+    semaphoreInfo.pWaitStageFlags       = waitStages.data();
+    semaphoreInfo.pWaitValues           = waitSemaphoreCount > 1u ? waitValues.data() : nullptr;
     semaphoreInfo.ppSignalSemaphores    = &m_ppRenderingSemaphores[frameIndex];
     semaphoreInfo.SignalSemaphoreCount  = 1u;
     m_pDevice->graphicsQueueSubmit(m_ppCommandLists[frameIndex], m_ppPrimaryBufferFences[frameIndex], &semaphoreInfo);
@@ -122,12 +154,17 @@ void RenderingHandler::endFrame()
 
 void RenderingHandler::updateBuffers()
 {
+    const ProfileZone profileZone("Update buffers");
+
     ThreadPool& threadPool = ThreadPool::GetInstance();
     std::vector<size_t> threads;
     threads.reserve(m_Renderers.size());
 
     for (Renderer* pRenderer : m_Renderers) {
-        threads.push_back(threadPool.Execute(std::bind(&Renderer::UpdateBuffers, pRenderer)));
+        threads.push_back(threadPool.Execute([pRenderer] {
+            const ProfileZone rendererZone(pRenderer->GetName().c_str());
+            pRenderer->UpdateBuffers();
+        }));
     }
 
     for (size_t thread : threads) {
@@ -137,12 +174,17 @@ void RenderingHandler::updateBuffers()
 
 void RenderingHandler::recordSecondaryCommandBuffers()
 {
+    const ProfileZone profileZone("Record secondary command buffers");
+
     ThreadPool& threadPool = ThreadPool::GetInstance();
     std::vector<size_t> threads;
     threads.reserve(m_Renderers.size());
 
     for (Renderer* pRenderer : m_Renderers) {
-        threads.push_back(threadPool.Execute(std::bind(&Renderer::RecordCommands, pRenderer)));
+        threads.push_back(threadPool.Execute([pRenderer] {
+            const ProfileZone rendererZone(pRenderer->GetName().c_str());
+            pRenderer->RecordCommands();
+        }));
     }
 
     for (size_t thread : threads) {
@@ -152,6 +194,8 @@ void RenderingHandler::recordSecondaryCommandBuffers()
 
 void RenderingHandler::recordPrimaryCommandBuffer()
 {
+    const ProfileZone profileZone("Record primary command buffer");
+
     const uint32_t frameIndex = m_pDevice->getFrameIndex();
     ICommandList* pPrimaryCommandList = m_ppCommandLists[frameIndex];
 
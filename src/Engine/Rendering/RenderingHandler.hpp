@@ -4,11 +4,12 @@
 #include <Engine/UI/UIRenderer.hpp>
 
 class RenderingCore;
+class UICore;
 
 class RenderingHandler
 {
 public:
-    RenderingHandler(RenderingCore* pRenderingCore);
+    RenderingHandler(RenderingCore* pRenderingCore, UICore* pUICore);
     ~RenderingHandler();
 
     bool Init();
@@ -20,6 +21,8 @@ public:
 
     inline ICommandList* getCurrentPrimaryCommandList()     { return m_ppCommandLists[m_pDevice->getFrameIndex()]; }
     inline IFence** getFences()                             { return m_ppPrimaryBufferFences; }
+    inline const MeshRenderer* getMeshRenderer() const      { return m_pMeshRenderer; }
+    inline const UIRenderer* getUIRenderer() const          { return m_pUIRenderer; }
 
 private:
     void beginFrame();
@@ -28,8 +28,28 @@ ShaderHandler::ShaderHandler(Device* pDevice)
     };
 
     m_InputLayoutInfos["Mesh"] = inputLayoutInfo;
+    m_InputLayoutInfos["MeshIndirect"] = inputLayoutInfo;
 
-    // Compile UI program
+    // PackedVertex: octahedral normals and half float texture coordinates
+    inputLayoutInfo.VertexInputAttributes = {
+        {
+            "POSITION",
+            RESOURCE_FORMAT::R32G32B32_FLOAT
+        },
+        {
+            "NORMAL",
+            RESOURCE_FORMAT::R16G16_SNORM
+        },
+        {
+            "TEXCOORD",
+            RESOURCE_FORMAT::R16G16_FLOAT
+        }
+    };
+
+    m_InputLayoutInfos["MeshPacked"] = inputLayoutInfo;
+    m_InputLayoutInfos["MeshIndirectPacked"] = inputLayoutInfo;
+
+    // UI quads: panel attachments and glyphs, batched into a single vertex buffer
     inputLayoutInfo.VertexInputAttributes = {
         {
             "POSITION",
@@ -38,6 +58,14 @@ ShaderHandler::ShaderHandler(Device* pDevice)
         {
             "TEXCOORD",
             RESOURCE_FORMAT::R32G32_FLOAT
+        },
+        {
+            "COLOR",
+            RESOURCE_FORMAT::R32G32B32A32_FLOAT
+        },
+        {
+            "SINGLECHANNEL",
+            RESOURCE_FORMAT::R32_FLOAT
         }
     };
 
@@ -60,23 +88,10 @@ std::shared_ptr<Shader> ShaderHandler::loadShader(const std::string& shaderPath,
     }
 
     std::string fullShaderName = shaderPath + Shader::getTypePostfix(shaderType) + m_pDevice->getShaderFileExtension();
-    auto shaderItr = m_ShaderCache.find(fullShaderName);
-    if (shaderItr != m_ShaderCache.end()) {
-        std::weak_ptr<Shader>& shaderPtr = shaderItr->second;
-
-        if (shaderPtr.expired()) {
-            // The shader used to exist but has been deleted
-            m_ShaderCache.erase(shaderItr);
-        } else {
-            return shaderPtr.lock();
-        }
-    }
-
-    // The shader is not in the cache, compile it
-    std::shared_ptr<Shader> shader(m_pDevice->createShader(shaderType, shaderPath, pInputLayoutInfo));
-    m_ShaderCache[fullShaderName] = shader;
-
-    return shader;
+    return m_ShaderCache.Load(fullShaderName, [&]() {
+        // The shader is not in the cache, compile it
+        return std::shared_ptr<Shader>(m_pDevice->createShader(shaderType, shaderPath, pInputLayoutInfo));
+    });
 }
 
 const InputLayoutInfo& ShaderHandler::getInputLayoutInfo(const std::string& shaderName) const
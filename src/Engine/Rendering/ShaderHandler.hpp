@@ -2,6 +2,7 @@
 
 #include <Engine/Rendering/APIAbstractions/InputLayout.hpp>
 #include <Engine/Rendering/APIAbstractions/Shader.hpp>
+#include <Engine/Utils/AssetCache.hpp>
 
 #include <memory>
 #include <unordered_map>
@@ -21,7 +22,7 @@ public:
 private:
     // Mapping of vertex shader names to their input layout infos
     std::unordered_map<std::string, InputLayoutInfo> m_InputLayoutInfos;
-    std::unordered_map<std::string, std::weak_ptr<Shader>> m_ShaderCache;
+    AssetCache<Shader> m_ShaderCache;
 
     Device* m_pDevice;
 };
@@ -6,6 +6,8 @@
 #include <Engine/Utils/DirectXUtils.hpp>
 #include <Engine/Utils/ECSUtils.hpp>
 
+#include <cfloat>
+
 ShaderResourceHandler ShaderResourceHandler::s_Instance;
 
 ShaderResourceHandler::ShaderResourceHandler()
@@ -21,7 +23,7 @@ bool ShaderResourceHandler::Init(Device* pDevice)
     const SamplerInfo samplerInfo = {
         .FilterMin           = FILTER::NEAREST,
         .FilterMag           = FILTER::NEAREST,
-        .FilterMip           = FILTER::NEAREST,
+        .FilterMip           = FILTER::LINEAR,
         .AnisotropyEnabled   = true,
         .MaxAnisotropy       = 1.0f,
         .AddressModeU        = ADDRESS_MODE::MIRROR_REPEAT,
@@ -31,7 +33,8 @@ bool ShaderResourceHandler::Init(Device* pDevice)
         .CompareEnabled      = false,
         .ComparisonFunc      = COMPARISON_FUNC::ALWAYS,
         .MinLOD              = 0.0f,
-        .MaxLOD              = 0.0f
+        // Textures are loaded with full mip chains
+        .MaxLOD              = FLT_MAX
     };
 
     m_pAniSampler = m_pDevice->createSampler(samplerInfo);
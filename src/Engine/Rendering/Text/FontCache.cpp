@@ -0,0 +1,240 @@
+#include "FontCache.hpp"
+
+#include <Engine/Rendering/APIAbstractions/Device.hpp>
+#include <Engine/Utils/Logger.hpp>
+
+#include <algorithm>
+
+FontCache::FontCache(Device* pDevice)
+    :m_pDevice(pDevice),
+    m_FTLib(nullptr),
+    m_AtlasDirty(true),
+    m_GlyphCount(0u)
+{}
+
+FontCache::~FontCache()
+{
+    for (auto& facePair : m_Faces) {
+        if (facePair.second.Face) {
+            FT_Done_Face(facePair.second.Face);
+        }
+    }
+
+    if (m_FTLib) {
+        const FT_Error err = FT_Done_FreeType(m_FTLib);
+        if (err) {
+            LOG_ERRORF("Failed to release FreeType library: %s", FT_Error_String(err));
+        }
+    }
+}
+
+bool FontCache::Init()
+{
+    // https://www.freetype.org/freetype2/docs/reference/ft2-base_interface.html
+    // [Since 2.5.6] In multi-threaded applications it is easiest to use one FT_Library object per thread.
+    // In case this is too cumbersome, a single FT_Library object across threads is possible also, as long as a mutex lock is used around FT_New_Face and FT_Done_Face.
+    const FT_Error err = FT_Init_FreeType(&m_FTLib);
+    if (err) {
+        LOG_ERRORF("Failed to initialize FreeType library: %s", FT_Error_String(err));
+        m_FTLib = nullptr;
+        return false;
+    }
+
+    m_AtlasPixels.resize((size_t)GLYPH_ATLAS_SIZE * GLYPH_ATLAS_SIZE, 0u);
+
+    LOG_INFO("Initialized FreeType library");
+    return true;
+}
+
+FontFace* FontCache::GetFace(const std::string& font, uint32_t pixelHeight)
+{
+    auto faceItr = m_Faces.find({font, pixelHeight});
+    if (faceItr != m_Faces.end()) {
+        // Fonts that failed to open are kept as faces without a FreeType face, to avoid reopening them
+        return faceItr->second.Face ? &faceItr->second : nullptr;
+    }
+
+    FontFace& face = m_Faces[{font, pixelHeight}];
+    face.Face = nullptr;
+
+    FT_Face ftFace = nullptr;
+    FT_Error err = FT_New_Face(m_FTLib, font.c_str(), 0, &ftFace);
+    if (err) {
+        LOG_WARNINGF("Failed to load FreeType face from file [%s]: %s", font.c_str(), FT_Error_String(err));
+        return nullptr;
+    }
+
+    // Set the desired size of the font
+    err = FT_Set_Pixel_Sizes(ftFace, 0, pixelHeight);
+    if (err) {
+        LOG_WARNINGF("[%s] FreeType failed to set pixel size %d: %s", font.c_str(), pixelHeight, FT_Error_String(err));
+        FT_Done_Face(ftFace);
+        return nullptr;
+    }
+
+    // Size metrics are in 26.6 fixed point
+    face.Face       = ftFace;
+    face.Ascender   = int32_t(ftFace->size->metrics.ascender >> 6);
+    face.LineHeight = int32_t(ftFace->size->metrics.height >> 6);
+    return &face;
+}
+
+bool FontCache::LayoutText(const std::string& text, const std::string& font, uint32_t pixelHeight, std::vector<GlyphQuad>& quads, glm::uvec2& textSize)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    FontFace* pFace = GetFace(font, pixelHeight);
+    if (!pFace) {
+        return false;
+    }
+
+    quads.clear();
+    textSize = { 0u, (uint32_t)pFace->LineHeight };
+
+    constexpr const float atlasScale = 1.0f / float(GLYPH_ATLAS_SIZE);
+
+    // The pen is placed on the baseline, y points downwards
+    glm::ivec2 pen = { 0, pFace->Ascender };
+
+    for (char character : text) {
+        if (character == '\n') {
+            pen.x = 0;
+            pen.y += pFace->LineHeight;
+            textSize.y += (uint32_t)pFace->LineHeight;
+            continue;
+        }
+
+        const uint32_t characterCode = (uint32_t)(unsigned char)character;
+
+        const AtlasGlyph* pGlyph = nullptr;
+        auto glyphItr = pFace->Glyphs.find(characterCode);
+        if (glyphItr != pFace->Glyphs.end()) {
+            pGlyph = &glyphItr->second;
+        } else {
+            pGlyph = LoadGlyph(*pFace, characterCode, font);
+            if (!pGlyph) {
+                continue;
+            }
+        }
+
+        if (pGlyph->Size.x > 0u && pGlyph->Size.y > 0u) {
+            GlyphQuad& quad = quads.emplace_back();
+            quad.Position   = { float(pen.x + pGlyph->Bearing.x), float(pen.y - pGlyph->Bearing.y) };
+            quad.Size       = glm::vec2(pGlyph->Size);
+            quad.TXPosition = glm::vec2(pGlyph->AtlasPosition) * atlasScale;
+            quad.TXSize     = glm::vec2(pGlyph->Size) * atlasScale;
+        }
+
+        pen.x += pGlyph->Advance;
+        textSize.x = std::max(textSize.x, (uint32_t)std::max(pen.x, 0));
+    }
+
+    return true;
+}
+
+std::shared_ptr<Texture> FontCache::GetAtlasTexture()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (!m_AtlasDirty) {
+        return m_pAtlasTexture;
+    }
+
+    InitialData initialData = {};
+    initialData.pData   = m_AtlasPixels.data();
+    initialData.RowSize = GLYPH_ATLAS_SIZE * sizeof(uint8_t);
+
+    TextureInfo textureInfo = {};
+    textureInfo.Dimensions      = { GLYPH_ATLAS_SIZE, GLYPH_ATLAS_SIZE };
+    textureInfo.Usage           = TEXTURE_USAGE::SAMPLED | TEXTURE_USAGE::TRANSFER_DST;
+    textureInfo.Layout          = TEXTURE_LAYOUT::SHADER_READ_ONLY;
+    textureInfo.Format          = RESOURCE_FORMAT::R8_UNORM;
+    textureInfo.pInitialData    = &initialData;
+
+    Texture* pAtlasTexture = m_pDevice->createTexture(textureInfo);
+    if (!pAtlasTexture) {
+        LOG_WARNING("Failed to create glyph atlas texture");
+        return m_pAtlasTexture;
+    }
+
+    // Users of the previous atlas texture keep it alive until they have switched to the new one
+    m_pAtlasTexture.reset(pAtlasTexture);
+    m_AtlasDirty = false;
+    return m_pAtlasTexture;
+}
+
+const AtlasGlyph* FontCache::LoadGlyph(FontFace& face, uint32_t character, const std::string& font)
+{
+    const FT_Error err = FT_Load_Char(face.Face, character, FT_LOAD_RENDER);
+    if (err) {
+        LOG_WARNINGF("Failed to load character: '%c', font: %s", (char)character, font.c_str());
+        return nullptr;
+    }
+
+    const FT_GlyphSlot pSlot = face.Face->glyph;
+    const FT_Bitmap& bitmap = pSlot->bitmap;
+
+    AtlasGlyph glyph = {};
+    glyph.Size      = { bitmap.width, bitmap.rows };
+    glyph.Bearing   = { pSlot->bitmap_left, pSlot->bitmap_top };
+    glyph.Advance   = int32_t(pSlot->advance.x >> 6);
+
+    if (glyph.Size.x > 0u && glyph.Size.y > 0u) {
+        if (bitmap.pixel_mode != FT_PIXEL_MODE_GRAY && bitmap.pixel_mode != FT_PIXEL_MODE_MONO) {
+            LOG_WARNINGF("Unsupported glyph pixel mode: %d, character: '%c', font: %s", (int)bitmap.pixel_mode, (char)character, font.c_str());
+            glyph.Size = { 0u, 0u };
+        } else if (!AllocateAtlasRegion(glyph.Size, glyph.AtlasPosition)) {
+            LOG_WARNINGF("The glyph atlas is full, character: '%c', font: %s", (char)character, font.c_str());
+            glyph.Size = { 0u, 0u };
+        } else {
+            // Pitch is the amount of bytes per row
+            for (uint32_t row = 0u; row < glyph.Size.y; row += 1u) {
+                const uint8_t* pSrcRow = bitmap.buffer + (ptrdiff_t)row * bitmap.pitch;
+                uint8_t* pDstRow = &m_AtlasPixels[(size_t)(glyph.AtlasPosition.y + row) * GLYPH_ATLAS_SIZE + glyph.AtlasPosition.x];
+
+                if (bitmap.pixel_mode == FT_PIXEL_MODE_GRAY) {
+                    std::memcpy(pDstRow, pSrcRow, glyph.Size.x);
+                } else {
+                    // Binary format, 1 bit is one pixel, starting with the most significant bit
+                    for (uint32_t column = 0u; column < glyph.Size.x; column += 1u) {
+                        pDstRow[column] = (pSrcRow[column / 8u] >> (7u - column % 8u)) & 1u ? 255u : 0u;
+                    }
+                }
+            }
+
+            m_AtlasDirty = true;
+        }
+    }
+
+    m_GlyphCount += 1u;
+    return &(face.Glyphs[character] = glyph);
+}
+
+bool FontCache::AllocateAtlasRegion(const glm::uvec2& size, glm::uvec2& atlasPosition)
+{
+    // Each glyph is followed by padding to its right and below it, the atlas' left and top edges are padded as well
+    const glm::uvec2 paddedSize = size + GLYPH_ATLAS_PADDING;
+
+    // Pick the shortest shelf the glyph fits in, to waste as little height as possible
+    GlyphShelf* pShelf = nullptr;
+    for (GlyphShelf& shelf : m_Shelves) {
+        if (shelf.Height >= paddedSize.y && shelf.Width + paddedSize.x <= GLYPH_ATLAS_SIZE && (!pShelf || shelf.Height < pShelf->Height)) {
+            pShelf = &shelf;
+        }
+    }
+
+    if (!pShelf) {
+        // Open a new shelf below the previous one
+        const uint32_t shelfPositionY = m_Shelves.empty() ? GLYPH_ATLAS_PADDING : m_Shelves.back().PositionY + m_Shelves.back().Height;
+        if (shelfPositionY + paddedSize.y > GLYPH_ATLAS_SIZE || GLYPH_ATLAS_PADDING + paddedSize.x > GLYPH_ATLAS_SIZE) {
+            return false;
+        }
+
+        m_Shelves.push_back({ shelfPositionY, paddedSize.y, GLYPH_ATLAS_PADDING });
+        pShelf = &m_Shelves.back();
+    }
+
+    atlasPosition = { pShelf->Width, pShelf->PositionY };
+    pShelf->Width += paddedSize.x;
+    return true;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Engine/Rendering/APIAbstractions/Texture.hpp>
+
+#include <glm/glm.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+// Width and height of the glyph atlas texture in pixels
+#define GLYPH_ATLAS_SIZE 1024u
+// Empty pixels around each glyph in the atlas, keeps neighbouring glyphs from bleeding into each other when sampled
+#define GLYPH_ATLAS_PADDING 1u
+
+// A glyph rasterized into the atlas. Metrics are in pixels.
+struct AtlasGlyph {
+    // Top left corner of the glyph's bitmap in the atlas
+    glm::uvec2 AtlasPosition;
+    glm::uvec2 Size;
+    // Offset from the pen position on the baseline to the top left corner of the bitmap, where y points upwards
+    glm::ivec2 Bearing;
+    int32_t Advance;
+};
+
+// An opened font face at a fixed pixel height, and the glyphs rasterized from it
+struct FontFace {
+    FT_Face Face;
+    // Distance from the baseline to the top of the tallest glyphs, and from one baseline to the next, in pixels
+    int32_t Ascender;
+    int32_t LineHeight;
+    std::unordered_map<uint32_t, AtlasGlyph> Glyphs;
+};
+
+/*  A glyph's quad in pixels, relative to the top left corner of the text, where y points downwards.
+    Texture coordinates are normalized atlas coordinates. */
+struct GlyphQuad {
+    glm::vec2 Position, Size;
+    glm::vec2 TXPosition, TXSize;
+};
+
+class Device;
+
+/*  Keeps font faces open, keyed by font file and pixel height, and rasterizes each glyph once into a shared R8 atlas.
+    Glyphs are packed into shelves: rows of glyphs as tall as their tallest glyph, where each glyph goes into the
+    shortest shelf it fits in. */
+class FontCache
+{
+public:
+    FontCache(Device* pDevice);
+    ~FontCache();
+
+    bool Init();
+
+    /*  Returns the face of a font at a pixel height, the font file is only opened the first time. Returns nullptr if the
+        font could not be opened. FreeType faces are not thread safe, the cache's mutex has to be locked while calling
+        GetFace and while using the face. */
+    FontFace* GetFace(const std::string& font, uint32_t pixelHeight);
+
+    /*  Lays out the text as one quad per visible glyph, rasterizing the glyphs that are not yet in the atlas.
+        Newlines start new rows. textSize is set to the size of the text's bounding box in pixels. */
+    bool LayoutText(const std::string& text, const std::string& font, uint32_t pixelHeight, std::vector<GlyphQuad>& quads, glm::uvec2& textSize);
+
+    /*  Returns the atlas texture, recreating it first if glyphs have been added since it was last created. Textures of
+        earlier versions of the atlas are released once no one references them. */
+    std::shared_ptr<Texture> GetAtlasTexture();
+
+    inline std::mutex& GetMutex()               { return m_Mutex; }
+    inline uint32_t GetGlyphCount() const       { return m_GlyphCount; }
+
+private:
+    // Rasterizes a character into the atlas. Characters without a visible bitmap, e.g. spaces, only store their advance.
+    const AtlasGlyph* LoadGlyph(FontFace& face, uint32_t character, const std::string& font);
+    // Finds room for a bitmap in the atlas, returns false if the atlas is full
+    bool AllocateAtlasRegion(const glm::uvec2& size, glm::uvec2& atlasPosition);
+
+private:
+    struct GlyphShelf {
+        uint32_t PositionY;
+        uint32_t Height;
+        // Width occupied by glyphs so far
+        uint32_t Width;
+    };
+
+private:
+    Device* m_pDevice;
+    FT_Library m_FTLib;
+
+    // Faces keyed by font file and pixel height
+    std::map<std::pair<std::string, uint32_t>, FontFace> m_Faces;
+
+    // The atlas' pixels are kept on the CPU to recreate the atlas texture as glyphs are added
+    std::vector<uint8_t> m_AtlasPixels;
+    std::vector<GlyphShelf> m_Shelves;
+    std::shared_ptr<Texture> m_pAtlasTexture;
+    bool m_AtlasDirty;
+    uint32_t m_GlyphCount;
+
+    std::mutex m_Mutex;
+};
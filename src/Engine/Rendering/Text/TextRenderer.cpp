@@ -3,62 +3,33 @@
 #include <Engine/ECS/ECSCore.hpp>
 #include <Engine/Rendering/APIAbstractions/DX11/DeviceDX11.hpp>
 #include <Engine/Rendering/ShaderResourceHandler.hpp>
+#include <Engine/Rendering/Text/FontCache.hpp>
 #include <Engine/UI/Panel.hpp>
 #include <Engine/Utils/DirectXUtils.hpp>
 #include <Engine/Utils/ECSUtils.hpp>
 #include <Engine/Utils/Logger.hpp>
+#include <Engine/Utils/PixelConversion.hpp>
 
 #include <DirectXTK/WICTextureLoader.h>
 
 #include <algorithm>
 
-TextRenderer::TextRenderer(Device* pDevice)
-    :m_pDevice(pDevice)
+TextRenderer::TextRenderer(Device* pDevice, FontCache* pFontCache)
+    :m_pDevice(pDevice),
+    m_pFontCache(pFontCache)
 {}
 
-TextRenderer::~TextRenderer()
+std::shared_ptr<Texture> TextRenderer::renderText(const std::string& text, const std::string& font, unsigned int fontPixelHeight, RESOURCE_FORMAT format)
 {
-    const FT_Error err = FT_Done_FreeType(ftLib);
-	if (err) {
-		LOG_ERRORF("Failed to release FreeType library: %s", FT_Error_String(err));
-	}
-}
-
-bool TextRenderer::Init()
-{
-    // https://www.freetype.org/freetype2/docs/reference/ft2-base_interface.html
-    // [Since 2.5.6] In multi-threaded applications it is easiest to use one FT_Library object per thread.
-    // In case this is too cumbersome, a single FT_Library object across threads is possible also, as long as a mutex lock is used around FT_New_Face and FT_Done_Face.
-
-    // Initialize FreeType library
-	const FT_Error err = FT_Init_FreeType(&ftLib);
-	if (err) {
-		LOG_ERRORF("Failed to initialize FreeType library: %s", FT_Error_String(err));
-        FT_Done_FreeType(ftLib);
-        return false;
-	}
-
-    LOG_INFO("Initialized FreeType library");
-    return true;
-}
-
-std::shared_ptr<Texture> TextRenderer::renderText(const std::string& text, const std::string& font, unsigned int fontPixelHeight)
-{
-    FT_Face face;
-    FT_Error err;
+    // The face is shared with the font cache, which requires its mutex to be locked while the face is used
+    std::unique_lock<std::mutex> fontLock(m_pFontCache->GetMutex());
 
-    err = FT_New_Face(ftLib, font.c_str(), 0, &face);
-    if (err) {
-        LOG_WARNINGF("Failed to load FreeType face from file [%s]: %s", font.c_str(), FT_Error_String(err));
+    const FontFace* pFontFace = m_pFontCache->GetFace(font, fontPixelHeight);
+    if (!pFontFace) {
         return nullptr;
     }
 
-    // Set the desired size of the font
-    err = FT_Set_Pixel_Sizes(face, 0, fontPixelHeight);
-    if (err) {
-        LOG_WARNINGF("[%s] FreeType failed to set pixel size %d: %s", font.c_str(), fontPixelHeight, FT_Error_String(err));
-        return nullptr;
-    }
+    FT_Face face = pFontFace->Face;
 
     // Create texture to render all characters to
     std::map<char, ProcessedGlyph> glyphs;
@@ -90,7 +61,6 @@ std::shared_ptr<Texture> TextRenderer::renderText(const std::string& text, const
         }*/
 
         if (character == ' ') {
-            LOG_INFOF("Max advance (rendering): %d", face->size->metrics.max_advance);
             pen.x += face->size->metrics.max_advance;
             continue;
         }
@@ -121,7 +91,9 @@ std::shared_ptr<Texture> TextRenderer::renderText(const std::string& text, const
         charIdx += 1;
     }
 
-    std::shared_ptr<Texture> finalTexture = bytemapToTexture(textBytemap);
+    fontLock.unlock();
+
+    std::shared_ptr<Texture> finalTexture = bytemapToTexture(textBytemap, format);
     if (finalTexture) {
         m_Textures.push_back(finalTexture);
     }
@@ -167,7 +139,6 @@ DirectX::XMUINT2 TextRenderer::calculateTextureSize(const std::string& text, con
 
     for (char character : text) {
         if (character == ' ') {
-            LOG_INFOF("Max advance (calculate size): %d", face->size->metrics.max_advance);
             textureSize.x += (uint32_t)face->size->metrics.max_advance;
             continue;
         }
@@ -204,7 +175,6 @@ DirectX::XMUINT2 TextRenderer::calculateTextureSize(const std::string& text, con
 
     textureSize.x = (uint32_t)(ceil((float)textureSize.x / 64.0f));
     textureSize.y = (uint32_t)(ceil((float)textureSize.y / 64.0f));
-    LOG_INFOF("Texture size: (%d, %d)", textureSize.x, textureSize.y);
     return textureSize;
 }
 
@@ -221,35 +191,30 @@ void TextRenderer::drawGlyphToTexture(uint8_t* renderTarget, const DirectX::XMUI
     }
 }
 
-std::shared_ptr<Texture> TextRenderer::bytemapToTexture(const Bytemap& bytemap)
+std::shared_ptr<Texture> TextRenderer::bytemapToTexture(const Bytemap& bytemap, RESOURCE_FORMAT format)
 {
-    // Duplicate each byte in the bytemap four times to create an R8G8B8A8 texture
-    Bytemap convertedBytemap;
-    convertedBytemap.rows = bytemap.rows;
-    convertedBytemap.width = bytemap.width;
-    convertedBytemap.buffer.reserve(bytemap.buffer.size() * 4);
-
-    for (const uint8_t& byte : bytemap.buffer) {
-        // Red
-        convertedBytemap.buffer.push_back(byte);
-        // Green
-        convertedBytemap.buffer.push_back(byte);
-        // Blue
-        convertedBytemap.buffer.push_back(byte);
-        // Alpha
-        convertedBytemap.buffer.push_back(byte);
+    // Single channel textures use the bytemap as is, R8G8B8A8 textures duplicate each byte four times
+    std::vector<uint8_t> expandedBytemap;
+    const uint8_t* pPixels = bytemap.buffer.data();
+
+    if (format == RESOURCE_FORMAT::R8G8B8A8_UNORM) {
+        expandedBytemap.resize(bytemap.buffer.size() * 4u);
+        ExpandR8ToR8G8B8A8(bytemap.buffer.data(), expandedBytemap.data(), bytemap.buffer.size());
+        pPixels = expandedBytemap.data();
+    } else if (format != RESOURCE_FORMAT::R8_UNORM) {
+        LOG_WARNINGF("Unsupported text texture format: %d", (int)format);
+        return nullptr;
     }
 
-    // Convert the glyph's bytemap into unsigned integers
     InitialData initialData = {};
-    initialData.pData   = convertedBytemap.buffer.data();
-    initialData.RowSize = convertedBytemap.width * 4u * sizeof(uint8_t);
+    initialData.pData   = pPixels;
+    initialData.RowSize = (uint32_t)getTextureRowSize(format, bytemap.width);
 
     TextureInfo textureInfo = {};
-    textureInfo.Dimensions      = { convertedBytemap.width, convertedBytemap.rows };
+    textureInfo.Dimensions      = { bytemap.width, bytemap.rows };
     textureInfo.Usage           = TEXTURE_USAGE::SAMPLED;
     textureInfo.Layout          = TEXTURE_LAYOUT::SHADER_READ_ONLY;
-    textureInfo.Format          = RESOURCE_FORMAT::R8G8B8A8_UNORM;
+    textureInfo.Format          = format;
     textureInfo.pInitialData    = &initialData;
 
     std::shared_ptr<Texture> glyphTexture(m_pDevice->createTexture(textureInfo));
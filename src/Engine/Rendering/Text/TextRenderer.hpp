@@ -23,17 +23,18 @@ struct ProcessedGlyph {
 };
 
 class Device;
+class FontCache;
 
 class TextRenderer
 {
 public:
-    TextRenderer(Device* pDevice);
-    ~TextRenderer();
+    TextRenderer(Device* pDevice, FontCache* pFontCache);
+    ~TextRenderer() = default;
 
-    bool Init();
-
-    // Creates a texture with text rendered onto it
-    std::shared_ptr<Texture> renderText(const std::string& text, const std::string& font, unsigned int fontPixelHeight);
+    /*  Creates a texture with text rendered onto it. The glyphs are rasterized on every call, text that changes is better
+        drawn using a UITextComponent, which draws glyphs from the font cache's atlas. The texture is single channel by
+        default, which the UI shader swizzles into white text. R8G8B8A8_UNORM is supported for users that need four channels. */
+    std::shared_ptr<Texture> renderText(const std::string& text, const std::string& font, unsigned int fontPixelHeight, RESOURCE_FORMAT format = RESOURCE_FORMAT::R8_UNORM);
 
 private:
     // Loads and maps each character in a string to FreeType glyph data
@@ -45,17 +46,16 @@ private:
     // Copies a glyph's bitmap data into the target bitmap's bitmap
     void drawGlyphToTexture(unsigned char* renderTarget, const DirectX::XMUINT2& textureSize, const DirectX::XMUINT2& pen, const Bytemap& glyphBytemap);
 
-    // Convert a bytemap to an appropriate format, and create a texture from the results
-    std::shared_ptr<Texture> bytemapToTexture(const Bytemap& bytemap);
+    // Convert a bytemap to the given format, and create a texture from the results
+    std::shared_ptr<Texture> bytemapToTexture(const Bytemap& bytemap, RESOURCE_FORMAT format);
 
     // Convert a bitmap into a bytemap
     void bitmapToBytemap(const FT_Bitmap& bitmap, Bytemap& bytemap);
 
 private:
     Device* m_pDevice;
+    FontCache* m_pFontCache;
 
     // Rendering text results in a texture and a texture reference being created. This is the storage for the textures.
     std::vector<std::weak_ptr<Texture>> m_Textures;
-
-    FT_Library ftLib;
 };
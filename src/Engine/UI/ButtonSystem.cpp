@@ -4,15 +4,24 @@
 #include <Engine/UI/Panel.hpp>
 #include <Engine/Utils/ECSUtils.hpp>
 
-ButtonSystem::ButtonSystem(Window* pWindow)
-    :m_pUIHandler(nullptr),
+#include <algorithm>
+#include <chrono>
+
+ButtonSystem::ButtonSystem(Window* pWindow, UIHandler* pUIHandler)
+    :m_pUIHandler(pUIHandler),
+    m_pWindow(pWindow),
     m_ClientWidth(pWindow->getWidth()),
     m_ClientHeight(pWindow->getHeight()),
     m_pInputHandler(pWindow->GetInputHandler()),
+    m_GridWidth(0u),
+    m_GridHeight(0u),
+    m_GridDirty(true),
+    m_GridLayoutVersion(0u),
     m_PressedButtonExists(false),
     m_PressedButton(UINT32_MAX),
     m_HoveredButtonExists(false),
-    m_HoveredButton(UINT32_MAX)
+    m_HoveredButton(UINT32_MAX),
+    m_Stats({})
 {
     SystemRegistration sysReg = {};
     sysReg.SubscriberRegistration.EntitySubscriptionRegistrations = {
@@ -22,6 +31,8 @@ ButtonSystem::ButtonSystem(Window* pWindow)
             {
                 { RW, UIPanelComponent::Type() }, {R, UIButtonComponent::Type() }
             },
+            .OnEntityAdded = std::bind_front(&ButtonSystem::OnButtonAdded, this),
+            .OnEntityRemoval = std::bind_front(&ButtonSystem::OnButtonRemoved, this)
         }
     };
 
@@ -32,69 +43,188 @@ void ButtonSystem::Update(float dt)
 {
     UNREFERENCED_VARIABLE(dt);
 
+    const auto updateStart = std::chrono::high_resolution_clock::now();
+    m_Stats.ButtonsTested = 0u;
+
     if (m_pInputHandler->cursorIsHidden()) {
+        m_Stats.UpdateTime = 0.0f;
         return;
     }
 
-    ECSCore* pECS = ECSCore::GetInstance();
-    ComponentArray<UIPanelComponent>* pPanelComponents = pECS->GetComponentArray<UIPanelComponent>();
-    ComponentArray<UIButtonComponent>* pButtonComponents = pECS->GetComponentArray<UIButtonComponent>();
+    if (m_pWindow->getWidth() != m_ClientWidth || m_pWindow->getHeight() != m_ClientHeight) {
+        m_ClientWidth   = m_pWindow->getWidth();
+        m_ClientHeight  = m_pWindow->getHeight();
+        m_GridDirty     = true;
+    }
+
+    if (m_GridDirty || m_pUIHandler->GetLayoutVersion() != m_GridLayoutVersion) {
+        RebuildGrid();
+    }
 
     const glm::dvec2& mousePosition = m_pInputHandler->getMousePosition();
+    const glm::dvec2 mousePixel = { mousePosition.x, m_ClientHeight - mousePosition.y };
+
+    Entity hoveredButton = UINT32_MAX;
+    const bool buttonIsHovered = mousePixel.x >= 0.0 && mousePixel.y >= 0.0 && FindButton((uint32_t)mousePixel.x, (uint32_t)mousePixel.y, hoveredButton);
+
+    // Only the buttons whose states change have their highlights rewritten
+    if (m_HoveredButtonExists && (!buttonIsHovered || hoveredButton != m_HoveredButton)) {
+        ECSCore* pECS = ECSCore::GetInstance();
+        pECS->GetComponent<UIPanelComponent>(m_HoveredButton).highlight = pECS->GetConstComponent<UIButtonComponent>(m_HoveredButton).defaultHighlight;
+    }
+
+    m_HoveredButtonExists = buttonIsHovered;
+    m_HoveredButton = hoveredButton;
+
+    if (buttonIsHovered) {
+        UpdateHoveredButton(hoveredButton);
+    }
+
+    const std::chrono::duration<float, std::milli> updateTime = std::chrono::high_resolution_clock::now() - updateStart;
+    m_Stats.UpdateTime = updateTime.count();
+}
+
+void ButtonSystem::OnButtonAdded(Entity entity)
+{
+    // Highlights are only rewritten when a button's state changes, so the button starts out with its default highlight
+    ECSCore* pECS = ECSCore::GetInstance();
+    pECS->GetComponent<UIPanelComponent>(entity).highlight = pECS->GetConstComponent<UIButtonComponent>(entity).defaultHighlight;
+
+    m_GridDirty = true;
+}
+
+void ButtonSystem::OnButtonRemoved(Entity entity)
+{
+    if (m_HoveredButtonExists && m_HoveredButton == entity) {
+        m_HoveredButtonExists = false;
+    }
+
+    if (m_PressedButtonExists && m_PressedButton == entity) {
+        m_PressedButtonExists = false;
+    }
+
+    m_GridDirty = true;
+}
+
+void ButtonSystem::RebuildGrid()
+{
+    m_GridDirty = false;
+    m_GridLayoutVersion = m_pUIHandler->GetLayoutVersion();
+    m_Stats.GridRebuilds += 1u;
+
+    m_GridWidth     = std::max(1u, (m_ClientWidth + BUTTON_GRID_CELL_SIZE - 1u) / BUTTON_GRID_CELL_SIZE);
+    m_GridHeight    = std::max(1u, (m_ClientHeight + BUTTON_GRID_CELL_SIZE - 1u) / BUTTON_GRID_CELL_SIZE);
+    const uint32_t cellCount = m_GridWidth * m_GridHeight;
+
+    // Translate the panels' factors to pixel rectangles, clamped to the window
+    const float clientWidth = (float)m_ClientWidth, clientHeight = (float)m_ClientHeight;
+    auto toPixel = [](float pixel, float clientSize) {
+        return (uint32_t)std::clamp(pixel, 0.0f, clientSize);
+    };
+
+    const ComponentArray<UIPanelComponent>* pPanelComponents = ECSCore::GetInstance()->GetComponentArray<UIPanelComponent>();
 
+    m_GridButtons.clear();
     for (Entity entity : m_Buttons.GetIDs()) {
-        UIPanelComponent& panel = pPanelComponents->GetData(entity);
-        UIButtonComponent& button = pButtonComponents->GetData(entity);
-        panel.highlight = button.defaultHighlight;
+        const UIPanelComponent& panel = pPanelComponents->GetConstData(entity);
+        const float left = panel.position.x * clientWidth, bottom = panel.position.y * clientHeight;
+
+        GridButton& gridButton = m_GridButtons.emplace_back();
+        gridButton.ButtonEntity = entity;
+        gridButton.Left      = toPixel(left, clientWidth);
+        gridButton.Right     = toPixel(left + panel.size.x * clientWidth, clientWidth);
+        gridButton.Bottom    = toPixel(bottom, clientHeight);
+        gridButton.Top       = toPixel(bottom + panel.size.y * clientHeight, clientHeight);
+        gridButton.DrawOrder = GetUIDrawOrder(panel.layer, false, entity);
+    }
 
-		const unsigned int mouseX = (unsigned int)mousePosition.x;
-		const unsigned int mouseY = (unsigned int)(m_ClientHeight - mousePosition.y);
+    // Count the buttons overlapping each cell, then turn the counts into the cells' offsets
+    auto forEachCell = [this](const GridButton& gridButton, auto function) {
+        const uint32_t cellLeft     = std::min(gridButton.Left / BUTTON_GRID_CELL_SIZE, m_GridWidth - 1u);
+        const uint32_t cellRight    = std::min(gridButton.Right / BUTTON_GRID_CELL_SIZE, m_GridWidth - 1u);
+        const uint32_t cellBottom   = std::min(gridButton.Bottom / BUTTON_GRID_CELL_SIZE, m_GridHeight - 1u);
+        const uint32_t cellTop      = std::min(gridButton.Top / BUTTON_GRID_CELL_SIZE, m_GridHeight - 1u);
 
-        // Check that the mouse and the button align horizontally
-        const unsigned int buttonXLeft = (unsigned int)(panel.position.x * m_ClientWidth);
-        if (mouseX < buttonXLeft) {
-            continue;
+        for (uint32_t cellY = cellBottom; cellY <= cellTop; cellY++) {
+            for (uint32_t cellX = cellLeft; cellX <= cellRight; cellX++) {
+                function(cellY * m_GridWidth + cellX);
+            }
         }
+    };
 
-        const unsigned int buttonXRight = (unsigned int)(buttonXLeft + panel.size.x * m_ClientWidth);
-        if (mouseX > buttonXRight) {
-            continue;
-        }
+    m_CellStarts.assign(cellCount + 1u, 0u);
+    for (const GridButton& gridButton : m_GridButtons) {
+        forEachCell(gridButton, [this](uint32_t cellIdx) { m_CellStarts[cellIdx + 1u] += 1u; });
+    }
+
+    for (uint32_t cellIdx = 0u; cellIdx < cellCount; cellIdx++) {
+        m_CellStarts[cellIdx + 1u] += m_CellStarts[cellIdx];
+    }
+
+    m_CellButtons.resize(m_CellStarts.back());
+    std::vector<uint32_t> cellOffsets(m_CellStarts.begin(), m_CellStarts.end() - 1);
+
+    for (uint32_t buttonIdx = 0u; buttonIdx < (uint32_t)m_GridButtons.size(); buttonIdx++) {
+        forEachCell(m_GridButtons[buttonIdx], [&](uint32_t cellIdx) { m_CellButtons[cellOffsets[cellIdx]++] = buttonIdx; });
+    }
+}
+
+bool ButtonSystem::FindButton(uint32_t mouseX, uint32_t mouseY, Entity& button)
+{
+    if (mouseX >= m_ClientWidth || mouseY >= m_ClientHeight) {
+        return false;
+    }
 
-        // Check that the mouse and the button align vertically
-        const unsigned int buttonYDown = (unsigned int)(panel.position.y * m_ClientHeight);
-        if (mouseY < buttonYDown) {
+    const uint32_t cellIdx = (mouseY / BUTTON_GRID_CELL_SIZE) * m_GridWidth + mouseX / BUTTON_GRID_CELL_SIZE;
+    const uint32_t cellStart = m_CellStarts[cellIdx], cellEnd = m_CellStarts[cellIdx + 1u];
+    m_Stats.ButtonsTested += cellEnd - cellStart;
+
+    // The button drawn last is on top
+    const GridButton* pTopButton = nullptr;
+    for (uint32_t cellButtonIdx = cellStart; cellButtonIdx < cellEnd; cellButtonIdx++) {
+        const GridButton& gridButton = m_GridButtons[m_CellButtons[cellButtonIdx]];
+        if (mouseX < gridButton.Left || mouseX > gridButton.Right || mouseY < gridButton.Bottom || mouseY > gridButton.Top) {
             continue;
         }
 
-        const unsigned int buttonYUp = (unsigned int)(buttonYDown + panel.size.y * m_ClientHeight);
-        if (mouseY > buttonYUp) {
-            continue;
+        if (!pTopButton || gridButton.DrawOrder > pTopButton->DrawOrder) {
+            pTopButton = &gridButton;
         }
+    }
 
-        // The mouse is hovering the button. Now there are three possible states to check and handle:
-        // 1. The button is being pressed: enable pressed highlight
-        // 2. The mouse is already pressed and is not being pressed now: enable default highlight and trigger button function
-        // 3. The mouse is not already pressed and is not being pressed now: enable hover highlight
-		m_HoveredButtonExists = true;
-		m_HoveredButton = entity;
-
-        if (m_pInputHandler->mouseButtonState(GLFW_MOUSE_BUTTON_LEFT)) {
-            // State 1
-            panel.highlight = button.pressHighlight;
-            m_PressedButtonExists = true;
-            m_PressedButton = entity;
+    if (!pTopButton) {
+        return false;
+    }
+
+    button = pTopButton->ButtonEntity;
+    return true;
+}
+
+void ButtonSystem::UpdateHoveredButton(Entity entity)
+{
+    ECSCore* pECS = ECSCore::GetInstance();
+    UIPanelComponent& panel = pECS->GetComponent<UIPanelComponent>(entity);
+    const UIButtonComponent& button = pECS->GetConstComponent<UIButtonComponent>(entity);
+
+    // The mouse is hovering the button. Now there are three possible states to check and handle:
+    // 1. The button is being pressed: enable pressed highlight
+    // 2. The mouse is already pressed and is not being pressed now: enable default highlight and trigger button function
+    // 3. The mouse is not already pressed and is not being pressed now: enable hover highlight
+    if (m_pInputHandler->mouseButtonState(GLFW_MOUSE_BUTTON_LEFT)) {
+        // State 1
+        panel.highlight = button.pressHighlight;
+        m_PressedButtonExists = true;
+        m_PressedButton = entity;
+    } else {
+        if (m_PressedButtonExists && m_PressedButton == entity) {
+            // State 2
+            m_PressedButtonExists = false;
+
+            panel.highlight = button.defaultHighlight;
+            button.onPress();
         } else {
-            if (m_PressedButtonExists && m_PressedButton == entity) {
-                // State 2
-                m_PressedButtonExists = false;
-
-                panel.highlight = button.defaultHighlight;
-                button.onPress();
-            } else {
-                // State 3
-                panel.highlight = button.hoverHighlight;
-            }
+            // State 3
+            panel.highlight = button.hoverHighlight;
         }
     }
 }
@@ -7,24 +7,72 @@ class InputHandler;
 class UIHandler;
 class Window;
 
+// Width and height of the button grid's cells, in pixels
+#define BUTTON_GRID_CELL_SIZE 64u
+
+struct ButtonSystemStats {
+    // Amount of buttons whose rectangles were tested against the mouse in the latest update
+    uint32_t ButtonsTested;
+    // Amount of times the button grid has been rebuilt
+    uint32_t GridRebuilds;
+    // Time spent in the latest update, including rebuilding the grid, in milliseconds
+    float UpdateTime;
+};
+
+/*  Hit tests the mouse against the buttons using a uniform grid of pixel cells over the window. Each cell lists the
+    buttons overlapping it, so a query only tests the buttons in the mouse's cell. The grid is rebuilt when buttons are
+    added or removed, when panels are moved using UIHandler::MovePanel, or when the window's size changes. When buttons
+    overlap, the one drawn on top is hovered, following the UI renderer's draw order. */
 class ButtonSystem : public System
 {
 public:
-    ButtonSystem(Window* pWindow);
+    ButtonSystem(Window* pWindow, UIHandler* pUIHandler);
     ~ButtonSystem() = default;
 
     void Update(float dt);
 
+    inline const ButtonSystemStats& GetStats() const { return m_Stats; }
+
+private:
+    struct GridButton {
+        Entity ButtonEntity;
+        // Pixel rectangle, where y points upwards
+        uint32_t Left, Right, Bottom, Top;
+        uint64_t DrawOrder;
+    };
+
+private:
+    void OnButtonAdded(Entity entity);
+    void OnButtonRemoved(Entity entity);
+
+    void RebuildGrid();
+    // Returns whether a button is under the mouse, and if so, the topmost one
+    bool FindButton(uint32_t mouseX, uint32_t mouseY, Entity& button);
+
+    // Applies the highlight for the button's state and calls its press function when it is released
+    void UpdateHoveredButton(Entity entity);
+
 private:
     IDVector m_Buttons;
 
     UIHandler* m_pUIHandler;
+    Window* m_pWindow;
 
     // Used for translating panel positions from [0,1] to [0, windowWidth or windowHeight]
     unsigned int m_ClientWidth, m_ClientHeight;
 
     InputHandler* m_pInputHandler;
 
+    // The grid's cells, each listing the indices of the buttons overlapping it in m_GridButtons.
+    // Cell i's buttons are m_CellButtons[m_CellStarts[i]] to m_CellButtons[m_CellStarts[i + 1] - 1].
+    std::vector<GridButton> m_GridButtons;
+    std::vector<uint32_t> m_CellStarts;
+    std::vector<uint32_t> m_CellButtons;
+    uint32_t m_GridWidth, m_GridHeight;
+    bool m_GridDirty;
+    // The UI handler's layout version when the grid was last built
+    uint32_t m_GridLayoutVersion;
+
     // The bools are needed because the entity ID can't be set to -1 (it's unsigned).
     // Here, the assumption is made that only one button can be hovered or pressed at a time.
     bool m_PressedButtonExists;
@@ -32,4 +80,6 @@ private:
 
     bool m_HoveredButtonExists;
     Entity m_HoveredButton;
+
+    ButtonSystemStats m_Stats;
 };
@@ -1,10 +1,8 @@
 #pragma once
 
 #include <Engine/ECS/Component.hpp>
-#include <Engine/ECS/ComponentOwner.hpp>
 #include <Engine/Rendering/APIAbstractions/Texture.hpp>
 #include <Engine/Utils/ECSUtils.hpp>
-#include <Engine/Utils/IDVector.hpp>
 
 #include <DirectXMath.h>
 #include <string>
@@ -41,6 +39,8 @@ struct TextureAttachment {
     // Position and size are specified as [0, 1], and are relative to the panel's position and size.
     DirectX::XMFLOAT2 position, size;
     std::shared_ptr<Texture> texture;
+    // Kept for re-deriving the position and size when the panel is resized
+    TextureAttachmentInfo info;
 };
 
 struct UIPanelComponent {
@@ -52,8 +52,11 @@ struct UIPanelComponent {
         A negative highlight factor will make the panel darker */
     DirectX::XMFLOAT4 highlight;
     float highlightFactor;
+    /*  Panels and texts on higher layers are drawn on top of lower layers. Within a layer, texts are drawn on top of panels,
+        and panels with higher entity IDs are drawn on top of those with lower IDs, see GetUIDrawOrder. */
+    uint32_t layer;
+    // Each attachment is drawn as a quad of its own, in the order they were attached
     std::vector<TextureAttachment> textures;
-    Texture* texture;
 };
 
 struct UIButtonComponent {
@@ -64,49 +67,52 @@ struct UIButtonComponent {
     std::function<void()> onPress;
 };
 
-class Device;
-
-struct AttachmentRenderResources {
-    DescriptorSet* pDescriptorSet;
-    IBuffer* pAttachmentBuffer;
+/*  Text drawn on top of the panels, using glyphs from the font cache's atlas. Changing the text is cheap: the glyphs
+    are only rasterized the first time they are used. */
+struct UITextComponent {
+    DECL_COMPONENT(UITextComponent);
+    std::string text;
+    std::string font;
+    uint32_t pixelHeight;
+    // The position is specified in factors [0, 1], and describes the point the text is aligned to
+    DirectX::XMFLOAT2 position;
+    // Explicit alignments are treated as left and bottom alignments
+    TX_HORIZONTAL_ALIGNMENT horizontalAlignment;
+    TX_VERTICAL_ALIGNMENT verticalAlignment;
+    DirectX::XMFLOAT4 color;
+    uint32_t layer;
 };
 
-class UIHandler : ComponentOwner
+// Panels and texts with higher draw orders are drawn on top. Hit testing the panels uses the same order.
+inline uint64_t GetUIDrawOrder(uint32_t layer, bool isText, Entity entity)
+{
+    return ((uint64_t)(layer * 2u + (isText ? 1u : 0u)) << 32u) | entity;
+}
+
+class Device;
+
+/*  Creates panels and places textures on them. Panels are not rendered to textures of their own, the UI renderer draws
+    each attachment as a quad directly onto the backbuffer. Panels should be moved using MovePanel, which lets systems
+    that cache the panels' layout, such as the button system, know that the layout has changed. */
+class UIHandler
 {
 public:
     UIHandler(Device* pDevice);
-    ~UIHandler();
+    ~UIHandler() = default;
 
-    bool Init();
-
-    UIPanelComponent CreatePanel(DirectX::XMFLOAT2 pos, DirectX::XMFLOAT2 size, const DirectX::XMFLOAT4& highlight, float highlightFactor);
+    UIPanelComponent CreatePanel(DirectX::XMFLOAT2 pos, DirectX::XMFLOAT2 size, const DirectX::XMFLOAT4& highlight, float highlightFactor, uint32_t layer = 0u);
     void AttachTextures(Entity entity, const TextureAttachmentInfo* pAttachmentInfos, const std::shared_ptr<Texture>* pTextureReferences, size_t textureCount);
+    /*  The attachments keep their positions and sizes relative to the panel, except for client resolution dependent
+        attachments, which are re-derived from the new size to keep their size in pixels */
+    void MovePanel(Entity entity, DirectX::XMFLOAT2 pos, DirectX::XMFLOAT2 size);
 
-private:
-    void PanelDestructor(UIPanelComponent& panel, Entity entity);
-
-    bool CreateRenderPass();
-    bool CreateDescriptorSetLayout();
-    bool CreatePipeline();
+    // Incremented whenever a panel is moved
+    inline uint32_t GetLayoutVersion() const { return m_LayoutVersion; }
 
-    // Creates a texture for a panel, which can be used as both a RTV and SRV
-    void CreatePanelTexture(UIPanelComponent& panel);
+private:
     void CreateTextureAttachment(TextureAttachment& attachment, const TextureAttachmentInfo& attachmentInfo, const std::shared_ptr<Texture>& texture, const UIPanelComponent& panel);
-    void RenderTexturesOntoPanel(std::vector<TextureAttachment>& attachments, UIPanelComponent& panel);
-    bool CreatePanelRenderResources(std::vector<AttachmentRenderResources>& renderResources, std::vector<TextureAttachment>& attachments);
-    Framebuffer* CreateFramebuffer(UIPanelComponent& panel);
 
 private:
     Device* m_pDevice;
-    ICommandPool* m_pCommandPool;
-    ICommandList* m_pCommandList;
-
-    IBuffer* m_pQuadVertices;
-    ISampler* m_pAniSampler;
-
-    IDescriptorSetLayout* m_pDescriptorSetLayout;
-
-    IRenderPass* m_pRenderPass;
-    IPipelineLayout* m_pPipelineLayout;
-    IPipeline* m_pPipeline;
+    uint32_t m_LayoutVersion;
 };
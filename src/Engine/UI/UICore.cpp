@@ -4,11 +4,12 @@
 
 UICore::UICore(RenderingCore* pRenderingCore)
     :   m_PanelHandler(pRenderingCore->GetDevice())
-    ,   m_TextRenderer(pRenderingCore->GetDevice())
-    ,   m_ButtonSystem(pRenderingCore->GetWindow())
+    ,   m_FontCache(pRenderingCore->GetDevice())
+    ,   m_TextRenderer(pRenderingCore->GetDevice(), &m_FontCache)
+    ,   m_ButtonSystem(pRenderingCore->GetWindow(), &m_PanelHandler)
 {}
 
 bool UICore::Init()
 {
-    return m_TextRenderer.Init() && m_PanelHandler.Init();
+    return m_FontCache.Init();
 }
@@ -2,6 +2,7 @@
 
 #include <Engine/UI/Panel.hpp>
 #include <Engine/UI/ButtonSystem.hpp>
+#include <Engine/Rendering/Text/FontCache.hpp>
 #include <Engine/Rendering/Text/TextRenderer.hpp>
 
 class RenderingCore;
@@ -14,12 +15,15 @@ public:
 
     UIHandler* GetPanelHandler()    { return &m_PanelHandler; }
     TextRenderer* GetTextRenderer() { return &m_TextRenderer; }
+    FontCache* GetFontCache()       { return &m_FontCache; }
+    ButtonSystem* GetButtonSystem() { return &m_ButtonSystem; }
 
     bool Init();
 
 private:
     // Component Handlers
     UIHandler m_PanelHandler;
+    FontCache m_FontCache;
     TextRenderer m_TextRenderer;
 
     // Systems
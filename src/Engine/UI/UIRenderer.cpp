@@ -1,25 +1,32 @@
 #include "UIRenderer.hpp"
 
-#include <Engine/Rendering/AssetContainers/Model.hpp>
+#include <Engine/ECS/ECSCore.hpp>
+#include <Engine/Rendering/APIAbstractions/CommandPool.hpp>
 #include <Engine/Rendering/RenderingHandler.hpp>
+#include <Engine/Rendering/ShaderBindings.hpp>
 #include <Engine/Rendering/ShaderResourceHandler.hpp>
 #include <Engine/UI/Panel.hpp>
 #include <Engine/Utils/ECSUtils.hpp>
 
 #include <algorithm>
+#include <chrono>
 
-UIRenderer::UIRenderer(Device* pDevice, RenderingHandler* pRenderingHandler)
+UIRenderer::UIRenderer(Device* pDevice, RenderingHandler* pRenderingHandler, FontCache* pFontCache)
     :Renderer(pDevice, pRenderingHandler),
-    m_CommandListsToReset(MAX_FRAMES_IN_FLIGHT),
-    m_pQuad(nullptr),
+    m_pFontCache(pFontCache),
+    m_pCommandPool(nullptr),
     m_pAniSampler(nullptr),
     m_pRenderPass(nullptr),
     m_pDescriptorSetLayout(nullptr),
     m_pPipelineLayout(nullptr),
-    m_pPipeline(nullptr)
+    m_pPipeline(nullptr),
+    m_Stats({})
 {
+    std::fill_n(m_ppVertexBuffers, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_ppIndexBuffers, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_pQuadCapacities, MAX_FRAMES_IN_FLIGHT, 0u);
     std::fill_n(m_ppCommandLists, MAX_FRAMES_IN_FLIGHT, nullptr);
-    std::fill_n(m_ppCommandPools, MAX_FRAMES_IN_FLIGHT, nullptr);
+    std::fill_n(m_pCommandListsDirty, MAX_FRAMES_IN_FLIGHT, true);
     std::fill_n(m_ppFramebuffers, MAX_FRAMES_IN_FLIGHT, nullptr);
 
     EntitySubscriberRegistration entitySubscriberRegistration = {
@@ -29,33 +36,35 @@ UIRenderer::UIRenderer(Device* pDevice, RenderingHandler* pRenderingHandler)
                 .ComponentAccesses =
                 {
                     { R, UIPanelComponent::Type() }
-                },
-                .OnEntityAdded = std::bind_front(&UIRenderer::OnPanelAdded, this),
-                .OnEntityRemoval = std::bind_front(&UIRenderer::OnPanelRemoved, this)
+                }
+            },
+            {
+                .pSubscriber = &m_Texts,
+                .ComponentAccesses =
+                {
+                    { R, UITextComponent::Type() }
+                }
             }
         }
     };
 
-    RegisterRenderer(entitySubscriberRegistration);
+    RegisterRenderer(TYPE_NAME(UIRenderer), entitySubscriberRegistration);
 }
 
 UIRenderer::~UIRenderer()
 {
-    // Delete all panel render resources
-    for (Entity entity : m_Panels) {
-        PanelRenderResources& panelRenderResources = m_PanelRenderResources.IndexID(entity);
-        delete panelRenderResources.pBuffer;
-        delete panelRenderResources.pDescriptorSet;
-
-        m_PanelRenderResources.Pop(entity);
-    }
-
     for (uint32_t frameIndex = 0u; frameIndex < MAX_FRAMES_IN_FLIGHT; frameIndex += 1u) {
+        delete m_ppVertexBuffers[frameIndex];
+        delete m_ppIndexBuffers[frameIndex];
         delete m_ppCommandLists[frameIndex];
-        delete m_ppCommandPools[frameIndex];
         delete m_ppFramebuffers[frameIndex];
+
+        for (auto& textureDescriptor : m_pTextureDescriptors[frameIndex]) {
+            delete textureDescriptor.second.pDescriptorSet;
+        }
     }
 
+    delete m_pCommandPool;
     delete m_pDescriptorSetLayout;
     delete m_pRenderPass;
     delete m_pPipelineLayout;
@@ -64,21 +73,7 @@ UIRenderer::~UIRenderer()
 
 bool UIRenderer::Init()
 {
-    for (uint32_t frameIndex = 0u; frameIndex < MAX_FRAMES_IN_FLIGHT; frameIndex += 1u) {
-        m_ppCommandPools[frameIndex] = m_pDevice->createCommandPool(COMMAND_POOL_FLAG::RESETTABLE_COMMAND_LISTS, m_pDevice->getQueueFamilyIndices().Graphics);
-        if (!m_ppCommandPools[frameIndex]) {
-            return false;
-        }
-
-        m_ppCommandPools[frameIndex]->allocateCommandLists(&m_ppCommandLists[frameIndex], 1u, COMMAND_LIST_LEVEL::SECONDARY);
-        if (!m_ppCommandLists[frameIndex]) {
-            return false;
-        }
-    }
-
-    ShaderResourceHandler* pShaderResourceHandler = ShaderResourceHandler::GetInstance();
-    m_pQuad         = pShaderResourceHandler->GetQuarterScreenQuad();
-    m_pAniSampler   = pShaderResourceHandler->GetAniSampler();
+    m_pAniSampler = ShaderResourceHandler::GetInstance()->GetAniSampler();
 
     if (!CreateDescriptorSetLayouts()) {
         return false;
@@ -92,63 +87,110 @@ bool UIRenderer::Init()
         return false;
     }
 
-    return CreatePipeline();
+    if (!CreatePipeline()) {
+        return false;
+    }
+
+    return CreateCommandLists();
 }
 
 void UIRenderer::UpdateBuffers()
 {
-    constexpr const size_t bufferSize = sizeof(
-        DirectX::XMFLOAT2) * 2 +    // Position and size
-        sizeof(DirectX::XMFLOAT4) + // Highlight color
-        sizeof(float);              // Highlight factor
+    const auto updateStart = std::chrono::high_resolution_clock::now();
+    const uint32_t frameIndex = m_pDevice->getFrameIndex();
 
-    const ComponentArray<UIPanelComponent>* pPanelComponents = ECSCore::GetInstance()->GetComponentArray<UIPanelComponent>();
+    const glm::uvec2& backbufferDims = m_pDevice->getBackbuffer(0u)->getDimensions();
+    const glm::vec2 backbufferSize((float)backbufferDims.x, (float)backbufferDims.y);
+
+    m_Quads.clear();
+    m_FrameTextures.clear();
+    m_TextureIndices.clear();
 
-    for (const Entity& entity : m_Panels) {
-        const UIPanelComponent& panel = pPanelComponents->GetConstData(entity);
-        PanelRenderResources& panelRenderResources = m_PanelRenderResources.IndexID(entity);
+    ECSCore* pECS = ECSCore::GetInstance();
+    const ComponentArray<UIPanelComponent>* pPanelComponents = pECS->GetComponentArray<UIPanelComponent>();
+    for (Entity entity : m_Panels) {
+        WritePanelQuads(entity, pPanelComponents->GetConstData(entity));
+    }
 
-        // Set per-object buffer
-        void* pMappedBuffer = nullptr;
-        m_pDevice->map(panelRenderResources.pBuffer, &pMappedBuffer);
-        memcpy(pMappedBuffer, &panel, bufferSize);
-        m_pDevice->unmap(panelRenderResources.pBuffer);
+    // Laying out the texts rasterizes new glyphs, which is done before the atlas texture is retrieved
+    const size_t firstGlyphQuad = m_Quads.size();
+    const ComponentArray<UITextComponent>* pTextComponents = pECS->GetComponentArray<UITextComponent>();
+    for (Entity entity : m_Texts) {
+        WriteTextQuads(entity, pTextComponents->GetConstData(entity), backbufferSize);
     }
+
+    if (m_Quads.size() > firstGlyphQuad) {
+        std::shared_ptr<Texture> pAtlasTexture = m_pFontCache->GetAtlasTexture();
+        if (pAtlasTexture) {
+            const uint32_t atlasTextureIdx = GetTextureIndex(pAtlasTexture);
+            for (size_t quadIdx = firstGlyphQuad; quadIdx < m_Quads.size(); quadIdx += 1u) {
+                m_Quads[quadIdx].TextureIdx = atlasTextureIdx;
+            }
+        } else {
+            m_Quads.resize(firstGlyphQuad);
+        }
+    }
+
+    BatchQuads(frameIndex, m_Batches);
+    ReleaseUnusedDescriptorSets(frameIndex);
+
+    const uint32_t quadCount = (uint32_t)(m_Vertices.size() / 4u);
+    if (quadCount > 0u && !ReserveQuadBuffers(frameIndex, quadCount)) {
+        m_Batches.clear();
+    }
+
+    if (m_Batches != m_pRecordedBatches[frameIndex]) {
+        std::swap(m_Batches, m_pRecordedBatches[frameIndex]);
+        m_pCommandListsDirty[frameIndex] = true;
+    }
+
+    if (!m_pRecordedBatches[frameIndex].empty()) {
+        void* pMappedMemory = nullptr;
+        m_pDevice->map(m_ppVertexBuffers[frameIndex], &pMappedMemory);
+        std::memcpy(pMappedMemory, m_Vertices.data(), sizeof(UIVertex) * m_Vertices.size());
+        m_pDevice->unmap(m_ppVertexBuffers[frameIndex]);
+    }
+
+    const std::chrono::duration<float, std::milli> updateTime = std::chrono::high_resolution_clock::now() - updateStart;
+    m_Stats.QuadCount   = m_pRecordedBatches[frameIndex].empty() ? 0u : quadCount;
+    m_Stats.DrawCount   = (uint32_t)m_pRecordedBatches[frameIndex].size();
+    m_Stats.UpdateTime  = updateTime.count();
 }
 
 void UIRenderer::RecordCommands()
 {
-    if (m_CommandListsToReset == 0u) {
+    const uint32_t frameIndex = m_pDevice->getFrameIndex();
+    if (m_pRecordedBatches[frameIndex].empty() || !m_pCommandListsDirty[frameIndex]) {
         return;
     }
 
-    m_CommandListsToReset -= 1u;
-
-    const uint32_t frameIndex = m_pDevice->getFrameIndex();
-    ICommandList* pCommandList = m_ppCommandLists[frameIndex];
-
     CommandListBeginInfo beginInfo = {};
     beginInfo.pRenderPass   = m_pRenderPass;
     beginInfo.Subpass       = 0u;
     beginInfo.pFramebuffer  = m_ppFramebuffers[frameIndex];
+
+    ICommandList* pCommandList = m_ppCommandLists[frameIndex];
     pCommandList->begin(COMMAND_LIST_USAGE::WITHIN_RENDER_PASS, &beginInfo);
 
-    if (!m_Panels.Empty()) {
-        pCommandList->bindPipeline(m_pPipeline);
-        pCommandList->bindVertexBuffer(0u, m_pQuad);
+    pCommandList->bindPipeline(m_pPipeline);
+    pCommandList->bindVertexBuffer(0u, m_ppVertexBuffers[frameIndex]);
+    pCommandList->bindIndexBuffer(m_ppIndexBuffers[frameIndex]);
 
-        for (const PanelRenderResources& panelRenderResources : m_PanelRenderResources) {
-            pCommandList->bindDescriptorSet(panelRenderResources.pDescriptorSet, m_pPipelineLayout, 0u);
-            pCommandList->draw(4u);
-        }
+    for (const UIBatch& batch : m_pRecordedBatches[frameIndex]) {
+        pCommandList->bindDescriptorSet(batch.pDescriptorSet, m_pPipelineLayout, 0u);
+        pCommandList->drawIndexed(batch.IndexCount, batch.FirstIndex);
     }
 
     pCommandList->end();
+    m_pCommandListsDirty[frameIndex] = false;
 }
 
 void UIRenderer::ExecuteCommands(ICommandList* pPrimaryCommandList)
 {
-    pPrimaryCommandList->executeSecondaryCommandList(m_ppCommandLists[m_pDevice->getFrameIndex()]);
+    const uint32_t frameIndex = m_pDevice->getFrameIndex();
+    if (!m_pRecordedBatches[frameIndex].empty()) {
+        pPrimaryCommandList->executeSecondaryCommandList(m_ppCommandLists[frameIndex]);
+    }
 }
 
 bool UIRenderer::CreateDescriptorSetLayouts()
@@ -158,7 +200,6 @@ bool UIRenderer::CreateDescriptorSetLayouts()
         return false;
     }
 
-    m_pDescriptorSetLayout->addBindingUniformBuffer(SHADER_BINDING::PER_OBJECT, SHADER_TYPE::VERTEX_SHADER | SHADER_TYPE::FRAGMENT_SHADER);
     m_pDescriptorSetLayout->addBindingCombinedTextureSampler(SHADER_BINDING::TEXTURE_ONE, SHADER_TYPE::FRAGMENT_SHADER);
     return m_pDescriptorSetLayout->finalize(m_pDevice);
 }
@@ -249,7 +290,7 @@ bool UIRenderer::CreatePipeline()
         {"UI", SHADER_TYPE::FRAGMENT_SHADER}
     };
 
-    pipelineInfo.PrimitiveTopology = PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP;
+    pipelineInfo.PrimitiveTopology = PRIMITIVE_TOPOLOGY::TRIANGLE_LIST;
 
     const glm::uvec2& backbufferDims = m_pDevice->getBackbuffer(0u)->getDimensions();
 
@@ -275,16 +316,17 @@ bool UIRenderer::CreatePipeline()
 
     pipelineInfo.DepthStencilStateInfo = {};
     pipelineInfo.DepthStencilStateInfo.DepthTestEnabled     = false;
-    pipelineInfo.DepthStencilStateInfo.DepthWriteEnabled    = true;
+    pipelineInfo.DepthStencilStateInfo.DepthWriteEnabled    = false;
     pipelineInfo.DepthStencilStateInfo.StencilTestEnabled   = false;
 
+    // The fragment shader outputs premultiplied colors, which lets glyphs and transparent panels blend onto what is beneath them
     BlendRenderTargetInfo rtvBlendInfo = {};
-    rtvBlendInfo.BlendEnabled           = false;
+    rtvBlendInfo.BlendEnabled           = true;
     rtvBlendInfo.SrcColorBlendFactor    = BLEND_FACTOR::ONE;
     rtvBlendInfo.DstColorBlendFactor    = BLEND_FACTOR::ONE_MINUS_SRC_ALPHA;
     rtvBlendInfo.ColorBlendOp           = BLEND_OP::ADD;
     rtvBlendInfo.SrcAlphaBlendFactor    = BLEND_FACTOR::ONE;
-    rtvBlendInfo.DstAlphaBlendFactor    = BLEND_FACTOR::ONE;
+    rtvBlendInfo.DstAlphaBlendFactor    = BLEND_FACTOR::ONE_MINUS_SRC_ALPHA;
     rtvBlendInfo.AlphaBlendOp           = BLEND_OP::ADD;
     rtvBlendInfo.ColorWriteMask         = COLOR_WRITE_MASK::ENABLE_ALL;
 
@@ -301,57 +343,245 @@ bool UIRenderer::CreatePipeline()
     return m_pPipeline;
 }
 
-void UIRenderer::OnPanelAdded(Entity entity)
+bool UIRenderer::CreateCommandLists()
 {
-    LOG_INFO("hello there");
-    m_CommandListsToReset = MAX_FRAMES_IN_FLIGHT;
-
-    UIPanelComponent& panel = ECSCore::GetInstance()->GetComponent<UIPanelComponent>(entity);
-
-    PanelRenderResources panelRenderResources = {};
-
-    // Create panel buffer
-    const BufferInfo bufferInfo = {
-        .ByteSize =
-            sizeof(DirectX::XMFLOAT2) * 2 + // Position and size
-            sizeof(DirectX::XMFLOAT4) +     // Highlight color
-            sizeof(float),                  // Highlight factor
-        .CPUAccess    = BUFFER_DATA_ACCESS::WRITE,
-        .GPUAccess    = BUFFER_DATA_ACCESS::READ,
-        .Usage        = BUFFER_USAGE::UNIFORM_BUFFER
+    m_pCommandPool = m_pDevice->createCommandPool(COMMAND_POOL_FLAG::RESETTABLE_COMMAND_LISTS, m_pDevice->getQueueFamilyIndices().Graphics);
+    if (!m_pCommandPool) {
+        LOG_ERROR("Failed to create command pool for UI rendering");
+        return false;
+    }
+
+    return m_pCommandPool->allocateCommandLists(m_ppCommandLists, MAX_FRAMES_IN_FLIGHT, COMMAND_LIST_LEVEL::SECONDARY);
+}
+
+void UIRenderer::WritePanelQuads(Entity entity, const UIPanelComponent& panel)
+{
+    // finalColor = txColor + highlightFactor * (highlight * txColor) = txColor * (1 + highlightFactor * highlight)
+    const DirectX::XMFLOAT4 color = {
+        1.0f + panel.highlightFactor * panel.highlight.x,
+        1.0f + panel.highlightFactor * panel.highlight.y,
+        1.0f + panel.highlightFactor * panel.highlight.z,
+        1.0f + panel.highlightFactor * panel.highlight.w
     };
 
-    panelRenderResources.pBuffer = m_pDevice->createBuffer(bufferInfo);
-    if (!panelRenderResources.pBuffer) {
-        return;
+    const glm::vec2 panelPosition(panel.position.x, panel.position.y);
+    const glm::vec2 panelSize(panel.size.x, panel.size.y);
+    const uint64_t drawOrder = GetUIDrawOrder(panel.layer, false, entity);
+
+    for (const TextureAttachment& attachment : panel.textures) {
+        if (!attachment.texture) {
+            continue;
+        }
+
+        const glm::vec2 bottomLeft = panelPosition + glm::vec2(attachment.position.x, attachment.position.y) * panelSize;
+
+        UIQuad& quad = m_Quads.emplace_back();
+        quad.BottomLeft     = bottomLeft;
+        quad.TopRight       = bottomLeft + glm::vec2(attachment.size.x, attachment.size.y) * panelSize;
+        quad.TXTopLeft      = { 0.0f, 0.0f };
+        quad.TXBottomRight  = { 1.0f, 1.0f };
+        quad.Color          = color;
+        quad.DrawOrder      = drawOrder;
+        quad.TextureIdx     = GetTextureIndex(attachment.texture);
     }
+}
 
-    // Create descriptor set
-    panelRenderResources.pDescriptorSet = m_pDevice->allocateDescriptorSet(m_pDescriptorSetLayout);
-    if (!panelRenderResources.pDescriptorSet) {
+void UIRenderer::WriteTextQuads(Entity entity, const UITextComponent& text, const glm::vec2& backbufferSize)
+{
+    glm::uvec2 textSize;
+    if (!m_pFontCache->LayoutText(text.text, text.font, text.pixelHeight, m_GlyphQuads, textSize)) {
         return;
     }
 
-    panelRenderResources.pDescriptorSet->updateUniformBufferDescriptor(SHADER_BINDING::PER_OBJECT, panelRenderResources.pBuffer);
-    panelRenderResources.pDescriptorSet->updateCombinedTextureSamplerDescriptor(SHADER_BINDING::TEXTURE_ONE, panel.texture, m_pAniSampler);
+    // Find the text's top left corner in pixels, snapped to whole pixels to keep the glyphs sharp. y points downwards.
+    glm::vec2 origin = { text.position.x * backbufferSize.x, (1.0f - text.position.y) * backbufferSize.y };
+
+    if (text.horizontalAlignment == TX_HORIZONTAL_ALIGNMENT_CENTER) {
+        origin.x -= textSize.x * 0.5f;
+    } else if (text.horizontalAlignment == TX_HORIZONTAL_ALIGNMENT_RIGHT) {
+        origin.x -= textSize.x;
+    }
+
+    if (text.verticalAlignment == TX_VERTICAL_ALIGNMENT_CENTER) {
+        origin.y -= textSize.y * 0.5f;
+    } else if (text.verticalAlignment != TX_VERTICAL_ALIGNMENT_TOP) {
+        origin.y -= textSize.y;
+    }
+
+    origin = glm::floor(origin);
+
+    const glm::vec2 pixelToFactor = 1.0f / backbufferSize;
+    const DirectX::XMFLOAT4 color = { text.color.x * text.color.w, text.color.y * text.color.w, text.color.z * text.color.w, text.color.w };
+    const uint64_t drawOrder = GetUIDrawOrder(text.layer, true, entity);
+
+    for (const GlyphQuad& glyphQuad : m_GlyphQuads) {
+        // Convert the corners to factors, where y points upwards
+        const glm::vec2 topLeft     = (origin + glyphQuad.Position) * pixelToFactor;
+        const glm::vec2 bottomRight = (origin + glyphQuad.Position + glyphQuad.Size) * pixelToFactor;
+
+        UIQuad& quad = m_Quads.emplace_back();
+        quad.BottomLeft     = { topLeft.x, 1.0f - bottomRight.y };
+        quad.TopRight       = { bottomRight.x, 1.0f - topLeft.y };
+        quad.TXTopLeft      = glyphQuad.TXPosition;
+        quad.TXBottomRight  = glyphQuad.TXPosition + glyphQuad.TXSize;
+        quad.Color          = color;
+        quad.DrawOrder      = drawOrder;
+        quad.TextureIdx     = UINT32_MAX;
+    }
+}
+
+uint32_t UIRenderer::GetTextureIndex(const std::shared_ptr<Texture>& pTexture)
+{
+    auto textureItr = m_TextureIndices.find(pTexture.get());
+    if (textureItr != m_TextureIndices.end()) {
+        return textureItr->second;
+    }
 
-    m_PanelRenderResources.push_back(panelRenderResources, entity);
+    const uint32_t textureIdx = (uint32_t)m_FrameTextures.size();
+    m_TextureIndices[pTexture.get()] = textureIdx;
+    m_FrameTextures.push_back(pTexture);
+    return textureIdx;
 }
 
-void UIRenderer::OnPanelRemoved(Entity entity)
+void UIRenderer::BatchQuads(uint32_t frameIndex, std::vector<UIBatch>& batches)
 {
-    m_CommandListsToReset = MAX_FRAMES_IN_FLIGHT;
+    // Sorting by texture would reorder overlapping panels. The sort is stable, so a panel's attachments keep their order.
+    m_SortPairs.resize(m_Quads.size());
+    for (size_t quadIdx = 0u; quadIdx < m_Quads.size(); quadIdx += 1u) {
+        m_SortPairs[quadIdx] = { m_Quads[quadIdx].DrawOrder, (uint32_t)quadIdx };
+    }
+
+    RadixSort(m_SortPairs, m_SortScratch);
+
+    m_Vertices.clear();
+    m_Vertices.reserve(m_Quads.size() * 4u);
+    batches.clear();
+
+    uint32_t batchTextureIdx = UINT32_MAX;
+    DescriptorSet* pDescriptorSet = nullptr;
+    float singleChannel = 0.0f;
+
+    for (const SortPair& sortPair : m_SortPairs) {
+        const UIQuad& quad = m_Quads[sortPair.Value];
+
+        if (quad.TextureIdx != batchTextureIdx) {
+            const std::shared_ptr<Texture>& pTexture = m_FrameTextures[quad.TextureIdx];
+            pDescriptorSet  = GetDescriptorSet(frameIndex, pTexture);
+            singleChannel   = pTexture->getFormat() == RESOURCE_FORMAT::R8_UNORM ? 1.0f : 0.0f;
+            batchTextureIdx = quad.TextureIdx;
 
-    PanelRenderResources panelRenderResources = m_PanelRenderResources.IndexID(entity);
-    m_PanelRenderResources.Pop(entity);
+            if (pDescriptorSet) {
+                batches.push_back({ pDescriptorSet, (uint32_t)m_Vertices.size() / 4u * 6u, 0u });
+            }
+        }
+
+        if (!pDescriptorSet) {
+            continue;
+        }
 
-    std::function<void()> deleteFunction = [this, panelRenderResources]() {
-        m_pRenderingHandler->waitAllFrames();
-        delete panelRenderResources.pBuffer;
-        delete panelRenderResources.pDescriptorSet;
+        const float left = quad.BottomLeft.x, right = quad.TopRight.x, top = quad.TopRight.y, bottom = quad.BottomLeft.y;
+        const glm::vec2& txTopLeft = quad.TXTopLeft;
+        const glm::vec2& txBottomRight = quad.TXBottomRight;
+
+        m_Vertices.insert(m_Vertices.end(), {
+            {{left, top},       {txTopLeft.x, txTopLeft.y},         quad.Color, singleChannel},
+            {{right, top},      {txBottomRight.x, txTopLeft.y},     quad.Color, singleChannel},
+            {{left, bottom},    {txTopLeft.x, txBottomRight.y},     quad.Color, singleChannel},
+            {{right, bottom},   {txBottomRight.x, txBottomRight.y}, quad.Color, singleChannel}
+        });
+
+        batches.back().IndexCount += 6u;
+    }
+}
+
+DescriptorSet* UIRenderer::GetDescriptorSet(uint32_t frameIndex, const std::shared_ptr<Texture>& pTexture)
+{
+    std::unordered_map<Texture*, TextureDescriptor>& textureDescriptors = m_pTextureDescriptors[frameIndex];
+
+    auto descriptorItr = textureDescriptors.find(pTexture.get());
+    if (descriptorItr != textureDescriptors.end()) {
+        descriptorItr->second.Used = true;
+        return descriptorItr->second.pDescriptorSet;
+    }
+
+    DescriptorSet* pDescriptorSet = m_pDevice->allocateDescriptorSet(m_pDescriptorSetLayout);
+    if (!pDescriptorSet) {
+        LOG_ERROR("Failed to allocate descriptor set for UI texture");
+        return nullptr;
+    }
+
+    pDescriptorSet->updateCombinedTextureSamplerDescriptor(SHADER_BINDING::TEXTURE_ONE, pTexture.get(), m_pAniSampler);
+    textureDescriptors[pTexture.get()] = { pDescriptorSet, pTexture, true };
+    return pDescriptorSet;
+}
+
+void UIRenderer::ReleaseUnusedDescriptorSets(uint32_t frameIndex)
+{
+    // The frame's fence has been signaled, so descriptor sets it did not use this time are no longer in use
+    std::unordered_map<Texture*, TextureDescriptor>& textureDescriptors = m_pTextureDescriptors[frameIndex];
+
+    for (auto descriptorItr = textureDescriptors.begin(); descriptorItr != textureDescriptors.end();) {
+        TextureDescriptor& textureDescriptor = descriptorItr->second;
+        if (textureDescriptor.Used) {
+            textureDescriptor.Used = false;
+            ++descriptorItr;
+        } else {
+            delete textureDescriptor.pDescriptorSet;
+            descriptorItr = textureDescriptors.erase(descriptorItr);
+        }
+    }
+}
+
+bool UIRenderer::ReserveQuadBuffers(uint32_t frameIndex, uint32_t quadCount)
+{
+    if (quadCount <= m_pQuadCapacities[frameIndex] && m_ppVertexBuffers[frameIndex]) {
+        return true;
+    }
+
+    delete m_ppVertexBuffers[frameIndex];
+    delete m_ppIndexBuffers[frameIndex];
+    m_ppIndexBuffers[frameIndex] = nullptr;
+    m_pCommandListsDirty[frameIndex] = true;
+
+    // Grow geometrically to avoid reallocating every time the UI grows
+    constexpr const uint32_t minCapacity = 1024u;
+    const uint32_t capacity = std::max({ minCapacity, quadCount, m_pQuadCapacities[frameIndex] * 2u });
+    m_pQuadCapacities[frameIndex] = 0u;
+
+    const BufferInfo vertexBufferInfo = {
+        .ByteSize   = capacity * 4u * sizeof(UIVertex),
+        .CPUAccess  = BUFFER_DATA_ACCESS::WRITE,
+        .GPUAccess  = BUFFER_DATA_ACCESS::READ,
+        .Usage      = BUFFER_USAGE::VERTEX_BUFFER
     };
 
-    // TODO: Execute this on a separate thread. Currently, this needs to be done on the main thread to block
-    // it from deleting a panel texture being used in rendering.
-    deleteFunction();
+    m_ppVertexBuffers[frameIndex] = m_pDevice->createBuffer(vertexBufferInfo);
+    if (!m_ppVertexBuffers[frameIndex]) {
+        LOG_ERROR("Failed to create UI vertex buffer");
+        return false;
+    }
+
+    // Every quad uses the same index pattern, so the index buffer is only written when it is created
+    std::vector<uint32_t> indices(capacity * 6u);
+    for (uint32_t quadIdx = 0u; quadIdx < capacity; quadIdx += 1u) {
+        const uint32_t firstVertex = quadIdx * 4u;
+        uint32_t* pQuadIndices = &indices[quadIdx * 6u];
+        pQuadIndices[0] = firstVertex;
+        pQuadIndices[1] = firstVertex + 1u;
+        pQuadIndices[2] = firstVertex + 2u;
+        pQuadIndices[3] = firstVertex + 2u;
+        pQuadIndices[4] = firstVertex + 1u;
+        pQuadIndices[5] = firstVertex + 3u;
+    }
+
+    m_ppIndexBuffers[frameIndex] = m_pDevice->createIndexBuffer(indices.data(), indices.size());
+    if (!m_ppIndexBuffers[frameIndex]) {
+        LOG_ERROR("Failed to create UI index buffer");
+        delete m_ppVertexBuffers[frameIndex];
+        m_ppVertexBuffers[frameIndex] = nullptr;
+        return false;
+    }
+
+    m_pQuadCapacities[frameIndex] = capacity;
+    return true;
 }
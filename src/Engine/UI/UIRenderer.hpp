@@ -1,20 +1,43 @@
 #pragma once
 
 #include <Engine/Rendering/Renderer.hpp>
-#include <Engine/Rendering/APIAbstractions/Viewport.hpp>
+#include <Engine/Rendering/Text/FontCache.hpp>
 #include <Engine/Utils/IDVector.hpp>
+#include <Engine/Utils/RadixSort.hpp>
+
+#include <DirectXMath.h>
+#include <unordered_map>
+
+struct UIPanelComponent;
+struct UITextComponent;
+
+struct UIVertex {
+    // Position in factors [0, 1] of the window, where y points upwards
+    DirectX::XMFLOAT2 Position;
+    DirectX::XMFLOAT2 TXCoords;
+    // Multiplies the texture's color: a panel's highlight, or a text's premultiplied color
+    DirectX::XMFLOAT4 Color;
+    // 1 when the texture is single channel, its red channel is then used for all channels
+    float SingleChannel;
+};
 
-class UIHandler;
-
-struct PanelRenderResources {
-    DescriptorSet* pDescriptorSet;
-    IBuffer* pBuffer;
+struct UIRendererStats {
+    // Amount of quads and draws in the latest frame
+    uint32_t QuadCount;
+    uint32_t DrawCount;
+    // Time spent gathering, sorting and writing the quads in the latest frame, in milliseconds
+    float UpdateTime;
 };
 
+/*  Draws the UI in immediate mode: every frame, each panel attachment and each glyph of every text is appended as a
+    quad to the frame's vertex buffer. The quads are sorted by their draw order, and each run of consecutive quads
+    sharing a texture is drawn using a single draw. Text shares the font cache's glyph atlas, and texts are drawn after
+    the panels of their layer, so all text on a layer is one draw.
+    The frame's command list is only re-recorded when its draws or buffers have changed. */
 class UIRenderer : public Renderer
 {
 public:
-    UIRenderer(Device* pDevice, RenderingHandler* pRenderingHandler);
+    UIRenderer(Device* pDevice, RenderingHandler* pRenderingHandler, FontCache* pFontCache);
     ~UIRenderer();
 
     bool Init() override final;
@@ -25,26 +48,85 @@ public:
 
     inline IRenderPass* GetRenderPass()                     { return m_pRenderPass; }
     inline Framebuffer* GetFramebuffer(uint32_t frameIndex) { return m_ppFramebuffers[frameIndex]; }
+    inline const UIRendererStats& GetStats() const          { return m_Stats; }
+
+private:
+    struct UIQuad {
+        // Corners in factors, where y points upwards
+        glm::vec2 BottomLeft, TopRight;
+        glm::vec2 TXTopLeft, TXBottomRight;
+        DirectX::XMFLOAT4 Color;
+        // The draw order of the quad's panel or text. A panel's attachments share an order and keep their attachment order.
+        uint64_t DrawOrder;
+        // Index into the frame's textures
+        uint32_t TextureIdx;
+    };
+
+    // A run of quads sharing a texture
+    struct UIBatch {
+        DescriptorSet* pDescriptorSet;
+        uint32_t FirstIndex;
+        uint32_t IndexCount;
+
+        bool operator==(const UIBatch& other) const = default;
+    };
+
+    // A texture's descriptor set, which keeps the texture alive while a frame might use it
+    struct TextureDescriptor {
+        DescriptorSet* pDescriptorSet;
+        std::shared_ptr<Texture> pTexture;
+        bool Used;
+    };
 
 private:
     bool CreateDescriptorSetLayouts();
     bool CreateRenderPass();
     bool CreateFramebuffers();
     bool CreatePipeline();
-
-    void OnPanelAdded(Entity entity);
-    void OnPanelRemoved(Entity entity);
+    bool CreateCommandLists();
+
+    void WritePanelQuads(Entity entity, const UIPanelComponent& panel);
+    // The text quads' texture index is set once every text has been laid out, as layouts might add glyphs to the atlas
+    void WriteTextQuads(Entity entity, const UITextComponent& text, const glm::vec2& backbufferSize);
+    // Returns the index of the texture in the frame's textures, adding it the first time it is used in the frame
+    uint32_t GetTextureIndex(const std::shared_ptr<Texture>& pTexture);
+
+    // Sorts the quads by draw order, writes their vertices and groups consecutive quads sharing a texture into batches
+    void BatchQuads(uint32_t frameIndex, std::vector<UIBatch>& batches);
+    // Returns the frame's descriptor set for the texture, allocating it the first time the frame uses the texture
+    DescriptorSet* GetDescriptorSet(uint32_t frameIndex, const std::shared_ptr<Texture>& pTexture);
+    // Deletes the frame's descriptor sets of textures that were not used in the frame
+    void ReleaseUnusedDescriptorSets(uint32_t frameIndex);
+    // Grows the frame's vertex and index buffers to fit the quads
+    bool ReserveQuadBuffers(uint32_t frameIndex, uint32_t quadCount);
 
 private:
     IDVector m_Panels;
-    IDDVector<PanelRenderResources> m_PanelRenderResources;
-
-    ICommandPool* m_ppCommandPools[MAX_FRAMES_IN_FLIGHT];
+    IDVector m_Texts;
+
+    FontCache* m_pFontCache;
+
+    // Scratch data, rewritten each frame
+    std::vector<UIQuad> m_Quads;
+    std::vector<SortPair> m_SortPairs;
+    std::vector<SortPair> m_SortScratch;
+    std::vector<UIVertex> m_Vertices;
+    std::vector<UIBatch> m_Batches;
+    std::vector<GlyphQuad> m_GlyphQuads;
+    std::vector<std::shared_ptr<Texture>> m_FrameTextures;
+    std::unordered_map<Texture*, uint32_t> m_TextureIndices;
+
+    // Per-frame resources. Each frame's resources are only changed once the frame's fence is signaled.
+    IBuffer* m_ppVertexBuffers[MAX_FRAMES_IN_FLIGHT];
+    IBuffer* m_ppIndexBuffers[MAX_FRAMES_IN_FLIGHT];
+    uint32_t m_pQuadCapacities[MAX_FRAMES_IN_FLIGHT];
+    std::vector<UIBatch> m_pRecordedBatches[MAX_FRAMES_IN_FLIGHT];
+    std::unordered_map<Texture*, TextureDescriptor> m_pTextureDescriptors[MAX_FRAMES_IN_FLIGHT];
+
+    ICommandPool* m_pCommandPool;
     ICommandList* m_ppCommandLists[MAX_FRAMES_IN_FLIGHT];
-    // Amount of command lists to reset and re-record
-    uint32_t m_CommandListsToReset;
+    bool m_pCommandListsDirty[MAX_FRAMES_IN_FLIGHT];
 
-    IBuffer* m_pQuad;
     ISampler* m_pAniSampler;
 
     IRenderPass* m_pRenderPass;
@@ -52,8 +134,8 @@ private:
 
     IDescriptorSetLayout* m_pDescriptorSetLayout;
 
-    Viewport m_Viewport;
-
     IPipelineLayout* m_pPipelineLayout;
     IPipeline* m_pPipeline;
+
+    UIRendererStats m_Stats;
 };
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <Engine/Utils/ResidencyManager.hpp>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Amount of independently locked shards. Requests for assets in different shards do not contend for locks.
+#define ASSET_CACHE_SHARD_COUNT     16u
+// Expired entries are removed from a shard once it has grown by this many entries since its previous sweep
+#define ASSET_CACHE_SWEEP_INTERVAL  64u
+
+/*  Thread-safe cache mapping asset paths to weak pointers of shared assets. Concurrent requests for an asset that is not
+    loaded are coalesced: the first request loads the asset, and the remaining requests wait for that load. Expired
+    entries are not removed on lookup, but in batches as the shards grow. */
+template <typename Asset>
+class AssetCache
+{
+public:
+    typedef std::shared_ptr<Asset> AssetPtr;
+    typedef std::shared_future<AssetPtr> Future;
+    // Called once an asynchronous load has finished, possibly on a worker thread. The asset is nullptr if the load failed.
+    typedef std::function<void(const AssetPtr&)> Callback;
+
+public:
+    AssetCache();
+    // Waits for in-flight loads to finish
+    ~AssetCache();
+
+    AssetCache(const AssetCache& other) = delete;
+    void operator=(const AssetCache& other) = delete;
+
+    /*  Keeps the cache's assets alive in the residency manager after they are released, and records the cache's hits and
+        misses. The size function returns the bytes of memory used by an asset. */
+    void SetResidencyManager(ResidencyManager* pResidencyManager, const std::function<size_t(const Asset&)>& getAssetSize);
+
+    // Returns nullptr if the asset is not loaded
+    AssetPtr Find(const std::string& key);
+
+    /*  Returns the loaded asset, or loads it on the calling thread using the load function. Blocks if another thread is
+        loading the asset, which should be avoided on thread pool workers. */
+    AssetPtr Load(const std::string& key, const std::function<AssetPtr()>& loadFunction);
+
+    /*  If the asset is neither loaded nor being loaded, startLoad is called to begin loading it, after which Finish()
+        has to be called once the asset has loaded. The callback is called right away if the asset is already loaded. */
+    Future LoadAsync(const std::string& key, const std::function<void()>& startLoad, const Callback& onLoaded = nullptr);
+
+    // Stores an asynchronously loaded asset and resolves the requests waiting for it. Failed loads are not cached.
+    void Finish(const std::string& key, const AssetPtr& asset);
+
+    void WaitForLoads();
+    // Removes every expired entry
+    void Sweep();
+
+    // Amount of loads started by the cache, i.e. the amount of requests that were not served by the cache or by a coalesced load
+    uint32_t GetLoadCount() const { return m_LoadCount; }
+
+private:
+    struct PendingLoad {
+        std::promise<AssetPtr> Promise;
+        Future LoadFuture;
+        std::vector<Callback> Callbacks;
+    };
+
+    struct Shard {
+        std::mutex Lock;
+        std::unordered_map<std::string, std::weak_ptr<Asset>> Assets;
+        std::unordered_map<std::string, PendingLoad> PendingLoads;
+        size_t SizeAfterSweep = 0u;
+    };
+
+private:
+    Shard& GetShard(const std::string& key);
+
+    // The shard's lock has to be held
+    static AssetPtr FindInShard(Shard& shard, const std::string& key);
+    static void SweepShard(Shard& shard);
+    // Registers a load of the asset. The shard's lock has to be held.
+    Future BeginLoad(Shard& shard, const std::string& key, const Callback& onLoaded);
+
+    // Informs the residency manager of a request served by a loaded asset, or by a load in progress if the asset is nullptr
+    void OnHit(const AssetPtr& asset);
+
+private:
+    std::array<Shard, ASSET_CACHE_SHARD_COUNT> m_Shards;
+
+    std::mutex m_LoadsLock;
+    std::condition_variable m_LoadFinished;
+    uint32_t m_ActiveLoads;
+
+    std::atomic_uint32_t m_LoadCount;
+
+    ResidencyManager* m_pResidencyManager;
+    std::function<size_t(const Asset&)> m_GetAssetSize;
+};
+
+template <typename Asset>
+inline AssetCache<Asset>::AssetCache()
+    :m_ActiveLoads(0u),
+    m_LoadCount(0u),
+    m_pResidencyManager(nullptr)
+{}
+
+template <typename Asset>
+inline AssetCache<Asset>::~AssetCache()
+{
+    WaitForLoads();
+}
+
+template <typename Asset>
+inline void AssetCache<Asset>::SetResidencyManager(ResidencyManager* pResidencyManager, const std::function<size_t(const Asset&)>& getAssetSize)
+{
+    m_pResidencyManager = pResidencyManager;
+    m_GetAssetSize = getAssetSize;
+}
+
+template <typename Asset>
+inline typename AssetCache<Asset>::AssetPtr AssetCache<Asset>::Find(const std::string& key)
+{
+    Shard& shard = GetShard(key);
+    AssetPtr asset;
+
+    {
+        std::scoped_lock<std::mutex> lock(shard.Lock);
+        asset = FindInShard(shard, key);
+    }
+
+    if (asset) {
+        OnHit(asset);
+    }
+
+    return asset;
+}
+
+template <typename Asset>
+inline typename AssetCache<Asset>::AssetPtr AssetCache<Asset>::Load(const std::string& key, const std::function<AssetPtr()>& loadFunction)
+{
+    Shard& shard = GetShard(key);
+    Future pendingLoad;
+    bool isLoader = false;
+
+    {
+        std::unique_lock<std::mutex> lock(shard.Lock);
+        AssetPtr asset = FindInShard(shard, key);
+        if (asset) {
+            lock.unlock();
+            OnHit(asset);
+            return asset;
+        }
+
+        auto pendingItr = shard.PendingLoads.find(key);
+        if (pendingItr != shard.PendingLoads.end()) {
+            pendingLoad = pendingItr->second.LoadFuture;
+        } else {
+            pendingLoad = BeginLoad(shard, key, nullptr);
+            isLoader = true;
+        }
+    }
+
+    if (isLoader) {
+        Finish(key, loadFunction());
+    } else {
+        OnHit(nullptr);
+    }
+
+    return pendingLoad.get();
+}
+
+template <typename Asset>
+inline typename AssetCache<Asset>::Future AssetCache<Asset>::LoadAsync(const std::string& key, const std::function<void()>& startLoad, const Callback& onLoaded)
+{
+    Shard& shard = GetShard(key);
+    std::unique_lock<std::mutex> lock(shard.Lock);
+
+    AssetPtr asset = FindInShard(shard, key);
+    if (asset) {
+        lock.unlock();
+        OnHit(asset);
+        if (onLoaded) {
+            onLoaded(asset);
+        }
+
+        std::promise<AssetPtr> loadedAsset;
+        loadedAsset.set_value(asset);
+        return loadedAsset.get_future().share();
+    }
+
+    auto pendingItr = shard.PendingLoads.find(key);
+    if (pendingItr != shard.PendingLoads.end()) {
+        if (onLoaded) {
+            pendingItr->second.Callbacks.push_back(onLoaded);
+        }
+
+        Future pendingLoad = pendingItr->second.LoadFuture;
+        lock.unlock();
+        OnHit(nullptr);
+        return pendingLoad;
+    }
+
+    Future pendingLoad = BeginLoad(shard, key, onLoaded);
+    lock.unlock();
+
+    // The load might finish before startLoad returns
+    startLoad();
+    return pendingLoad;
+}
+
+template <typename Asset>
+inline void AssetCache<Asset>::Finish(const std::string& key, const AssetPtr& asset)
+{
+    Shard& shard = GetShard(key);
+    std::promise<AssetPtr> promise;
+    std::vector<Callback> callbacks;
+
+    {
+        std::scoped_lock<std::mutex> lock(shard.Lock);
+        if (asset) {
+            shard.Assets[key] = asset;
+
+            if (shard.Assets.size() >= shard.SizeAfterSweep + ASSET_CACHE_SWEEP_INTERVAL) {
+                SweepShard(shard);
+            }
+        }
+
+        // Later requests find the asset in the shard, and will not add callbacks to the finished load
+        auto pendingItr = shard.PendingLoads.find(key);
+        promise = std::move(pendingItr->second.Promise);
+        callbacks = std::move(pendingItr->second.Callbacks);
+        shard.PendingLoads.erase(pendingItr);
+    }
+
+    if (m_pResidencyManager) {
+        m_pResidencyManager->RecordMiss();
+        if (asset) {
+            m_pResidencyManager->Touch(asset, m_GetAssetSize(*asset));
+        }
+    }
+
+    promise.set_value(asset);
+    for (const Callback& callback : callbacks) {
+        callback(asset);
+    }
+
+    std::scoped_lock<std::mutex> lock(m_LoadsLock);
+    m_ActiveLoads -= 1u;
+    m_LoadFinished.notify_all();
+}
+
+template <typename Asset>
+inline void AssetCache<Asset>::WaitForLoads()
+{
+    std::unique_lock<std::mutex> lock(m_LoadsLock);
+    m_LoadFinished.wait(lock, [this]() { return m_ActiveLoads == 0u; });
+}
+
+template <typename Asset>
+inline void AssetCache<Asset>::Sweep()
+{
+    for (Shard& shard : m_Shards) {
+        std::scoped_lock<std::mutex> lock(shard.Lock);
+        SweepShard(shard);
+    }
+
+    if (m_pResidencyManager) {
+        m_pResidencyManager->Trim();
+    }
+}
+
+template <typename Asset>
+inline typename AssetCache<Asset>::Shard& AssetCache<Asset>::GetShard(const std::string& key)
+{
+    return m_Shards[std::hash<std::string>()(key) % ASSET_CACHE_SHARD_COUNT];
+}
+
+template <typename Asset>
+inline typename AssetCache<Asset>::AssetPtr AssetCache<Asset>::FindInShard(Shard& shard, const std::string& key)
+{
+    // Expired entries are left for the next sweep
+    auto assetItr = shard.Assets.find(key);
+    return assetItr == shard.Assets.end() ? nullptr : assetItr->second.lock();
+}
+
+template <typename Asset>
+inline void AssetCache<Asset>::SweepShard(Shard& shard)
+{
+    std::erase_if(shard.Assets, [](const auto& asset) { return asset.second.expired(); });
+    shard.SizeAfterSweep = shard.Assets.size();
+}
+
+template <typename Asset>
+inline typename AssetCache<Asset>::Future AssetCache<Asset>::BeginLoad(Shard& shard, const std::string& key, const Callback& onLoaded)
+{
+    PendingLoad& pendingLoad = shard.PendingLoads[key];
+    pendingLoad.LoadFuture = pendingLoad.Promise.get_future().share();
+    if (onLoaded) {
+        pendingLoad.Callbacks.push_back(onLoaded);
+    }
+
+    m_LoadCount += 1u;
+
+    std::scoped_lock<std::mutex> lock(m_LoadsLock);
+    m_ActiveLoads += 1u;
+
+    return pendingLoad.LoadFuture;
+}
+
+template <typename Asset>
+inline void AssetCache<Asset>::OnHit(const AssetPtr& asset)
+{
+    if (!m_pResidencyManager) {
+        return;
+    }
+
+    m_pResidencyManager->RecordHit();
+    if (asset) {
+        m_pResidencyManager->Touch(asset, m_GetAssetSize(*asset));
+    }
+}
@@ -0,0 +1,114 @@
+#include "MappedFile.hpp"
+
+#include <Engine/Utils/Logger.hpp>
+
+#ifdef PLATFORM_WINDOWS
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    :m_pData(nullptr),
+    m_Size(0u),
+    #ifdef PLATFORM_WINDOWS
+        m_File(INVALID_HANDLE_VALUE),
+        m_Mapping(nullptr)
+    #else
+        m_File(-1)
+    #endif
+{}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string& filePath)
+{
+    Close();
+
+    #ifdef PLATFORM_WINDOWS
+        m_File = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_File == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(m_File, &fileSize) || fileSize.QuadPart == 0) {
+            Close();
+            return false;
+        }
+
+        m_Size = (size_t)fileSize.QuadPart;
+
+        m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+        if (!m_Mapping) {
+            LOG_WARNINGF("Failed to create file mapping: %s", filePath.c_str());
+            Close();
+            return false;
+        }
+
+        m_pData = (const uint8_t*)MapViewOfFile(m_Mapping, FILE_MAP_READ, 0u, 0u, 0u);
+    #else
+        m_File = open(filePath.c_str(), O_RDONLY);
+        if (m_File == -1) {
+            return false;
+        }
+
+        struct stat fileStats = {};
+        if (fstat(m_File, &fileStats) != 0 || fileStats.st_size == 0) {
+            Close();
+            return false;
+        }
+
+        m_Size = (size_t)fileStats.st_size;
+
+        void* pData = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0);
+        m_pData = pData == MAP_FAILED ? nullptr : (const uint8_t*)pData;
+    #endif
+
+    if (!m_pData) {
+        LOG_WARNINGF("Failed to map file: %s", filePath.c_str());
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    #ifdef PLATFORM_WINDOWS
+        if (m_pData) {
+            UnmapViewOfFile(m_pData);
+        }
+
+        if (m_Mapping) {
+            CloseHandle(m_Mapping);
+        }
+
+        if (m_File != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_File);
+        }
+
+        m_Mapping   = nullptr;
+        m_File      = INVALID_HANDLE_VALUE;
+    #else
+        if (m_pData) {
+            munmap((void*)m_pData, m_Size);
+        }
+
+        if (m_File != -1) {
+            close(m_File);
+        }
+
+        m_File = -1;
+    #endif
+
+    m_pData = nullptr;
+    m_Size  = 0u;
+}
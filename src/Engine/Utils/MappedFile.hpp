@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+// Maps a file into memory for reading. The pages are loaded by the OS on demand.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile& other) = delete;
+    void operator=(const MappedFile& other) = delete;
+
+    bool Open(const std::string& filePath);
+    void Close();
+
+    const uint8_t* GetData() const { return m_pData; }
+    size_t GetSize() const { return m_Size; }
+
+private:
+    const uint8_t* m_pData;
+    size_t m_Size;
+
+    #ifdef PLATFORM_WINDOWS
+        void* m_File;
+        void* m_Mapping;
+    #else
+        int m_File;
+    #endif
+};
@@ -0,0 +1,34 @@
+#include "PixelConversion.hpp"
+
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+    #define PIXEL_CONVERSION_SSE2
+    #include <emmintrin.h>
+#endif
+
+void ExpandR8ToR8G8B8A8(const uint8_t* pSrc, uint8_t* pDst, size_t pixelCount)
+{
+    size_t pixelIdx = 0u;
+
+#ifdef PIXEL_CONVERSION_SSE2
+    for (; pixelIdx + 16u <= pixelCount; pixelIdx += 16u) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i*)(pSrc + pixelIdx));
+
+        // Interleaving the bytes with themselves twice repeats each byte four times
+        const __m128i pairsLow  = _mm_unpacklo_epi8(pixels, pixels);
+        const __m128i pairsHigh = _mm_unpackhi_epi8(pixels, pixels);
+
+        __m128i* pDstPixels = (__m128i*)(pDst + pixelIdx * 4u);
+        _mm_storeu_si128(pDstPixels,      _mm_unpacklo_epi16(pairsLow, pairsLow));
+        _mm_storeu_si128(pDstPixels + 1,  _mm_unpackhi_epi16(pairsLow, pairsLow));
+        _mm_storeu_si128(pDstPixels + 2,  _mm_unpacklo_epi16(pairsHigh, pairsHigh));
+        _mm_storeu_si128(pDstPixels + 3,  _mm_unpackhi_epi16(pairsHigh, pairsHigh));
+    }
+#endif
+
+    for (; pixelIdx < pixelCount; pixelIdx += 1u) {
+        const uint32_t pixel = pSrc[pixelIdx] * 0x01010101u;
+        std::memcpy(pDst + pixelIdx * 4u, &pixel, sizeof(uint32_t));
+    }
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*  Expands single channel pixels into R8G8B8A8 pixels by copying each byte into all four channels. The destination
+    holds pixelCount * 4 bytes. Sixteen pixels are expanded at a time using SSE2 unpacks where available. */
+void ExpandR8ToR8G8B8A8(const uint8_t* pSrc, uint8_t* pDst, size_t pixelCount);
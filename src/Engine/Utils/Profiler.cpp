@@ -0,0 +1,146 @@
+#include "Profiler.hpp"
+
+#include <Engine/Utils/Logger.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define PROFILER_RDTSC
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
+Profiler Profiler::s_Instance;
+
+namespace
+{
+    // Writes the string as a JSON string, zone names are expected to be plain but are escaped regardless
+    void WriteJSONString(std::ofstream& file, const char* pString)
+    {
+        file.put('"');
+        for (const char* pChar = pString; *pChar; pChar++) {
+            if (*pChar == '"' || *pChar == '\\') {
+                file.put('\\');
+            }
+
+            file.put((unsigned char)*pChar < 0x20u ? ' ' : *pChar);
+        }
+
+        file.put('"');
+    }
+}
+
+Profiler::Profiler()
+    :m_Enabled(false),
+    m_EnableTimestamp(0u)
+{}
+
+void Profiler::SetEnabled(bool enabled)
+{
+    if (enabled && !IsEnabled()) {
+        m_MainThreadID = std::this_thread::get_id();
+        m_EnableTimestamp = GetTimestamp();
+        m_EnableTime = std::chrono::steady_clock::now();
+    }
+
+    m_Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::RecordZone(const char* pName, uint64_t start, uint64_t end)
+{
+    // Registers the thread the first time it records a zone
+    thread_local ThreadProfile* t_pThreadProfile = RegisterThread();
+
+    // Only the owning thread writes to its ring buffer, the count is published for exporting threads
+    const uint64_t eventCount = t_pThreadProfile->EventCount.load(std::memory_order_relaxed);
+    t_pThreadProfile->Events[eventCount % PROFILER_RING_EVENTS] = { pName, start, end };
+    t_pThreadProfile->EventCount.store(eventCount + 1u, std::memory_order_release);
+}
+
+bool Profiler::WriteChromeTrace(const std::string& filePath) const
+{
+    std::ofstream traceFile(filePath, std::fstream::out | std::fstream::trunc);
+    if (!traceFile.is_open()) {
+        LOG_WARNINGF("Failed to open trace file: %s", filePath.c_str());
+        return false;
+    }
+
+    const double ticksPerMicrosecond = GetTicksPerMicrosecond();
+    const uint64_t firstTimestamp = m_EnableTimestamp;
+
+    std::scoped_lock<std::mutex> lock(m_ThreadProfilesLock);
+
+    // Complete events ("X") with times in microseconds, and a metadata event naming each thread
+    traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    traceFile << std::fixed;
+    traceFile.precision(3);
+
+    bool isFirstEvent = true;
+    for (const std::unique_ptr<ThreadProfile>& pThreadProfile : m_ThreadProfiles) {
+        const uint32_t threadIndex = pThreadProfile->ThreadIndex;
+        const std::string threadName = pThreadProfile->ThreadID == m_MainThreadID ? "Main thread" : "Worker " + std::to_string(threadIndex);
+
+        traceFile << (isFirstEvent ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadIndex
+            << ",\"args\":{\"name\":\"" << threadName << "\"}}";
+        isFirstEvent = false;
+
+        const uint64_t eventCount = pThreadProfile->EventCount.load(std::memory_order_acquire);
+        const uint64_t firstEvent = eventCount - std::min<uint64_t>(eventCount, PROFILER_RING_EVENTS);
+
+        for (uint64_t eventIdx = firstEvent; eventIdx < eventCount; eventIdx++) {
+            const ProfileEvent& event = pThreadProfile->Events[eventIdx % PROFILER_RING_EVENTS];
+            // Zones started before the profiler was enabled have no meaningful start time
+            if (event.Start < firstTimestamp) {
+                continue;
+            }
+
+            traceFile << ",\n{\"name\":";
+            WriteJSONString(traceFile, event.pName);
+            traceFile << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << threadIndex
+                << ",\"ts\":" << double(event.Start - firstTimestamp) / ticksPerMicrosecond
+                << ",\"dur\":" << double(event.End - event.Start) / ticksPerMicrosecond << "}";
+        }
+    }
+
+    traceFile << "\n]}\n";
+
+    LOG_INFOF("Wrote profiler trace of %d threads to %s", (int)m_ThreadProfiles.size(), filePath.c_str());
+    return traceFile.good();
+}
+
+uint64_t Profiler::GetTimestamp()
+{
+    #ifdef PROFILER_RDTSC
+        return __rdtsc();
+    #else
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+}
+
+Profiler::ThreadProfile* Profiler::RegisterThread()
+{
+    std::unique_ptr<ThreadProfile> pThreadProfile = std::make_unique<ThreadProfile>();
+    pThreadProfile->ThreadID = std::this_thread::get_id();
+    pThreadProfile->Events.resize(PROFILER_RING_EVENTS);
+    pThreadProfile->EventCount = 0u;
+
+    std::scoped_lock<std::mutex> lock(m_ThreadProfilesLock);
+    pThreadProfile->ThreadIndex = (uint32_t)m_ThreadProfiles.size();
+    m_ThreadProfiles.push_back(std::move(pThreadProfile));
+    return m_ThreadProfiles.back().get();
+}
+
+double Profiler::GetTicksPerMicrosecond() const
+{
+    #ifdef PROFILER_RDTSC
+        const std::chrono::duration<double, std::micro> enabledTime = std::chrono::steady_clock::now() - m_EnableTime;
+        const uint64_t enabledTicks = GetTimestamp() - m_EnableTimestamp;
+        return enabledTime.count() > 0.0 ? double(enabledTicks) / enabledTime.count() : 1.0;
+    #else
+        return 1000.0;
+    #endif
+}
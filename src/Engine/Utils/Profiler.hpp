@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Zones recorded per thread before the oldest ones are overwritten
+#define PROFILER_RING_EVENTS 65536u
+
+struct ProfileEvent {
+    // Zone names are not copied, they must outlive the profiler, e.g. string literals or system names
+    const char* pName;
+    uint64_t Start;
+    uint64_t End;
+};
+
+/*  Records timed zones into a ring buffer per thread, which threads register the first time they record a zone. Recording
+    only takes timestamps and writes to the thread's own ring buffer, and does nothing while the profiler is disabled.
+    Timestamps are read from the CPU's time stamp counter where available, and converted to time when exporting. */
+class Profiler
+{
+public:
+    Profiler();
+    ~Profiler() = default;
+
+    Profiler(const Profiler& other) = delete;
+    void operator=(const Profiler& other) = delete;
+
+    static Profiler& GetInstance() { return s_Instance; }
+
+    // The thread enabling the profiler is named the main thread in exported traces
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+    void RecordZone(const char* pName, uint64_t start, uint64_t end);
+
+    /*  Writes the recorded zones in Chrome's trace event format, which chrome://tracing and Perfetto open. Zones recorded
+        while exporting might be missing, export between frames. */
+    bool WriteChromeTrace(const std::string& filePath) const;
+
+    static uint64_t GetTimestamp();
+
+private:
+    struct ThreadProfile {
+        std::thread::id ThreadID;
+        uint32_t ThreadIndex;
+        std::vector<ProfileEvent> Events;
+        // Amount of zones recorded by the thread, the latest zone is at (EventCount - 1) % PROFILER_RING_EVENTS
+        std::atomic_uint64_t EventCount;
+    };
+
+private:
+    ThreadProfile* RegisterThread();
+    // Timestamp ticks per microsecond, measured over the time the profiler has been enabled
+    double GetTicksPerMicrosecond() const;
+
+private:
+    static Profiler s_Instance;
+
+    std::atomic_bool m_Enabled;
+    std::thread::id m_MainThreadID;
+
+    std::vector<std::unique_ptr<ThreadProfile>> m_ThreadProfiles;
+    mutable std::mutex m_ThreadProfilesLock;
+
+    // Used to convert timestamps to time
+    uint64_t m_EnableTimestamp;
+    std::chrono::steady_clock::time_point m_EnableTime;
+};
+
+// Records the time from the zone's construction to its destruction
+class ProfileZone
+{
+public:
+    ProfileZone(const char* pName)
+        :m_pName(pName),
+        m_Start(Profiler::GetInstance().IsEnabled() ? Profiler::GetTimestamp() : 0u)
+    {}
+
+    ~ProfileZone()
+    {
+        if (m_Start != 0u) {
+            Profiler::GetInstance().RecordZone(m_pName, m_Start, Profiler::GetTimestamp());
+        }
+    }
+
+    ProfileZone(const ProfileZone& other) = delete;
+    void operator=(const ProfileZone& other) = delete;
+
+private:
+    const char* m_pName;
+    uint64_t m_Start;
+};
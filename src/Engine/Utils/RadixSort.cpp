@@ -0,0 +1,114 @@
+#include "RadixSort.hpp"
+
+#include <Engine/Utils/ThreadPool.hpp>
+
+#include <algorithm>
+#include <array>
+
+#define RADIX_DIGIT_BITS    8u
+#define RADIX_BUCKET_COUNT  (1u << RADIX_DIGIT_BITS)
+#define RADIX_PASS_COUNT    (sizeof(uint64_t) * 8u / RADIX_DIGIT_BITS)
+
+using RadixHistogram = std::array<uint32_t, RADIX_BUCKET_COUNT>;
+
+static inline uint32_t GetDigit(uint64_t key, uint32_t pass)
+{
+    return uint32_t(key >> (pass * RADIX_DIGIT_BITS)) & (RADIX_BUCKET_COUNT - 1u);
+}
+
+/*  Executes chunkFunction once per chunk, on the calling thread and the thread pool. Sorts run within jobs on the pool,
+    e.g. when recording command buckets, so the chunks are spread using the nest-safe ParallelFor. */
+static void ExecuteChunks(uint32_t chunkCount, const std::function<void(uint32_t)>& chunkFunction)
+{
+    ThreadPool::GetInstance().ParallelFor(chunkCount, [&chunkFunction](size_t chunkIdx) {
+        chunkFunction((uint32_t)chunkIdx);
+    });
+}
+
+void RadixSort(std::vector<SortPair>& pairs, std::vector<SortPair>& scratch)
+{
+    const size_t pairCount = pairs.size();
+    if (pairCount < 2u) {
+        return;
+    }
+
+    scratch.resize(pairCount);
+
+    const uint32_t threadCount = std::max(1u, (uint32_t)ThreadPool::GetInstance().GetThreadCount());
+    const uint32_t chunkCount = pairCount < RADIX_SORT_PARALLEL_THRESHOLD ? 1u :
+        std::min(threadCount, uint32_t(pairCount / (RADIX_SORT_PARALLEL_THRESHOLD / 2u)));
+    const size_t chunkSize = (pairCount + chunkCount - 1u) / chunkCount;
+
+    // Count digit occurrences for every pass in a single read, used to skip passes where all keys share a digit
+    std::vector<std::array<RadixHistogram, RADIX_PASS_COUNT>> passHistograms(chunkCount);
+    ExecuteChunks(chunkCount, [&](uint32_t chunkIdx) {
+        std::array<RadixHistogram, RADIX_PASS_COUNT>& histograms = passHistograms[chunkIdx];
+        for (RadixHistogram& histogram : histograms) {
+            histogram.fill(0u);
+        }
+
+        const size_t chunkEnd = std::min(pairCount, (chunkIdx + 1u) * chunkSize);
+        for (size_t pairIdx = chunkIdx * chunkSize; pairIdx < chunkEnd; pairIdx++) {
+            const uint64_t key = pairs[pairIdx].Key;
+            for (uint32_t pass = 0u; pass < RADIX_PASS_COUNT; pass++) {
+                histograms[pass][GetDigit(key, pass)] += 1u;
+            }
+        }
+    });
+
+    std::vector<RadixHistogram> chunkHistograms(chunkCount);
+    std::vector<RadixHistogram> chunkOffsets(chunkCount);
+
+    SortPair* pSrc = pairs.data();
+    SortPair* pDst = scratch.data();
+
+    for (uint32_t pass = 0u; pass < RADIX_PASS_COUNT; pass++) {
+        // Skip the pass if every key has the same digit
+        const uint32_t firstDigit = GetDigit(pSrc[0].Key, pass);
+        uint32_t firstDigitCount = 0u;
+        for (const std::array<RadixHistogram, RADIX_PASS_COUNT>& histograms : passHistograms) {
+            firstDigitCount += histograms[pass][firstDigit];
+        }
+
+        if (firstDigitCount == pairCount) {
+            continue;
+        }
+
+        // The pairs have been moved by previous passes, so each chunk's histogram has to be recounted
+        ExecuteChunks(chunkCount, [&](uint32_t chunkIdx) {
+            RadixHistogram& histogram = chunkHistograms[chunkIdx];
+            histogram.fill(0u);
+
+            const size_t chunkEnd = std::min(pairCount, (chunkIdx + 1u) * chunkSize);
+            for (size_t pairIdx = chunkIdx * chunkSize; pairIdx < chunkEnd; pairIdx++) {
+                histogram[GetDigit(pSrc[pairIdx].Key, pass)] += 1u;
+            }
+        });
+
+        // Calculate where each chunk writes each digit. Chunks write in order within a digit to keep the sort stable.
+        uint32_t offset = 0u;
+        for (uint32_t digit = 0u; digit < RADIX_BUCKET_COUNT; digit++) {
+            for (uint32_t chunkIdx = 0u; chunkIdx < chunkCount; chunkIdx++) {
+                chunkOffsets[chunkIdx][digit] = offset;
+                offset += chunkHistograms[chunkIdx][digit];
+            }
+        }
+
+        ExecuteChunks(chunkCount, [&](uint32_t chunkIdx) {
+            RadixHistogram& offsets = chunkOffsets[chunkIdx];
+
+            const size_t chunkEnd = std::min(pairCount, (chunkIdx + 1u) * chunkSize);
+            for (size_t pairIdx = chunkIdx * chunkSize; pairIdx < chunkEnd; pairIdx++) {
+                const SortPair& pair = pSrc[pairIdx];
+                pDst[offsets[GetDigit(pair.Key, pass)]++] = pair;
+            }
+        });
+
+        std::swap(pSrc, pDst);
+    }
+
+    if (pSrc != pairs.data()) {
+        // An odd amount of passes were performed, the sorted pairs are in the scratch buffer
+        pairs.swap(scratch);
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+struct SortPair {
+    uint64_t Key;
+    uint32_t Value;
+};
+
+// Inputs smaller than this are sorted on the calling thread only
+#define RADIX_SORT_PARALLEL_THRESHOLD 8192u
+
+/*  Sorts key-value pairs by their keys in ascending order. The sort is a stable LSD radix sort using 8-bit digits.
+    Passes where every key shares the same digit are skipped. Large inputs are split into chunks that are histogrammed
+    and scattered in parallel using the thread pool. The scratch vector is used as a ping-pong buffer, keeping it
+    between calls avoids reallocations. */
+void RadixSort(std::vector<SortPair>& pairs, std::vector<SortPair>& scratch);
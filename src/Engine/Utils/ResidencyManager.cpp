@@ -0,0 +1,101 @@
+#include "ResidencyManager.hpp"
+
+ResidencyManager::ResidencyManager(size_t budgetBytes)
+    :m_TrackedBytes(0u),
+    m_BudgetBytes(budgetBytes),
+    m_MightHaveReleasedAssets(true),
+    m_Hits(0u),
+    m_Misses(0u),
+    m_Evictions(0u)
+{}
+
+void ResidencyManager::Touch(const std::shared_ptr<void>& asset, size_t byteSize)
+{
+    std::vector<std::shared_ptr<void>> evictedAssets;
+
+    {
+        std::scoped_lock<std::mutex> lock(m_Lock);
+
+        auto entryItr = m_Entries.find(asset.get());
+        if (entryItr != m_Entries.end()) {
+            m_LRU.splice(m_LRU.begin(), m_LRU, entryItr->second);
+            return;
+        }
+
+        m_LRU.push_front({ asset, byteSize });
+        m_Entries[asset.get()] = m_LRU.begin();
+        m_TrackedBytes += byteSize;
+
+        if (m_TrackedBytes > m_BudgetBytes && m_MightHaveReleasedAssets) {
+            evictedAssets = EvictReleasedAssets();
+        }
+    }
+
+    // Destroying the evicted assets might release further assets, e.g. a model's textures
+    evictedAssets.clear();
+}
+
+void ResidencyManager::Trim()
+{
+    std::vector<std::shared_ptr<void>> evictedAssets;
+
+    {
+        std::scoped_lock<std::mutex> lock(m_Lock);
+        if (m_TrackedBytes > m_BudgetBytes) {
+            evictedAssets = EvictReleasedAssets();
+        }
+    }
+
+    // Assets released by destroying the evicted assets are evicted by the next trim
+    evictedAssets.clear();
+}
+
+void ResidencyManager::RecordHit()
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+    m_Hits += 1u;
+}
+
+void ResidencyManager::RecordMiss()
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+    m_Misses += 1u;
+}
+
+ResidencyStats ResidencyManager::GetStats()
+{
+    std::scoped_lock<std::mutex> lock(m_Lock);
+    return {
+        .Hits           = m_Hits,
+        .Misses         = m_Misses,
+        .Evictions      = m_Evictions,
+        .TrackedBytes   = m_TrackedBytes,
+        .BudgetBytes    = m_BudgetBytes
+    };
+}
+
+std::vector<std::shared_ptr<void>> ResidencyManager::EvictReleasedAssets()
+{
+    std::vector<std::shared_ptr<void>> evictedAssets;
+
+    // Walks from the least recently used asset towards the front, leaving assets in use where they are
+    auto assetItr = m_LRU.end();
+    while (assetItr != m_LRU.begin() && m_TrackedBytes > m_BudgetBytes) {
+        --assetItr;
+
+        // Only the manager holds released assets
+        if (assetItr->Asset.use_count() > 1) {
+            continue;
+        }
+
+        m_TrackedBytes -= assetItr->ByteSize;
+        m_Evictions += 1u;
+        m_Entries.erase(assetItr->Asset.get());
+
+        evictedAssets.push_back(std::move(assetItr->Asset));
+        assetItr = m_LRU.erase(assetItr);
+    }
+
+    m_MightHaveReleasedAssets = m_TrackedBytes <= m_BudgetBytes;
+    return evictedAssets;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct ResidencyStats {
+    // Requests served by loaded or loading assets, and requests that had to load the asset
+    uint64_t Hits;
+    uint64_t Misses;
+    // Released assets freed to stay within the budget
+    uint64_t Evictions;
+    // Bytes of every tracked asset, including assets in use
+    size_t TrackedBytes;
+    size_t BudgetBytes;
+};
+
+/*  Keeps recently used assets alive in an LRU list, so that assets released by every user are not reloaded should they
+    be requested again shortly after. While the tracked assets exceed the memory budget, the least recently used assets
+    that are no longer in use are evicted. Assets still in use are never freed by the manager. Releasing an asset is not
+    observed by the manager, so Trim() is called each frame to evict assets released while over budget. */
+class ResidencyManager
+{
+public:
+    ResidencyManager(size_t budgetBytes);
+    ~ResidencyManager() = default;
+
+    /*  Moves the asset to the front of the LRU list, and evicts released assets while over budget. Skips evicting if the
+        latest scan found every asset in use. */
+    void Touch(const std::shared_ptr<void>& asset, size_t byteSize);
+    // Evicts released assets while over budget
+    void Trim();
+
+    void RecordHit();
+    void RecordMiss();
+
+    ResidencyStats GetStats();
+
+private:
+    struct ResidentAsset {
+        std::shared_ptr<void> Asset;
+        size_t ByteSize;
+    };
+
+private:
+    /*  Returns the evicted assets, which are released by the caller after unlocking. m_Lock has to be held. Assets in use
+        keep their place in the LRU list, which only reflects when assets were last requested. */
+    std::vector<std::shared_ptr<void>> EvictReleasedAssets();
+
+private:
+    // Most recently used first
+    std::list<ResidentAsset> m_LRU;
+    std::unordered_map<const void*, std::list<ResidentAsset>::iterator> m_Entries;
+
+    size_t m_TrackedBytes;
+    size_t m_BudgetBytes;
+    /*  Cleared when a scan found every asset in use while over budget. Inserting assets then skips scanning, as only
+        releases make assets evictable, and Trim() scans regardless. */
+    bool m_MightHaveReleasedAssets;
+
+    uint64_t m_Hits;
+    uint64_t m_Misses;
+    uint64_t m_Evictions;
+
+    std::mutex m_Lock;
+};
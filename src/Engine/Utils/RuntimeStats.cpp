@@ -1,26 +1,153 @@
 #include "RuntimeStats.hpp"
 
 #include <algorithm>
+#include <bit>
+#include <cmath>
 
 #ifdef _WIN32
     #include <Psapi.h>
     #include <Windows.h>
 #endif
 
+FrameTimeHistogram::FrameTimeHistogram()
+    :m_Count(0u)
+{
+    m_Buckets.fill(0u);
+}
+
+void FrameTimeHistogram::record(uint32_t microseconds)
+{
+    m_Buckets[getBucketIndex(microseconds)] += 1u;
+    m_Count += 1u;
+}
+
+uint32_t FrameTimeHistogram::getPercentile(double percentile) const
+{
+    if (m_Count == 0u) {
+        return 0u;
+    }
+
+    // The rank of the frame at the percentile, counting from 1
+    const uint64_t rank = std::max<uint64_t>(1u, (uint64_t)std::ceil(std::clamp(percentile, 0.0, 1.0) * double(m_Count)));
+
+    uint64_t cumulativeCount = 0u;
+    for (uint32_t bucketIdx = 0u; bucketIdx < FRAME_HISTOGRAM_BUCKETS; bucketIdx++) {
+        cumulativeCount += m_Buckets[bucketIdx];
+        if (cumulativeCount >= rank) {
+            const uint32_t lowerBound = getBucketLowerBound(bucketIdx);
+            return lowerBound + (getBucketUpperBound(bucketIdx) - lowerBound) / 2u;
+        }
+    }
+
+    return getBucketUpperBound(FRAME_HISTOGRAM_BUCKETS - 1u);
+}
+
+uint32_t FrameTimeHistogram::getBucketUpperBound(uint32_t bucketIdx)
+{
+    if (bucketIdx < FRAME_HISTOGRAM_SUB_BUCKETS) {
+        return bucketIdx;
+    }
+
+    const uint32_t shift = bucketIdx / FRAME_HISTOGRAM_SUB_BUCKETS - 1u;
+    return uint32_t(uint64_t(getBucketLowerBound(bucketIdx)) + (1ull << shift) - 1u);
+}
+
+uint32_t FrameTimeHistogram::getBucketIndex(uint32_t microseconds)
+{
+    if (microseconds < FRAME_HISTOGRAM_SUB_BUCKETS) {
+        return microseconds;
+    }
+
+    // The sub-bucket is given by the bits following the most significant bit
+    const uint32_t shift = (uint32_t)std::bit_width(microseconds) - 1u - FRAME_HISTOGRAM_SUB_BUCKET_BITS;
+    const uint32_t subBucket = (microseconds >> shift) - FRAME_HISTOGRAM_SUB_BUCKETS;
+    return (shift + 1u) * FRAME_HISTOGRAM_SUB_BUCKETS + subBucket;
+}
+
+uint32_t FrameTimeHistogram::getBucketLowerBound(uint32_t bucketIdx)
+{
+    if (bucketIdx < FRAME_HISTOGRAM_SUB_BUCKETS) {
+        return bucketIdx;
+    }
+
+    const uint32_t shift = bucketIdx / FRAME_HISTOGRAM_SUB_BUCKETS - 1u;
+    const uint32_t subBucket = bucketIdx % FRAME_HISTOGRAM_SUB_BUCKETS;
+    return (FRAME_HISTOGRAM_SUB_BUCKETS + subBucket) << shift;
+}
+
 RuntimeStats::RuntimeStats()
     :m_FrameCount(0u),
-    m_AverageFrametime(0.0f)
-{}
+    m_AverageFrametime(0.0f),
+    m_StartupTime(0.0f),
+    m_PipelineWaitTime(0.0f),
+    m_MaxFrameTime(0.0f),
+    m_FrameSeconds(FRAME_TIME_SERIES_SECONDS, { 0u, 0.0f }),
+    m_SecondCount(0u),
+    m_SecondTime(0.0f)
+{
+    // Two, three and six missed refreshes at 60 Hz
+    setHitchThresholds({ 1.0f / 30.0f, 1.0f / 20.0f, 1.0f / 10.0f });
+}
 
 void RuntimeStats::setFrameTime(float frameTime)
 {
     if (m_FrameCount) {
         m_AverageFrametime = m_AverageFrametime + (frameTime - m_AverageFrametime) / m_FrameCount;
+
+        const double microseconds = std::clamp(double(frameTime) * 1000000.0, 0.0, double(UINT32_MAX));
+        m_FrameTimeHistogram.record((uint32_t)microseconds);
+        m_MaxFrameTime = std::max(m_MaxFrameTime, frameTime);
+
+        for (size_t thresholdIdx = 0u; thresholdIdx < m_HitchThresholds.size(); thresholdIdx++) {
+            m_HitchCounts[thresholdIdx] += frameTime > m_HitchThresholds[thresholdIdx];
+        }
+
+        // Frames belong to the second they end in. Seconds passed without frames, e.g. during a long hitch, are left empty.
+        m_SecondTime += frameTime;
+        if (m_SecondTime >= 1.0f) {
+            const uint64_t elapsedSeconds = (uint64_t)m_SecondTime;
+            const uint64_t clearedSeconds = std::min<uint64_t>(elapsedSeconds, FRAME_TIME_SERIES_SECONDS);
+            for (uint64_t secondIdx = 1u; secondIdx <= clearedSeconds; secondIdx++) {
+                m_FrameSeconds[(m_SecondCount + secondIdx) % FRAME_TIME_SERIES_SECONDS] = { 0u, 0.0f };
+            }
+
+            m_SecondCount += elapsedSeconds;
+            m_SecondTime -= float(elapsedSeconds);
+        }
+
+        FrameSecond& frameSecond = m_FrameSeconds[m_SecondCount % FRAME_TIME_SERIES_SECONDS];
+        frameSecond.FrameCount += 1u;
+        frameSecond.MaxFrameTime = std::max(frameSecond.MaxFrameTime, frameTime);
     }
 
     m_FrameCount += 1;
 }
 
+void RuntimeStats::setHitchThresholds(const std::vector<float>& hitchThresholds)
+{
+    m_HitchThresholds = hitchThresholds;
+    m_HitchCounts.assign(m_HitchThresholds.size(), 0u);
+}
+
+float RuntimeStats::getFrameTimePercentile(double percentile) const
+{
+    return float(m_FrameTimeHistogram.getPercentile(percentile)) / 1000000.0f;
+}
+
+std::vector<FrameSecond> RuntimeStats::getFrameTimeSeries() const
+{
+    // The second being accumulated occupies a slot of the ring buffer
+    const uint64_t keptSeconds = std::min<uint64_t>(m_SecondCount, FRAME_TIME_SERIES_SECONDS - 1u);
+
+    std::vector<FrameSecond> frameSeconds;
+    frameSeconds.reserve((size_t)keptSeconds);
+    for (uint64_t secondIdx = m_SecondCount - keptSeconds; secondIdx < m_SecondCount; secondIdx++) {
+        frameSeconds.push_back(m_FrameSeconds[secondIdx % FRAME_TIME_SERIES_SECONDS]);
+    }
+
+    return frameSeconds;
+}
+
 size_t RuntimeStats::getPeakMemoryUsage()
 {
     #ifdef _WIN32
@@ -1,7 +1,51 @@
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <stdint.h>
+#include <vector>
+
+// Linear sub-buckets per power of two in the frame time histogram, which bounds the error of percentiles to 1/128
+#define FRAME_HISTOGRAM_SUB_BUCKET_BITS 6u
+#define FRAME_HISTOGRAM_SUB_BUCKETS (1u << FRAME_HISTOGRAM_SUB_BUCKET_BITS)
+// Covers frame times up to 2^32 microseconds. Times below the sub-bucket count are stored exactly.
+#define FRAME_HISTOGRAM_BUCKETS (FRAME_HISTOGRAM_SUB_BUCKETS * (33u - FRAME_HISTOGRAM_SUB_BUCKET_BITS))
+// Seconds of frame statistics kept in the time series, the oldest seconds are overwritten
+#define FRAME_TIME_SERIES_SECONDS 3600u
+
+/*  Counts frame times in microseconds using log-linear buckets, as in HDR histograms: each power of two is split into
+    equally sized sub-buckets. Recording is a few bit operations and an increment, and the memory is fixed. */
+class FrameTimeHistogram
+{
+public:
+    FrameTimeHistogram();
+    ~FrameTimeHistogram() = default;
+
+    void record(uint32_t microseconds);
+
+    // Percentile is in [0, 1]. Returns the midpoint of the bucket containing the percentile, in microseconds.
+    uint32_t getPercentile(double percentile) const;
+    uint64_t getCount() const { return m_Count; }
+
+    uint32_t getBucketCount(uint32_t bucketIdx) const { return m_Buckets[bucketIdx]; }
+    // The highest time counted by the bucket, in microseconds
+    static uint32_t getBucketUpperBound(uint32_t bucketIdx);
+
+private:
+    static uint32_t getBucketIndex(uint32_t microseconds);
+    static uint32_t getBucketLowerBound(uint32_t bucketIdx);
+
+private:
+    std::array<uint32_t, FRAME_HISTOGRAM_BUCKETS> m_Buckets;
+    uint64_t m_Count;
+};
+
+// The frames that ended during a second of the time series
+struct FrameSecond {
+    uint32_t FrameCount;
+    // In seconds
+    float MaxFrameTime;
+};
 
 class RuntimeStats
 {
@@ -9,12 +53,48 @@ public:
     RuntimeStats();
     ~RuntimeStats() = default;
 
+    // Frame time is in seconds. Performs no allocations.
     void setFrameTime(float frameTime);
+    // Milliseconds from the start of initialization until the first frame was submitted
+    void setStartupTime(float startupTime)                  { m_StartupTime = startupTime; }
+    // Milliseconds initialization spent waiting for pipelines to compile
+    void setPipelineWaitTime(float pipelineWaitTime)        { m_PipelineWaitTime = pipelineWaitTime; }
+    // Frames longer than a threshold are counted as hitches of that threshold. In seconds, resets the hitch counts.
+    void setHitchThresholds(const std::vector<float>& hitchThresholds);
 
     float getAverageFrametime() const { return m_AverageFrametime; }
+    float getStartupTime() const { return m_StartupTime; }
+    float getPipelineWaitTime() const { return m_PipelineWaitTime; }
     static size_t getPeakMemoryUsage();
 
+    // Percentile is in [0, 1], the frame time is in seconds
+    float getFrameTimePercentile(double percentile) const;
+    float getMaxFrameTime() const { return m_MaxFrameTime; }
+    const FrameTimeHistogram& getFrameTimeHistogram() const { return m_FrameTimeHistogram; }
+
+    const std::vector<float>& getHitchThresholds() const    { return m_HitchThresholds; }
+    // The amount of frames longer than each hitch threshold
+    const std::vector<uint32_t>& getHitchCounts() const     { return m_HitchCounts; }
+
+    // The completed seconds of the time series, oldest first
+    std::vector<FrameSecond> getFrameTimeSeries() const;
+
 private:
     uint64_t m_FrameCount;
     float m_AverageFrametime;
+    float m_StartupTime;
+    float m_PipelineWaitTime;
+
+    // The distribution excludes the first frame, as does the average
+    FrameTimeHistogram m_FrameTimeHistogram;
+    float m_MaxFrameTime;
+
+    std::vector<float> m_HitchThresholds;
+    std::vector<uint32_t> m_HitchCounts;
+
+    // Ring buffer of FRAME_TIME_SERIES_SECONDS seconds, the second being accumulated is at m_SecondCount
+    std::vector<FrameSecond> m_FrameSeconds;
+    uint64_t m_SecondCount;
+    // Time elapsed of the second being accumulated
+    float m_SecondTime;
 };
@@ -1,5 +1,11 @@
 #include "ThreadPool.hpp"
 
+#include <Engine/Utils/Debug.hpp>
+#include <Engine/Utils/Logger.hpp>
+
+#include <algorithm>
+#include <memory>
+
 ThreadPool ThreadPool::s_Instance;
 
 ThreadPool::ThreadPool()
@@ -95,6 +101,50 @@ void ThreadPool::JoinAll()
     m_JobsExist.wait(uLock, [this]{ return m_Jobs.empty() && m_FreeJoinResourcesIndices.size() == m_JoinResources.size(); });
 }
 
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& job)
+{
+    struct ParallelForState {
+        std::atomic_size_t NextIndex;
+        std::atomic_size_t FinishedCount;
+        std::mutex Mutex;
+        std::condition_variable CondVar;
+    };
+
+    const size_t helperCount = std::min(m_Threads.size(), count > 0u ? count - 1u : 0u);
+    if (helperCount == 0u) {
+        for (size_t index = 0u; index < count; index += 1u) {
+            job(index);
+        }
+
+        return;
+    }
+
+    // Helpers that start after every index is claimed return right away, the shared state outlives the call for their sake
+    std::shared_ptr<ParallelForState> pState = std::make_shared<ParallelForState>();
+    pState->NextIndex       = 0u;
+    pState->FinishedCount   = 0u;
+
+    const auto workOnIndices = [pState, count, &job]() {
+        for (size_t index = pState->NextIndex++; index < count; index = pState->NextIndex++) {
+            job(index);
+
+            if (++pState->FinishedCount == count) {
+                std::scoped_lock<std::mutex> lock(pState->Mutex);
+                pState->CondVar.notify_all();
+            }
+        }
+    };
+
+    for (size_t helperIdx = 0u; helperIdx < helperCount; helperIdx += 1u) {
+        ExecuteDetached(workOnIndices);
+    }
+
+    workOnIndices();
+
+    std::unique_lock<std::mutex> uLock(pState->Mutex);
+    pState->CondVar.wait(uLock, [&pState, count]{ return pState->FinishedCount == count; });
+}
+
 void ThreadPool::WaitForJob()
 {
     std::unique_lock<std::mutex> uLock(m_ScheduleLock);
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <mutex>
+#include <queue>
 #include <thread>
 #include <vector>
 
@@ -42,6 +45,11 @@ public:
     void Join(size_t joinResourcesIndex);
     void JoinAll();
 
+    /*  Calls the job once per index in [0, count), spread across the calling thread and the pool's threads. The calling
+        thread works through the indices as well and only waits for indices already being worked on, which makes it safe
+        to call from jobs running on the pool. */
+    void ParallelFor(size_t count, const std::function<void(size_t)>& job);
+
     size_t GetThreadCount() const { return m_Threads.size(); }
 
 private:
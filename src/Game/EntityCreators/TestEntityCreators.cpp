@@ -15,7 +15,7 @@ Entity CreateMusicCubeEntity(const DirectX::XMFLOAT3& position, const std::strin
 
     EngineCore* pEngineCore = EngineCore::GetInstance();
     AssetLoadersCore* pAssetLoaders = pEngineCore->GetAssetLoadersCore();
-    pECS->AddComponent(cubeEntity, pAssetLoaders->GetModelLoader()->LoadModel("./assets/Models/Cube.dae"));
+    pAssetLoaders->GetModelLoader()->LoadModelAsync("./assets/Models/Cube.dae", cubeEntity);
 
     // Attach sound to the cube
     AudioCore* pAudioCore = pEngineCore->GetAudioCore();
@@ -34,7 +34,7 @@ Entity CreateMusicPointLightEntity(const DirectX::XMFLOAT3& position, const Dire
 
     EngineCore* pEngineCore = EngineCore::GetInstance();
     AssetLoadersCore* pAssetLoaders = pEngineCore->GetAssetLoadersCore();
-    pECS->AddComponent(entity, pAssetLoaders->GetModelLoader()->LoadModel("./assets/Models/Cube.dae"));
+    pAssetLoaders->GetModelLoader()->LoadModelAsync("./assets/Models/Cube.dae", entity);
 
     // Attach sound to the cube
     AudioCore* pAudioCore = pEngineCore->GetAudioCore();
@@ -5,12 +5,64 @@
 
 #include <argh/argh.h>
 
+#include <sstream>
+
 bool Game::Finalize(const argh::parser& flagParser)
 {
     State* pStartingState = nullptr;
 
     if (flagParser[{"-b", "--benchmark"}]) {
-        pStartingState = DBG_NEW BenchmarkState(&m_StateManager, &m_RuntimeStats);
+        // Optionally fill the benchmark scene with extra renderables, e.g. --renderables=20000 --churn=100
+        BenchmarkSettings benchmarkSettings = {};
+        flagParser({"--renderables"}, 0u) >> benchmarkSettings.RenderableCount;
+        flagParser({"--churn"}, 0u) >> benchmarkSettings.ChurnPerFrame;
+        // Optionally measure the time to load meshes and textures, e.g. --uploads=1000
+        flagParser({"--uploads"}, 0u) >> benchmarkSettings.UploadCount;
+        // Optionally measure the time to update uniform buffers each frame, e.g. --uniform-buffers=10000
+        flagParser({"--uniform-buffers"}, 0u) >> benchmarkSettings.UniformBufferCount;
+        // Optionally measure the time to load distinct models synchronously and asynchronously, e.g. --assets=100
+        flagParser({"--assets"}, 0u) >> benchmarkSettings.AssetCount;
+        // Optionally stress test the asset caches' request coalescing from many threads
+        benchmarkSettings.AssetCacheStress = flagParser[{"--cache-stress"}];
+        // Optionally fill the scene with imported high-polygon models to measure LOD selection, e.g. --lod-models=50000
+        flagParser({"--lod-models"}, 0u) >> benchmarkSettings.LODModelCount;
+        // Optionally load procedural 4K textures along with the bundled textures to measure texture load times, e.g. --textures=16
+        flagParser({"--textures"}, 0u) >> benchmarkSettings.TextureCount;
+        // Optionally measure how many changing strings can be rendered per second with and without the glyph atlas, e.g. --text-strings=10000
+        flagParser({"--text-strings"}, 0u) >> benchmarkSettings.TextStringCount;
+        // Optionally spawn textured UI panels to measure the UI renderer's batching, e.g. --panels=5000
+        flagParser({"--panels"}, 0u) >> benchmarkSettings.PanelCount;
+        // Optionally spawn UI buttons to measure the cost of hit testing the mouse, e.g. --buttons=10000
+        flagParser({"--buttons"}, 0u) >> benchmarkSettings.ButtonCount;
+        // Optionally spawn moving sound emitters to measure the CPU time of spatial audio, e.g. --emitters=5000
+        flagParser({"--emitters"}, 0u) >> benchmarkSettings.EmitterCount;
+        // Optionally measure how many voices the software audio mixer can mix per millisecond, e.g. --mixer-voices=1000
+        flagParser({"--mixer-voices"}, 0u) >> benchmarkSettings.MixerVoiceCount;
+        // Optionally spawn static emitters sharing ten sounds to measure the sound cache's memory and load times, e.g. --sound-emitters=1000
+        flagParser({"--sound-emitters"}, 0u) >> benchmarkSettings.SoundEmitterCount;
+        // Optionally play looping sounds to measure the audio CPU time and voice churn of looping, e.g. --looping-sounds=1000
+        flagParser({"--looping-sounds"}, 0u) >> benchmarkSettings.LoopingSoundCount;
+        // Optionally profile the benchmark's frames, writing a trace that chrome://tracing and Perfetto open
+        benchmarkSettings.Profile = flagParser[{"--profile"}];
+        // Optionally replace the engine config's hitch thresholds, in milliseconds, e.g. --hitch-thresholds=16.7,33.3,50
+        std::string hitchThresholdsStr;
+        if (flagParser({"--hitch-thresholds"}) >> hitchThresholdsStr) {
+            std::vector<float> hitchThresholds;
+            std::istringstream thresholdStream(hitchThresholdsStr);
+            std::string thresholdStr;
+            while (std::getline(thresholdStream, thresholdStr, ',')) {
+                const float thresholdMS = std::strtof(thresholdStr.c_str(), nullptr);
+                if (thresholdMS > 0.0f) {
+                    hitchThresholds.push_back(thresholdMS / 1000.0f);
+                } else {
+                    LOG_WARNINGF("Ignoring hitch threshold: %s, thresholds must be positive milliseconds", thresholdStr.c_str());
+                }
+            }
+
+            m_RuntimeStats.setHitchThresholds(hitchThresholds);
+        }
+
+        pStartingState = DBG_NEW BenchmarkState(&m_StateManager, &m_RuntimeStats, m_pRenderingHandler, benchmarkSettings);
     } else {
         pStartingState = DBG_NEW MainMenuState(&m_StateManager);
     }
@@ -2,6 +2,7 @@
 
 #include <Engine/ECS/ECSCore.hpp>
 #include <Engine/Rendering/APIAbstractions/Device.hpp>
+#include <Engine/Rendering/AssetLoaders/MeshOptimizer.hpp>
 #include <Engine/Rendering/AssetLoaders/TextureCache.hpp>
 #include <Engine/Transform.hpp>
 #include <Engine/Utils/Debug.hpp>
@@ -85,7 +86,7 @@ ModelComponent TubeHandler::CreateTube(const std::vector<DirectX::XMFLOAT3>& sec
     }
 
     // Make indices
-    std::vector<unsigned int> indices;
+    std::vector<uint32_t> indices;
     indices.resize(faces * 2 * 3 * (tubePoints.size() - 1)); // Two triangles per face with 3 vertices each
 
 	unsigned startVertexIndex = 0;
@@ -104,6 +105,9 @@ ModelComponent TubeHandler::CreateTube(const std::vector<DirectX::XMFLOAT3>& sec
 		startVertexIndex += 2;
     }
 
+    const MeshOptimizationStats optimizationStats = MeshOptimizer::OptimizeMesh(vertices, indices);
+    MeshOptimizer::LogStats("Tube", optimizationStats);
+
     ModelComponent modelComponent = {
         .ModelPtr = std::shared_ptr<Model>(DBG_NEW Model(), ReleaseModel)
     };
@@ -115,10 +119,19 @@ ModelComponent TubeHandler::CreateTube(const std::vector<DirectX::XMFLOAT3>& sec
     mesh.materialIndex  = 0;
     mesh.vertexCount    = vertices.size();
     mesh.indexCount     = indices.size();
+    mesh.LODs           = { { 0u, (uint32_t)indices.size() } };
 
     EngineCore* pEngineCore = EngineCore::GetInstance();
-    Device* pDevice = pEngineCore->GetRenderingCore()->GetDevice();
-    mesh.pVertexBuffer = pDevice->createVertexBuffer(vertices.data(), sizeof(Vertex), vertices.size());
+    RenderingCore* pRenderingCore = pEngineCore->GetRenderingCore();
+    Device* pDevice = pRenderingCore->GetDevice();
+
+    if (pRenderingCore->IsPackedVerticesEnabled()) {
+        const std::vector<PackedVertex> packedVertices = MeshOptimizer::PackVertices(vertices.data(), vertices.size());
+        mesh.pVertexBuffer = pDevice->createVertexBuffer(packedVertices.data(), sizeof(PackedVertex), packedVertices.size());
+    } else {
+        mesh.pVertexBuffer = pDevice->createVertexBuffer(vertices.data(), sizeof(Vertex), vertices.size());
+    }
+
     if (!mesh.pVertexBuffer) {
         return { };
     }
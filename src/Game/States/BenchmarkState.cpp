@@ -8,24 +8,41 @@
 #include <Engine/Rendering/Components/VPMatrices.hpp>
 #include <Engine/Rendering/Window.hpp>
 #include <Engine/Transform.hpp>
+#include <Engine/Utils/Profiler.hpp>
 #include <Engine/Utils/RuntimeStats.hpp>
 
 #include <Game/EntityCreators/TestEntityCreators.hpp>
+#include <Game/States/Benchmarks/IBenchmarkModule.hpp>
 
 #include <vendor/json/json.hpp>
 
+#include <chrono>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 
-BenchmarkState::BenchmarkState(StateManager* pStateManager, const RuntimeStats* pRuntimeStats)
+BenchmarkState::BenchmarkState(StateManager* pStateManager, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler, const BenchmarkSettings& settings)
     :   State(pStateManager)
     ,   m_pRuntimeStats(pRuntimeStats)
+    ,   m_pRenderingHandler(pRenderingHandler)
+    ,   m_Settings(settings)
+    ,   m_Modules(IBenchmarkModule::CreateModules(settings, pRuntimeStats, pRenderingHandler))
+    ,   m_FrameCount(0u)
+    ,   m_StateLoadTime(0.0f)
     ,   m_RacerController(&m_TubeHandler)
 {}
 
+BenchmarkState::~BenchmarkState()
+{
+    for (IBenchmarkModule* pModule : m_Modules) {
+        delete pModule;
+    }
+}
+
 void BenchmarkState::Init()
 {
     LOG_INFO("Started benchmark");
+    const auto initStart = std::chrono::high_resolution_clock::now();
 
     EngineCore* pEngineCore = EngineCore::GetInstance();
     pEngineCore->GetRenderingCore()->GetWindow()->GetInputHandler()->disable();
@@ -57,9 +74,24 @@ void BenchmarkState::Init()
         CreateMusicCubeEntity(sectionPoint, soundPath);
     }
 
+    for (IBenchmarkModule* pModule : m_Modules) {
+        pModule->Measure();
+    }
+
     CreatePointLights();
     CreateTube(sectionPoints);
     CreatePlayer();
+
+    for (IBenchmarkModule* pModule : m_Modules) {
+        pModule->CreateScene();
+    }
+
+    const std::chrono::duration<float, std::milli> initTime = std::chrono::high_resolution_clock::now() - initStart;
+    m_StateLoadTime = initTime.count();
+    LOG_INFOF("Loaded benchmark state in %.3f ms", m_StateLoadTime);
+
+    // Only the benchmark's frames are profiled
+    Profiler::GetInstance().SetEnabled(m_Settings.Profile);
 }
 
 void BenchmarkState::Resume()
@@ -76,10 +108,22 @@ void BenchmarkState::Update(float dt)
 {
     UNREFERENCED_VARIABLE(dt);
 
+    m_FrameCount += 1u;
+
+    for (IBenchmarkModule* pModule : m_Modules) {
+        pModule->Update(m_FrameCount);
+    }
+
     const TrackPositionComponent& trackPosition = ECSCore::GetInstance()->GetConstComponent<TrackPositionComponent>(m_PlayerEntity);
     if (trackPosition.section == m_TubeHandler.GetTubeSections().size() - 2 && trackPosition.T >= 1.0f) {
         // The end has been reached
         PrintBenchmarkResults();
+        if (m_Settings.Profile) {
+            Profiler& profiler = Profiler::GetInstance();
+            profiler.SetEnabled(false);
+            profiler.WriteChromeTrace("benchmark_trace.json");
+        }
+
         EngineCore::GetInstance()->GetRenderingCore()->GetWindow()->Close();
     }
 }
@@ -167,6 +211,61 @@ void BenchmarkState::PrintBenchmarkResults() const
     json benchmarkResults;
     benchmarkResults["AverageFPS"]      = 1.0f / m_pRuntimeStats->getAverageFrametime();
     benchmarkResults["PeakMemoryUsage"] = float(m_pRuntimeStats->getPeakMemoryUsage() / MB);
+    benchmarkResults["StartupTime"]     = m_pRuntimeStats->getStartupTime();
+    benchmarkResults["PipelineWaitTime"] = m_pRuntimeStats->getPipelineWaitTime();
+
+    // Frame time distribution in milliseconds
+    benchmarkResults["FrameTimeP50"]    = m_pRuntimeStats->getFrameTimePercentile(0.5) * 1000.0f;
+    benchmarkResults["FrameTimeP90"]    = m_pRuntimeStats->getFrameTimePercentile(0.9) * 1000.0f;
+    benchmarkResults["FrameTimeP99"]    = m_pRuntimeStats->getFrameTimePercentile(0.99) * 1000.0f;
+    benchmarkResults["FrameTimeP99.9"]  = m_pRuntimeStats->getFrameTimePercentile(0.999) * 1000.0f;
+    benchmarkResults["MaxFrameTime"]    = m_pRuntimeStats->getMaxFrameTime() * 1000.0f;
+
+    const std::vector<float>& hitchThresholds = m_pRuntimeStats->getHitchThresholds();
+    const std::vector<uint32_t>& hitchCounts = m_pRuntimeStats->getHitchCounts();
+    json hitchThresholdsMS = json::array();
+    json hitches = json::array();
+    for (size_t thresholdIdx = 0u; thresholdIdx < hitchThresholds.size(); thresholdIdx++) {
+        hitchThresholdsMS.push_back(hitchThresholds[thresholdIdx] * 1000.0f);
+        hitches.push_back({ {"Threshold", hitchThresholds[thresholdIdx] * 1000.0f}, {"Count", hitchCounts[thresholdIdx]} });
+    }
+
+    // The thresholds in use, from the engine config or the --hitch-thresholds flag
+    benchmarkResults["HitchThresholds"] = hitchThresholdsMS;
+    benchmarkResults["Hitches"] = hitches;
+
+    // The histogram's non-empty buckets as pairs of the bucket's upper bound and its frame count
+    const FrameTimeHistogram& frameTimeHistogram = m_pRuntimeStats->getFrameTimeHistogram();
+    json histogram = json::array();
+    for (uint32_t bucketIdx = 0u; bucketIdx < FRAME_HISTOGRAM_BUCKETS; bucketIdx++) {
+        const uint32_t bucketCount = frameTimeHistogram.getBucketCount(bucketIdx);
+        if (bucketCount) {
+            histogram.push_back({ FrameTimeHistogram::getBucketUpperBound(bucketIdx) / 1000.0f, bucketCount });
+        }
+    }
+
+    benchmarkResults["FrameTimeHistogram"] = histogram;
+
+    json framesPerSecond = json::array();
+    json maxFrameTimePerSecond = json::array();
+    for (const FrameSecond& frameSecond : m_pRuntimeStats->getFrameTimeSeries()) {
+        framesPerSecond.push_back(frameSecond.FrameCount);
+        maxFrameTimePerSecond.push_back(frameSecond.MaxFrameTime * 1000.0f);
+    }
+
+    benchmarkResults["FramesPerSecond"]         = framesPerSecond;
+    benchmarkResults["MaxFrameTimePerSecond"]   = maxFrameTimePerSecond;
+
+    benchmarkResults["AverageFrameTime"]    = m_pRuntimeStats->getAverageFrametime() * 1000.0f;
+    benchmarkResults["StateLoadTime"]       = m_StateLoadTime;
+
+    for (const IBenchmarkModule* pModule : m_Modules) {
+        pModule->WriteResults(benchmarkResults, m_FrameCount);
+    }
+
+    const DescriptorPoolHandler& descriptorPoolHandler = EngineCore::GetInstance()->GetRenderingCore()->GetDevice()->getDescriptorPoolHandler();
+    benchmarkResults["DescriptorSets"]      = descriptorPoolHandler.getAllocatedSetCount();
+    benchmarkResults["DescriptorPools"]     = descriptorPoolHandler.getPoolCount();
 
     std::ofstream benchmarkFile(pOutFile, std::fstream::out | std::fstream::trunc);
     benchmarkFile << std::setw(4) << benchmarkResults << std::endl;
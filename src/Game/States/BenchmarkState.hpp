@@ -5,20 +5,23 @@
 #include <Game/LightSpinner.hpp>
 #include <Game/Racer/Components/Track.hpp>
 #include <Game/Racer/Systems/RacerController.hpp>
+#include <Game/States/Benchmarks/BenchmarkSettings.hpp>
 
 class AssetLoadersCore;
 class AudioCore;
 class Device;
+class IBenchmarkModule;
 class InputHandler;
 class ModelLoader;
 class RenderingCore;
+class RenderingHandler;
 class RuntimeStats;
 
 class BenchmarkState : public State
 {
 public:
-    BenchmarkState(StateManager* pStateManager, const RuntimeStats* pRuntimeStats);
-    ~BenchmarkState() = default;
+    BenchmarkState(StateManager* pStateManager, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler, const BenchmarkSettings& settings);
+    ~BenchmarkState();
 
     void Init() override final;
 
@@ -36,6 +39,16 @@ private:
 
 private:
     const RuntimeStats* m_pRuntimeStats;
+    const RenderingHandler* m_pRenderingHandler;
+    BenchmarkSettings m_Settings;
+
+    // The benchmark's scenarios, each measuring an area of the engine
+    std::vector<IBenchmarkModule*> m_Modules;
+
+    uint64_t m_FrameCount;
+
+    // Time spent in Init, including the modules' measurements
+    float m_StateLoadTime;
 
     Entity m_PlayerEntity;
 
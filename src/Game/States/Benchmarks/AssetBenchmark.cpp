@@ -0,0 +1,206 @@
+#include "AssetBenchmark.hpp"
+
+#include <Engine/Rendering/AssetLoaders/AssetLoadersCore.hpp>
+#include <Engine/Utils/AssetCache.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+AssetBenchmark::AssetBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+    :   IBenchmarkModule(settings, pRuntimeStats, pRenderingHandler)
+    ,   m_SyncAssetLoadTime(0.0f)
+    ,   m_AsyncAssetIssueTime(0.0f)
+    ,   m_AsyncAssetLoadTime(0.0f)
+    ,   m_AssetCacheStressTime(0.0f)
+    ,   m_AssetCacheStressLoads(0u)
+{}
+
+void AssetBenchmark::Measure()
+{
+    MeasureAssetLoadTime();
+    StressTestAssetCache();
+}
+
+void AssetBenchmark::WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const
+{
+    UNREFERENCED_VARIABLE(frameCount);
+
+    benchmarkResults["LoadedAssets"]        = m_Settings.AssetCount;
+    benchmarkResults["SyncAssetLoadTime"]   = m_SyncAssetLoadTime;
+    benchmarkResults["AsyncAssetLoadTime"]  = m_AsyncAssetLoadTime;
+    benchmarkResults["AsyncAssetIssueTime"] = m_AsyncAssetIssueTime;
+    benchmarkResults["AssetCacheStressTime"]    = m_AssetCacheStressTime;
+    benchmarkResults["AssetCacheStressLoads"]   = m_AssetCacheStressLoads;
+
+    const ResidencyStats residencyStats = EngineCore::GetInstance()->GetAssetLoadersCore()->GetResidencyManager()->GetStats();
+    benchmarkResults["AssetCacheHits"]      = residencyStats.Hits;
+    benchmarkResults["AssetCacheMisses"]    = residencyStats.Misses;
+    benchmarkResults["AssetEvictions"]      = residencyStats.Evictions;
+    benchmarkResults["ResidentAssetBytes"]  = residencyStats.TrackedBytes;
+}
+
+void AssetBenchmark::MeasureAssetLoadTime()
+{
+    if (m_Settings.AssetCount == 0u) {
+        return;
+    }
+
+    // Separate copies for each measurement, as loaded models are cached by their paths
+    const std::string assetDirectory = "./benchmark_assets/";
+    std::filesystem::remove_all(assetDirectory);
+    const std::vector<std::string> syncModelPaths = CreateAssetCopies(assetDirectory + "sync/");
+    const std::vector<std::string> asyncModelPaths = CreateAssetCopies(assetDirectory + "async/");
+    if (syncModelPaths.empty() || asyncModelPaths.empty()) {
+        return;
+    }
+
+    ModelLoader* pModelLoader = EngineCore::GetInstance()->GetAssetLoadersCore()->GetModelLoader();
+
+    std::vector<ModelComponent> syncModels;
+    syncModels.reserve(syncModelPaths.size());
+
+    const auto syncLoadStart = std::chrono::high_resolution_clock::now();
+    for (const std::string& modelPath : syncModelPaths) {
+        syncModels.push_back(pModelLoader->LoadModel(modelPath));
+    }
+
+    const std::chrono::duration<float, std::milli> syncLoadTime = std::chrono::high_resolution_clock::now() - syncLoadStart;
+    m_SyncAssetLoadTime = syncLoadTime.count();
+
+    std::vector<ModelFuture> asyncModels;
+    asyncModels.reserve(asyncModelPaths.size());
+
+    const auto asyncLoadStart = std::chrono::high_resolution_clock::now();
+    for (const std::string& modelPath : asyncModelPaths) {
+        asyncModels.push_back(pModelLoader->LoadModelAsync(modelPath));
+    }
+
+    const std::chrono::duration<float, std::milli> asyncIssueTime = std::chrono::high_resolution_clock::now() - asyncLoadStart;
+    m_AsyncAssetIssueTime = asyncIssueTime.count();
+
+    for (const ModelFuture& modelFuture : asyncModels) {
+        modelFuture.wait();
+    }
+
+    const std::chrono::duration<float, std::milli> asyncLoadTime = std::chrono::high_resolution_clock::now() - asyncLoadStart;
+    m_AsyncAssetLoadTime = asyncLoadTime.count();
+
+    LOG_INFOF("Loaded %d models synchronously in %.3f ms, and asynchronously in %.3f ms (%.3f ms blocked)",
+        m_Settings.AssetCount, m_SyncAssetLoadTime, m_AsyncAssetLoadTime, m_AsyncAssetIssueTime);
+
+    // The loaded resources no longer need the files
+    syncModels.clear();
+    asyncModels.clear();
+    std::filesystem::remove_all(assetDirectory);
+}
+
+std::vector<std::string> AssetBenchmark::CreateAssetCopies(const std::string& directory) const
+{
+    const std::string modelName = "Cube.dae";
+    const std::string textureName = "Cube.png";
+    const std::string sourceDirectory = "./assets/Models/";
+
+    std::vector<std::string> modelPaths;
+    modelPaths.reserve(m_Settings.AssetCount);
+
+    for (uint32_t assetIdx = 0u; assetIdx < m_Settings.AssetCount; assetIdx++) {
+        const std::string assetDirectory = directory + std::to_string(assetIdx) + "/";
+
+        std::error_code error;
+        std::filesystem::create_directories(assetDirectory, error);
+        if (!error) {
+            std::filesystem::copy_file(sourceDirectory + modelName, assetDirectory + modelName, error);
+        }
+
+        if (!error) {
+            std::filesystem::copy_file(sourceDirectory + textureName, assetDirectory + textureName, error);
+        }
+
+        if (error) {
+            LOG_WARNINGF("Failed to copy benchmark assets into [%s]: %s", assetDirectory.c_str(), error.message().c_str());
+            return {};
+        }
+
+        modelPaths.push_back(assetDirectory + modelName);
+    }
+
+    return modelPaths;
+}
+
+void AssetBenchmark::StressTestAssetCache()
+{
+    if (!m_Settings.AssetCacheStress) {
+        return;
+    }
+
+    constexpr const uint32_t threadCount = 32u;
+    constexpr const uint32_t assetCount = 1000u;
+    LOG_INFOF("Requesting %d assets from %d threads", assetCount, threadCount);
+
+    AssetCache<uint32_t> assetCache;
+    std::atomic_uint32_t loadCount = 0u;
+
+    const auto loadAsset = [&loadCount](uint32_t assetIdx) {
+        loadCount += 1u;
+        return std::make_shared<uint32_t>(assetIdx);
+    };
+
+    // Every thread holds on to its assets, which should therefore be loaded exactly once
+    std::vector<std::vector<std::shared_ptr<uint32_t>>> threadAssets(threadCount);
+    std::atomic_bool assetsValid = true;
+
+    const auto requestAssets = [&](uint32_t threadIdx) {
+        std::vector<std::shared_ptr<uint32_t>>& assets = threadAssets[threadIdx];
+        assets.reserve(assetCount);
+
+        for (uint32_t requestIdx = 0u; requestIdx < assetCount; requestIdx++) {
+            // Each thread starts at a different asset, and alternates between synchronous and asynchronous requests
+            const uint32_t assetIdx = (requestIdx + threadIdx * (assetCount / threadCount)) % assetCount;
+            const std::string assetPath = "stress/" + std::to_string(assetIdx);
+
+            if (requestIdx % 2u == 0u) {
+                assets.push_back(assetCache.Load(assetPath, std::bind(loadAsset, assetIdx)));
+            } else {
+                const auto startLoad = [&assetCache, &loadAsset, assetPath, assetIdx]() {
+                    ThreadPool::GetInstance().ExecuteDetached([&assetCache, &loadAsset, assetPath, assetIdx]() {
+                        assetCache.Finish(assetPath, loadAsset(assetIdx));
+                    });
+                };
+
+                assets.push_back(assetCache.LoadAsync(assetPath, startLoad).get());
+            }
+
+            if (!assets.back() || *assets.back() != assetIdx) {
+                assetsValid = false;
+            }
+        }
+    };
+
+    const auto stressStart = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (uint32_t threadIdx = 0u; threadIdx < threadCount; threadIdx++) {
+        threads.emplace_back(requestAssets, threadIdx);
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const std::chrono::duration<float, std::milli> stressTime = std::chrono::high_resolution_clock::now() - stressStart;
+    m_AssetCacheStressTime = stressTime.count();
+    m_AssetCacheStressLoads = loadCount;
+
+    if (!assetsValid || m_AssetCacheStressLoads != assetCount) {
+        LOG_ERRORF("Asset cache stress test failed: %d loads of %d assets, assets valid: %d", m_AssetCacheStressLoads, assetCount, (int)assetsValid);
+    } else {
+        LOG_INFOF("Asset cache served %d requests with %d loads in %.3f ms", threadCount * assetCount, m_AssetCacheStressLoads, m_AssetCacheStressTime);
+    }
+
+    // Release the assets and remove their expired entries
+    threadAssets.clear();
+    assetCache.Sweep();
+}
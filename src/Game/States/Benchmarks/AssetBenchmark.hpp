@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Game/States/Benchmarks/IBenchmarkModule.hpp>
+
+#include <string>
+
+// Measures model load times, stress tests the asset caches and reports the residency manager's statistics
+class AssetBenchmark : public IBenchmarkModule
+{
+public:
+    AssetBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+    ~AssetBenchmark() = default;
+
+    void Measure() override final;
+
+    void WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const override final;
+
+private:
+    /*  Loads AssetCount copies of a model, each in its own directory to make both the models and their textures distinct.
+        Measures the time to load them synchronously, and the time spent issuing and finishing asynchronous loads. */
+    void MeasureAssetLoadTime();
+    // Copies the model and its texture into AssetCount directories, returning the models' paths
+    std::vector<std::string> CreateAssetCopies(const std::string& directory) const;
+    // Requests the same set of assets from many threads at once, both synchronously and asynchronously
+    void StressTestAssetCache();
+
+private:
+    float m_SyncAssetLoadTime;
+    float m_AsyncAssetIssueTime;
+    float m_AsyncAssetLoadTime;
+
+    float m_AssetCacheStressTime;
+    uint32_t m_AssetCacheStressLoads;
+};
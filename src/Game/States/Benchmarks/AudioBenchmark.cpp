@@ -0,0 +1,319 @@
+#include "AudioBenchmark.hpp"
+
+#include <Engine/Audio/Software/AudioBackendSoftware.hpp>
+#include <Engine/Audio/Software/AudioSink.hpp>
+#include <Engine/Physics/Velocity.hpp>
+#include <Engine/Transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <thread>
+
+AudioBenchmark::AudioBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+    :   IBenchmarkModule(settings, pRuntimeStats, pRenderingHandler)
+    ,   m_AudioUpdateTimeSum(0.0f)
+    ,   m_VoiceUpdateTimeSum(0.0f)
+    ,   m_RealVoicesSum(0u)
+    ,   m_ChangedVoicesSum(0u)
+    ,   m_MixerTime(0.0f)
+    ,   m_MixerVoicesPerMS(0.0f)
+    ,   m_SoundCacheIssueTime(0.0f)
+    ,   m_SoundCacheLoadTime(0.0f)
+    ,   m_SoundCacheMemory(0u)
+    ,   m_SoundCacheSounds(0u)
+    ,   m_PeakSoundMemory(0u)
+    ,   m_InitialPlayedVoices(0u)
+{}
+
+void AudioBenchmark::Measure()
+{
+    MeasureMixerThroughput();
+}
+
+void AudioBenchmark::CreateScene()
+{
+    CreateEmitterField();
+    MeasureSoundCache();
+    CreateLoopingSounds();
+
+    // The audio module is the last to create its scene, so every voice played before the first frame has been counted
+    m_InitialPlayedVoices = EngineCore::GetInstance()->GetAudioCore()->GetSoundPlayer()->GetStats().PlayedVoices;
+}
+
+void AudioBenchmark::Update(uint64_t frameCount)
+{
+    UNREFERENCED_VARIABLE(frameCount);
+
+    SoundPlayer* pSoundPlayer = EngineCore::GetInstance()->GetAudioCore()->GetSoundPlayer();
+    const SoundPlayerStats& soundPlayerStats = pSoundPlayer->GetStats();
+    m_PeakSoundMemory       = std::max(m_PeakSoundMemory, pSoundPlayer->GetBackend()->GetSoundMemory());
+    m_AudioUpdateTimeSum    += soundPlayerStats.UpdateTime;
+    m_VoiceUpdateTimeSum    += soundPlayerStats.VoiceStats.UpdateTime;
+    m_RealVoicesSum         += soundPlayerStats.VoiceStats.RealVoices;
+    m_ChangedVoicesSum      += soundPlayerStats.VoiceStats.ChangedVoices;
+}
+
+void AudioBenchmark::WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const
+{
+    benchmarkResults["Emitters"]                    = m_Settings.EmitterCount;
+    benchmarkResults["AverageAudioUpdateTime"]      = frameCount ? m_AudioUpdateTimeSum / frameCount : 0.0f;
+    benchmarkResults["AverageVoiceUpdateTime"]      = frameCount ? m_VoiceUpdateTimeSum / frameCount : 0.0f;
+    benchmarkResults["AverageRealVoices"]           = frameCount ? float(m_RealVoicesSum) / frameCount : 0.0f;
+    benchmarkResults["AverageChangedVoices"]        = frameCount ? float(m_ChangedVoicesSum) / frameCount : 0.0f;
+
+    benchmarkResults["MixerVoices"]         = m_Settings.MixerVoiceCount;
+    benchmarkResults["MixerTime"]           = m_MixerTime;
+    benchmarkResults["MixerVoicesPerMS"]    = m_MixerVoicesPerMS;
+
+    benchmarkResults["SoundEmitters"]           = m_Settings.SoundEmitterCount;
+    benchmarkResults["SoundCacheSounds"]        = m_SoundCacheSounds;
+    benchmarkResults["SoundCacheIssueTime"]     = m_SoundCacheIssueTime;
+    benchmarkResults["SoundCacheLoadTime"]      = m_SoundCacheLoadTime;
+    benchmarkResults["SoundCacheMemory"]        = m_SoundCacheMemory;
+    benchmarkResults["PeakSoundMemory"]         = m_PeakSoundMemory;
+
+    // Looping voices loop in the backend, only sounds created during the benchmark play new voices
+    const uint64_t playedVoices = EngineCore::GetInstance()->GetAudioCore()->GetSoundPlayer()->GetStats().PlayedVoices - m_InitialPlayedVoices;
+    benchmarkResults["LoopingSounds"]               = m_Settings.LoopingSoundCount;
+    benchmarkResults["AveragePlayedVoicesPerFrame"] = frameCount ? float(playedVoices) / frameCount : 0.0f;
+}
+
+void AudioBenchmark::CreateEmitterField()
+{
+    if (m_Settings.EmitterCount == 0u) {
+        return;
+    }
+
+    // The emitters' sound is generated, as the software audio backend only loads WAV files
+    const std::string directory = "./benchmark_assets/audio/";
+    const std::string soundPath = directory + "EngineHum.wav";
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error || !WriteWaveFile(soundPath, CreateEngineSound(1u))) {
+        LOG_WARNINGF("Failed to write emitter sound: %s", soundPath.c_str());
+        return;
+    }
+
+    LOG_INFOF("Creating %d sound emitters", m_Settings.EmitterCount);
+
+    // The emitters share a single looping sound, played on a voice per emitter
+    SoundPlayer* pSoundPlayer = EngineCore::GetInstance()->GetAudioCore()->GetSoundPlayer();
+    SoundComponent sound = pSoundPlayer->CreateSound(soundPath);
+    if (sound.Sound == INVALID_AUDIO_HANDLE) {
+        return;
+    }
+
+    ECSCore* pECS = ECSCore::GetInstance();
+    for (uint32_t emitterIdx = 0u; emitterIdx < m_Settings.EmitterCount; emitterIdx++) {
+        // Spread the emitters around the tube, moving back and forth along it
+        const float angle = emitterIdx * 2.399963f;
+        const float radius = 2.0f + float(emitterIdx % 16u);
+        const DirectX::XMFLOAT3 position = { std::cos(angle) * radius, std::sin(angle) * radius, -float(emitterIdx % 64u) };
+        const DirectX::XMFLOAT3 velocity = { 0.0f, 0.0f, emitterIdx % 2u ? 5.0f : -5.0f };
+
+        if (!pSoundPlayer->PlaySound(sound, true)) {
+            return;
+        }
+
+        const Entity emitterEntity = pECS->CreateEntity();
+        pECS->AddComponent(emitterEntity, PositionComponent({ .Position = position }));
+        pECS->AddComponent(emitterEntity, VelocityComponent({ .Velocity = velocity }));
+        pECS->AddComponent(emitterEntity, sound);
+    }
+}
+
+PCMData AudioBenchmark::CreateEngineSound(uint32_t channelCount, float fundamental, uint32_t durationSeconds) const
+{
+    // 44.1 kHz makes the software mixer resample the sound when loading it. Whole periods in a second make the loop seamless.
+    constexpr const uint32_t sampleRate = 44100u;
+    const uint32_t frameCount = sampleRate * durationSeconds;
+
+    PCMData pcmData = {
+        .ChannelCount   = channelCount,
+        .SampleRate     = sampleRate
+    };
+
+    pcmData.Samples.resize(size_t(frameCount) * channelCount);
+    for (uint32_t frameIdx = 0u; frameIdx < frameCount; frameIdx++) {
+        // Wrapping the time to a second keeps the phase precise in long sounds
+        const float time = float(frameIdx % sampleRate) / sampleRate;
+
+        for (uint32_t channelIdx = 0u; channelIdx < channelCount; channelIdx++) {
+            // Offset the channels' phases slightly to make stereo sounds wider
+            const float phase = DirectX::XM_2PI * fundamental * time + float(channelIdx) * 0.5f;
+            pcmData.Samples[frameIdx * channelCount + channelIdx] = 0.4f * std::sin(phase) + 0.2f * std::sin(2.0f * phase) + 0.1f * std::sin(3.0f * phase);
+        }
+    }
+
+    return pcmData;
+}
+
+void AudioBenchmark::MeasureMixerThroughput()
+{
+    if (m_Settings.MixerVoiceCount == 0u) {
+        return;
+    }
+
+    LOG_INFOF("Measuring software mixer throughput using %d voices", m_Settings.MixerVoiceCount);
+
+    // A mixer of its own, discarding its output, isolates the mixing from the rest of the audio update
+    AudioBackendSoftware mixer(DBG_NEW AudioSinkNull());
+    if (!mixer.Init()) {
+        return;
+    }
+
+    const SoundHandle monoSound = mixer.CreateSound(CreateEngineSound(1u));
+    const SoundHandle stereoSound = mixer.CreateSound(CreateEngineSound(2u));
+    if (monoSound == INVALID_AUDIO_HANDLE || stereoSound == INVALID_AUDIO_HANDLE) {
+        return;
+    }
+
+    // Every fourth voice is unpitched, the rest are pitched like Doppler shifted emitters
+    for (uint32_t voiceIdx = 0u; voiceIdx < m_Settings.MixerVoiceCount; voiceIdx++) {
+        const VoiceHandle voice = mixer.PlaySound(voiceIdx % 2u ? stereoSound : monoSound, true);
+        const float pan = float(voiceIdx % 9u) / 8.0f;
+
+        mixer.SetVoiceVolume(voice, 1.0f / m_Settings.MixerVoiceCount);
+        mixer.SetVoicePan(voice, 1.0f - pan, pan);
+        mixer.SetVoicePitch(voice, voiceIdx % 4u ? 0.9f + 0.2f * float(voiceIdx % 16u) / 15.0f : 1.0f);
+    }
+
+    // Mix one second of audio in frame sized updates
+    constexpr const uint32_t updateCount = 60u;
+    float mixTime = 0.0f;
+    for (uint32_t updateIdx = 0u; updateIdx < updateCount; updateIdx++) {
+        mixer.Update(1.0f / updateCount);
+        mixTime += mixer.GetStats().MixTime;
+    }
+
+    m_MixerTime = mixTime;
+    m_MixerVoicesPerMS = mixTime > 0.0f ? float(m_Settings.MixerVoiceCount) * 1000.0f / mixTime : 0.0f;
+    LOG_INFOF("Mixed one second of %d voices in %.3f ms, %.1f voices per ms", m_Settings.MixerVoiceCount, m_MixerTime, m_MixerVoicesPerMS);
+}
+
+void AudioBenchmark::MeasureSoundCache()
+{
+    if (m_Settings.SoundEmitterCount == 0u) {
+        return;
+    }
+
+    // Eight short sounds which are decoded up front, and two long stereo sounds larger than the streaming threshold
+    constexpr const uint32_t soundCount = 10u;
+    constexpr const uint32_t streamedSoundCount = 2u;
+    constexpr const uint32_t streamedSoundDuration = 30u;
+
+    const std::string directory = "./benchmark_assets/audio/shared/";
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        LOG_WARNINGF("Failed to create directory: %s", directory.c_str());
+        return;
+    }
+
+    std::vector<std::string> soundPaths;
+    soundPaths.reserve(soundCount);
+    for (uint32_t soundIdx = 0u; soundIdx < soundCount; soundIdx++) {
+        const bool isStreamed = soundIdx >= soundCount - streamedSoundCount;
+        const std::string soundPath = directory + "Sound" + std::to_string(soundIdx) + ".wav";
+        const PCMData pcmData = CreateEngineSound(isStreamed ? 2u : 1u + soundIdx % 2u, 110.0f + 20.0f * soundIdx, isStreamed ? streamedSoundDuration : 1u);
+
+        if (!WriteWaveFile(soundPath, pcmData)) {
+            LOG_WARNINGF("Failed to write shared sound: %s", soundPath.c_str());
+            return;
+        }
+
+        soundPaths.push_back(soundPath);
+    }
+
+    LOG_INFOF("Creating %d sound emitters sharing %d sounds", m_Settings.SoundEmitterCount, soundCount);
+
+    SoundPlayer* pSoundPlayer = EngineCore::GetInstance()->GetAudioCore()->GetSoundPlayer();
+    IAudioBackend* pAudioBackend = pSoundPlayer->GetBackend();
+    const size_t soundMemoryBefore = pAudioBackend->GetSoundMemory();
+    const size_t cachedSoundsBefore = pSoundPlayer->GetCachedSoundCount();
+
+    const auto issueStart = std::chrono::high_resolution_clock::now();
+
+    ECSCore* pECS = ECSCore::GetInstance();
+    std::vector<SoundHandle> sounds;
+    for (uint32_t emitterIdx = 0u; emitterIdx < m_Settings.SoundEmitterCount; emitterIdx++) {
+        SoundComponent sound = pSoundPlayer->CreateSound(soundPaths[emitterIdx % soundCount]);
+        if (!pSoundPlayer->PlaySound(sound, true)) {
+            return;
+        }
+
+        if (emitterIdx < soundCount) {
+            sounds.push_back(sound.Sound);
+        }
+
+        // Place the emitters in rings around the start of the tube
+        const float angle = emitterIdx * 2.399963f;
+        const float radius = 4.0f + float(emitterIdx % 8u);
+        const DirectX::XMFLOAT3 position = { std::cos(angle) * radius, std::sin(angle) * radius, -float(emitterIdx % 32u) * 2.0f };
+
+        const Entity emitterEntity = pECS->CreateEntity();
+        pECS->AddComponent(emitterEntity, PositionComponent({ .Position = position }));
+        pECS->AddComponent(emitterEntity, sound);
+    }
+
+    const std::chrono::duration<float, std::milli> issueTime = std::chrono::high_resolution_clock::now() - issueStart;
+    m_SoundCacheIssueTime = issueTime.count();
+
+    for (SoundHandle sound : sounds) {
+        while (!pAudioBackend->IsSoundLoaded(sound)) {
+            std::this_thread::yield();
+        }
+    }
+
+    const std::chrono::duration<float, std::milli> loadTime = std::chrono::high_resolution_clock::now() - issueStart;
+    m_SoundCacheLoadTime = loadTime.count();
+    m_SoundCacheMemory = pAudioBackend->GetSoundMemory() - soundMemoryBefore;
+    m_SoundCacheSounds = uint32_t(pSoundPlayer->GetCachedSoundCount() - cachedSoundsBefore);
+
+    LOG_INFOF("Created %d sound emitters in %.3f ms, their %d sounds loaded in %.3f ms using %zu bytes",
+        m_Settings.SoundEmitterCount, m_SoundCacheIssueTime, m_SoundCacheSounds, m_SoundCacheLoadTime, m_SoundCacheMemory);
+}
+
+void AudioBenchmark::CreateLoopingSounds()
+{
+    if (m_Settings.LoopingSoundCount == 0u) {
+        return;
+    }
+
+    const std::string directory = "./benchmark_assets/audio/";
+    const std::string soundPath = directory + "LoopingHum.wav";
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error || !WriteWaveFile(soundPath, CreateEngineSound(1u, 220.0f))) {
+        LOG_WARNINGF("Failed to write looping sound: %s", soundPath.c_str());
+        return;
+    }
+
+    LOG_INFOF("Scheduling %d looping sounds", m_Settings.LoopingSoundCount);
+
+    SoundPlayer* pSoundPlayer = EngineCore::GetInstance()->GetAudioCore()->GetSoundPlayer();
+    SoundComponent sound = pSoundPlayer->CreateSound(soundPath);
+    if (sound.Sound == INVALID_AUDIO_HANDLE) {
+        return;
+    }
+
+    // Stagger the voices over the sound's second, starting shortly after the current frame
+    constexpr const uint32_t staggerSteps = 16u;
+    const uint64_t sampleRate = pSoundPlayer->GetDSPSampleRate();
+    const uint64_t startClock = pSoundPlayer->GetDSPClock() + sampleRate / 10u;
+
+    ECSCore* pECS = ECSCore::GetInstance();
+    for (uint32_t soundIdx = 0u; soundIdx < m_Settings.LoopingSoundCount; soundIdx++) {
+        if (!pSoundPlayer->ScheduleSound(sound, startClock + sampleRate * (soundIdx % staggerSteps) / staggerSteps, true)) {
+            return;
+        }
+
+        pSoundPlayer->SetVolume(sound, 1.0f / m_Settings.LoopingSoundCount);
+
+        const Entity soundEntity = pECS->CreateEntity();
+        pECS->AddComponent(soundEntity, sound);
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Engine/Audio/Software/WaveFile.hpp>
+#include <Game/States/Benchmarks/IBenchmarkModule.hpp>
+
+/*  Measures the software mixer's throughput, and fills the scene with moving emitters, emitters sharing cached sounds
+    and looping sounds. Accumulates the sound player's CPU time and voice statistics every frame. */
+class AudioBenchmark : public IBenchmarkModule
+{
+public:
+    AudioBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+    ~AudioBenchmark() = default;
+
+    void Measure() override final;
+    void CreateScene() override final;
+    void Update(uint64_t frameCount) override final;
+
+    void WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const override final;
+
+private:
+    // Spawns EmitterCount moving emitters along the tube, all playing the same looping sound
+    void CreateEmitterField();
+    // Generates an engine hum that loops seamlessly, as long as the fundamental frequency is a whole number of hertz
+    PCMData CreateEngineSound(uint32_t channelCount, float fundamental = 110.0f, uint32_t durationSeconds = 1u) const;
+    // Mixes one second of MixerVoiceCount looping voices in a software mixer discarding its output, measuring the time spent mixing
+    void MeasureMixerThroughput();
+    /*  Spawns SoundEmitterCount emitters playing looping sounds through the sound player, which shares ten sounds between
+        them. Measures the time spent creating the emitters, the time until the sounds have loaded and the sounds' memory. */
+    void MeasureSoundCache();
+    // Schedules LoopingSoundCount looping voices of a one second sound, spread over the sound's length
+    void CreateLoopingSounds();
+
+private:
+    // Accumulated sound player statistics
+    float m_AudioUpdateTimeSum;
+    float m_VoiceUpdateTimeSum;
+    uint64_t m_RealVoicesSum;
+    uint64_t m_ChangedVoicesSum;
+
+    // Time to mix one second of audio, and the amount of voices that one millisecond of mixing covers per millisecond of audio
+    float m_MixerTime;
+    float m_MixerVoicesPerMS;
+
+    float m_SoundCacheIssueTime;
+    float m_SoundCacheLoadTime;
+    // Memory of the sounds created by the sound cache measurement, and the highest memory of every sound during the benchmark
+    size_t m_SoundCacheMemory;
+    uint32_t m_SoundCacheSounds;
+    size_t m_PeakSoundMemory;
+    // Voices played before the benchmark's first frame, which lets the voices played during the benchmark be counted
+    uint64_t m_InitialPlayedVoices;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+
+struct BenchmarkSettings {
+    // Amount of static cubes to spawn in addition to the benchmark scene, used for measuring rendering throughput
+    uint32_t RenderableCount;
+    // Amount of the additional renderables to despawn and respawn each frame
+    uint32_t ChurnPerFrame;
+    // Amount of meshes and textures to upload before the benchmark starts, used for measuring load times
+    uint32_t UploadCount;
+    // Amount of uniform buffers to update per frame in the uniform update microbenchmark
+    uint32_t UniformBufferCount;
+    // Amount of distinct models to load synchronously and asynchronously, used for measuring state load times
+    uint32_t AssetCount;
+    // Whether to hammer an asset cache with concurrent requests, verifying that each asset is loaded once
+    bool AssetCacheStress;
+    // Amount of imported sphere models to spawn, whose LODs are selected by their distance to the camera
+    uint32_t LODModelCount;
+    // Amount of procedural 4096x4096 textures to load in addition to the bundled textures, used for measuring texture load times
+    uint32_t TextureCount;
+    // Amount of changing strings to render with and without the glyph atlas, used for measuring dynamic text throughput
+    uint32_t TextStringCount;
+    // Amount of textured UI panels to spawn, used for measuring how well the UI renderer batches panels
+    uint32_t PanelCount;
+    // Amount of UI buttons to spawn, used for measuring the cost of hit testing the mouse against many buttons
+    uint32_t ButtonCount;
+    // Amount of moving sound emitters to spawn, used for measuring the CPU time of spatial audio
+    uint32_t EmitterCount;
+    // Amount of looping voices to mix in the software mixer microbenchmark, used for measuring mixing throughput
+    uint32_t MixerVoiceCount;
+    // Amount of static sound emitters sharing ten sounds, a few of which are streamed, used for measuring the sound cache
+    uint32_t SoundEmitterCount;
+    // Amount of non-spatial looping sounds to play, started at staggered frames using the DSP clock
+    uint32_t LoopingSoundCount;
+    // Whether to record the CPU time of each system, job and renderer, written to benchmark_trace.json
+    bool Profile;
+};
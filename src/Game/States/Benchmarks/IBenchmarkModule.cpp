@@ -0,0 +1,50 @@
+#include "IBenchmarkModule.hpp"
+
+#include <Engine/Utils/Debug.hpp>
+#include <Game/States/Benchmarks/AssetBenchmark.hpp>
+#include <Game/States/Benchmarks/AudioBenchmark.hpp>
+#include <Game/States/Benchmarks/MeshBenchmark.hpp>
+#include <Game/States/Benchmarks/TextBenchmark.hpp>
+#include <Game/States/Benchmarks/TextureBenchmark.hpp>
+#include <Game/States/Benchmarks/UIBenchmark.hpp>
+#include <Game/States/Benchmarks/UploadBenchmark.hpp>
+
+#include <iterator>
+
+typedef IBenchmarkModule* (*BenchmarkModuleCreator)(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+
+template <typename Module>
+IBenchmarkModule* CreateModule(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+{
+    return DBG_NEW Module(settings, pRuntimeStats, pRenderingHandler);
+}
+
+/*  The registered modules, in the order they are run. New benchmark scenarios are added as modules here rather than to
+    the benchmark state. The microbenchmarks of the earlier modules are measured before the later modules' scenes exist. */
+static const BenchmarkModuleCreator g_BenchmarkModules[] = {
+    CreateModule<UploadBenchmark>,
+    CreateModule<AssetBenchmark>,
+    CreateModule<TextureBenchmark>,
+    CreateModule<TextBenchmark>,
+    CreateModule<MeshBenchmark>,
+    CreateModule<UIBenchmark>,
+    CreateModule<AudioBenchmark>
+};
+
+std::vector<IBenchmarkModule*> IBenchmarkModule::CreateModules(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+{
+    std::vector<IBenchmarkModule*> modules;
+    modules.reserve(std::size(g_BenchmarkModules));
+
+    for (BenchmarkModuleCreator createModule : g_BenchmarkModules) {
+        modules.push_back(createModule(settings, pRuntimeStats, pRenderingHandler));
+    }
+
+    return modules;
+}
+
+IBenchmarkModule::IBenchmarkModule(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+    :   m_Settings(settings)
+    ,   m_pRuntimeStats(pRuntimeStats)
+    ,   m_pRenderingHandler(pRenderingHandler)
+{}
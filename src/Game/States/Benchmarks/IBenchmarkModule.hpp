@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Game/States/Benchmarks/BenchmarkSettings.hpp>
+
+#include <vendor/json/json.hpp>
+
+#include <vector>
+
+class RenderingHandler;
+class RuntimeStats;
+
+/*  A benchmark module measures one area of the engine. The benchmark state runs every registered module: first their
+    one-off measurements, then the creation of their entities in the benchmark scene, then their per-frame statistics,
+    and finally it collects their results. Modules whose settings are zero only write zeroed results. */
+class IBenchmarkModule
+{
+public:
+    // Creates every registered module, in the order they are run
+    static std::vector<IBenchmarkModule*> CreateModules(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+
+public:
+    IBenchmarkModule(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+    virtual ~IBenchmarkModule() = default;
+
+    // Runs measurements that finish before the benchmark scene is created
+    virtual void Measure() {}
+    // Adds the module's entities to the benchmark scene
+    virtual void CreateScene() {}
+    // Called every benchmark frame, the frame count includes the current frame
+    virtual void Update(uint64_t frameCount) { UNREFERENCED_VARIABLE(frameCount); }
+
+    virtual void WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const = 0;
+
+protected:
+    const BenchmarkSettings m_Settings;
+    const RuntimeStats* m_pRuntimeStats;
+    const RenderingHandler* m_pRenderingHandler;
+};
@@ -0,0 +1,257 @@
+#include "MeshBenchmark.hpp"
+
+#include <Engine/Rendering/AssetLoaders/AssetLoadersCore.hpp>
+#include <Engine/Rendering/RenderingHandler.hpp>
+#include <Engine/Transform.hpp>
+#include <Engine/Utils/RuntimeStats.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+MeshBenchmark::MeshBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+    :   IBenchmarkModule(settings, pRuntimeStats, pRenderingHandler)
+    ,   m_NextChurnIdx(0u)
+    ,   m_MeshRecordTimeSum(0.0f)
+    ,   m_MeshUpdateTimeSum(0.0f)
+    ,   m_BucketsRecordedSum(0u)
+    ,   m_TriangleCountSum(0u)
+    ,   m_FullDetailTriangleCountSum(0u)
+    ,   m_LODChangesSum(0u)
+{}
+
+void MeshBenchmark::CreateScene()
+{
+    CreateRenderableField();
+    CreateLODField();
+}
+
+void MeshBenchmark::Update(uint64_t frameCount)
+{
+    UNREFERENCED_VARIABLE(frameCount);
+
+    // The stats describe the previous frame's recording
+    const MeshRendererStats& meshRendererStats = m_pRenderingHandler->getMeshRenderer()->getStats();
+    m_MeshRecordTimeSum     += meshRendererStats.RecordTime;
+    m_MeshUpdateTimeSum     += meshRendererStats.UpdateTime;
+    m_BucketsRecordedSum    += meshRendererStats.BucketsRecorded;
+    m_TriangleCountSum      += meshRendererStats.TriangleCount;
+    m_FullDetailTriangleCountSum += meshRendererStats.FullDetailTriangleCount;
+    m_LODChangesSum         += meshRendererStats.LODChanges;
+
+    ChurnRenderableField();
+}
+
+void MeshBenchmark::WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const
+{
+    const MeshRenderer* pMeshRenderer = m_pRenderingHandler->getMeshRenderer();
+    const MeshRendererStats& meshRendererStats = pMeshRenderer->getStats();
+    benchmarkResults["Renderables"]         = m_Settings.RenderableCount;
+    benchmarkResults["IndirectMeshDrawing"] = pMeshRenderer->isIndirectDrawing();
+    benchmarkResults["BindlessMaterials"]   = pMeshRenderer->isBindlessMaterials();
+    benchmarkResults["Materials"]           = pMeshRenderer->getMaterialCount();
+    benchmarkResults["ChurnPerFrame"]       = m_Settings.ChurnPerFrame;
+    benchmarkResults["MeshDraws"]           = meshRendererStats.DrawCount;
+    benchmarkResults["MeshDrawCalls"]       = meshRendererStats.DrawCalls;
+    benchmarkResults["MeshBindsSaved"]      = meshRendererStats.BindsSaved;
+    benchmarkResults["MeshCommandLists"]    = meshRendererStats.CommandListCount;
+    benchmarkResults["AverageMeshRecordTime"]       = frameCount ? m_MeshRecordTimeSum / frameCount : 0.0f;
+    benchmarkResults["AverageMeshUpdateTime"]       = frameCount ? m_MeshUpdateTimeSum / frameCount : 0.0f;
+    benchmarkResults["AverageMeshBucketsRecorded"]  = frameCount ? float(m_BucketsRecordedSum) / frameCount : 0.0f;
+    benchmarkResults["RecordingThreads"]    = ThreadPool::GetInstance().GetThreadCount();
+
+    const float averageTriangles = frameCount ? float(m_TriangleCountSum) / frameCount : 0.0f;
+    benchmarkResults["LODModels"]           = m_Settings.LODModelCount;
+    benchmarkResults["MeshLODs"]            = pMeshRenderer->isMeshLODs();
+    benchmarkResults["AverageMeshTriangles"]            = averageTriangles;
+    benchmarkResults["AverageFullDetailMeshTriangles"]  = frameCount ? float(m_FullDetailTriangleCountSum) / frameCount : 0.0f;
+    benchmarkResults["MeshTrianglesPerSecond"]          = averageTriangles / m_pRuntimeStats->getAverageFrametime();
+    benchmarkResults["AverageLODChanges"]               = frameCount ? float(m_LODChangesSum) / frameCount : 0.0f;
+}
+
+void MeshBenchmark::CreateRenderableField()
+{
+    if (m_Settings.RenderableCount == 0u) {
+        return;
+    }
+
+    LOG_INFOF("Creating %d additional renderables", m_Settings.RenderableCount);
+
+    m_FieldEntities.reserve(m_Settings.RenderableCount);
+    for (uint32_t cubeIdx = 0u; cubeIdx < m_Settings.RenderableCount; cubeIdx++) {
+        m_FieldEntities.push_back(CreateFieldCube(cubeIdx));
+    }
+}
+
+void MeshBenchmark::CreateLODField()
+{
+    if (m_Settings.LODModelCount == 0u) {
+        return;
+    }
+
+    const std::string modelPath = WriteLODSphere("./benchmark_assets/lod/");
+    if (modelPath.empty()) {
+        return;
+    }
+
+    LOG_INFOF("Creating %d LOD models", m_Settings.LODModelCount);
+
+    ECSCore* pECS = ECSCore::GetInstance();
+    ModelLoader* pModelLoader = EngineCore::GetInstance()->GetAssetLoadersCore()->GetModelLoader();
+
+    // Loading the model once imports and simplifies it, every renderable shares the loaded model
+    const ModelComponent modelComponent = pModelLoader->LoadModel(modelPath);
+    if (!modelComponent.ModelPtr) {
+        return;
+    }
+
+    // Layers of spheres along the tube, spread out enough for the distant layers to use coarser LODs
+    constexpr const float spacing = 1.5f;
+    constexpr const uint32_t rowLength = 64u;
+    constexpr const uint32_t layerSize = rowLength * rowLength;
+    constexpr const DirectX::XMFLOAT3 scale = DirectX::XMFLOAT3(0.5f, 0.5f, 0.5f);
+
+    for (uint32_t modelIdx = 0u; modelIdx < m_Settings.LODModelCount; modelIdx++) {
+        const uint32_t layerIdx = modelIdx % layerSize;
+        const DirectX::XMFLOAT3 position = {
+            (float(layerIdx % rowLength) - rowLength * 0.5f) * spacing,
+            (float(layerIdx / rowLength) - rowLength * 0.5f) * spacing,
+            -float(modelIdx / layerSize) * spacing * 8.0f - 4.0f
+        };
+
+        const Entity modelEntity = pECS->CreateEntity();
+        pECS->AddComponent(modelEntity, PositionComponent({ .Position = position }));
+        pECS->AddComponent(modelEntity, ScaleComponent({ .Scale = scale }));
+        pECS->AddComponent(modelEntity, RotationComponent({ .Quaternion = g_QuaternionIdentity }));
+        pECS->AddComponent(modelEntity, WorldMatrixComponent({ .WorldMatrix = CreateWorldMatrix(position, scale, g_QuaternionIdentity) }));
+        pECS->AddComponent(modelEntity, modelComponent);
+    }
+}
+
+std::string MeshBenchmark::WriteLODSphere(const std::string& directory) const
+{
+    const std::string modelName = "Sphere.obj";
+    const std::string materialName = "Sphere.mtl";
+    const std::string textureName = "Cube.png";
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (!error) {
+        std::filesystem::copy_file("./assets/Models/" + textureName, directory + textureName, std::filesystem::copy_options::overwrite_existing, error);
+    }
+
+    if (error) {
+        LOG_WARNINGF("Failed to create LOD benchmark assets in [%s]: %s", directory.c_str(), error.message().c_str());
+        return "";
+    }
+
+    std::ofstream materialFile(directory + materialName, std::fstream::out | std::fstream::trunc);
+    materialFile << "newmtl Sphere\nKd 1 1 1\nmap_Kd " << textureName << "\n";
+    materialFile.close();
+
+    // A UV sphere with a radius of one. Vertices along the texture seam and at the poles are duplicated.
+    constexpr const uint32_t segments = 64u;
+    constexpr const uint32_t rings = 32u;
+    constexpr const float pi = DirectX::XM_PI;
+
+    std::ofstream modelFile(directory + modelName, std::fstream::out | std::fstream::trunc);
+    modelFile << "mtllib " << materialName << "\n";
+
+    for (uint32_t ring = 0u; ring <= rings; ring++) {
+        const float v = float(ring) / rings;
+        const float polar = v * pi;
+
+        for (uint32_t segment = 0u; segment <= segments; segment++) {
+            const float u = float(segment) / segments;
+            const float azimuth = u * 2.0f * pi;
+            const DirectX::XMFLOAT3 normal = {
+                std::sin(polar) * std::cos(azimuth),
+                std::cos(polar),
+                std::sin(polar) * std::sin(azimuth)
+            };
+
+            modelFile << "v " << normal.x << " " << normal.y << " " << normal.z << "\n";
+            modelFile << "vn " << normal.x << " " << normal.y << " " << normal.z << "\n";
+            modelFile << "vt " << u << " " << 1.0f - v << "\n";
+        }
+    }
+
+    modelFile << "usemtl Sphere\n";
+
+    // OBJ indices start at one
+    const auto writeIndex = [&modelFile](uint32_t ring, uint32_t segment) {
+        const uint32_t index = ring * (segments + 1u) + segment + 1u;
+        modelFile << " " << index << "/" << index << "/" << index;
+    };
+
+    for (uint32_t ring = 0u; ring < rings; ring++) {
+        for (uint32_t segment = 0u; segment < segments; segment++) {
+            // The triangles touching the poles would be degenerate
+            if (ring != 0u) {
+                modelFile << "f";
+                writeIndex(ring, segment);
+                writeIndex(ring, segment + 1u);
+                writeIndex(ring + 1u, segment);
+                modelFile << "\n";
+            }
+
+            if (ring != rings - 1u) {
+                modelFile << "f";
+                writeIndex(ring, segment + 1u);
+                writeIndex(ring + 1u, segment + 1u);
+                writeIndex(ring + 1u, segment);
+                modelFile << "\n";
+            }
+        }
+    }
+
+    modelFile.close();
+    if (!modelFile) {
+        LOG_WARNINGF("Failed to write LOD benchmark model to [%s]", directory.c_str());
+        return "";
+    }
+
+    return directory + modelName;
+}
+
+Entity MeshBenchmark::CreateFieldCube(uint32_t cubeIdx)
+{
+    // Place the cubes in a grid of layers along the tube
+    constexpr const float spacing = 1.0f;
+    constexpr const uint32_t rowLength = 64u;
+    constexpr const uint32_t layerSize = rowLength * rowLength;
+    constexpr const DirectX::XMFLOAT3 scale = DirectX::XMFLOAT3(0.25f, 0.25f, 0.25f);
+
+    const uint32_t layerIdx = cubeIdx % layerSize;
+    const DirectX::XMFLOAT3 position = {
+        (float(layerIdx % rowLength) - rowLength * 0.5f) * spacing,
+        (float(layerIdx / rowLength) - rowLength * 0.5f) * spacing,
+        -float(cubeIdx / layerSize) * spacing * 4.0f - 4.0f
+    };
+
+    ECSCore* pECS = ECSCore::GetInstance();
+    ModelLoader* pModelLoader = EngineCore::GetInstance()->GetAssetLoadersCore()->GetModelLoader();
+
+    const Entity cubeEntity = pECS->CreateEntity();
+    pECS->AddComponent(cubeEntity, PositionComponent({ .Position = position }));
+    pECS->AddComponent(cubeEntity, ScaleComponent({ .Scale = scale }));
+    pECS->AddComponent(cubeEntity, RotationComponent({ .Quaternion = g_QuaternionIdentity }));
+    pECS->AddComponent(cubeEntity, WorldMatrixComponent({ .WorldMatrix = CreateWorldMatrix(position, scale, g_QuaternionIdentity) }));
+    pECS->AddComponent(cubeEntity, pModelLoader->LoadModel("./assets/Models/Cube.dae"));
+    return cubeEntity;
+}
+
+void MeshBenchmark::ChurnRenderableField()
+{
+    const uint32_t fieldSize = (uint32_t)m_FieldEntities.size();
+    const uint32_t churnCount = std::min(m_Settings.ChurnPerFrame, fieldSize);
+
+    ECSCore* pECS = ECSCore::GetInstance();
+    for (uint32_t churnIdx = 0u; churnIdx < churnCount; churnIdx++) {
+        pECS->RemoveEntity(m_FieldEntities[m_NextChurnIdx]);
+        m_FieldEntities[m_NextChurnIdx] = CreateFieldCube(m_NextChurnIdx);
+
+        m_NextChurnIdx = (m_NextChurnIdx + 1u) % fieldSize;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Engine/ECS/Entity.hpp>
+#include <Game/States/Benchmarks/IBenchmarkModule.hpp>
+
+#include <string>
+
+/*  Fills the scene with additional renderables, optionally replacing some of them every frame, and with imported models
+    whose LODs are selected by their distance to the camera. Measures the mesh renderer's recording and draw statistics. */
+class MeshBenchmark : public IBenchmarkModule
+{
+public:
+    MeshBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+    ~MeshBenchmark() = default;
+
+    void CreateScene() override final;
+    void Update(uint64_t frameCount) override final;
+
+    void WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const override final;
+
+private:
+    void CreateRenderableField();
+    void CreateLODField();
+    // Writes a finely tessellated sphere as an OBJ model, returns its path or an empty string on failure
+    std::string WriteLODSphere(const std::string& directory) const;
+    Entity CreateFieldCube(uint32_t cubeIdx);
+    // Replaces the oldest renderables in the field with new ones
+    void ChurnRenderableField();
+
+private:
+    std::vector<Entity> m_FieldEntities;
+    uint32_t m_NextChurnIdx;
+
+    // Accumulated mesh recording statistics, used to calculate averages over the benchmark
+    float m_MeshRecordTimeSum;
+    float m_MeshUpdateTimeSum;
+    uint64_t m_BucketsRecordedSum;
+    uint64_t m_TriangleCountSum;
+    uint64_t m_FullDetailTriangleCountSum;
+    uint64_t m_LODChangesSum;
+};
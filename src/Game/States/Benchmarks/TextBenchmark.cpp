@@ -0,0 +1,95 @@
+#include "TextBenchmark.hpp"
+
+#include <Engine/Rendering/APIAbstractions/Texture.hpp>
+#include <Engine/Rendering/APIAbstractions/UploadQueue.hpp>
+#include <Engine/Rendering/Text/FontCache.hpp>
+#include <Engine/Rendering/Text/TextRenderer.hpp>
+
+#include <chrono>
+
+TextBenchmark::TextBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+    :   IBenchmarkModule(settings, pRuntimeStats, pRenderingHandler)
+    ,   m_BakedTextStringsPerSecond(0.0f)
+    ,   m_AtlasTextStringsPerSecond(0.0f)
+    ,   m_TextTextureBytes(0u)
+    ,   m_TextTextureBytesSaved(0u)
+{}
+
+void TextBenchmark::Measure()
+{
+    if (m_Settings.TextStringCount == 0u) {
+        return;
+    }
+
+    const std::string font = "assets/Fonts/arial/arial.ttf";
+    constexpr const uint32_t pixelHeight = 32u;
+    LOG_INFOF("Rendering %d strings of dynamic text", m_Settings.TextStringCount);
+
+    // The strings change like a score or a timer would
+    auto getString = [](uint32_t stringIdx) {
+        return "Score: " + std::to_string(stringIdx * 7919u);
+    };
+
+    UICore* pUICore = EngineCore::GetInstance()->GetUICore();
+    Device* pDevice = EngineCore::GetInstance()->GetRenderingCore()->GetDevice();
+
+    // Without the atlas, each string is rasterized into a texture of its own
+    TextRenderer* pTextRenderer = pUICore->GetTextRenderer();
+    std::vector<std::shared_ptr<Texture>> textTextures;
+    textTextures.reserve(m_Settings.TextStringCount);
+
+    auto measureStart = std::chrono::high_resolution_clock::now();
+    for (uint32_t stringIdx = 0u; stringIdx < m_Settings.TextStringCount; stringIdx++) {
+        textTextures.push_back(pTextRenderer->renderText(getString(stringIdx), font, pixelHeight));
+    }
+
+    const std::chrono::duration<float> bakedTime = std::chrono::high_resolution_clock::now() - measureStart;
+    m_BakedTextStringsPerSecond = m_Settings.TextStringCount / bakedTime.count();
+
+    // The text textures are single channel, they would occupy four times the memory as R8G8B8A8 textures
+    for (const std::shared_ptr<Texture>& textTexture : textTextures) {
+        if (textTexture) {
+            m_TextTextureBytes += textTexture->getByteSize();
+            m_TextTextureBytesSaved += getTextureSize(RESOURCE_FORMAT::R8G8B8A8_UNORM, textTexture->getDimensions()) - textTexture->getByteSize();
+        }
+    }
+
+    LOG_INFOF("Text textures occupy %.2f MB, saving %.2f MB versus R8G8B8A8 textures", m_TextTextureBytes / 1000000.0f, m_TextTextureBytesSaved / 1000000.0f);
+
+    // The textures can be deleted once their uploads have finished
+    UploadQueue* pUploadQueue = pDevice->getUploadQueue();
+    if (pUploadQueue) {
+        pUploadQueue->waitIdle();
+    }
+
+    textTextures.clear();
+
+    // With the atlas, each string is laid out as quads referencing glyphs that have already been rasterized
+    FontCache* pFontCache = pUICore->GetFontCache();
+    std::vector<GlyphQuad> glyphQuads;
+    glm::uvec2 textSize;
+
+    measureStart = std::chrono::high_resolution_clock::now();
+    for (uint32_t stringIdx = 0u; stringIdx < m_Settings.TextStringCount; stringIdx++) {
+        pFontCache->LayoutText(getString(stringIdx), font, pixelHeight, glyphQuads, textSize);
+    }
+
+    const std::chrono::duration<float> atlasTime = std::chrono::high_resolution_clock::now() - measureStart;
+    m_AtlasTextStringsPerSecond = m_Settings.TextStringCount / atlasTime.count();
+
+    LOG_INFOF("Rendered %.0f strings per second without the glyph atlas, and %.0f strings per second with it", m_BakedTextStringsPerSecond, m_AtlasTextStringsPerSecond);
+}
+
+void TextBenchmark::WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const
+{
+    UNREFERENCED_VARIABLE(frameCount);
+
+    constexpr const float MB = 1000000.0f;
+
+    benchmarkResults["TextStrings"]                 = m_Settings.TextStringCount;
+    benchmarkResults["BakedTextStringsPerSecond"]   = m_BakedTextStringsPerSecond;
+    benchmarkResults["AtlasTextStringsPerSecond"]   = m_AtlasTextStringsPerSecond;
+    benchmarkResults["TextTextureMemory"]           = float(m_TextTextureBytes / MB);
+    benchmarkResults["TextTextureMemorySaved"]      = float(m_TextTextureBytesSaved / MB);
+    benchmarkResults["GlyphAtlasGlyphs"]            = EngineCore::GetInstance()->GetUICore()->GetFontCache()->GetGlyphCount();
+}
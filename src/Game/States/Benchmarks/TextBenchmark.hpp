@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Game/States/Benchmarks/IBenchmarkModule.hpp>
+
+// Measures how many changing strings can be rendered per second with and without the glyph atlas
+class TextBenchmark : public IBenchmarkModule
+{
+public:
+    TextBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+    ~TextBenchmark() = default;
+
+    /*  Renders TextStringCount changing strings, first by rasterizing each string into its own texture, and then by laying
+        them out as quads referencing the glyph atlas. Measures the amount of strings per second of both, and the memory
+        occupied by the rasterized textures. */
+    void Measure() override final;
+
+    void WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const override final;
+
+private:
+    float m_BakedTextStringsPerSecond;
+    float m_AtlasTextStringsPerSecond;
+    // Size of the textures rasterized without the atlas, and the memory saved by them being single channel
+    uint64_t m_TextTextureBytes;
+    uint64_t m_TextTextureBytesSaved;
+};
@@ -0,0 +1,213 @@
+#include "TextureBenchmark.hpp"
+
+#include <Engine/Rendering/APIAbstractions/Texture.hpp>
+#include <Engine/Rendering/APIAbstractions/UploadQueue.hpp>
+#include <Engine/Rendering/AssetLoaders/AssetLoadersCore.hpp>
+#include <Engine/Rendering/AssetLoaders/TextureCooker.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+TextureBenchmark::TextureBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+    :   IBenchmarkModule(settings, pRuntimeStats, pRenderingHandler)
+    ,   m_BundledTextureImportTime(0.0f)
+    ,   m_BundledTextureCookedLoadTime(0.0f)
+    ,   m_TexturePackImportTime(0.0f)
+    ,   m_TexturePackCookedLoadTime(0.0f)
+    ,   m_TextureBytes(0u)
+    ,   m_UncompressedTextureBytes(0u)
+{}
+
+void TextureBenchmark::Measure()
+{
+    MeasureTextureLoadTime();
+}
+
+void TextureBenchmark::WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const
+{
+    UNREFERENCED_VARIABLE(frameCount);
+
+    constexpr const float MB = 1000000.0f;
+
+    benchmarkResults["Textures"]            = m_Settings.TextureCount;
+    const std::unordered_map<RESOURCE_FORMAT, std::string> textureFormatNames = {
+        {RESOURCE_FORMAT::R8G8B8A8_UNORM, "None"},
+        {RESOURCE_FORMAT::BC1_UNORM, "BC1"},
+        {RESOURCE_FORMAT::BC3_UNORM, "BC3"},
+        {RESOURCE_FORMAT::BC7_UNORM, "BC7"}
+    };
+
+    benchmarkResults["TextureCompression"]  = textureFormatNames.at(EngineCore::GetInstance()->GetRenderingCore()->GetTextureFormat());
+    benchmarkResults["BundledTextureImportTime"]        = m_BundledTextureImportTime;
+    benchmarkResults["BundledTextureCookedLoadTime"]    = m_BundledTextureCookedLoadTime;
+    benchmarkResults["TexturePackImportTime"]           = m_TexturePackImportTime;
+    benchmarkResults["TexturePackCookedLoadTime"]       = m_TexturePackCookedLoadTime;
+    benchmarkResults["TextureMemory"]                   = float(m_TextureBytes / MB);
+    benchmarkResults["UncompressedTextureMemory"]       = float(m_UncompressedTextureBytes / MB);
+}
+
+void TextureBenchmark::MeasureTextureLoadTime()
+{
+    if (m_Settings.TextureCount == 0u) {
+        return;
+    }
+
+    // Copies of the textures, to load them without any previously cooked versions or cached textures
+    const std::string textureDirectory = "./benchmark_assets/textures/";
+    std::filesystem::remove_all(textureDirectory);
+
+    std::error_code error;
+    std::filesystem::create_directories(textureDirectory + "bundled/cooked/", error);
+    if (!error) {
+        std::filesystem::create_directories(textureDirectory + "pack/cooked/", error);
+    }
+
+    const std::vector<std::string> bundledTextureNames = { "Cube.png", "Solid_White.png" };
+    std::vector<std::string> bundledTexturePaths;
+
+    for (const std::string& textureName : bundledTextureNames) {
+        if (!error) {
+            std::filesystem::copy_file("./assets/Models/" + textureName, textureDirectory + "bundled/" + textureName, error);
+            bundledTexturePaths.push_back(textureDirectory + "bundled/" + textureName);
+        }
+    }
+
+    if (error) {
+        LOG_WARNINGF("Failed to create texture benchmark assets in [%s]: %s", textureDirectory.c_str(), error.message().c_str());
+        return;
+    }
+
+    std::vector<std::string> packTexturePaths;
+    packTexturePaths.reserve(m_Settings.TextureCount);
+    for (uint32_t textureIdx = 0u; textureIdx < m_Settings.TextureCount; textureIdx++) {
+        const std::string texturePath = WriteProceduralTexture(textureDirectory + "pack/", textureIdx);
+        if (texturePath.empty()) {
+            return;
+        }
+
+        packTexturePaths.push_back(texturePath);
+    }
+
+    uint64_t bundledBytes = 0u, packBytes = 0u;
+    MeasureTextureSet(bundledTexturePaths, textureDirectory + "bundled/cooked/", m_BundledTextureImportTime, m_BundledTextureCookedLoadTime, bundledBytes);
+    MeasureTextureSet(packTexturePaths, textureDirectory + "pack/cooked/", m_TexturePackImportTime, m_TexturePackCookedLoadTime, packBytes);
+    m_TextureBytes = bundledBytes + packBytes;
+
+    LOG_INFOF("Loaded bundled textures in %.3f ms, and cooked in %.3f ms", m_BundledTextureImportTime, m_BundledTextureCookedLoadTime);
+    LOG_INFOF("Loaded %d 4K textures in %.3f ms, and cooked in %.3f ms", m_Settings.TextureCount, m_TexturePackImportTime, m_TexturePackCookedLoadTime);
+    LOG_INFOF("Textures occupy %.2f MB, versus %.2f MB as single uncompressed levels", m_TextureBytes / 1000000.0f, m_UncompressedTextureBytes / 1000000.0f);
+
+    std::filesystem::remove_all(textureDirectory);
+}
+
+void TextureBenchmark::MeasureTextureSet(const std::vector<std::string>& texturePaths, const std::string& cookedDirectory, float& importTime, float& cookedLoadTime, uint64_t& byteSize)
+{
+    TextureCache* pTextureCache = EngineCore::GetInstance()->GetAssetLoadersCore()->GetTextureCache();
+    UploadQueue* pUploadQueue = EngineCore::GetInstance()->GetRenderingCore()->GetDevice()->getUploadQueue();
+
+    std::vector<std::shared_ptr<Texture>> textures;
+    textures.reserve(texturePaths.size());
+
+    // Without cooked versions, the loads decode the images, generate their mip levels and compress them
+    const auto importStart = std::chrono::high_resolution_clock::now();
+    for (const std::string& texturePath : texturePaths) {
+        textures.push_back(pTextureCache->LoadTexture(texturePath));
+    }
+
+    if (pUploadQueue) {
+        pUploadQueue->waitIdle();
+    }
+
+    const std::chrono::duration<float, std::milli> importDuration = std::chrono::high_resolution_clock::now() - importStart;
+    importTime = importDuration.count();
+
+    byteSize = 0u;
+    for (const std::shared_ptr<Texture>& texture : textures) {
+        if (texture) {
+            byteSize += texture->getByteSize();
+            m_UncompressedTextureBytes += getTextureSize(RESOURCE_FORMAT::R8G8B8A8_UNORM, texture->getDimensions());
+        }
+    }
+
+    textures.clear();
+
+    // Copy the images and cook the copies, as the asset cooker would. The texture cache only reads cooked textures.
+    std::vector<std::string> cookedTexturePaths;
+    cookedTexturePaths.reserve(texturePaths.size());
+
+    for (const std::string& texturePath : texturePaths) {
+        const std::string copyPath = cookedDirectory + std::filesystem::path(texturePath).filename().string();
+
+        std::error_code error;
+        std::filesystem::copy_file(texturePath, copyPath, error);
+        if (error) {
+            LOG_WARNINGF("Failed to copy texture [%s]: %s", texturePath.c_str(), error.message().c_str());
+            return;
+        }
+
+        if (!TextureCooker::CookTexture(copyPath, pTextureCache->GetTextureFormat())) {
+            LOG_WARNINGF("Failed to cook texture: [%s]", copyPath.c_str());
+            return;
+        }
+
+        cookedTexturePaths.push_back(copyPath);
+    }
+
+    const auto cookedLoadStart = std::chrono::high_resolution_clock::now();
+    for (const std::string& texturePath : cookedTexturePaths) {
+        textures.push_back(pTextureCache->LoadTexture(texturePath));
+    }
+
+    if (pUploadQueue) {
+        pUploadQueue->waitIdle();
+    }
+
+    const std::chrono::duration<float, std::milli> cookedLoadDuration = std::chrono::high_resolution_clock::now() - cookedLoadStart;
+    cookedLoadTime = cookedLoadDuration.count();
+}
+
+std::string TextureBenchmark::WriteProceduralTexture(const std::string& directory, uint32_t textureIdx) const
+{
+    constexpr const uint32_t textureSize = 4096u;
+    const std::string texturePath = directory + "Pack" + std::to_string(textureIdx) + ".tga";
+
+    std::ofstream textureFile(texturePath, std::ios::binary | std::ios::trunc);
+    if (!textureFile.is_open()) {
+        LOG_WARNINGF("Failed to open procedural texture for writing: [%s]", texturePath.c_str());
+        return "";
+    }
+
+    // Uncompressed 32-bit true color image, with its origin in the top left corner
+    const uint8_t header[18] = {
+        0u, 0u, 2u,
+        0u, 0u, 0u, 0u, 0u,
+        0u, 0u, 0u, 0u,
+        uint8_t(textureSize & 0xFFu), uint8_t(textureSize >> 8u),
+        uint8_t(textureSize & 0xFFu), uint8_t(textureSize >> 8u),
+        32u, 0x28u
+    };
+
+    textureFile.write((const char*)header, sizeof(header));
+
+    // Smooth gradients overlaid with tiles and per-texture stripes, pixels are stored as BGRA
+    std::vector<uint8_t> row(textureSize * 4u);
+    for (uint32_t y = 0u; y < textureSize; y++) {
+        for (uint32_t x = 0u; x < textureSize; x++) {
+            const bool tile = ((x / 64u) + (y / 64u)) % 2u == 0u;
+            row[x * 4u + 0u] = uint8_t(x * 255u / textureSize);
+            row[x * 4u + 1u] = uint8_t(y * 255u / textureSize);
+            row[x * 4u + 2u] = tile ? 224u : uint8_t(((x + y) * (textureIdx + 1u)) >> 4u);
+            row[x * 4u + 3u] = 255u;
+        }
+
+        textureFile.write((const char*)row.data(), row.size());
+    }
+
+    if (!textureFile.good()) {
+        LOG_WARNINGF("Failed to write procedural texture: [%s]", texturePath.c_str());
+        return "";
+    }
+
+    return texturePath;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Game/States/Benchmarks/IBenchmarkModule.hpp>
+
+#include <string>
+
+// Measures the time to load textures from source images and from cooked textures, and the memory the textures occupy
+class TextureBenchmark : public IBenchmarkModule
+{
+public:
+    TextureBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+    ~TextureBenchmark() = default;
+
+    void Measure() override final;
+
+    void WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const override final;
+
+private:
+    // Measures the time to load the bundled textures and TextureCount procedural textures, and the memory they occupy
+    void MeasureTextureLoadTime();
+    /*  Loads the textures from their source images, and then from cooked copies of them in the given directory. Returns
+        the times of both loads and the size of the loaded textures. */
+    void MeasureTextureSet(const std::vector<std::string>& texturePaths, const std::string& cookedDirectory, float& importTime, float& cookedLoadTime, uint64_t& byteSize);
+    // Writes a procedural 4096x4096 TGA image, returns its path or an empty string on failure
+    std::string WriteProceduralTexture(const std::string& directory, uint32_t textureIdx) const;
+
+private:
+    // Texture load times from source images and from cooked textures, and the loaded textures' sizes including mip levels
+    float m_BundledTextureImportTime;
+    float m_BundledTextureCookedLoadTime;
+    float m_TexturePackImportTime;
+    float m_TexturePackCookedLoadTime;
+    uint64_t m_TextureBytes;
+    // Size of the textures as single R8G8B8A8 levels, as they were loaded before mip generation and compression
+    uint64_t m_UncompressedTextureBytes;
+};
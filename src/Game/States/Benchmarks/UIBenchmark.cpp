@@ -0,0 +1,173 @@
+#include "UIBenchmark.hpp"
+
+#include <Engine/Rendering/AssetLoaders/AssetLoadersCore.hpp>
+#include <Engine/Rendering/RenderingHandler.hpp>
+#include <Engine/UI/Panel.hpp>
+
+#include <chrono>
+#include <cmath>
+
+UIBenchmark::UIBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+    :   IBenchmarkModule(settings, pRuntimeStats, pRenderingHandler)
+    ,   m_FrameCounterEntity(0u)
+    ,   m_PanelCreationTime(0.0f)
+    ,   m_UIUpdateTimeSum(0.0f)
+    ,   m_UIDrawCountSum(0u)
+    ,   m_ButtonUpdateTimeSum(0.0f)
+    ,   m_ButtonsTestedSum(0u)
+{}
+
+void UIBenchmark::CreateScene()
+{
+    CreateFrameCounter();
+    CreatePanelField();
+    CreateButtonField();
+}
+
+void UIBenchmark::Update(uint64_t frameCount)
+{
+    const UIRendererStats& uiRendererStats = m_pRenderingHandler->getUIRenderer()->GetStats();
+    m_UIUpdateTimeSum   += uiRendererStats.UpdateTime;
+    m_UIDrawCountSum    += uiRendererStats.DrawCount;
+
+    const ButtonSystemStats& buttonSystemStats = EngineCore::GetInstance()->GetUICore()->GetButtonSystem()->GetStats();
+    m_ButtonUpdateTimeSum   += buttonSystemStats.UpdateTime;
+    m_ButtonsTestedSum      += buttonSystemStats.ButtonsTested;
+
+    ECSCore::GetInstance()->GetComponent<UITextComponent>(m_FrameCounterEntity).text = "Frame " + std::to_string(frameCount);
+
+    MoveFieldButton(frameCount);
+}
+
+void UIBenchmark::WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const
+{
+    benchmarkResults["Panels"]              = m_Settings.PanelCount;
+    benchmarkResults["PanelCreationTime"]   = m_PanelCreationTime;
+    benchmarkResults["AverageUIUpdateTime"] = frameCount ? m_UIUpdateTimeSum / frameCount : 0.0f;
+    benchmarkResults["AverageUIDrawCount"]  = frameCount ? float(m_UIDrawCountSum) / frameCount : 0.0f;
+
+    const ButtonSystemStats& buttonSystemStats = EngineCore::GetInstance()->GetUICore()->GetButtonSystem()->GetStats();
+    benchmarkResults["Buttons"]                     = m_Settings.ButtonCount;
+    benchmarkResults["ButtonGridRebuilds"]          = buttonSystemStats.GridRebuilds;
+    benchmarkResults["AverageButtonUpdateTime"]     = frameCount ? m_ButtonUpdateTimeSum / frameCount : 0.0f;
+    benchmarkResults["AverageButtonsTested"]        = frameCount ? float(m_ButtonsTestedSum) / frameCount : 0.0f;
+}
+
+void UIBenchmark::CreateFrameCounter()
+{
+    const UITextComponent textComponent = {
+        .text                   = "Frame 0",
+        .font                   = "assets/Fonts/arial/arial.ttf",
+        .pixelHeight            = 24u,
+        .position               = { 0.01f, 0.99f },
+        .horizontalAlignment    = TX_HORIZONTAL_ALIGNMENT_LEFT,
+        .verticalAlignment      = TX_VERTICAL_ALIGNMENT_TOP,
+        .color                  = { 1.0f, 1.0f, 1.0f, 1.0f }
+    };
+
+    m_FrameCounterEntity = ECSCore::GetInstance()->CreateEntity();
+    ECSCore::GetInstance()->AddComponent(m_FrameCounterEntity, textComponent);
+}
+
+void UIBenchmark::CreatePanelField()
+{
+    if (m_Settings.PanelCount == 0u) {
+        return;
+    }
+
+    LOG_INFOF("Creating %d UI panels", m_Settings.PanelCount);
+    const auto creationStart = std::chrono::high_resolution_clock::now();
+
+    // Fit the panels in a square grid covering the window
+    const uint32_t rowLength = (uint32_t)std::ceil(std::sqrt((float)m_Settings.PanelCount));
+    const float cellSize = 1.0f / rowLength;
+    const DirectX::XMFLOAT2 panelSize = { cellSize * 0.8f, cellSize * 0.8f };
+    constexpr const uint32_t layerCount = 4u;
+
+    EngineCore* pEngineCore = EngineCore::GetInstance();
+    UIHandler* pUIHandler = pEngineCore->GetUICore()->GetPanelHandler();
+    TextureCache* pTextureCache = pEngineCore->GetAssetLoadersCore()->GetTextureCache();
+
+    // Alternating textures make neighbouring panels differ, the renderer still draws each texture once per layer
+    const std::shared_ptr<Texture> pPanelTextures[2] = {
+        pTextureCache->LoadTexture("./assets/Models/Cube.png"),
+        pTextureCache->LoadTexture("./assets/Models/Solid_White.png")
+    };
+
+    TextureAttachmentInfo txAttachmentInfo = {};
+    txAttachmentInfo.sizeSetting = TX_SIZE_STRETCH;
+
+    ECSCore* pECS = ECSCore::GetInstance();
+    for (uint32_t panelIdx = 0u; panelIdx < m_Settings.PanelCount; panelIdx++) {
+        const DirectX::XMFLOAT2 position = { (panelIdx % rowLength) * cellSize, (panelIdx / rowLength) * cellSize };
+        const Entity panelEntity = pECS->CreateEntity();
+        pECS->AddComponent(panelEntity, pUIHandler->CreatePanel(position, panelSize, { 0.0f, 0.0f, 0.0f, 0.0f }, 0.0f, panelIdx % layerCount));
+        pUIHandler->AttachTextures(panelEntity, &txAttachmentInfo, &pPanelTextures[panelIdx % 2u], 1u);
+    }
+
+    const std::chrono::duration<float, std::milli> creationTime = std::chrono::high_resolution_clock::now() - creationStart;
+    m_PanelCreationTime = creationTime.count();
+    LOG_INFOF("Created %d UI panels in %.3f ms", m_Settings.PanelCount, m_PanelCreationTime);
+}
+
+void UIBenchmark::CreateButtonField()
+{
+    if (m_Settings.ButtonCount == 0u) {
+        return;
+    }
+
+    LOG_INFOF("Creating %d UI buttons", m_Settings.ButtonCount);
+
+    // Fit the buttons in a square grid covering the window, like the slots of a large inventory
+    const uint32_t rowLength = (uint32_t)std::ceil(std::sqrt((float)m_Settings.ButtonCount));
+    const float cellSize = 1.0f / rowLength;
+    const DirectX::XMFLOAT2 buttonSize = { cellSize * 0.9f, cellSize * 0.9f };
+    constexpr const uint32_t layerCount = 4u;
+    constexpr const DirectX::XMFLOAT4 defaultHighlight = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    EngineCore* pEngineCore = EngineCore::GetInstance();
+    UIHandler* pUIHandler = pEngineCore->GetUICore()->GetPanelHandler();
+    const std::shared_ptr<Texture> pButtonTexture = pEngineCore->GetAssetLoadersCore()->GetTextureCache()->LoadTexture("./assets/Models/Solid_White.png");
+
+    TextureAttachmentInfo txAttachmentInfo = {};
+    txAttachmentInfo.sizeSetting = TX_SIZE_STRETCH;
+
+    const UIButtonComponent buttonComponent = {
+        .defaultHighlight   = defaultHighlight,
+        .hoverHighlight     = { 0.1f, 0.0f, 0.0f, 1.0f },
+        .pressHighlight     = { 0.2f, 0.0f, 0.0f, 1.0f },
+        .onPress            = []() {}
+    };
+
+    ECSCore* pECS = ECSCore::GetInstance();
+    m_ButtonEntities.reserve(m_Settings.ButtonCount);
+
+    for (uint32_t buttonIdx = 0u; buttonIdx < m_Settings.ButtonCount; buttonIdx++) {
+        const DirectX::XMFLOAT2 position = { (buttonIdx % rowLength) * cellSize, (buttonIdx / rowLength) * cellSize };
+        const Entity buttonEntity = pECS->CreateEntity();
+        pECS->AddComponent(buttonEntity, pUIHandler->CreatePanel(position, buttonSize, defaultHighlight, 1.0f, buttonIdx % layerCount));
+        pUIHandler->AttachTextures(buttonEntity, &txAttachmentInfo, &pButtonTexture, 1u);
+        pECS->AddComponent(buttonEntity, buttonComponent);
+        m_ButtonEntities.push_back(buttonEntity);
+    }
+}
+
+void UIBenchmark::MoveFieldButton(uint64_t frameCount)
+{
+    constexpr const uint64_t moveInterval = 60u;
+    if (m_ButtonEntities.empty() || frameCount % moveInterval != 0u) {
+        return;
+    }
+
+    // Swap the positions of two buttons, keeping the field intact
+    const Entity firstButton = m_ButtonEntities[(frameCount / moveInterval) % m_ButtonEntities.size()];
+    const Entity secondButton = m_ButtonEntities[(frameCount / moveInterval + 1u) % m_ButtonEntities.size()];
+
+    ECSCore* pECS = ECSCore::GetInstance();
+    const UIPanelComponent firstPanel = pECS->GetConstComponent<UIPanelComponent>(firstButton);
+    const UIPanelComponent& secondPanel = pECS->GetConstComponent<UIPanelComponent>(secondButton);
+
+    UIHandler* pUIHandler = EngineCore::GetInstance()->GetUICore()->GetPanelHandler();
+    pUIHandler->MovePanel(firstButton, secondPanel.position, secondPanel.size);
+    pUIHandler->MovePanel(secondButton, firstPanel.position, firstPanel.size);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Engine/ECS/Entity.hpp>
+#include <Game/States/Benchmarks/IBenchmarkModule.hpp>
+
+/*  Shows a frame counter drawn as atlas text, and fills the window with textured panels and buttons. Measures the UI
+    renderer's batching and the cost of hit testing the mouse against the buttons. */
+class UIBenchmark : public IBenchmarkModule
+{
+public:
+    UIBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+    ~UIBenchmark() = default;
+
+    void CreateScene() override final;
+    void Update(uint64_t frameCount) override final;
+
+    void WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const override final;
+
+private:
+    // Creates a text label showing the frame count, which changes every frame
+    void CreateFrameCounter();
+    // Spawns PanelCount small panels in a grid, alternating between two textures and spread over a few layers
+    void CreatePanelField();
+    // Spawns ButtonCount small buttons in a grid covering the window, spread over a few layers
+    void CreateButtonField();
+    // Moves one of the buttons every so often, which makes the button system rebuild its grid
+    void MoveFieldButton(uint64_t frameCount);
+
+private:
+    Entity m_FrameCounterEntity;
+
+    float m_PanelCreationTime;
+    // Accumulated UI renderer statistics, used to calculate averages over the benchmark
+    float m_UIUpdateTimeSum;
+    uint64_t m_UIDrawCountSum;
+
+    std::vector<Entity> m_ButtonEntities;
+    // Accumulated button system statistics
+    float m_ButtonUpdateTimeSum;
+    uint64_t m_ButtonsTestedSum;
+};
@@ -0,0 +1,157 @@
+#include "UploadBenchmark.hpp"
+
+#include <Engine/Rendering/APIAbstractions/Device.hpp>
+#include <Engine/Rendering/APIAbstractions/IBuffer.hpp>
+#include <Engine/Rendering/APIAbstractions/Texture.hpp>
+#include <Engine/Rendering/AssetContainers/Model.hpp>
+
+#include <chrono>
+
+UploadBenchmark::UploadBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler)
+    :   IBenchmarkModule(settings, pRuntimeStats, pRenderingHandler)
+    ,   m_UploadTime(0.0f)
+    ,   m_UploadStats({})
+    ,   m_UniformUpdateTime(0.0f)
+{}
+
+void UploadBenchmark::Measure()
+{
+    MeasureUploadTime();
+    MeasureUniformUpdateTime();
+}
+
+void UploadBenchmark::WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const
+{
+    UNREFERENCED_VARIABLE(frameCount);
+
+    benchmarkResults["UploadedMeshes"]      = m_Settings.UploadCount;
+    benchmarkResults["UploadedTextures"]    = m_Settings.UploadCount;
+    benchmarkResults["UploadTime"]          = m_UploadTime;
+    benchmarkResults["UploadedBytes"]       = m_UploadStats.UploadedBytes;
+    benchmarkResults["UploadBatches"]       = m_UploadStats.SubmittedBatches;
+    benchmarkResults["UploadRingFullSubmits"] = m_UploadStats.RingFullSubmits;
+
+    benchmarkResults["UniformBuffers"]      = m_Settings.UniformBufferCount;
+    benchmarkResults["AverageUniformUpdateTime"] = m_UniformUpdateTime;
+}
+
+void UploadBenchmark::MeasureUploadTime()
+{
+    if (m_Settings.UploadCount == 0u) {
+        return;
+    }
+
+    LOG_INFOF("Uploading %d meshes and %d textures", m_Settings.UploadCount, m_Settings.UploadCount);
+
+    // A cube's worth of vertices and indices per mesh, and a 256x256 texture
+    constexpr const uint32_t vertexCount = 24u;
+    constexpr const uint32_t indexCount = 36u;
+    constexpr const uint32_t textureSize = 256u;
+
+    const std::vector<Vertex> vertices(vertexCount, Vertex());
+    const std::vector<unsigned> indices(indexCount, 0u);
+    const std::vector<uint32_t> pixels(textureSize * textureSize, 0xFFFFFFFFu);
+
+    InitialData textureData = {};
+    textureData.pData   = pixels.data();
+    textureData.RowSize = textureSize * sizeof(uint32_t);
+
+    TextureInfo textureInfo = {};
+    textureInfo.Dimensions      = { textureSize, textureSize };
+    textureInfo.Usage           = TEXTURE_USAGE::SAMPLED | TEXTURE_USAGE::TRANSFER_DST;
+    textureInfo.Layout          = TEXTURE_LAYOUT::SHADER_READ_ONLY;
+    textureInfo.Format          = RESOURCE_FORMAT::R8G8B8A8_UNORM;
+    textureInfo.pInitialData    = &textureData;
+
+    Device* pDevice = EngineCore::GetInstance()->GetRenderingCore()->GetDevice();
+    UploadQueue* pUploadQueue = pDevice->getUploadQueue();
+    const UploadQueueStats statsBefore = pUploadQueue ? pUploadQueue->getStats() : UploadQueueStats({});
+
+    std::vector<IBuffer*> buffers;
+    std::vector<Texture*> textures;
+    buffers.reserve(m_Settings.UploadCount * 2u);
+    textures.reserve(m_Settings.UploadCount);
+
+    const auto uploadStart = std::chrono::high_resolution_clock::now();
+
+    for (uint32_t uploadIdx = 0u; uploadIdx < m_Settings.UploadCount; uploadIdx++) {
+        buffers.push_back(pDevice->createVertexBuffer(vertices.data(), sizeof(Vertex), vertexCount));
+        buffers.push_back(pDevice->createIndexBuffer(indices.data(), indexCount));
+        textures.push_back(pDevice->createTexture(textureInfo));
+    }
+
+    // The load has finished once the data has reached the GPU
+    if (pUploadQueue) {
+        pUploadQueue->waitIdle();
+    }
+
+    const std::chrono::duration<float, std::milli> uploadTime = std::chrono::high_resolution_clock::now() - uploadStart;
+    m_UploadTime = uploadTime.count();
+
+    if (pUploadQueue) {
+        const UploadQueueStats statsAfter = pUploadQueue->getStats();
+        m_UploadStats.Uploads           = statsAfter.Uploads - statsBefore.Uploads;
+        m_UploadStats.UploadedBytes     = statsAfter.UploadedBytes - statsBefore.UploadedBytes;
+        m_UploadStats.SubmittedBatches  = statsAfter.SubmittedBatches - statsBefore.SubmittedBatches;
+        m_UploadStats.RingFullSubmits   = statsAfter.RingFullSubmits - statsBefore.RingFullSubmits;
+    }
+
+    LOG_INFOF("Uploaded %d meshes and %d textures in %.2f ms", m_Settings.UploadCount, m_Settings.UploadCount, m_UploadTime);
+
+    for (IBuffer* pBuffer : buffers) {
+        delete pBuffer;
+    }
+
+    for (Texture* pTexture : textures) {
+        delete pTexture;
+    }
+}
+
+void UploadBenchmark::MeasureUniformUpdateTime()
+{
+    if (m_Settings.UniformBufferCount == 0u) {
+        return;
+    }
+
+    constexpr const uint32_t frameCount = 100u;
+    LOG_INFOF("Updating %d uniform buffers for %d frames", m_Settings.UniformBufferCount, frameCount);
+
+    // A WVP and a world matrix per buffer, as in the mesh renderer's per-object buffers
+    DirectX::XMFLOAT4X4 matrices[2] = {};
+
+    BufferInfo bufferInfo = {};
+    bufferInfo.ByteSize     = sizeof(matrices);
+    bufferInfo.CPUAccess    = BUFFER_DATA_ACCESS::WRITE;
+    bufferInfo.GPUAccess    = BUFFER_DATA_ACCESS::READ;
+    bufferInfo.Usage        = BUFFER_USAGE::UNIFORM_BUFFER;
+
+    Device* pDevice = EngineCore::GetInstance()->GetRenderingCore()->GetDevice();
+    std::vector<IBuffer*> buffers;
+    buffers.reserve(m_Settings.UniformBufferCount);
+    for (uint32_t bufferIdx = 0u; bufferIdx < m_Settings.UniformBufferCount; bufferIdx++) {
+        buffers.push_back(pDevice->createBuffer(bufferInfo));
+    }
+
+    const auto updateStart = std::chrono::high_resolution_clock::now();
+
+    // The buffers are never read by the GPU, which leaves only the CPU cost of mapping, writing and unmapping
+    for (uint32_t frameIdx = 0u; frameIdx < frameCount; frameIdx++) {
+        matrices[1]._44 = float(frameIdx);
+
+        for (IBuffer* pBuffer : buffers) {
+            void* pMappedMemory = nullptr;
+            pDevice->map(pBuffer, &pMappedMemory);
+            memcpy(pMappedMemory, matrices, sizeof(matrices));
+            pDevice->unmap(pBuffer);
+        }
+    }
+
+    const std::chrono::duration<float, std::milli> updateTime = std::chrono::high_resolution_clock::now() - updateStart;
+    m_UniformUpdateTime = updateTime.count() / frameCount;
+
+    LOG_INFOF("Updated %d uniform buffers in %.3f ms per frame", m_Settings.UniformBufferCount, m_UniformUpdateTime);
+
+    for (IBuffer* pBuffer : buffers) {
+        delete pBuffer;
+    }
+}
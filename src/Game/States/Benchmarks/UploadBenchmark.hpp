@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Engine/Rendering/APIAbstractions/UploadQueue.hpp>
+#include <Game/States/Benchmarks/IBenchmarkModule.hpp>
+
+// Measures the time to upload meshes and textures, and the time to update uniform buffers each frame
+class UploadBenchmark : public IBenchmarkModule
+{
+public:
+    UploadBenchmark(const BenchmarkSettings& settings, const RuntimeStats* pRuntimeStats, const RenderingHandler* pRenderingHandler);
+    ~UploadBenchmark() = default;
+
+    void Measure() override final;
+
+    void WriteResults(nlohmann::json& benchmarkResults, uint64_t frameCount) const override final;
+
+private:
+    // Creates and deletes UploadCount meshes and textures, measuring the time until their data has reached the GPU
+    void MeasureUploadTime();
+    // Writes to UniformBufferCount uniform buffers for a number of simulated frames, measuring the average time per frame
+    void MeasureUniformUpdateTime();
+
+private:
+    float m_UploadTime;
+    UploadQueueStats m_UploadStats;
+
+    float m_UniformUpdateTime;
+};
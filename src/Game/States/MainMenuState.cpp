@@ -4,16 +4,14 @@
 #include <Engine/ECS/ECSCore.hpp>
 #include <Engine/GameState/StateManager.hpp>
 #include <Engine/InputHandler.hpp>
+#include <Engine/Rendering/AssetLoaders/AssetLoadersCore.hpp>
 #include <Engine/Rendering/AssetLoaders/TextureCache.hpp>
-#include <Engine/Rendering/Text/TextRenderer.hpp>
 #include <Engine/UI/Panel.hpp>
 #include <Engine/Utils/Debug.hpp>
 #include <Engine/Utils/ECSUtils.hpp>
 #include <Engine/Utils/Logger.hpp>
 #include <Game/States/GameSession.hpp>
 
-#include <array>
-
 MainMenuState::MainMenuState(StateManager* pStateManager)
     :State(pStateManager)
 {}
@@ -29,7 +27,14 @@ void MainMenuState::Init()
 
 void MainMenuState::Resume()
 {
-    EngineCore::GetInstance()->GetRenderingCore()->GetWindow()->GetInputHandler()->showCursor();
+    EngineCore* pEngineCore = EngineCore::GetInstance();
+    pEngineCore->GetRenderingCore()->GetWindow()->GetInputHandler()->showCursor();
+
+    // Assets released by the game session stay resident within the memory budget, sparing the next session from reloading them
+    constexpr const float MB = 1024.0f * 1024.0f;
+    const ResidencyStats residencyStats = pEngineCore->GetAssetLoadersCore()->GetResidencyManager()->GetStats();
+    LOG_INFOF("Asset residency: %llu hits, %llu misses, %llu evictions, %.1f/%.1f MB tracked",
+        residencyStats.Hits, residencyStats.Misses, residencyStats.Evictions, residencyStats.TrackedBytes / MB, residencyStats.BudgetBytes / MB);
 }
 
 void MainMenuState::Pause()
@@ -60,22 +65,26 @@ void MainMenuState::CreatePlayButton()
     m_PlayButtonEntity = pECS->CreateEntity();
     pECS->AddComponent(m_PlayButtonEntity, pUIHandler->CreatePanel(buttonPos, buttonSize, buttonHighlight, buttonHighlightFactor));
 
-    // Attach background and text textures to the panel
+    // Attach a background texture to the panel, and draw the button's text on top of it
     TextureCache* pTextureCache = pEngineCore->GetAssetLoadersCore()->GetTextureCache();
-    TextRenderer* pTextRenderer = pUICore->GetTextRenderer();
+    const std::shared_ptr<Texture> pBackgroundTexture = pTextureCache->LoadTexture("./assets/Models/Cube.png");
 
-    const std::array<std::shared_ptr<Texture>, 2> panelTextures = {
-        pTextureCache->LoadTexture("./assets/Models/Cube.png"),
-        pTextRenderer->renderText("Play", "assets/Fonts/arial/arial.ttf", 50)
-    };
+    TextureAttachmentInfo txAttachmentInfo = {};
+    txAttachmentInfo.sizeSetting = TX_SIZE_STRETCH;
+
+    pUIHandler->AttachTextures(m_PlayButtonEntity, &txAttachmentInfo, &pBackgroundTexture, 1u);
 
-    TextureAttachmentInfo txAttachmentInfos[2];
-    txAttachmentInfos[0].sizeSetting            = TX_SIZE_STRETCH;
-    txAttachmentInfos[1].horizontalAlignment    = TX_HORIZONTAL_ALIGNMENT_CENTER;
-    txAttachmentInfos[1].verticalAlignment      = TX_VERTICAL_ALIGNMENT_CENTER;
-    txAttachmentInfos[1].sizeSetting            = TX_SIZE_CLIENT_RESOLUTION_DEPENDENT;
+    const UITextComponent textComponent = {
+        .text                   = "Play",
+        .font                   = "assets/Fonts/arial/arial.ttf",
+        .pixelHeight            = 50u,
+        .position               = { buttonPos.x + buttonSize.x * 0.5f, buttonPos.y + buttonSize.y * 0.5f },
+        .horizontalAlignment    = TX_HORIZONTAL_ALIGNMENT_CENTER,
+        .verticalAlignment      = TX_VERTICAL_ALIGNMENT_CENTER,
+        .color                  = { 1.0f, 1.0f, 1.0f, 1.0f }
+    };
 
-    pUIHandler->AttachTextures(m_PlayButtonEntity, txAttachmentInfos, panelTextures.data(), panelTextures.size());
+    pECS->AddComponent(m_PlayButtonEntity, textComponent);
 
     const UIButtonComponent buttonComponent = {
         .defaultHighlight = buttonHighlight,
@@ -0,0 +1,162 @@
+#include <Engine/Rendering/AssetLoaders/ModelCooker.hpp>
+#include <Engine/Rendering/AssetLoaders/TextureCooker.hpp>
+#include <Engine/Utils/Logger.hpp>
+#include <Engine/Utils/MappedFile.hpp>
+#include <Engine/Utils/ThreadPool.hpp>
+
+#include <argh/argh.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+// Measures the time to import the model using Assimp, versus mapping its cooked version and reading its vertices and indices
+static void CompareLoadTimes(const std::string& filePath)
+{
+    const auto importStart = std::chrono::high_resolution_clock::now();
+
+    ModelData modelData;
+    if (!ModelCooker::ImportModel(filePath, modelData)) {
+        return;
+    }
+
+    const std::chrono::duration<float, std::milli> importTime = std::chrono::high_resolution_clock::now() - importStart;
+    const auto mapStart = std::chrono::high_resolution_clock::now();
+
+    MappedFile cookedFile;
+    const CookedModelHeader* pHeader = cookedFile.Open(ModelCooker::GetCookedPath(filePath)) ? ModelCooker::ValidateCookedModel(cookedFile, filePath) : nullptr;
+    if (!pHeader) {
+        LOG_WARNINGF("No up to date cooked model to compare with: [%s]", filePath.c_str());
+        return;
+    }
+
+    // Touch every page holding vertices and indices, as uploading them would
+    const uint8_t* pFileData = cookedFile.GetData();
+    const CookedMesh* pMeshes = reinterpret_cast<const CookedMesh*>(pHeader + 1);
+    uint32_t checksum = 0u;
+    uint32_t triangleCount = 0u;
+
+    for (uint32_t meshIdx = 0u; meshIdx < pHeader->MeshCount; meshIdx += 1u) {
+        const CookedMesh& mesh = pMeshes[meshIdx];
+        const uint8_t* pMeshEnd = pFileData + mesh.IndicesOffset + sizeof(uint32_t) * mesh.IndexCount;
+        for (const uint8_t* pByte = pFileData + mesh.VerticesOffset; pByte < pMeshEnd; pByte += 4096u) {
+            checksum += *pByte;
+        }
+
+        triangleCount += mesh.IndexCount / 3u;
+    }
+
+    const std::chrono::duration<float, std::milli> mapTime = std::chrono::high_resolution_clock::now() - mapStart;
+    LOG_INFOF("[%s] %d triangles: Assimp %.2f ms, cooked %.2f ms (checksum %d)", filePath.c_str(), triangleCount, importTime.count(), mapTime.count(), checksum);
+}
+
+// Measures the time to decode the image, generate its mips and compress them, versus mapping its cooked version
+static void CompareTextureLoadTimes(const std::string& filePath, RESOURCE_FORMAT format)
+{
+    const auto importStart = std::chrono::high_resolution_clock::now();
+
+    TextureData textureData;
+    if (!TextureCooker::ImportTexture(filePath, format, textureData)) {
+        return;
+    }
+
+    const std::chrono::duration<float, std::milli> importTime = std::chrono::high_resolution_clock::now() - importStart;
+    const auto mapStart = std::chrono::high_resolution_clock::now();
+
+    MappedFile cookedFile;
+    const CookedTextureHeader* pHeader = cookedFile.Open(TextureCooker::GetCookedPath(filePath)) ? TextureCooker::ValidateCookedTexture(cookedFile, filePath, format) : nullptr;
+    if (!pHeader) {
+        LOG_WARNINGF("No up to date cooked texture to compare with: [%s]", filePath.c_str());
+        return;
+    }
+
+    // Touch every page holding mip levels, as uploading them would
+    uint32_t checksum = 0u;
+    for (const uint8_t* pByte = cookedFile.GetData(); pByte < cookedFile.GetData() + cookedFile.GetSize(); pByte += 4096u) {
+        checksum += *pByte;
+    }
+
+    const std::chrono::duration<float, std::milli> mapTime = std::chrono::high_resolution_clock::now() - mapStart;
+    LOG_INFOF("[%s] %dx%d, %d mip levels, %zu bytes: import %.2f ms, cooked %.2f ms (checksum %d)", filePath.c_str(), pHeader->Width, pHeader->Height,
+        pHeader->MipLevels, cookedFile.GetSize(), importTime.count(), mapTime.count(), checksum);
+}
+
+static bool IsTexture(const std::string& filePath)
+{
+    const std::unordered_set<std::string> textureExtensions = { ".png", ".jpg", ".jpeg", ".tga", ".bmp" };
+
+    std::string extension = std::filesystem::path(filePath).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](unsigned char c){ return (char)std::tolower(c); });
+
+    return textureExtensions.contains(extension);
+}
+
+/*  Cooks every model and texture passed on the command line, e.g. AssetCooker ./assets/Models/Cube.dae. --compare also
+    measures load times. Textures are cooked uncompressed unless a format is given, e.g. --texture-format=bc7. The
+    format has to match the engine config's TextureCompression for the cooked textures to be used. */
+int main(int argc, char** argv)
+{
+    Logger::init();
+    ThreadPool::GetInstance().Init();
+    argh::parser flagParser(argc, argv);
+
+    const std::vector<std::string>& arguments = flagParser.pos_args();
+    if (arguments.size() < 2u) {
+        LOG_ERROR("Usage: AssetCooker [--compare] [--texture-format=none|bc1|bc3|bc7] <model and texture paths>");
+        return 1;
+    }
+
+    const std::unordered_map<std::string, RESOURCE_FORMAT> textureFormats = {
+        {"none", RESOURCE_FORMAT::R8G8B8A8_UNORM},
+        {"bc1", RESOURCE_FORMAT::BC1_UNORM},
+        {"bc3", RESOURCE_FORMAT::BC3_UNORM},
+        {"bc7", RESOURCE_FORMAT::BC7_UNORM}
+    };
+
+    std::string textureFormatStr;
+    flagParser({"--texture-format"}, "none") >> textureFormatStr;
+    const auto textureFormatItr = textureFormats.find(textureFormatStr);
+    if (textureFormatItr == textureFormats.end()) {
+        LOG_ERRORF("Unknown texture format: %s", textureFormatStr.c_str());
+        return 1;
+    }
+
+    const RESOURCE_FORMAT textureFormat = textureFormatItr->second;
+
+    int failedCount = 0;
+    for (size_t argIdx = 1u; argIdx < arguments.size(); argIdx += 1u) {
+        const std::string& filePath = arguments[argIdx];
+        if (IsTexture(filePath)) {
+            if (!TextureCooker::CookTexture(filePath, textureFormat)) {
+                LOG_ERRORF("Failed to cook texture: [%s]", filePath.c_str());
+                failedCount += 1;
+                continue;
+            }
+
+            LOG_INFOF("Cooked [%s] into [%s]", filePath.c_str(), TextureCooker::GetCookedPath(filePath).c_str());
+
+            if (flagParser["--compare"]) {
+                CompareTextureLoadTimes(filePath, textureFormat);
+            }
+
+            continue;
+        }
+
+        if (!ModelCooker::CookModel(filePath)) {
+            LOG_ERRORF("Failed to cook model: [%s]", filePath.c_str());
+            failedCount += 1;
+            continue;
+        }
+
+        LOG_INFOF("Cooked [%s] into [%s]", filePath.c_str(), ModelCooker::GetCookedPath(filePath).c_str());
+
+        if (flagParser["--compare"]) {
+            CompareLoadTimes(filePath);
+        }
+    }
+
+    return failedCount;
+}